@@ -139,22 +139,132 @@ static GstdClientCmd cmds[] = {
         "Deletes the pipeline with the given name",
       "pipeline_delete <name>"},
   {"pipeline_play", gstd_client_cmd_socket, "Sets the pipeline to playing",
-      "pipeline_play <name>"},
+      "pipeline_play <name>|<glob>|<name,name,...>"},
   {"pipeline_pause", gstd_client_cmd_socket, "Sets the pipeline to paused",
-      "pipeline_pause <name>"},
+      "pipeline_pause <name>|<glob>|<name,name,...>"},
   {"pipeline_stop", gstd_client_cmd_socket, "Sets the pipeline to null",
-      "pipeline_stop <name>"},
+      "pipeline_stop <name>|<glob>|<name,name,...>"},
   {"pipeline_get_graph", gstd_client_cmd_socket, "Gets pipeline graph",
       "pipeline_get_graph <name>"},
   {"pipeline_verbose", gstd_client_cmd_socket, "Updates pipeline verbose",
       "pipeline_verbose <name> <value>"},
+  {"pipeline_create_from_pool", gstd_client_cmd_socket,
+        "Creates a new pipeline taking a warm instance from the given pool",
+      "pipeline_create_from_pool <name> <pool>"},
+  {"pipeline_play_from_pool", gstd_client_cmd_socket,
+        "Takes a warm instance from the given pool and sets it to playing",
+      "pipeline_play_from_pool <name> <pool>"},
+
+  {"pool_create", gstd_client_cmd_socket,
+        "Creates a pool of warm pipelines based on the name and description",
+      "pool_create <pool> <description>"},
+  {"pool_delete", gstd_client_cmd_socket,
+        "Deletes the pool with the given name and its warm pipelines",
+      "pool_delete <pool>"},
+  {"pool_size", gstd_client_cmd_socket,
+        "Sets the amount of warm pipelines kept in the pool",
+      "pool_size <pool> <size>"},
 
   {"element_set", gstd_client_cmd_socket,
         "Sets a property in an element of a given pipeline",
-      "element_set <pipe> <element> <property> <value>"},
+      "element_set <pipe> <element>[/<child>] <property> <value>"},
   {"element_get", gstd_client_cmd_socket,
         "Queries a property in an element of a given pipeline",
-      "element_get <pipe> <element> <property>"},
+      "element_get <pipe> <element>[/<child>] <property>"},
+  {"element_ramp", gstd_client_cmd_socket,
+        "Animates a controllable property with interpolated keyframes, "
+        "times are in nanoseconds and a leading '+' makes them relative "
+        "to the current position",
+      "element_ramp <pipe> <element> <property> <none|linear|cubic> "
+        "<[+]time:value> [[+]time:value ...]"},
+  {"element_ramp_stop", gstd_client_cmd_socket,
+        "Removes the interpolated control of a property",
+      "element_ramp_stop <pipe> <element> <property>"},
+  {"element_batch", gstd_client_cmd_socket,
+        "Sets several properties together right before the next buffer "
+        "goes through the trigger pad, or once the given running time in "
+        "nanoseconds is reached",
+      "element_batch <pipe> [at=<time>] [pad=<element.pad>] "
+        "<element.property=value> [element.property=value ...]"},
+  {"pipeline_schedule", gstd_client_cmd_socket,
+        "Executes a command once the pipeline running time or the wall "
+        "clock time since the epoch reaches the deadline, in nanoseconds. "
+        "A leading '+' makes the deadline relative to now",
+      "pipeline_schedule <pipe> <name> <[+]running-time|wall=[+]time> "
+        "<command>"},
+  {"pipeline_unschedule", gstd_client_cmd_socket,
+        "Cancels a scheduled command",
+      "pipeline_unschedule <pipe> <name>"},
+  {"rule_create", gstd_client_cmd_socket,
+        "Runs commands separated by ';' whenever a message matching the "
+        "type, source and fields is posted, or a signal is emitted",
+      "rule_create <pipe> <name> "
+        "<message=type[@source][,field=value...]|signal=element.signal> "
+        "<command>[; command...]"},
+  {"rule_delete", gstd_client_cmd_socket, "Deletes a rule",
+      "rule_delete <pipe> <name>"},
+  {"sync_group_create", gstd_client_cmd_socket,
+        "Groups pipelines to share a clock and base time",
+      "sync_group_create <group> <pipe>[,pipe...]"},
+  {"sync_group_delete", gstd_client_cmd_socket,
+        "Deletes a group, releasing the clock of its pipelines",
+      "sync_group_delete <group>"},
+  {"sync_group_play", gstd_client_cmd_socket,
+        "Starts all the pipelines of a group at a common base time",
+      "sync_group_play <group>"},
+  {"sync_group_stop", gstd_client_cmd_socket,
+        "Stops all the pipelines of a group",
+      "sync_group_stop <group>"},
+  {"link_create", gstd_client_cmd_socket,
+        "Feeds the buffers of a producer element into an appsrc of another "
+        "pipeline without copying them",
+      "link_create <link> <pipe.element[.pad]> <pipe.appsrc>"},
+  {"link_delete", gstd_client_cmd_socket,
+        "Stops feeding a consumer, leaving both pipelines running",
+      "link_delete <link>"},
+  {"recording_start", gstd_client_cmd_socket,
+        "Attaches a branch to a tee of a running pipeline, starting on the "
+        "next keyframe",
+      "recording_start <pipe> <name> <tee> <element> ! ... ! <sink>"},
+  {"recording_stop", gstd_client_cmd_socket,
+        "Detaches a recording branch, finalizing it with an EOS",
+      "recording_stop <pipe> <name>"},
+  {"element_create", gstd_client_cmd_socket,
+        "Adds an element or bin to a running pipeline, linking is left to "
+        "element_link",
+      "element_create <pipe> <name> <element> [! ... ]"},
+  {"element_delete", gstd_client_cmd_socket,
+        "Unlinks and removes an element from a running pipeline",
+      "element_delete <pipe> <name>"},
+  {"element_link", gstd_client_cmd_socket,
+        "Links two elements of a running pipeline",
+      "element_link <pipe> <src>[.<pad>] <sink>[.<pad>]"},
+  {"element_unlink", gstd_client_cmd_socket,
+        "Unlinks two elements of a running pipeline",
+      "element_unlink <pipe> <src>[.<pad>] <sink>[.<pad>]"},
+  {"endpoint_create", gstd_client_cmd_socket,
+        "Exchanges the data of an appsink or appsrc through a shared memory "
+        "ring other processes can map",
+      "endpoint_create <pipe> <name> <element> [<slots> [<slot-size>]]"},
+  {"endpoint_delete", gstd_client_cmd_socket,
+        "Stops exchanging data and removes the shared memory ring",
+      "endpoint_delete <pipe> <name>"},
+  {"element_snapshot", gstd_client_cmd_socket,
+        "Encodes the last sample of an element as a base64 still image",
+      "element_snapshot <pipe> <element> "
+        "[format=<jpeg|png>[,width=<w>][,height=<h>]]"},
+  {"telemetry_create", gstd_client_cmd_socket,
+        "Samples a numeric element property, or property.field of a "
+        "structure property, into an in-memory time series. The interval "
+        "is at least 100 ms and the capacity at most 86400 points",
+      "telemetry_create <pipe> <name> <element> <property> "
+        "[<interval-ms> [<capacity>]]"},
+  {"telemetry_read", gstd_client_cmd_socket,
+        "Returns the points of a time series, all of them by default",
+      "telemetry_read <pipe> <name> [all|last=<s>|from=<us>,to=<us>]"},
+  {"telemetry_delete", gstd_client_cmd_socket,
+        "Stops sampling and drops the time series",
+      "telemetry_delete <pipe> <name>"},
 
   {"list_pipelines", gstd_client_cmd_socket, "List the existing pipelines",
       "list_pipelines"},
@@ -178,12 +288,24 @@ static GstdClientCmd cmds[] = {
         "Apply a timeout for the bus polling. -1: forever, 0: return immediately, "
         "n: wait n nanoseconds",
       "bus_timeout <pipe> <timeout>"},
+  {"bus_policy", gstd_client_cmd_socket,
+        "Select the messages the daemon reacts to on its own. Separate with "
+        "a '+', i.e.: buffering+clock-lost+latency+request-state",
+      "bus_policy <pipe> <policy>"},
 
   {"event_eos", gstd_client_cmd_socket, "Send an end-of-stream event",
       "event_eos <pipe>"},
   {"event_seek", gstd_client_cmd_socket,
-        "Perform a seek in the given pipeline",
+        "Perform a seek in the given pipeline. Format, flags and types "
+        "accept their names as well, i.e.: time flush+trickmode-key-units set",
       "event_seek <pipe> <rate=1.0> <format=3> <flags=1> <start-type=1> <start=0> <end-type=1> <end=-1>"},
+  {"event_rate", gstd_client_cmd_socket,
+        "Change the playback rate without flushing the pipeline",
+      "event_rate <pipe> <rate> <flags=none>"},
+  {"event_force_key_unit", gstd_client_cmd_socket,
+        "Request a key unit from the encoders of the pipeline, or of an "
+        "element or element.pad",
+      "event_force_key_unit <pipe> <target=pipeline> <direction=upstream> <running-time=-1> <all-headers=true> <count=0>"},
   {"event_flush_start", gstd_client_cmd_socket,
         "Put the pipeline in flushing mode",
       "event_flush_start <pipe>"},
@@ -212,6 +334,9 @@ static GstdClientCmd cmds[] = {
   {"debug_reset", gstd_client_cmd_socket,
         "Enable/Disable debug threshold reset",
       "debug_reset <reset>"},
+  {"debug_tracers", gstd_client_cmd_socket,
+        "Enable GStreamer tracers, results are under each pipeline stats",
+      "debug_tracers <name(params);name(params)>"},
 
   {NULL}
 };
@@ -21,6 +21,7 @@
 #include "config.h"
 #endif
 
+#include <string.h>
 #include <glib/gprintf.h>
 
 #include "gstd_debug.h"
@@ -36,10 +37,15 @@ enum
   PROP_THRESHOLD,
   PROP_FLAGS,
   PROP_RESET,
+  PROP_TRACERS,
   N_PROPERTIES                  // NOT A PROPERTY
 };
 
 #define PROP_RESET_DEFAULT    TRUE
+#define PROP_TRACERS_DEFAULT  NULL
+
+/* The category GStreamer tracers log their records to */
+#define GSTD_DEBUG_TRACER_CATEGORY "GST_TRACER"
 
 struct _GstdDebug
 {
@@ -65,6 +71,17 @@ struct _GstdDebug
    */
   gboolean reset;
 
+  /*
+   * Tracers enabled at runtime, as in "latency(flags=pipeline+element)"
+   */
+  gchar *tracers;
+
+  /*
+   * Tracer instances. GStreamer offers no way to unregister their hooks
+   * so they are kept alive for the whole process
+   */
+  GList *tracer_objects;
+
   GParamFlags flags;
 };
 
@@ -80,6 +97,14 @@ static void
 gstd_debug_set_property (GObject *, guint, const GValue *, GParamSpec *);
 static void gstd_debug_get_property (GObject *, guint, GValue *, GParamSpec *);
 static void gstd_debug_dispose (GObject *);
+static void gstd_debug_add_tracers (GstdDebug *, const gchar *);
+static void gstd_debug_route_tracer_records (void);
+static void gstd_debug_log (GstDebugCategory *, GstDebugLevel,
+    const gchar *, const gchar *, gint, GObject *, GstDebugMessage *,
+    gpointer) G_GNUC_NO_INSTRUMENT;
+
+/* Whether gstd raised the tracer category to deliver the records */
+static gint tracer_records = FALSE;
 
 static gchar *
 debug_obtain_default_level (void)
@@ -132,6 +157,13 @@ gstd_debug_class_init (GstdDebugClass * klass)
       "Clear previously set debug thresholds ",
       PROP_RESET_DEFAULT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+  properties[PROP_TRACERS] =
+      g_param_spec_string ("tracers",
+      "Tracers",
+      "The tracers enabled at runtime, using the GST_TRACERS syntax. "
+      "Tracers are added to the active ones and can't be disabled",
+      PROP_TRACERS_DEFAULT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (object_class, N_PROPERTIES, properties);
 
   /* Initialize debug category with nice colors */
@@ -151,6 +183,8 @@ gstd_debug_init (GstdDebug * self)
   self->color = gst_debug_is_colored ();
   self->threshold = debug_obtain_default_level ();
   self->reset = PROP_RESET_DEFAULT;
+  self->tracers = g_strdup (PROP_TRACERS_DEFAULT);
+  self->tracer_objects = NULL;
 
   gstd_object_set_reader (GSTD_OBJECT (self),
       g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
@@ -187,6 +221,10 @@ gstd_debug_get_property (GObject * object,
       GST_WARNING_OBJECT (self, "Returning debug reset %d", self->reset);
       g_value_set_boolean (value, self->reset);
       break;
+    case PROP_TRACERS:
+      GST_DEBUG_OBJECT (self, "Returning tracers %s", self->tracers);
+      g_value_set_string (value, self->tracers);
+      break;
     default:
       /* We don't have any other property... */
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -208,6 +246,152 @@ gstd_debug_set_threshold (GstdDebug * self)
   gst_debug_set_threshold_from_string (self->threshold, FALSE);
 }
 
+static gboolean
+gstd_debug_add_tracer (GstdDebug * self, const gchar * name,
+    const gchar * params)
+{
+#if GST_CHECK_VERSION(1,14,0) && !defined(GST_DISABLE_GST_TRACER_HOOKS)
+  GstPluginFeature *feature;
+  GstTracer *tracer;
+  GType type;
+
+  feature = gst_registry_find_feature (gst_registry_get (), name,
+      GST_TYPE_TRACER_FACTORY);
+  if (!feature) {
+    GST_ERROR_OBJECT (self, "No such tracer \"%s\"", name);
+    return FALSE;
+  }
+
+  /* Make sure the tracer type is registered */
+  if (!gst_plugin_feature_load (feature)) {
+    GST_ERROR_OBJECT (self, "Unable to load tracer \"%s\"", name);
+    gst_object_unref (feature);
+    return FALSE;
+  }
+
+  type = gst_tracer_factory_get_tracer_type (GST_TRACER_FACTORY (feature));
+  gst_object_unref (feature);
+
+  /* Tracers register their hooks when constructed */
+  tracer = g_object_new (type, "params", params, NULL);
+  self->tracer_objects = g_list_append (self->tracer_objects, tracer);
+
+  GST_INFO_OBJECT (self, "Enabled tracer \"%s\" with params \"%s\"", name,
+      params ? params : "");
+  return TRUE;
+#else
+  GST_ERROR_OBJECT (self, "Runtime tracers are not supported by this "
+      "GStreamer version");
+  return FALSE;
+#endif
+}
+
+static void
+gstd_debug_add_tracers (GstdDebug * self, const gchar * tracers)
+{
+  gchar **specs;
+  gchar **spec;
+  gboolean added = FALSE;
+
+  if (!tracers) {
+    return;
+  }
+
+  /* Same syntax as GST_TRACERS: name(params);name(params) */
+  specs = g_strsplit (tracers, ";", -1);
+  for (spec = specs; *spec; spec++) {
+    gchar *name = g_strstrip (*spec);
+    gchar *params = NULL;
+    gchar *open;
+    gchar *tracer;
+
+    if ('\0' == name[0]) {
+      continue;
+    }
+
+    open = strchr (name, '(');
+    if (open) {
+      gchar *close = strrchr (open, ')');
+      if (close) {
+        *close = '\0';
+      }
+      *open = '\0';
+      params = open + 1;
+    }
+
+    /* Enabling twice would register the hooks twice */
+    tracer = self->tracers ? strstr (self->tracers, name) : NULL;
+    if (tracer && (tracer == self->tracers || ';' == *(tracer - 1))
+        && strchr ("(;", tracer[strlen (name)])) {
+      GST_INFO_OBJECT (self, "Tracer \"%s\" is already enabled", name);
+      continue;
+    }
+
+    if (gstd_debug_add_tracer (self, name, params)) {
+      gchar *acc = self->tracers;
+
+      self->tracers = g_strdup_printf ("%s%s%s(%s)", acc ? acc : "",
+          acc ? ";" : "", name, params ? params : "");
+      g_free (acc);
+      added = TRUE;
+    }
+  }
+  g_strfreev (specs);
+
+  /* Tracer records are only delivered through the debug log, keep
+     them out of the printed one before letting them through */
+  if (added) {
+    gstd_debug_route_tracer_records ();
+    gst_debug_set_threshold_for_name (GSTD_DEBUG_TRACER_CATEGORY,
+        GST_LEVEL_TRACE);
+  }
+}
+
+static void
+gstd_debug_route_tracer_records (void)
+{
+  static gsize routed = 0;
+
+  if (!g_once_init_enter (&routed)) {
+    return;
+  }
+
+  g_atomic_int_set (&tracer_records, TRUE);
+
+  /* A GST_DEBUG_FILE handler writes to a file of its own we can't
+     reopen, the records are left there as requested */
+  if (!g_getenv ("GST_DEBUG_FILE")
+      && gst_debug_remove_log_function (gst_debug_log_default)) {
+    gst_debug_add_log_function (gstd_debug_log, NULL, NULL);
+  }
+
+  g_once_init_leave (&routed, 1);
+}
+
+gboolean
+gstd_debug_is_tracer_record (GstDebugCategory * category,
+    GstDebugLevel level)
+{
+  return GST_LEVEL_TRACE == level && g_atomic_int_get (&tracer_records)
+      && !strcmp (gst_debug_category_get_name (category),
+      GSTD_DEBUG_TRACER_CATEGORY);
+}
+
+/* Stands in for the default handler, printing everything but the
+   tracer records */
+static void
+gstd_debug_log (GstDebugCategory * category, GstDebugLevel level,
+    const gchar * file, const gchar * function, gint line, GObject * object,
+    GstDebugMessage * message, gpointer user_data)
+{
+  if (gstd_debug_is_tracer_record (category, level)) {
+    return;
+  }
+
+  gst_debug_log_default (category, level, file, function, line, object,
+      message, user_data);
+}
+
 static void
 gstd_debug_set_property (GObject * object,
     guint property_id, const GValue * value, GParamSpec * pspec)
@@ -249,6 +433,9 @@ gstd_debug_set_property (GObject * object,
       self->reset = g_value_get_boolean (value);
       GST_DEBUG_OBJECT (self, "Changing debug reset to %d", self->reset);
       break;
+    case PROP_TRACERS:
+      gstd_debug_add_tracers (self, g_value_get_string (value));
+      break;
     default:
       /* We don't have any other property... */
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -267,6 +454,16 @@ gstd_debug_dispose (GObject * object)
     g_free (self->threshold);
     self->threshold = NULL;
   }
+
+  if (self->tracers) {
+    g_free (self->tracers);
+    self->tracers = NULL;
+  }
+
+  /* Tracer instances are intentionally leaked, their hooks are still
+     registered */
+  g_list_free (self->tracer_objects);
+  self->tracer_objects = NULL;
 }
 
 
@@ -50,5 +50,19 @@ GType gstd_debug_get_type (void);
  */
 GstdDebug *gstd_debug_new (void);
 
+/**
+ * gstd_debug_is_tracer_record:
+ * @category: The category of the log record
+ * @level: The level of the log record
+ *
+ * Tells log handlers apart the tracer records gstd asked for when
+ * enabling tracers at runtime. Those are consumed by the pipeline
+ * stats and are not meant to be printed.
+ *
+ * Returns: TRUE if the record should not be printed
+ */
+gboolean gstd_debug_is_tracer_record (GstDebugCategory * category,
+    GstDebugLevel level);
+
 
 #endif // __GSTD_DEBUG_H__
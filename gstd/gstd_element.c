@@ -42,6 +42,8 @@
 #include "gstd_list_reader.h"
 #include "gstd_signal.h"
 #include "gstd_signal_list.h"
+#include "gstd_pad.h"
+#include "gstd_snapshot.h"
 
 enum
 {
@@ -49,6 +51,9 @@ enum
   PROP_EVENT,
   PROP_PROPERTIES,
   PROP_SIGNALS,
+  PROP_PADS,
+  PROP_ELEMENTS,
+  PROP_SNAPSHOT,
   N_PROPERTIES                  // NOT A PROPERTY
 };
 
@@ -87,6 +92,26 @@ struct _GstdElement
    * The signals held by the element
    */
   GstdList *element_signals;
+
+  /*
+   * The pads held by the element
+   */
+  GstdList *element_pads;
+
+  /*
+   * The children of the element, if it is a bin
+   */
+  GstdList *element_children;
+
+  /*
+   * Encodes the last sample of the element on request
+   */
+  GstdSnapshot *snapshot;
+
+  /*
+   * Whether new source pads get their buffer flow measured
+   */
+  gboolean pad_stats;
 };
 
 struct _GstdElementClass
@@ -111,6 +136,13 @@ void gstd_element_signals_to_string (GstdElement * self,
     GstdIFormatter * formatter);
 static GstdReturnCode gstd_element_fill_properties (GstdElement * self);
 static GstdReturnCode gstd_element_fill_signals (GstdElement * self);
+static GstdReturnCode gstd_element_fill_pads (GstdElement * self);
+static void gstd_element_pad_added (GstElement *, GstPad *, GstdElement *);
+static void gstd_element_pad_removed (GstElement *, GstPad *, GstdElement *);
+static GstdReturnCode gstd_element_fill_children (GstdElement * self);
+static void gstd_element_child_added (GstBin *, GstElement *, GstdElement *);
+static void gstd_element_child_removed (GstBin *, GstElement *,
+    GstdElement *);
 static GType gstd_element_property_get_type (GType g_type);
 static void
 gstd_element_class_init (GstdElementClass * klass)
@@ -151,6 +183,27 @@ gstd_element_class_init (GstdElementClass * klass)
       GSTD_TYPE_LIST,
       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
 
+  properties[PROP_PADS] =
+      g_param_spec_object ("pads",
+      "Pads",
+      "The pads of the element",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_ELEMENTS] =
+      g_param_spec_object ("elements",
+      "Elements",
+      "The elements inside the element, if it is a bin",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_SNAPSHOT] =
+      g_param_spec_object ("snapshot",
+      "Snapshot",
+      "Still images of the last sample of the element",
+      GSTD_TYPE_SNAPSHOT,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
   g_object_class_install_properties (object_class, N_PROPERTIES, properties);
 
   gstd_object_class->to_string = gstd_element_to_string;
@@ -168,6 +221,7 @@ gstd_element_init (GstdElement * self)
   GST_INFO_OBJECT (self, "Initializing element");
   self->element = GSTD_ELEMENT_DEFAULT_GSTELEMENT;
   self->event_handler = NULL;
+  self->snapshot = NULL;
 
   gstd_object_set_reader (GSTD_OBJECT (self),
       g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
@@ -183,9 +237,25 @@ gstd_element_init (GstdElement * self)
   gstd_object_set_reader (GSTD_OBJECT (self->element_properties),
       g_object_new (GSTD_TYPE_LIST_READER, NULL));
 
+  self->element_pads =
+      GSTD_LIST (g_object_new (GSTD_TYPE_LIST, "name", "element_pads",
+          "node-type", GSTD_TYPE_PAD, "flags", GSTD_PARAM_READ, NULL));
+
+  self->element_children =
+      GSTD_LIST (g_object_new (GSTD_TYPE_LIST, "name", "elements",
+          "node-type", GSTD_TYPE_ELEMENT, "flags", GSTD_PARAM_READ, NULL));
+
+  self->pad_stats = FALSE;
+
   gstd_object_set_reader (GSTD_OBJECT (self->element_signals),
       g_object_new (GSTD_TYPE_LIST_READER, NULL));
 
+  gstd_object_set_reader (GSTD_OBJECT (self->element_pads),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+
+  gstd_object_set_reader (GSTD_OBJECT (self->element_children),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+
 }
 
 static void
@@ -196,6 +266,7 @@ gstd_element_dispose (GObject * object)
   GST_INFO_OBJECT (self, "Disposing %s element", GSTD_OBJECT_NAME (self));
 
   if (self->element) {
+    g_signal_handlers_disconnect_by_data (self->element, self);
     g_object_unref (self->element);
     self->element = NULL;
   }
@@ -205,8 +276,15 @@ gstd_element_dispose (GObject * object)
     self->event_handler = NULL;
   }
 
+  if (self->snapshot) {
+    g_object_unref (self->snapshot);
+    self->snapshot = NULL;
+  }
+
   g_object_unref (self->element_properties);
   g_object_unref (self->element_signals);
+  g_object_unref (self->element_pads);
+  g_object_unref (self->element_children);
 
   G_OBJECT_CLASS (gstd_element_parent_class)->dispose (object);
 }
@@ -237,6 +315,19 @@ gstd_element_get_property (GObject * object,
       GST_DEBUG_OBJECT (self, "Returning signals %p", self->element_signals);
       g_value_set_object (value, self->element_signals);
       break;
+    case PROP_PADS:
+      GST_DEBUG_OBJECT (self, "Returning pads %p", self->element_pads);
+      g_value_set_object (value, self->element_pads);
+      break;
+    case PROP_ELEMENTS:
+      GST_DEBUG_OBJECT (self, "Returning elements %p",
+          self->element_children);
+      g_value_set_object (value, self->element_children);
+      break;
+    case PROP_SNAPSHOT:
+      GST_DEBUG_OBJECT (self, "Returning snapshot %p", self->snapshot);
+      g_value_set_object (value, self->snapshot);
+      break;
     default:
       /* We don't have any other property... */
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -258,12 +349,18 @@ gstd_element_set_property (GObject * object,
       }
       self->event_handler = g_object_new (GSTD_TYPE_EVENT_HANDLER, "receiver",
           G_OBJECT (self->element), NULL);
+      if (self->snapshot) {
+        g_object_unref (self->snapshot);
+      }
+      self->snapshot = gstd_snapshot_new (self->element);
 
       GST_DEBUG_OBJECT (self, "Setting element %p (%s)", self->element,
           GST_OBJECT_NAME (self->element));
 
       gstd_element_fill_properties (self);
       gstd_element_fill_signals (self);
+      gstd_element_fill_pads (self);
+      gstd_element_fill_children (self);
       break;
     default:
       /* We don't have any other property... */
@@ -576,6 +673,179 @@ gstd_element_fill_signals (GstdElement * self)
   return GSTD_EOK;
 }
 
+static void
+gstd_element_append_pad (GstdElement * self, GstPad * pad)
+{
+  GstdPad *element_pad;
+
+  element_pad = g_object_new (GSTD_TYPE_PAD, "name", GST_PAD_NAME (pad),
+      "gstpad", pad, NULL);
+
+  if (!gstd_list_append_child (self->element_pads,
+          GSTD_OBJECT (element_pad))) {
+    g_object_unref (element_pad);
+    return;
+  }
+
+  if (g_atomic_int_get (&self->pad_stats)
+      && GST_PAD_SRC == gst_pad_get_direction (pad)) {
+    gstd_pad_set_stats_enabled (element_pad, TRUE);
+  }
+}
+
+static GstdReturnCode
+gstd_element_fill_pads (GstdElement * self)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  gboolean done;
+
+  g_return_val_if_fail (GSTD_IS_ELEMENT (self), GSTD_NULL_ARGUMENT);
+
+  GST_DEBUG_OBJECT (self, "Gathering \"%s\" pads", GST_OBJECT_NAME (self));
+
+  /* Connect first so that no pad is missed, duplicates are rejected by
+     the list */
+  g_signal_connect (self->element, "pad-added",
+      G_CALLBACK (gstd_element_pad_added), self);
+  g_signal_connect (self->element, "pad-removed",
+      G_CALLBACK (gstd_element_pad_removed), self);
+
+  it = gst_element_iterate_pads (self->element);
+
+  done = FALSE;
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:
+        gstd_element_append_pad (self, g_value_get_object (&item));
+        g_value_reset (&item);
+        break;
+      case GST_ITERATOR_RESYNC:
+        gst_iterator_resync (it);
+        break;
+      case GST_ITERATOR_ERROR:
+        GST_ERROR_OBJECT (self, "Unknown pad iterator error");
+        done = TRUE;
+        break;
+      case GST_ITERATOR_DONE:
+        done = TRUE;
+        break;
+    }
+  }
+  g_value_unset (&item);
+  gst_iterator_free (it);
+
+  return GSTD_EOK;
+}
+
+static void
+gstd_element_pad_added (GstElement * element, GstPad * pad,
+    GstdElement * self)
+{
+  GST_DEBUG_OBJECT (self, "Pad %s:%s added", GST_DEBUG_PAD_NAME (pad));
+  gstd_element_append_pad (self, pad);
+}
+
+static void
+gstd_element_pad_removed (GstElement * element, GstPad * pad,
+    GstdElement * self)
+{
+  GST_DEBUG_OBJECT (self, "Pad %s:%s removed", GST_DEBUG_PAD_NAME (pad));
+  gstd_list_remove_child (self->element_pads, GST_PAD_NAME (pad));
+}
+
+static GstdReturnCode
+gstd_element_fill_children (GstdElement * self)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  gboolean done;
+
+  g_return_val_if_fail (GSTD_IS_ELEMENT (self), GSTD_NULL_ARGUMENT);
+
+  if (!GST_IS_BIN (self->element))
+    return GSTD_EOK;
+
+  GST_DEBUG_OBJECT (self, "Gathering \"%s\" children",
+      GST_OBJECT_NAME (self->element));
+
+  /* Same as with pads, connect first so that no child is missed. Each
+     child bin registers its own children, so the whole hierarchy is
+     followed without resorting to deep-element-added */
+  g_signal_connect (self->element, "element-added",
+      G_CALLBACK (gstd_element_child_added), self);
+  g_signal_connect (self->element, "element-removed",
+      G_CALLBACK (gstd_element_child_removed), self);
+
+  it = gst_bin_iterate_elements (GST_BIN (self->element));
+
+  done = FALSE;
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:
+        gstd_element_child_added (GST_BIN (self->element),
+            g_value_get_object (&item), self);
+        g_value_reset (&item);
+        break;
+      case GST_ITERATOR_RESYNC:
+        gst_iterator_resync (it);
+        break;
+      case GST_ITERATOR_ERROR:
+        GST_ERROR_OBJECT (self, "Unknown element iterator error");
+        done = TRUE;
+        break;
+      case GST_ITERATOR_DONE:
+        done = TRUE;
+        break;
+    }
+  }
+  g_value_unset (&item);
+  gst_iterator_free (it);
+
+  return GSTD_EOK;
+}
+
+static void
+gstd_element_child_added (GstBin * bin, GstElement * element,
+    GstdElement * self)
+{
+  GstdElement *child;
+  GstdObject *existing;
+
+  GST_DEBUG_OBJECT (self, "Element %s added to %s", GST_OBJECT_NAME (element),
+      GST_OBJECT_NAME (bin));
+
+  /* Don't build a whole subtree only to have the list reject it */
+  existing = gstd_list_find_child (self->element_children,
+      GST_OBJECT_NAME (element));
+  if (existing) {
+    g_object_unref (existing);
+    return;
+  }
+
+  child = g_object_new (GSTD_TYPE_ELEMENT, "name", GST_OBJECT_NAME (element),
+      "gstelement", element, NULL);
+
+  if (!gstd_list_append_child (self->element_children, GSTD_OBJECT (child))) {
+    g_object_unref (child);
+    return;
+  }
+
+  /* Children inherit the pad stats of their bin */
+  if (g_atomic_int_get (&self->pad_stats)) {
+    gstd_element_set_pad_stats (child, TRUE);
+  }
+}
+
+static void
+gstd_element_child_removed (GstBin * bin, GstElement * element,
+    GstdElement * self)
+{
+  GST_DEBUG_OBJECT (self, "Element %s removed from %s",
+      GST_OBJECT_NAME (element), GST_OBJECT_NAME (bin));
+  gstd_list_remove_child (self->element_children, GST_OBJECT_NAME (element));
+}
+
 static GType
 gstd_element_property_get_type (GType g_type)
 {
@@ -620,3 +890,42 @@ gstd_element_property_get_type (GType g_type)
     }
   }
 }
+
+void
+gstd_element_set_pad_stats (GstdElement * self, gboolean enabled)
+{
+  GList *children;
+  GList *child;
+  GList *pads;
+  GList *pad;
+
+  g_return_if_fail (GSTD_IS_ELEMENT (self));
+
+  g_atomic_int_set (&self->pad_stats, enabled);
+
+  GST_OBJECT_LOCK (self->element_pads);
+  pads = g_list_copy_deep (self->element_pads->list, (GCopyFunc) g_object_ref,
+      NULL);
+  GST_OBJECT_UNLOCK (self->element_pads);
+
+  for (pad = pads; pad; pad = pad->next) {
+    GstdPad *element_pad = GSTD_PAD (pad->data);
+
+    /* Disabling reaches every pad, including the ones enabled one by one */
+    if (!enabled || GST_PAD_SRC == gstd_pad_get_direction (element_pad)) {
+      gstd_pad_set_stats_enabled (element_pad, enabled);
+    }
+  }
+  g_list_free_full (pads, g_object_unref);
+
+  /* Elements nested in bins have pads of their own */
+  GST_OBJECT_LOCK (self->element_children);
+  children = g_list_copy_deep (self->element_children->list,
+      (GCopyFunc) g_object_ref, NULL);
+  GST_OBJECT_UNLOCK (self->element_children);
+
+  for (child = children; child; child = child->next) {
+    gstd_element_set_pad_stats (GSTD_ELEMENT (child->data), enabled);
+  }
+  g_list_free_full (children, g_object_unref);
+}
@@ -42,5 +42,16 @@ typedef struct _GstdElement GstdElement;
 typedef struct _GstdElementClass GstdElementClass;
 GType gstd_element_get_type (void);
 
+/**
+ * gstd_element_set_pad_stats:
+ * @object: The element to instrument
+ * @enabled: Whether to measure the buffer flow of the source pads
+ *
+ * Enables or disables the buffer flow counters on every source pad
+ * of the element and of the elements nested in it, including the ones
+ * added afterwards. Disabling reaches every pad.
+ */
+void gstd_element_set_pad_stats (GstdElement * object, gboolean enabled);
+
 G_END_DECLS
 #endif // __GSTD_ELEMENT_H__
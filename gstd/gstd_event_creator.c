@@ -111,17 +111,32 @@ gstd_event_creator_send_event (GstdEventCreator * self,
     const gchar * event_type, const gchar * description)
 {
   GstEvent *event;
+  GstPad *pad;
+  gboolean sent;
 
   GST_INFO_OBJECT (self, "Event Creator sending event %s", event_type);
 
   event = gstd_event_factory_make (event_type, description);
-  if (event) {
-    if (gst_element_send_event (GST_ELEMENT (self->receiver), event))
-      return GSTD_EOK;
-    else
-      return GSTD_EVENT_ERROR;
+  if (!event) {
+    return GSTD_BAD_VALUE;
   }
-  return GSTD_BAD_VALUE;
+
+  if (GST_IS_PAD (self->receiver)) {
+    pad = GST_PAD (self->receiver);
+
+    /* Events travelling against the pad direction are handled by the
+       pad itself, the rest are pushed to its peer */
+    if ((GST_PAD_IS_SRC (pad) && GST_EVENT_IS_UPSTREAM (event)) ||
+        (GST_PAD_IS_SINK (pad) && GST_EVENT_IS_DOWNSTREAM (event))) {
+      sent = gst_pad_send_event (pad, event);
+    } else {
+      sent = gst_pad_push_event (pad, event);
+    }
+  } else {
+    sent = gst_element_send_event (GST_ELEMENT (self->receiver), event);
+  }
+
+  return sent ? GSTD_EOK : GSTD_EVENT_ERROR;
 }
 
 static void
@@ -35,6 +35,15 @@
 #define GSTD_EVENT_FACTORY_SEEK_STOP_TYPE_DEFAULT GST_SEEK_TYPE_SET
 #define GSTD_EVENT_FACTORY_SEEK_STOP_DEFAULT GST_CLOCK_TIME_NONE
 #define GSTD_EVENT_FACTORY_FLUSH_STOP_RESET_DEFAULT TRUE
+#define GSTD_EVENT_FACTORY_RATE_FLAGS_DEFAULT GST_SEEK_FLAG_NONE
+#define GSTD_EVENT_FACTORY_FORCE_KEY_UNIT_UPSTREAM_DEFAULT TRUE
+#define GSTD_EVENT_FACTORY_FORCE_KEY_UNIT_RUNNING_TIME_DEFAULT -1
+#define GSTD_EVENT_FACTORY_FORCE_KEY_UNIT_ALL_HEADERS_DEFAULT TRUE
+#define GSTD_EVENT_FACTORY_FORCE_KEY_UNIT_COUNT_DEFAULT 0
+
+/* Same structure gst_video_event_new_*_force_key_unit() create, built
+   by hand to avoid depending on gstreamer-video */
+#define GSTD_EVENT_FACTORY_FORCE_KEY_UNIT_NAME "GstForceKeyUnit"
 
 typedef enum _GstdEventType GstdEventType;
 
@@ -71,15 +80,22 @@ enum _GstdEventType
 
   GSTD_EVENT_SEEK = 14,
 
-  GSTD_EVENT_NAVIGATION = 15
+  GSTD_EVENT_NAVIGATION = 15,
+
+  GSTD_EVENT_RATE = 16,
+
+  GSTD_EVENT_FORCE_KEY_UNIT = 17
 };
 
 static gboolean gstd_ascii_to_gint64 (const gchar *, gint64 *);
 static gboolean gstd_ascii_to_double (const gchar *, gdouble *);
 static gboolean gstd_ascii_to_boolean (const gchar *, gboolean *);
+static gboolean gstd_ascii_to_enum (const gchar *, GType, gint64 *);
 GstdEventType gstd_event_factory_parse_event (const gchar *);
 static GstEvent *gstd_event_factory_make_seek_event (const gchar *);
 static GstEvent *gstd_event_factory_make_flush_stop_event (const gchar *);
+static GstEvent *gstd_event_factory_make_rate_event (const gchar *);
+static GstEvent *gstd_event_factory_make_force_key_unit_event (const gchar *);
 
 GstEvent *
 gstd_event_factory_make (const gchar * name, const gchar * description)
@@ -105,6 +121,12 @@ gstd_event_factory_make (const gchar * name, const gchar * description)
     case GSTD_EVENT_FLUSH_STOP:
       event = gstd_event_factory_make_flush_stop_event (description);
       break;
+    case GSTD_EVENT_RATE:
+      event = gstd_event_factory_make_rate_event (description);
+      break;
+    case GSTD_EVENT_FORCE_KEY_UNIT:
+      event = gstd_event_factory_make_force_key_unit_event (description);
+      break;
     default:
       event = NULL;
       break;
@@ -158,7 +180,57 @@ gstd_ascii_to_boolean (const gchar * full_string, gboolean * out_value)
   return ret;
 }
 
+/* Accepts either the numeric value or the nicks of an enum or flags
+   type, i.e.: time, or flush+trickmode-key-units */
+static gboolean
+gstd_ascii_to_enum (const gchar * full_string, GType type, gint64 * out_value)
+{
+  GEnumClass *enum_class;
+  GFlagsClass *flags_class;
+  GEnumValue *enum_value;
+  GFlagsValue *flags_value;
+  gchar **nicks;
+  gchar **nick;
+  gboolean ret;
+
+  g_return_val_if_fail (full_string, FALSE);
+  g_return_val_if_fail (out_value, FALSE);
+
+  if (g_ascii_isdigit (full_string[0]) || '-' == full_string[0]) {
+    return gstd_ascii_to_gint64 (full_string, out_value);
+  }
+
+  ret = TRUE;
+  *out_value = 0;
+
+  if (G_TYPE_IS_ENUM (type)) {
+    enum_class = g_type_class_ref (type);
+    enum_value = g_enum_get_value_by_nick (enum_class, full_string);
+    if (enum_value) {
+      *out_value = enum_value->value;
+    } else {
+      ret = FALSE;
+    }
+    g_type_class_unref (enum_class);
+  } else if (G_TYPE_IS_FLAGS (type)) {
+    flags_class = g_type_class_ref (type);
+    nicks = g_strsplit_set (full_string, "+|", -1);
+    for (nick = nicks; *nick && ret; nick++) {
+      flags_value = g_flags_get_value_by_nick (flags_class, *nick);
+      if (flags_value) {
+        *out_value |= flags_value->value;
+      } else {
+        ret = FALSE;
+      }
+    }
+    g_strfreev (nicks);
+    g_type_class_unref (flags_class);
+  } else {
+    ret = FALSE;
+  }
 
+  return ret;
+}
 
 static GstEvent *
 gstd_event_factory_make_seek_event (const gchar * description)
@@ -193,7 +265,7 @@ gstd_event_factory_make_seek_event (const gchar * description)
     goto fallback;
   }
 
-  if (!gstd_ascii_to_gint64 (tokens[1], &temp_format)) {
+  if (!gstd_ascii_to_enum (tokens[1], GST_TYPE_FORMAT, &temp_format)) {
     goto out;
   }
   format = (GstFormat) temp_format;
@@ -202,7 +274,7 @@ gstd_event_factory_make_seek_event (const gchar * description)
     goto fallback;
   }
 
-  if (!gstd_ascii_to_gint64 (tokens[2], &temp_flags)) {
+  if (!gstd_ascii_to_enum (tokens[2], GST_TYPE_SEEK_FLAGS, &temp_flags)) {
     goto out;
   }
   flags = (GstSeekFlags) temp_flags;
@@ -211,7 +283,8 @@ gstd_event_factory_make_seek_event (const gchar * description)
     goto fallback;
   }
 
-  if (!gstd_ascii_to_gint64 (tokens[3], &temp_start_type)) {
+  if (!gstd_ascii_to_enum (tokens[3], GST_TYPE_SEEK_TYPE,
+          &temp_start_type)) {
     goto out;
   }
   start_type = (GstSeekType) temp_start_type;
@@ -228,7 +301,7 @@ gstd_event_factory_make_seek_event (const gchar * description)
     goto fallback;
   }
 
-  if (!gstd_ascii_to_gint64 (tokens[5], &temp_stop_type)) {
+  if (!gstd_ascii_to_enum (tokens[5], GST_TYPE_SEEK_TYPE, &temp_stop_type)) {
     goto out;
   }
   stop_type = (GstSeekType) temp_stop_type;
@@ -268,6 +341,128 @@ gstd_event_factory_make_flush_stop_event (const gchar * description)
   return gst_event_new_flush_stop (reset_time);
 }
 
+static GstEvent *
+gstd_event_factory_make_rate_event (const gchar * description)
+{
+  GstSeekFlags flags = GSTD_EVENT_FACTORY_RATE_FLAGS_DEFAULT;
+  GstEvent *event = NULL;
+  gchar **tokens = NULL;
+  gint64 temp_flags;
+  gdouble rate;
+
+  if (NULL == description) {
+    return NULL;
+  }
+
+  tokens = g_strsplit (description, " ", 2);
+
+  if (NULL == tokens[0] || !gstd_ascii_to_double (tokens[0], &rate)) {
+    goto out;
+  }
+
+  if (NULL != tokens[1]) {
+    if (!gstd_ascii_to_enum (tokens[1], GST_TYPE_SEEK_FLAGS, &temp_flags)) {
+      goto out;
+    }
+    flags = (GstSeekFlags) temp_flags;
+  }
+
+  /* Positions are left untouched so only the rate changes. Without
+     instant rate changes, the new rate applies after the queued data */
+#if GST_CHECK_VERSION(1,18,0)
+  flags |= GST_SEEK_FLAG_INSTANT_RATE_CHANGE;
+#endif
+  flags &= ~GST_SEEK_FLAG_FLUSH;
+
+  event = gst_event_new_seek (rate, GST_FORMAT_TIME, flags, GST_SEEK_TYPE_NONE,
+      GST_CLOCK_TIME_NONE, GST_SEEK_TYPE_NONE, GST_CLOCK_TIME_NONE);
+
+out:
+  {
+    g_strfreev (tokens);
+    return event;
+  }
+}
+
+static GstEvent *
+gstd_event_factory_make_force_key_unit_event (const gchar * description)
+{
+  gboolean upstream = GSTD_EVENT_FACTORY_FORCE_KEY_UNIT_UPSTREAM_DEFAULT;
+  gint64 running_time = GSTD_EVENT_FACTORY_FORCE_KEY_UNIT_RUNNING_TIME_DEFAULT;
+  gboolean all_headers = GSTD_EVENT_FACTORY_FORCE_KEY_UNIT_ALL_HEADERS_DEFAULT;
+  gint64 count = GSTD_EVENT_FACTORY_FORCE_KEY_UNIT_COUNT_DEFAULT;
+  GstStructure *structure;
+  GstEvent *event = NULL;
+  gchar **tokens = NULL;
+
+  if (NULL != description) {
+    tokens = g_strsplit (description, " ", 4);
+  }
+
+  if (NULL == tokens || NULL == tokens[0]) {
+    goto fallback;
+  }
+
+  if (!g_ascii_strcasecmp (tokens[0], "upstream")) {
+    upstream = TRUE;
+  } else if (!g_ascii_strcasecmp (tokens[0], "downstream")) {
+    upstream = FALSE;
+  } else {
+    goto out;
+  }
+
+  if (NULL == tokens[1]) {
+    goto fallback;
+  }
+
+  if (!gstd_ascii_to_gint64 (tokens[1], &running_time)) {
+    goto out;
+  }
+
+  if (NULL == tokens[2]) {
+    goto fallback;
+  }
+
+  if (!gstd_ascii_to_boolean (tokens[2], &all_headers)) {
+    goto out;
+  }
+
+  if (NULL == tokens[3]) {
+    goto fallback;
+  }
+
+  if (!gstd_ascii_to_gint64 (tokens[3], &count) || count < 0) {
+    goto out;
+  }
+
+fallback:
+  {
+    /* Negative running times mean as soon as possible */
+    if (running_time < 0) {
+      running_time = GST_CLOCK_TIME_NONE;
+    }
+
+    structure = gst_structure_new (GSTD_EVENT_FACTORY_FORCE_KEY_UNIT_NAME,
+        "running-time", GST_TYPE_CLOCK_TIME, (GstClockTime) running_time,
+        "all-headers", G_TYPE_BOOLEAN, all_headers,
+        "count", G_TYPE_UINT, (guint) count, NULL);
+
+    if (upstream) {
+      event = gst_event_new_custom (GST_EVENT_CUSTOM_UPSTREAM, structure);
+    } else {
+      gst_structure_set (structure,
+          "timestamp", GST_TYPE_CLOCK_TIME, GST_CLOCK_TIME_NONE,
+          "stream-time", GST_TYPE_CLOCK_TIME, GST_CLOCK_TIME_NONE, NULL);
+      event = gst_event_new_custom (GST_EVENT_CUSTOM_DOWNSTREAM, structure);
+    }
+  }
+out:
+  {
+    g_strfreev (tokens);
+    return event;
+  }
+}
+
 GstdEventType
 gstd_event_factory_parse_event (const gchar * name)
 {
@@ -284,6 +479,11 @@ gstd_event_factory_parse_event (const gchar * name)
     ret = GSTD_EVENT_FLUSH_START;
   } else if (!strcmp (name, "flush-stop") || !strcmp (name, "flush_stop")) {
     ret = GSTD_EVENT_FLUSH_STOP;
+  } else if (!strcmp (name, "rate")) {
+    ret = GSTD_EVENT_RATE;
+  } else if (!strcmp (name, "force-key-unit")
+      || !strcmp (name, "force_key_unit")) {
+    ret = GSTD_EVENT_FORCE_KEY_UNIT;
   }
   return ret;
 }
@@ -72,7 +72,8 @@ static gboolean gstd_http_init_get_option_group (GstdIpc * base,
     GOptionGroup ** group);
 static SoupStatus get_status_code (GstdReturnCode ret);
 static GstdReturnCode do_get (SoupServer * server, SoupMessage * msg,
-    char **output, const char *path, GstdSession * session);
+    char **output, const char *path, GHashTable * query,
+    GstdSession * session);
 static GstdReturnCode do_post (SoupServer * server, SoupMessage * msg,
     char *name, char *description, char **output, const char *path,
     GstdSession * session);
@@ -159,11 +160,46 @@ get_status_code (GstdReturnCode ret)
   return status;
 }
 
+gboolean
+gstd_http_query_is_node (const gchar * path)
+{
+  gchar **tokens;
+  guint len;
+  guint i;
+  gboolean is_node;
+
+  g_return_val_if_fail (path, FALSE);
+
+  /* Tokens have the form {"", "pipelines", <p>, ...} */
+  tokens = g_strsplit (path, "/", -1);
+  len = g_strv_length (tokens);
+
+  /* Names may not be empty, as in /pipelines//telemetry/s0 */
+  is_node = len >= 5 && !g_strcmp0 (tokens[0], "")
+      && !g_strcmp0 (tokens[1], "pipelines");
+  for (i = 2; is_node && i < len; i++) {
+    is_node = '\0' != tokens[i][0];
+  }
+
+  /* /pipelines/<p>/elements/<e>/snapshot or /pipelines/<p>/telemetry/<s> */
+  is_node = is_node && ((6 == len && !g_strcmp0 (tokens[3], "elements")
+          && !g_strcmp0 (tokens[5], "snapshot"))
+      || (5 == len && !g_strcmp0 (tokens[3], "telemetry")));
+
+  g_strfreev (tokens);
+
+  return is_node;
+}
+
 static GstdReturnCode
 do_get (SoupServer * server, SoupMessage * msg, char **output, const char *path,
-    GstdSession * session)
+    GHashTable * query, GstdSession * session)
 {
   gchar *message = NULL;
+  GString *node = NULL;
+  GHashTableIter iter;
+  gpointer key = NULL;
+  gpointer value = NULL;
   GstdReturnCode ret = GSTD_EOK;
 
   g_return_val_if_fail (server, GSTD_NULL_ARGUMENT);
@@ -172,7 +208,31 @@ do_get (SoupServer * server, SoupMessage * msg, char **output, const char *path,
   g_return_val_if_fail (output, GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (path, GSTD_NULL_ARGUMENT);
 
-  message = g_strdup_printf ("read %s", path);
+  /* Nodes such as snapshots take their parameters from the query,
+     which is read as a trailing node: ?a=1&b=2 -> /a=1,b=2. Other
+     resources ignore the query, cache busters for instance. */
+  if (query && g_hash_table_size (query) > 0
+      && gstd_http_query_is_node (path)) {
+    node = g_string_new (NULL);
+    g_hash_table_iter_init (&iter, query);
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+      /* Separators would let a parameter spill into another one, or
+         into another node or command argument */
+      if (strpbrk (key, ",/= ") || strpbrk (value, ",/ ")) {
+        GST_ERROR_OBJECT (session, "Invalid query param \"%s\"",
+            (gchar *) key);
+        g_string_free (node, TRUE);
+        return GSTD_BAD_VALUE;
+      }
+      g_string_append_printf (node, "%s%s=%s", node->len ? "," : "",
+          (gchar *) key, (gchar *) value);
+    }
+    message = g_strdup_printf ("read %s/%s", path, node->str);
+    g_string_free (node, TRUE);
+  } else {
+    message = g_strdup_printf ("read %s", path);
+  }
+
   ret = gstd_parser_parse_cmd (session, message, output);
   g_free (message);
   message = NULL;
@@ -309,7 +369,7 @@ do_request (gpointer data_request, gpointer eval)
   }
 
   if (msg->method == SOUP_METHOD_GET) {
-    ret = do_get (server, msg, &output, path, session);
+    ret = do_get (server, msg, &output, path, query, session);
   } else if (msg->method == SOUP_METHOD_POST) {
     ret = do_post (server, msg, name, description_pipe, &output, path, session);
   } else if (msg->method == SOUP_METHOD_PUT) {
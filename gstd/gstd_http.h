@@ -42,6 +42,18 @@ typedef struct _GstdHttp GstdHttp;
 typedef struct _GstdHttpClass GstdHttpClass;
 GType gstd_http_get_type (void);
 
+/**
+ * gstd_http_query_is_node:
+ * @path: The path of a GET request
+ *
+ * Tells whether the query of a GET on @path is read as a trailing
+ * parameter node. Only /pipelines/<p>/elements/<e>/snapshot and
+ * /pipelines/<p>/telemetry/<s> take one, other resources ignore the
+ * query.
+ *
+ * Returns: TRUE if the query is a parameter node of @path
+ */
+gboolean gstd_http_query_is_node (const gchar * path);
 
 G_END_DECLS
 #endif //__GSTD_HTTP_H__
@@ -0,0 +1,303 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_latency_stats.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Latency Stats debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_latency_stats_debug);
+#define GST_CAT_DEFAULT gstd_latency_stats_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+enum
+{
+  PROP_WINDOW = 1,
+  PROP_SAMPLES,
+  PROP_MIN,
+  PROP_MEAN,
+  PROP_P50,
+  PROP_P90,
+  PROP_P99,
+  PROP_MAX,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/**
+ * GstdLatencyStats:
+ * Percentiles over the most recent latency samples
+ */
+struct _GstdLatencyStats
+{
+  GstdObject parent;
+
+  /**
+   * Ring of the most recent samples
+   */
+  guint64 *window;
+  guint size;
+  guint next;
+
+  /**
+   * The amount of samples ever added
+   */
+  guint64 samples;
+};
+
+struct _GstdLatencyStatsClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdLatencyStats, gstd_latency_stats, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_latency_stats_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void
+gstd_latency_stats_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_latency_stats_finalize (GObject *);
+static gint gstd_latency_stats_compare (gconstpointer, gconstpointer);
+
+static void
+gstd_latency_stats_class_init (GstdLatencyStatsClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_latency_stats_set_property;
+  object_class->get_property = gstd_latency_stats_get_property;
+  object_class->finalize = gstd_latency_stats_finalize;
+
+  properties[PROP_WINDOW] =
+      g_param_spec_uint ("window",
+      "Window",
+      "The amount of recent samples the statistics are computed over",
+      1, G_MAXUINT16, GSTD_LATENCY_STATS_DEFAULT_WINDOW,
+      G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+      GSTD_PARAM_READ);
+
+  properties[PROP_SAMPLES] =
+      g_param_spec_uint64 ("samples",
+      "Samples",
+      "The amount of samples measured so far",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_MIN] =
+      g_param_spec_uint64 ("min",
+      "Min",
+      "The minimum latency in the window, in nanoseconds",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_MEAN] =
+      g_param_spec_uint64 ("mean",
+      "Mean",
+      "The mean latency in the window, in nanoseconds",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_P50] =
+      g_param_spec_uint64 ("p50",
+      "P50",
+      "The median latency in the window, in nanoseconds",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_P90] =
+      g_param_spec_uint64 ("p90",
+      "P90",
+      "The 90th percentile latency in the window, in nanoseconds",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_P99] =
+      g_param_spec_uint64 ("p99",
+      "P99",
+      "The 99th percentile latency in the window, in nanoseconds",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_MAX] =
+      g_param_spec_uint64 ("max",
+      "Max",
+      "The maximum latency in the window, in nanoseconds",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_latency_stats_debug, "gstdlatencystats",
+      debug_color, "Gstd Latency Stats category");
+}
+
+static void
+gstd_latency_stats_init (GstdLatencyStats * self)
+{
+  self->size = GSTD_LATENCY_STATS_DEFAULT_WINDOW;
+  self->window = NULL;
+  self->next = 0;
+  self->samples = 0;
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_latency_stats_finalize (GObject * object)
+{
+  GstdLatencyStats *self = GSTD_LATENCY_STATS (object);
+
+  g_free (self->window);
+  self->window = NULL;
+
+  G_OBJECT_CLASS (gstd_latency_stats_parent_class)->finalize (object);
+}
+
+static gint
+gstd_latency_stats_compare (gconstpointer a, gconstpointer b)
+{
+  guint64 first = *(const guint64 *) a;
+  guint64 second = *(const guint64 *) b;
+
+  return (first > second) - (first < second);
+}
+
+static void
+gstd_latency_stats_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdLatencyStats *self = GSTD_LATENCY_STATS (object);
+  guint64 *sorted;
+  guint64 total = 0;
+  guint count;
+  guint i;
+
+  if (PROP_WINDOW == property_id) {
+    g_value_set_uint (value, self->size);
+    return;
+  }
+
+  if (PROP_SAMPLES == property_id) {
+    GST_OBJECT_LOCK (self);
+    g_value_set_uint64 (value, self->samples);
+    GST_OBJECT_UNLOCK (self);
+    return;
+  }
+
+  /* Sort a copy so that the streaming side isn't blocked meanwhile */
+  GST_OBJECT_LOCK (self);
+  count = MIN (self->samples, self->size);
+  sorted = g_memdup (self->window, count * sizeof (guint64));
+  GST_OBJECT_UNLOCK (self);
+
+  if (0 == count) {
+    g_value_set_uint64 (value, 0);
+    g_free (sorted);
+    return;
+  }
+
+  qsort (sorted, count, sizeof (guint64), gstd_latency_stats_compare);
+
+  switch (property_id) {
+    case PROP_MIN:
+      g_value_set_uint64 (value, sorted[0]);
+      break;
+    case PROP_MEAN:
+      for (i = 0; i < count; i++) {
+        total += sorted[i];
+      }
+      g_value_set_uint64 (value, total / count);
+      break;
+    case PROP_P50:
+      g_value_set_uint64 (value, sorted[(count - 1) * 50 / 100]);
+      break;
+    case PROP_P90:
+      g_value_set_uint64 (value, sorted[(count - 1) * 90 / 100]);
+      break;
+    case PROP_P99:
+      g_value_set_uint64 (value, sorted[(count - 1) * 99 / 100]);
+      break;
+    case PROP_MAX:
+      g_value_set_uint64 (value, sorted[count - 1]);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+
+  g_free (sorted);
+}
+
+static void
+gstd_latency_stats_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdLatencyStats *self = GSTD_LATENCY_STATS (object);
+
+  switch (property_id) {
+    case PROP_WINDOW:
+      self->size = g_value_get_uint (value);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+GstdLatencyStats *
+gstd_latency_stats_new (const gchar * name, guint window)
+{
+  GstdLatencyStats *self;
+
+  g_return_val_if_fail (name, NULL);
+
+  self = GSTD_LATENCY_STATS (g_object_new (GSTD_TYPE_LATENCY_STATS,
+          "name", name, "window", window, NULL));
+  self->window = g_new0 (guint64, self->size);
+
+  return self;
+}
+
+void
+gstd_latency_stats_add (GstdLatencyStats * self, guint64 latency)
+{
+  g_return_if_fail (GSTD_IS_LATENCY_STATS (self));
+
+  GST_OBJECT_LOCK (self);
+  self->window[self->next] = latency;
+  self->next = (self->next + 1) % self->size;
+  self->samples++;
+  GST_OBJECT_UNLOCK (self);
+}
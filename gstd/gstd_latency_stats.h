@@ -0,0 +1,71 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_LATENCY_STATS_H__
+#define __GSTD_LATENCY_STATS_H__
+
+#include <glib-object.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_LATENCY_STATS \
+  (gstd_latency_stats_get_type())
+#define GSTD_LATENCY_STATS(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_LATENCY_STATS,GstdLatencyStats))
+#define GSTD_LATENCY_STATS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_LATENCY_STATS,GstdLatencyStatsClass))
+#define GSTD_IS_LATENCY_STATS(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_LATENCY_STATS))
+#define GSTD_IS_LATENCY_STATS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_LATENCY_STATS))
+#define GSTD_LATENCY_STATS_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_LATENCY_STATS, GstdLatencyStatsClass))
+typedef struct _GstdLatencyStats GstdLatencyStats;
+typedef struct _GstdLatencyStatsClass GstdLatencyStatsClass;
+GType gstd_latency_stats_get_type (void);
+
+#define GSTD_LATENCY_STATS_DEFAULT_WINDOW 1024
+
+/**
+ * gstd_latency_stats_new: (constructor)
+ * @name: The name of the measured path or element
+ * @window: The amount of recent samples percentiles are computed over
+ *
+ * Creates a new object to aggregate latency samples.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdLatencyStats. Free
+ * after usage using g_object_unref()
+ */
+GstdLatencyStats *gstd_latency_stats_new (const gchar * name, guint window);
+
+/**
+ * gstd_latency_stats_add:
+ * @object: The stats to update
+ * @latency: The measured latency, in nanoseconds
+ *
+ * Adds a sample, replacing the oldest one once the window is full.
+ */
+void gstd_latency_stats_add (GstdLatencyStats * object, guint64 latency);
+
+G_END_DECLS
+#endif // __GSTD_LATENCY_STATS_H__
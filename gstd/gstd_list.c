@@ -47,7 +47,6 @@ GST_DEBUG_CATEGORY_STATIC (gstd_list_debug);
 #define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
 
 /* VTable */
-static gint gstd_list_find_node (gconstpointer, gconstpointer);
 static GstdReturnCode
 gstd_list_create (GstdObject * object, const gchar * name,
     const gchar * description);
@@ -113,6 +112,9 @@ gstd_list_init (GstdList * self)
 {
   GST_INFO_OBJECT (self, "Initializing list");
   self->list = NULL;
+  self->index = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  self->deleting = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+      NULL);
   self->count = GSTD_LIST_DEFAULT_COUNT;
   self->node_type = GSTD_LIST_DEFAULT_NODE_TYPE;
 }
@@ -129,6 +131,14 @@ gstd_list_dispose (GObject * object)
     g_list_free_full (self->list, g_object_unref);
     self->list = NULL;
   }
+  if (self->index) {
+    g_hash_table_unref (self->index);
+    self->index = NULL;
+  }
+  if (self->deleting) {
+    g_hash_table_unref (self->deleting);
+    self->deleting = NULL;
+  }
   GST_OBJECT_UNLOCK (self);
 
   G_OBJECT_CLASS (gstd_list_parent_class)->dispose (object);
@@ -184,17 +194,6 @@ gstd_list_set_property (GObject * object,
   }
 }
 
-static gint
-gstd_list_find_node (gconstpointer _obj, gconstpointer _name)
-{
-  GstdObject *obj = GSTD_OBJECT (_obj);
-  gchar *name = (gchar *) _name;
-
-  GST_LOG ("Comparing %s vs %s", GSTD_OBJECT_NAME (obj), name);
-
-  return strcmp (GSTD_OBJECT_NAME (obj), name);
-}
-
 static GstdReturnCode
 gstd_list_create (GstdObject * object, const gchar * name,
     const gchar * description)
@@ -244,6 +243,8 @@ gstd_list_delete (GstdObject * object, const gchar * node)
   GstdList *self;
   GstdObject *todelete;
   GList *found;
+  GList *link;
+  gint position;
   GstdReturnCode ret;
 
   g_return_val_if_fail (GSTD_IS_OBJECT (object), GSTD_NULL_ARGUMENT);
@@ -255,7 +256,7 @@ gstd_list_delete (GstdObject * object, const gchar * node)
 
   /* Test if the resource to delete exists */
   GST_OBJECT_LOCK (self);
-  found = g_list_find_custom (self->list, node, gstd_list_find_node);
+  found = g_hash_table_lookup (self->index, node);
 
   if (!found) {
     GST_OBJECT_UNLOCK (self);
@@ -264,18 +265,31 @@ gstd_list_delete (GstdObject * object, const gchar * node)
 
   todelete = GSTD_OBJECT (found->data);
 
-  GST_INFO_OBJECT (self, "Deleting %s from %s list", GSTD_OBJECT_NAME (self),
-      GSTD_OBJECT_NAME (self));
+  /* Unlist the resource first, deleters may block and readers must not
+     wait on them. The name stays reserved in case it has to be listed
+     back */
+  position = g_list_position (self->list, found);
+  g_hash_table_remove (self->index, node);
+  g_hash_table_add (self->deleting, g_strdup (node));
+  self->list = g_list_delete_link (self->list, found);
+  self->count = g_hash_table_size (self->index);
+  GST_OBJECT_UNLOCK (self);
+
+  GST_INFO_OBJECT (self, "Deleting %s from %s list",
+      GSTD_OBJECT_NAME (todelete), GSTD_OBJECT_NAME (self));
 
   ret = gstd_ideleter_delete (object->deleter, todelete);
+
+  GST_OBJECT_LOCK (self);
+  g_hash_table_remove (self->deleting, node);
   if (ret) {
-    GST_OBJECT_UNLOCK (self);
-    return ret;
+    /* Back where it was, other nodes may have come and gone meanwhile */
+    position = MIN (position, (gint) g_list_length (self->list));
+    self->list = g_list_insert (self->list, todelete, position);
+    link = g_list_nth (self->list, position);
+    g_hash_table_insert (self->index, g_strdup (node), link);
+    self->count = g_hash_table_size (self->index);
   }
-
-  self->count--;
-
-  self->list = g_list_delete_link (self->list, found);
   GST_OBJECT_UNLOCK (self);
 
   return ret;
@@ -336,11 +350,12 @@ gstd_list_find_child (GstdList * self, const gchar * name)
   g_return_val_if_fail (name, NULL);
 
   GST_OBJECT_LOCK (self);
-  result = g_list_find_custom (self->list, name, gstd_list_find_node);
-
+  result = g_hash_table_lookup (self->index, name);
 
   if (result) {
-    child = GSTD_OBJECT (result->data);
+    /* Nodes may be removed from streaming threads as soon as the lock
+       is released */
+    child = GSTD_OBJECT (g_object_ref (result->data));
   } else {
     child = NULL;
   }
@@ -352,26 +367,28 @@ gstd_list_find_child (GstdList * self, const gchar * name)
 gboolean
 gstd_list_append_child (GstdList * self, GstdObject * child)
 {
-  GList *found;
+  GList *link;
 
   g_return_val_if_fail (self, GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (child, GSTD_NULL_ARGUMENT);
 
-  /* Test if the resource to create already exists */
+  /* Test if the resource to create already exists or is still being
+     deleted */
   GST_OBJECT_LOCK (self);
-  found =
-      g_list_find_custom (self->list, GSTD_OBJECT_NAME (child),
-      gstd_list_find_node);
-  if (found) {
+  if (g_hash_table_contains (self->index, GSTD_OBJECT_NAME (child)) ||
+      g_hash_table_contains (self->deleting, GSTD_OBJECT_NAME (child))) {
     GST_OBJECT_UNLOCK (self);
     goto exists;
   }
 
-  self->list = g_list_append (self->list, child);
-  self->count = g_list_length (self->list);
-  GST_OBJECT_UNLOCK (self);
+  link = g_list_alloc ();
+  link->data = child;
+  self->list = g_list_concat (self->list, link);
+  g_hash_table_insert (self->index, g_strdup (GSTD_OBJECT_NAME (child)), link);
+  self->count = g_hash_table_size (self->index);
   GST_INFO_OBJECT (self, "Appended %s to %s list", GSTD_OBJECT_NAME (child),
       GSTD_OBJECT_NAME (self));
+  GST_OBJECT_UNLOCK (self);
 
   return TRUE;
 
@@ -382,3 +399,32 @@ exists:
     return FALSE;
   }
 }
+
+gboolean
+gstd_list_remove_child (GstdList * self, const gchar * name)
+{
+  GList *found;
+  GstdObject *child;
+
+  g_return_val_if_fail (self, FALSE);
+  g_return_val_if_fail (name, FALSE);
+
+  GST_OBJECT_LOCK (self);
+  found = g_hash_table_lookup (self->index, name);
+  if (!found) {
+    GST_OBJECT_UNLOCK (self);
+    return FALSE;
+  }
+
+  child = GSTD_OBJECT (found->data);
+  g_hash_table_remove (self->index, name);
+  self->list = g_list_delete_link (self->list, found);
+  self->count = g_hash_table_size (self->index);
+  GST_OBJECT_UNLOCK (self);
+
+  GST_INFO_OBJECT (self, "Removed %s from %s list", name,
+      GSTD_OBJECT_NAME (self));
+  g_object_unref (child);
+
+  return TRUE;
+}
@@ -58,6 +58,13 @@ struct _GstdList
   GParamFlags flags;
 
   GList *list;
+
+  /* Maps each node name to its link in the list */
+  GHashTable *index;
+
+  /* The names of the nodes being deleted, which can't be taken until
+     the deleter is done with them */
+  GHashTable *deleting;
 };
 
 struct _GstdListClass
@@ -67,8 +74,17 @@ struct _GstdListClass
 
 GType gstd_list_get_type (void);
 
+/**
+ * gstd_list_find_child:
+ * @self: The list to look the node up in
+ * @name: The name of the node
+ *
+ * Returns: (transfer full) (nullable): The node named @name. Free after
+ * usage using g_object_unref()
+ */
 GstdObject *gstd_list_find_child (GstdList * self, const gchar * name);
 gboolean gstd_list_append_child (GstdList *, GstdObject * child);
+gboolean gstd_list_remove_child (GstdList * self, const gchar * name);
 
 G_END_DECLS
 #endif // __GSTD_LIST_H__
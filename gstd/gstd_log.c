@@ -22,6 +22,7 @@
 #endif
 
 #include "gstd_log.h"
+#include "gstd_debug.h"
 
 #include <gst/gst.h>
 #include <glib/gstdio.h>
@@ -115,6 +116,11 @@ gstd_log_proxy (GstDebugCategory * category, GstDebugLevel level,
 {
   const gchar *cat_name;
 
+  /* Tracer records are consumed by the pipeline stats */
+  if (gstd_debug_is_tracer_record (category, level)) {
+    return;
+  }
+
   cat_name = gst_debug_category_get_name (category);
 
   /* Log every gstd trace into the gstd log file */
@@ -0,0 +1,268 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+
+#include "gstd_pad.h"
+#include "gstd_pad_stats.h"
+#include "gstd_event_handler.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pad debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pad_debug);
+#define GST_CAT_DEFAULT gstd_pad_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+enum
+{
+  PROP_GSTPAD = 1,
+  PROP_DIRECTION,
+  PROP_CAPS,
+  PROP_PEER,
+  PROP_STATS,
+  PROP_EVENT,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+#define GSTD_PAD_DEFAULT_GSTPAD NULL
+
+/**
+ * GstdPad:
+ * A wrapper for the conventional pad
+ */
+struct _GstdPad
+{
+  GstdObject parent;
+
+  /**
+   * The GStreamer pad
+   */
+  GstPad *pad;
+
+  /**
+   * The buffer flow counters of the pad
+   */
+  GstdPadStats *stats;
+
+  /**
+   * The gstd event handler for this pad
+   */
+  GstdEventHandler *event_handler;
+};
+
+struct _GstdPadClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPad, gstd_pad, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void gstd_pad_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void gstd_pad_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_pad_dispose (GObject *);
+
+static void
+gstd_pad_class_init (GstdPadClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_pad_set_property;
+  object_class->get_property = gstd_pad_get_property;
+  object_class->dispose = gstd_pad_dispose;
+
+  properties[PROP_GSTPAD] =
+      g_param_spec_object ("gstpad",
+      "GstPad",
+      "The internal GStreamer pad",
+      GST_TYPE_PAD,
+      G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
+  properties[PROP_DIRECTION] =
+      g_param_spec_enum ("direction",
+      "Direction",
+      "The direction of the pad",
+      GST_TYPE_PAD_DIRECTION, GST_PAD_UNKNOWN,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_CAPS] =
+      g_param_spec_string ("caps",
+      "Caps",
+      "The negotiated caps of the pad",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_PEER] =
+      g_param_spec_string ("peer",
+      "Peer",
+      "The pad this one is linked to, as in element:pad",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_STATS] =
+      g_param_spec_object ("stats",
+      "Stats",
+      "The buffer flow counters of the pad",
+      GSTD_TYPE_PAD_STATS,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_EVENT] =
+      g_param_spec_object ("event", "Event",
+      "The event handler of the pad",
+      GSTD_TYPE_EVENT_HANDLER, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pad_debug, "gstdpad", debug_color,
+      "Gstd Pad category");
+}
+
+static void
+gstd_pad_init (GstdPad * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pad");
+
+  self->pad = GSTD_PAD_DEFAULT_GSTPAD;
+  self->stats = NULL;
+  self->event_handler = NULL;
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_pad_dispose (GObject * object)
+{
+  GstdPad *self = GSTD_PAD (object);
+
+  /* The probe holds a reference to the stats, remove it first */
+  if (self->stats) {
+    gstd_pad_stats_set_enabled (self->stats, FALSE);
+    g_object_unref (self->stats);
+    self->stats = NULL;
+  }
+
+  if (self->event_handler) {
+    g_object_unref (self->event_handler);
+    self->event_handler = NULL;
+  }
+
+  if (self->pad) {
+    gst_object_unref (self->pad);
+    self->pad = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_pad_parent_class)->dispose (object);
+}
+
+static void
+gstd_pad_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPad *self = GSTD_PAD (object);
+  GstCaps *caps;
+  GstPad *peer;
+
+  switch (property_id) {
+    case PROP_GSTPAD:
+      g_value_set_object (value, self->pad);
+      break;
+    case PROP_DIRECTION:
+      g_value_set_enum (value, gst_pad_get_direction (self->pad));
+      break;
+    case PROP_CAPS:
+      caps = gst_pad_get_current_caps (self->pad);
+      if (caps) {
+        g_value_take_string (value, gst_caps_to_string (caps));
+        gst_caps_unref (caps);
+      } else {
+        g_value_set_string (value, NULL);
+      }
+      break;
+    case PROP_PEER:
+      peer = gst_pad_get_peer (self->pad);
+      if (peer) {
+        g_value_take_string (value, g_strdup_printf ("%s:%s",
+                GST_DEBUG_PAD_NAME (peer)));
+        gst_object_unref (peer);
+      } else {
+        g_value_set_string (value, NULL);
+      }
+      break;
+    case PROP_STATS:
+      GST_DEBUG_OBJECT (self, "Returning stats %p", self->stats);
+      g_value_set_object (value, self->stats);
+      break;
+    case PROP_EVENT:
+      GST_DEBUG_OBJECT (self, "Returning event handler %p",
+          self->event_handler);
+      g_value_set_object (value, self->event_handler);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_pad_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdPad *self = GSTD_PAD (object);
+
+  switch (property_id) {
+    case PROP_GSTPAD:
+      self->pad = g_value_dup_object (value);
+      self->stats = gstd_pad_stats_new (self->pad);
+      self->event_handler = g_object_new (GSTD_TYPE_EVENT_HANDLER, "receiver",
+          G_OBJECT (self->pad), NULL);
+      GST_DEBUG_OBJECT (self, "Setting pad %s:%s",
+          GST_DEBUG_PAD_NAME (self->pad));
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+void
+gstd_pad_set_stats_enabled (GstdPad * self, gboolean enabled)
+{
+  g_return_if_fail (GSTD_IS_PAD (self));
+
+  gstd_pad_stats_set_enabled (self->stats, enabled);
+}
+
+GstPadDirection
+gstd_pad_get_direction (GstdPad * self)
+{
+  g_return_val_if_fail (GSTD_IS_PAD (self), GST_PAD_UNKNOWN);
+
+  return gst_pad_get_direction (self->pad);
+}
@@ -0,0 +1,66 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PAD_H__
+#define __GSTD_PAD_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PAD \
+  (gstd_pad_get_type())
+#define GSTD_PAD(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PAD,GstdPad))
+#define GSTD_PAD_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PAD,GstdPadClass))
+#define GSTD_IS_PAD(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PAD))
+#define GSTD_IS_PAD_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PAD))
+#define GSTD_PAD_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PAD, GstdPadClass))
+typedef struct _GstdPad GstdPad;
+typedef struct _GstdPadClass GstdPadClass;
+GType gstd_pad_get_type (void);
+
+/**
+ * gstd_pad_set_stats_enabled:
+ * @object: The pad to instrument
+ * @enabled: Whether to measure the buffer flow through the pad
+ *
+ * Enables or disables the buffer flow counters of the pad.
+ */
+void gstd_pad_set_stats_enabled (GstdPad * object, gboolean enabled);
+
+/**
+ * gstd_pad_get_direction:
+ * @object: The pad to query
+ *
+ * Returns: The direction of the wrapped pad.
+ */
+GstPadDirection gstd_pad_get_direction (GstdPad * object);
+
+G_END_DECLS
+#endif // __GSTD_PAD_H__
@@ -0,0 +1,365 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+
+#include "gstd_pad_stats.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pad Stats debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pad_stats_debug);
+#define GST_CAT_DEFAULT gstd_pad_stats_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/* The counters are written by the streaming thread only, so relaxed
+   loads and stores are enough to avoid torn reads from other threads */
+#define GSTD_PAD_STATS_LOAD(counter) \
+  __atomic_load_n (&(counter), __ATOMIC_RELAXED)
+#define GSTD_PAD_STATS_STORE(counter, value) \
+  __atomic_store_n (&(counter), (value), __ATOMIC_RELAXED)
+
+enum
+{
+  PROP_ENABLE = 1,
+  PROP_BUFFERS,
+  PROP_BYTES,
+  PROP_FPS,
+  PROP_BITRATE,
+  PROP_MEAN_GAP,
+  PROP_MAX_GAP,
+  PROP_LAST_PTS,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+#define GSTD_PAD_STATS_DEFAULT_ENABLE FALSE
+
+/**
+ * GstdPadStats:
+ * Buffer flow counters of a pad
+ */
+struct _GstdPadStats
+{
+  GstdObject parent;
+
+  /**
+   * The instrumented pad
+   */
+  GstPad *pad;
+
+  /**
+   * The id of the probe feeding the counters, 0 if disabled
+   */
+  gulong probe_id;
+
+  /**
+   * Counters, only written from the streaming thread
+   */
+  guint64 buffers;
+  guint64 bytes;
+  guint64 first;
+  guint64 last;
+  guint64 total_gap;
+  guint64 max_gap;
+  guint64 last_pts;
+};
+
+struct _GstdPadStatsClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPadStats, gstd_pad_stats, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pad_stats_set_property (GObject *, guint, const GValue *, GParamSpec *);
+static void
+gstd_pad_stats_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_pad_stats_dispose (GObject *);
+static GstPadProbeReturn gstd_pad_stats_probe (GstPad *, GstPadProbeInfo *,
+    gpointer);
+static void gstd_pad_stats_account (GstdPadStats *, GstBuffer *, guint64);
+
+static void
+gstd_pad_stats_class_init (GstdPadStatsClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_pad_stats_set_property;
+  object_class->get_property = gstd_pad_stats_get_property;
+  object_class->dispose = gstd_pad_stats_dispose;
+
+  properties[PROP_ENABLE] =
+      g_param_spec_boolean ("enable",
+      "Enable",
+      "Measure the buffer flow through the pad. Enabling resets counters",
+      GSTD_PAD_STATS_DEFAULT_ENABLE,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_BUFFERS] =
+      g_param_spec_uint64 ("buffers",
+      "Buffers",
+      "The amount of buffers that went through the pad",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_BYTES] =
+      g_param_spec_uint64 ("bytes",
+      "Bytes",
+      "The amount of bytes that went through the pad",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_FPS] =
+      g_param_spec_double ("fps",
+      "FPS",
+      "The mean buffer rate, in buffers per second",
+      0, G_MAXDOUBLE, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_BITRATE] =
+      g_param_spec_uint64 ("bitrate",
+      "Bitrate",
+      "The mean bitrate, in bits per second",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_MEAN_GAP] =
+      g_param_spec_uint64 ("mean-gap",
+      "Mean Gap",
+      "The mean time between buffers, in nanoseconds",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_MAX_GAP] =
+      g_param_spec_uint64 ("max-gap",
+      "Max Gap",
+      "The longest time between buffers, in nanoseconds",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_LAST_PTS] =
+      g_param_spec_uint64 ("last-pts",
+      "Last PTS",
+      "The presentation timestamp of the last buffer",
+      0, G_MAXUINT64, GST_CLOCK_TIME_NONE,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pad_stats_debug, "gstdpadstats", debug_color,
+      "Gstd Pad Stats category");
+}
+
+static void
+gstd_pad_stats_init (GstdPadStats * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pad stats");
+
+  self->pad = NULL;
+  self->probe_id = 0;
+  self->last_pts = GST_CLOCK_TIME_NONE;
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_pad_stats_dispose (GObject * object)
+{
+  GstdPadStats *self = GSTD_PAD_STATS (object);
+
+  if (self->pad) {
+    gstd_pad_stats_set_enabled (self, FALSE);
+    gst_object_unref (self->pad);
+    self->pad = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_pad_stats_parent_class)->dispose (object);
+}
+
+static void
+gstd_pad_stats_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPadStats *self = GSTD_PAD_STATS (object);
+  guint64 buffers;
+  guint64 elapsed;
+
+  buffers = GSTD_PAD_STATS_LOAD (self->buffers);
+  elapsed = GSTD_PAD_STATS_LOAD (self->last) - GSTD_PAD_STATS_LOAD (self->first);
+
+  switch (property_id) {
+    case PROP_ENABLE:
+      GST_OBJECT_LOCK (self);
+      g_value_set_boolean (value, 0 != self->probe_id);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_BUFFERS:
+      g_value_set_uint64 (value, buffers);
+      break;
+    case PROP_BYTES:
+      g_value_set_uint64 (value, GSTD_PAD_STATS_LOAD (self->bytes));
+      break;
+    case PROP_FPS:
+      g_value_set_double (value, (buffers > 1 && elapsed) ?
+          (gdouble) (buffers - 1) * GST_SECOND / elapsed : 0);
+      break;
+    case PROP_BITRATE:
+      g_value_set_uint64 (value, elapsed ?
+          gst_util_uint64_scale (GSTD_PAD_STATS_LOAD (self->bytes) * 8,
+              GST_SECOND, elapsed) : 0);
+      break;
+    case PROP_MEAN_GAP:
+      g_value_set_uint64 (value, buffers > 1 ?
+          GSTD_PAD_STATS_LOAD (self->total_gap) / (buffers - 1) : 0);
+      break;
+    case PROP_MAX_GAP:
+      g_value_set_uint64 (value, GSTD_PAD_STATS_LOAD (self->max_gap));
+      break;
+    case PROP_LAST_PTS:
+      g_value_set_uint64 (value, GSTD_PAD_STATS_LOAD (self->last_pts));
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_pad_stats_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdPadStats *self = GSTD_PAD_STATS (object);
+
+  switch (property_id) {
+    case PROP_ENABLE:
+      gstd_pad_stats_set_enabled (self, g_value_get_boolean (value));
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+GstdPadStats *
+gstd_pad_stats_new (GstPad * pad)
+{
+  GstdPadStats *self;
+
+  g_return_val_if_fail (GST_IS_PAD (pad), NULL);
+
+  self = GSTD_PAD_STATS (g_object_new (GSTD_TYPE_PAD_STATS, "name", "stats",
+          NULL));
+  self->pad = gst_object_ref (pad);
+
+  return self;
+}
+
+void
+gstd_pad_stats_set_enabled (GstdPadStats * self, gboolean enabled)
+{
+  g_return_if_fail (GSTD_IS_PAD_STATS (self));
+  g_return_if_fail (self->pad);
+
+  GST_OBJECT_LOCK (self);
+  if (enabled && !self->probe_id) {
+    GSTD_PAD_STATS_STORE (self->buffers, 0);
+    GSTD_PAD_STATS_STORE (self->bytes, 0);
+    GSTD_PAD_STATS_STORE (self->first, 0);
+    GSTD_PAD_STATS_STORE (self->last, 0);
+    GSTD_PAD_STATS_STORE (self->total_gap, 0);
+    GSTD_PAD_STATS_STORE (self->max_gap, 0);
+    GSTD_PAD_STATS_STORE (self->last_pts, GST_CLOCK_TIME_NONE);
+
+    self->probe_id = gst_pad_add_probe (self->pad,
+        GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+        gstd_pad_stats_probe, g_object_ref (self), g_object_unref);
+    GST_INFO_OBJECT (self, "Instrumented %s:%s", GST_DEBUG_PAD_NAME (self->pad));
+  } else if (!enabled && self->probe_id) {
+    gst_pad_remove_probe (self->pad, self->probe_id);
+    self->probe_id = 0;
+    GST_INFO_OBJECT (self, "Removed instrumentation from %s:%s",
+        GST_DEBUG_PAD_NAME (self->pad));
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static GstPadProbeReturn
+gstd_pad_stats_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  GstdPadStats *self = GSTD_PAD_STATS (user_data);
+  guint64 now;
+
+  now = gst_util_get_timestamp ();
+
+  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER) {
+    gstd_pad_stats_account (self, GST_PAD_PROBE_INFO_BUFFER (info), now);
+  } else if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    GstBufferList *list = GST_PAD_PROBE_INFO_BUFFER_LIST (info);
+    guint length = gst_buffer_list_length (list);
+    guint i;
+
+    for (i = 0; i < length; i++) {
+      gstd_pad_stats_account (self, gst_buffer_list_get (list, i), now);
+    }
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+gstd_pad_stats_account (GstdPadStats * self, GstBuffer * buffer, guint64 now)
+{
+  guint64 buffers;
+
+  /* Only the streaming thread writes, plain read-modify-write is safe */
+  buffers = self->buffers;
+
+  if (0 == buffers) {
+    GSTD_PAD_STATS_STORE (self->first, now);
+  } else {
+    guint64 gap = now - self->last;
+
+    GSTD_PAD_STATS_STORE (self->total_gap, self->total_gap + gap);
+    if (gap > self->max_gap) {
+      GSTD_PAD_STATS_STORE (self->max_gap, gap);
+    }
+  }
+
+  GSTD_PAD_STATS_STORE (self->last, now);
+  GSTD_PAD_STATS_STORE (self->bytes,
+      self->bytes + gst_buffer_get_size (buffer));
+  if (GST_BUFFER_PTS_IS_VALID (buffer)) {
+    GSTD_PAD_STATS_STORE (self->last_pts, GST_BUFFER_PTS (buffer));
+  }
+  GSTD_PAD_STATS_STORE (self->buffers, buffers + 1);
+}
@@ -0,0 +1,71 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PAD_STATS_H__
+#define __GSTD_PAD_STATS_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PAD_STATS \
+  (gstd_pad_stats_get_type())
+#define GSTD_PAD_STATS(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PAD_STATS,GstdPadStats))
+#define GSTD_PAD_STATS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PAD_STATS,GstdPadStatsClass))
+#define GSTD_IS_PAD_STATS(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PAD_STATS))
+#define GSTD_IS_PAD_STATS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PAD_STATS))
+#define GSTD_PAD_STATS_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PAD_STATS, GstdPadStatsClass))
+typedef struct _GstdPadStats GstdPadStats;
+typedef struct _GstdPadStatsClass GstdPadStatsClass;
+GType gstd_pad_stats_get_type (void);
+
+/**
+ * gstd_pad_stats_new: (constructor)
+ * @pad: The pad to instrument
+ *
+ * Creates a new object to measure the buffer flow through @pad. The
+ * pad isn't instrumented until the object is enabled.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPadStats. Free after
+ * usage using g_object_unref()
+ */
+GstdPadStats *gstd_pad_stats_new (GstPad * pad);
+
+/**
+ * gstd_pad_stats_set_enabled:
+ * @object: The stats to enable or disable
+ * @enabled: Whether to measure the buffer flow
+ *
+ * Installs or removes the probe that feeds the counters. Enabling
+ * resets the counters.
+ */
+void gstd_pad_stats_set_enabled (GstdPadStats * object, gboolean enabled);
+
+G_END_DECLS
+#endif // __GSTD_PAD_STATS_H__
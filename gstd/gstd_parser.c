@@ -24,6 +24,8 @@
 #include "gstd_event_handler.h"
 #include "gstd_parser.h"
 #include "gstd_session.h"
+#include "gstd_pipeline_pool.h"
+#include "gstd_pipeline_bulk.h"
 
 #define check_argument(arg, code) \
     if (NULL == (arg)) return (code)
@@ -39,6 +41,7 @@ static GstdReturnCode gstd_parser_update (GstdSession * session,
     GstdObject * obj, gchar * args, gchar ** response);
 static GstdReturnCode gstd_parser_delete (GstdSession * session,
     GstdObject * obj, gchar * args, gchar ** response);
+static void gstd_parser_element_path (gchar ** element);
 static GstdReturnCode gstd_parser_parse_raw_cmd (GstdSession * session,
     gchar * action, gchar * args, gchar ** response);
 static GstdReturnCode gstd_parser_pipeline_create (GstdSession *, gchar *,
@@ -55,10 +58,72 @@ static GstdReturnCode gstd_parser_pipeline_graph (GstdSession *, gchar *,
     gchar *, gchar **);
 static GstdReturnCode gstd_parser_pipeline_verbose (GstdSession *, gchar *,
     gchar *, gchar **);
+static GstdReturnCode gstd_parser_pipeline_create_from_pool (GstdSession *,
+    gchar *, gchar *, gchar **);
+static GstdReturnCode gstd_parser_pipeline_play_from_pool (GstdSession *,
+    gchar *, gchar *, gchar **);
+static GstdReturnCode gstd_parser_pipeline_from_pool (GstdSession *, gchar *,
+    gboolean, gchar **);
+static GstdReturnCode gstd_parser_pool_create (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_pool_delete (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_pool_size (GstdSession *, gchar *,
+    gchar *, gchar **);
 static GstdReturnCode gstd_parser_element_set (GstdSession *, gchar *,
     gchar *, gchar **);
 static GstdReturnCode gstd_parser_element_get (GstdSession *, gchar *,
     gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_ramp (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_ramp_stop (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_batch (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_pipeline_schedule (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_pipeline_unschedule (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_rule_create (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_rule_delete (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_sync_group_create (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_sync_group_delete (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_sync_group_play (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_sync_group_stop (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_link_create (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_link_delete (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_recording_start (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_recording_stop (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_create (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_delete (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_link (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_unlink (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_endpoint_create (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_endpoint_delete (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_snapshot (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_telemetry_create (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_telemetry_read (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_telemetry_delete (GstdSession *, gchar *,
+    gchar *, gchar **);
 static GstdReturnCode gstd_parser_list_pipelines (GstdSession *, gchar *,
     gchar *, gchar **);
 static GstdReturnCode gstd_parser_list_elements (GstdSession *, gchar *,
@@ -73,10 +138,16 @@ static GstdReturnCode gstd_parser_bus_filter (GstdSession *, gchar *, gchar *,
     gchar **);
 static GstdReturnCode gstd_parser_bus_timeout (GstdSession *, gchar *, gchar *,
     gchar **);
+static GstdReturnCode gstd_parser_bus_policy (GstdSession *, gchar *, gchar *,
+    gchar **);
 static GstdReturnCode gstd_parser_event_eos (GstdSession *, gchar *, gchar *,
     gchar **);
 static GstdReturnCode gstd_parser_event_seek (GstdSession *, gchar *, gchar *,
     gchar **);
+static GstdReturnCode gstd_parser_event_rate (GstdSession *, gchar *, gchar *,
+    gchar **);
+static GstdReturnCode gstd_parser_event_force_key_unit (GstdSession *,
+    gchar *, gchar *, gchar **);
 static GstdReturnCode gstd_parser_event_flush_start (GstdSession *, gchar *,
     gchar *, gchar **);
 static GstdReturnCode gstd_parser_event_flush_stop (GstdSession *, gchar *,
@@ -95,6 +166,8 @@ static GstdReturnCode gstd_parser_debug_color (GstdSession *, gchar *, gchar *,
     gchar **);
 static GstdReturnCode gstd_parser_debug_reset (GstdSession *, gchar *, gchar *,
     gchar **);
+static GstdReturnCode gstd_parser_debug_tracers (GstdSession *, gchar *,
+    gchar *, gchar **);
 
 typedef GstdReturnCode GstdFunc (GstdSession *, gchar *, gchar *, gchar **);
 typedef struct _GstdCmd
@@ -116,9 +189,40 @@ static GstdCmd cmds[] = {
   {"pipeline_stop", gstd_parser_pipeline_stop},
   {"pipeline_get_graph", gstd_parser_pipeline_graph},
   {"pipeline_verbose", gstd_parser_pipeline_verbose},
+  {"pipeline_create_from_pool", gstd_parser_pipeline_create_from_pool},
+  {"pipeline_play_from_pool", gstd_parser_pipeline_play_from_pool},
+
+  {"pool_create", gstd_parser_pool_create},
+  {"pool_delete", gstd_parser_pool_delete},
+  {"pool_size", gstd_parser_pool_size},
 
   {"element_set", gstd_parser_element_set},
   {"element_get", gstd_parser_element_get},
+  {"element_ramp", gstd_parser_element_ramp},
+  {"element_ramp_stop", gstd_parser_element_ramp_stop},
+  {"element_batch", gstd_parser_element_batch},
+  {"pipeline_schedule", gstd_parser_pipeline_schedule},
+  {"pipeline_unschedule", gstd_parser_pipeline_unschedule},
+  {"rule_create", gstd_parser_rule_create},
+  {"rule_delete", gstd_parser_rule_delete},
+  {"sync_group_create", gstd_parser_sync_group_create},
+  {"sync_group_delete", gstd_parser_sync_group_delete},
+  {"sync_group_play", gstd_parser_sync_group_play},
+  {"sync_group_stop", gstd_parser_sync_group_stop},
+  {"link_create", gstd_parser_link_create},
+  {"link_delete", gstd_parser_link_delete},
+  {"recording_start", gstd_parser_recording_start},
+  {"recording_stop", gstd_parser_recording_stop},
+  {"element_create", gstd_parser_element_create},
+  {"element_delete", gstd_parser_element_delete},
+  {"element_link", gstd_parser_element_link},
+  {"element_unlink", gstd_parser_element_unlink},
+  {"endpoint_create", gstd_parser_endpoint_create},
+  {"endpoint_delete", gstd_parser_endpoint_delete},
+  {"element_snapshot", gstd_parser_element_snapshot},
+  {"telemetry_create", gstd_parser_telemetry_create},
+  {"telemetry_read", gstd_parser_telemetry_read},
+  {"telemetry_delete", gstd_parser_telemetry_delete},
 
   {"list_pipelines", gstd_parser_list_pipelines},
   {"list_elements", gstd_parser_list_elements},
@@ -128,9 +232,12 @@ static GstdCmd cmds[] = {
   {"bus_read", gstd_parser_bus_read},
   {"bus_filter", gstd_parser_bus_filter},
   {"bus_timeout", gstd_parser_bus_timeout},
+  {"bus_policy", gstd_parser_bus_policy},
 
   {"event_eos", gstd_parser_event_eos},
   {"event_seek", gstd_parser_event_seek},
+  {"event_rate", gstd_parser_event_rate},
+  {"event_force_key_unit", gstd_parser_event_force_key_unit},
   {"event_flush_start", gstd_parser_event_flush_start},
   {"event_flush_stop", gstd_parser_event_flush_stop},
 
@@ -142,10 +249,27 @@ static GstdCmd cmds[] = {
   {"debug_threshold", gstd_parser_debug_threshold},
   {"debug_color", gstd_parser_debug_color},
   {"debug_reset", gstd_parser_debug_reset},
+  {"debug_tracers", gstd_parser_debug_tracers},
 
   {NULL}
 };
 
+/* Elements nested in bins are addressed as <bin>/<child>, expand them
+   into the /elements/<bin>/elements/<child> resource path */
+static void
+gstd_parser_element_path (gchar ** element)
+{
+  gchar **names;
+
+  if (!*element || !g_strrstr (*element, "/"))
+    return;
+
+  names = g_strsplit (*element, "/", -1);
+  g_free (*element);
+  *element = g_strjoinv ("/elements/", names);
+  g_strfreev (names);
+}
+
 static GstdReturnCode
 gstd_parser_parse_raw_cmd (GstdSession * session, gchar * action, gchar * args,
     gchar ** response)
@@ -383,6 +507,11 @@ gstd_parser_pipeline_play (GstdSession * session, gchar * action, gchar * args,
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
+  if (gstd_pipeline_bulk_is_bulk (args)) {
+    return gstd_pipeline_bulk_set_state (session->pipelines, args,
+        "playing", response);
+  }
+
   uri = g_strdup_printf ("/pipelines/%s/state playing", args);
   ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
   g_free (uri);
@@ -400,6 +529,11 @@ gstd_parser_pipeline_pause (GstdSession * session, gchar * action, gchar * args,
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
+  if (gstd_pipeline_bulk_is_bulk (args)) {
+    return gstd_pipeline_bulk_set_state (session->pipelines, args,
+        "paused", response);
+  }
+
   uri = g_strdup_printf ("/pipelines/%s/state paused", args);
   ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
   g_free (uri);
@@ -417,6 +551,11 @@ gstd_parser_pipeline_stop (GstdSession * session, gchar * action, gchar * args,
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
+  if (gstd_pipeline_bulk_is_bulk (args)) {
+    return gstd_pipeline_bulk_set_state (session->pipelines, args,
+        "null", response);
+  }
+
   uri = g_strdup_printf ("/pipelines/%s/state null", args);
   ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
   g_free (uri);
@@ -476,77 +615,114 @@ gstd_parser_pipeline_verbose (GstdSession * session, gchar * action,
 }
 
 static GstdReturnCode
-gstd_parser_element_set (GstdSession * session, gchar * action, gchar * args,
-    gchar ** response)
+gstd_parser_pipeline_create_from_pool (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
 {
-  GstdReturnCode ret;
-  gchar *uri;
-  gchar **tokens;
-
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
-  tokens = g_strsplit (args, " ", 4);
-  check_argument (tokens[0], GSTD_BAD_COMMAND);
-  check_argument (tokens[1], GSTD_BAD_COMMAND);
-  check_argument (tokens[2], GSTD_BAD_COMMAND);
-  check_argument (tokens[3], GSTD_BAD_COMMAND);
-
-  uri = g_strdup_printf ("/pipelines/%s/elements/%s/properties/%s %s",
-      tokens[0], tokens[1], tokens[2], tokens[3]);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+  return gstd_parser_pipeline_from_pool (session, args, FALSE, response);
+}
 
-  g_free (uri);
-  g_strfreev (tokens);
+static GstdReturnCode
+gstd_parser_pipeline_play_from_pool (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
-  return ret;
+  return gstd_parser_pipeline_from_pool (session, args, TRUE, response);
 }
 
 static GstdReturnCode
-gstd_parser_element_get (GstdSession * session, gchar * action, gchar * args,
-    gchar ** response)
+gstd_parser_pipeline_from_pool (GstdSession * session, gchar * args,
+    gboolean play, gchar ** response)
 {
   GstdReturnCode ret;
+  GstdObject *pool;
+  GstdObject *existing;
+  GstdPipeline *pipeline;
   gchar *uri;
   gchar **tokens;
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
-  tokens = g_strsplit (args, " ", 3);
+  // Tokens has the form {<name>, <pool>}
+  tokens = g_strsplit (args, " ", 2);
   check_argument (tokens[0], GSTD_BAD_COMMAND);
   check_argument (tokens[1], GSTD_BAD_COMMAND);
-  check_argument (tokens[2], GSTD_BAD_COMMAND);
 
-  uri = g_strdup_printf ("/pipelines/%s/elements/%s/properties/%s",
-      tokens[0], tokens[1], tokens[2]);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+  /* Don't waste a warm instance on a name that is already taken */
+  existing = gstd_list_find_child (session->pipelines, tokens[0]);
+  if (existing) {
+    g_object_unref (existing);
+    GST_ERROR_OBJECT (session, "The pipeline \"%s\" already exists",
+        tokens[0]);
+    ret = GSTD_EXISTING_RESOURCE;
+    goto out;
+  }
 
+  uri = g_strdup_printf ("/pools/%s", tokens[1]);
+  ret = gstd_get_by_uri (session, uri, &pool);
   g_free (uri);
-  g_strfreev (tokens);
+  if (ret)
+    goto out;
 
-  return ret;
+  if (!GSTD_IS_PIPELINE_POOL (pool)) {
+    GST_ERROR_OBJECT (session, "\"%s\" is not a pipeline pool", tokens[1]);
+    g_object_unref (pool);
+    ret = GSTD_NO_RESOURCE;
+    goto out;
+  }
+
+  ret = gstd_pipeline_pool_take (GSTD_PIPELINE_POOL (pool), tokens[0],
+      &pipeline);
+  g_object_unref (pool);
+  if (ret)
+    goto out;
+
+  if (!gstd_list_append_child (session->pipelines, GSTD_OBJECT (pipeline))) {
+    g_object_unref (pipeline);
+    ret = GSTD_EXISTING_RESOURCE;
+    goto out;
+  }
+
+  if (play) {
+    uri = g_strdup_printf ("/pipelines/%s/state playing", tokens[0]);
+    ret =
+        gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+    g_free (uri);
+  } else {
+    ret = gstd_object_to_string (GSTD_OBJECT (pipeline), response);
+  }
+
+out:
+  {
+    g_strfreev (tokens);
+    return ret;
+  }
 }
 
 static GstdReturnCode
-gstd_parser_list_pipelines (GstdSession * session, gchar * action, gchar * args,
-    gchar ** response)
+gstd_parser_pool_create (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
 
-  uri = g_strdup_printf ("/pipelines");
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+  uri = g_strdup_printf ("/pools %s", args ? args : "");
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
   g_free (uri);
 
   return ret;
 }
 
 static GstdReturnCode
-gstd_parser_list_elements (GstdSession * session, gchar * action, gchar * args,
-    gchar ** response)
+gstd_parser_pool_delete (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
@@ -554,15 +730,15 @@ gstd_parser_list_elements (GstdSession * session, gchar * action, gchar * args,
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
-  uri = g_strdup_printf ("/pipelines/%s/elements/", args);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+  uri = g_strdup_printf ("/pools %s", args);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "delete", uri, response);
   g_free (uri);
 
   return ret;
 }
 
 static GstdReturnCode
-gstd_parser_list_properties (GstdSession * session, gchar * action,
+gstd_parser_pool_size (GstdSession * session, gchar * action,
     gchar * args, gchar ** response)
 {
   GstdReturnCode ret;
@@ -576,10 +752,8 @@ gstd_parser_list_properties (GstdSession * session, gchar * action,
   check_argument (tokens[0], GSTD_BAD_COMMAND);
   check_argument (tokens[1], GSTD_BAD_COMMAND);
 
-  uri =
-      g_strdup_printf ("/pipelines/%s/elements/%s/properties", tokens[0],
-      tokens[1]);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+  uri = g_strdup_printf ("/pools/%s/size %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
 
   g_free (uri);
   g_strfreev (tokens);
@@ -588,7 +762,7 @@ gstd_parser_list_properties (GstdSession * session, gchar * action,
 }
 
 static GstdReturnCode
-gstd_parser_list_signals (GstdSession * session, gchar * action, gchar * args,
+gstd_parser_element_set (GstdSession * session, gchar * action, gchar * args,
     gchar ** response)
 {
   GstdReturnCode ret;
@@ -598,14 +772,16 @@ gstd_parser_list_signals (GstdSession * session, gchar * action, gchar * args,
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
-  tokens = g_strsplit (args, " ", 2);
+  tokens = g_strsplit (args, " ", 4);
   check_argument (tokens[0], GSTD_BAD_COMMAND);
   check_argument (tokens[1], GSTD_BAD_COMMAND);
+  check_argument (tokens[2], GSTD_BAD_COMMAND);
+  check_argument (tokens[3], GSTD_BAD_COMMAND);
+  gstd_parser_element_path (&tokens[1]);
 
-  uri =
-      g_strdup_printf ("/pipelines/%s/elements/%s/signals", tokens[0],
-      tokens[1]);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+  uri = g_strdup_printf ("/pipelines/%s/elements/%s/properties/%s %s",
+      tokens[0], tokens[1], tokens[2], tokens[3]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
 
   g_free (uri);
   g_strfreev (tokens);
@@ -614,27 +790,35 @@ gstd_parser_list_signals (GstdSession * session, gchar * action, gchar * args,
 }
 
 static GstdReturnCode
-gstd_parser_bus_read (GstdSession * session, gchar * action,
-    gchar * pipeline, gchar ** response)
+gstd_parser_element_get (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
+  gchar **tokens;
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (pipeline, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
-  uri = g_strdup_printf ("/pipelines/%s/bus/message", pipeline);
+  tokens = g_strsplit (args, " ", 3);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+  check_argument (tokens[2], GSTD_BAD_COMMAND);
+  gstd_parser_element_path (&tokens[1]);
+
+  uri = g_strdup_printf ("/pipelines/%s/elements/%s/properties/%s",
+      tokens[0], tokens[1], tokens[2]);
   ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
 
   g_free (uri);
+  g_strfreev (tokens);
 
   return ret;
 }
 
 static GstdReturnCode
-gstd_parser_bus_filter (GstdSession * session, gchar * action,
-    gchar * args, gchar ** response)
+gstd_parser_element_ramp (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
@@ -642,14 +826,18 @@ gstd_parser_bus_filter (GstdSession * session, gchar * action,
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
 
-  tokens = g_strsplit (args, " ", 2);
+  tokens = g_strsplit (args, " ", 5);
   check_argument (tokens[0], GSTD_BAD_COMMAND);
   check_argument (tokens[1], GSTD_BAD_COMMAND);
+  check_argument (tokens[2], GSTD_BAD_COMMAND);
+  check_argument (tokens[3], GSTD_BAD_COMMAND);
+  check_argument (tokens[4], GSTD_BAD_COMMAND);
+  gstd_parser_element_path (&tokens[1]);
 
-  uri = g_strdup_printf ("/pipelines/%s/bus/types %s", tokens[0], tokens[1]);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+  uri = g_strdup_printf ("/pipelines/%s/elements/%s/properties/%s %s %s",
+      tokens[0], tokens[1], tokens[2], tokens[3], tokens[4]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
 
   g_free (uri);
   g_strfreev (tokens);
@@ -658,8 +846,8 @@ gstd_parser_bus_filter (GstdSession * session, gchar * action,
 }
 
 static GstdReturnCode
-gstd_parser_bus_timeout (GstdSession * session, gchar * action, gchar * args,
-    gchar ** response)
+gstd_parser_element_ramp_stop (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
@@ -667,14 +855,16 @@ gstd_parser_bus_timeout (GstdSession * session, gchar * action, gchar * args,
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
 
-  tokens = g_strsplit (args, " ", 2);
+  tokens = g_strsplit (args, " ", 3);
   check_argument (tokens[0], GSTD_BAD_COMMAND);
   check_argument (tokens[1], GSTD_BAD_COMMAND);
+  check_argument (tokens[2], GSTD_BAD_COMMAND);
+  gstd_parser_element_path (&tokens[1]);
 
-  uri = g_strdup_printf ("/pipelines/%s/bus/timeout %s", tokens[0], tokens[1]);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+  uri = g_strdup_printf ("/pipelines/%s/elements/%s/properties/%s control",
+      tokens[0], tokens[1], tokens[2]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "delete", uri, response);
 
   g_free (uri);
   g_strfreev (tokens);
@@ -683,27 +873,32 @@ gstd_parser_bus_timeout (GstdSession * session, gchar * action, gchar * args,
 }
 
 static GstdReturnCode
-gstd_parser_event_eos (GstdSession * session, gchar * action, gchar * pipeline,
+gstd_parser_element_batch (GstdSession * session, gchar * action, gchar * args,
     gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
+  gchar **tokens;
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (pipeline, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
-  uri = g_strdup_printf ("/pipelines/%s/event eos", pipeline);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/batch %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
 
   g_free (uri);
+  g_strfreev (tokens);
 
   return ret;
 }
 
 static GstdReturnCode
-gstd_parser_event_seek (GstdSession * session, gchar * action, gchar * args,
-    gchar ** response)
+gstd_parser_pipeline_schedule (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
@@ -711,13 +906,12 @@ gstd_parser_event_seek (GstdSession * session, gchar * action, gchar * args,
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
 
   tokens = g_strsplit (args, " ", 2);
   check_argument (tokens[0], GSTD_BAD_COMMAND);
-  // We don't check for the second token since we want to allow defaults
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
 
-  uri = g_strdup_printf ("/pipelines/%s/event seek %s", tokens[0], tokens[1]);
+  uri = g_strdup_printf ("/pipelines/%s/schedule %s", tokens[0], tokens[1]);
   ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
 
   g_free (uri);
@@ -727,27 +921,32 @@ gstd_parser_event_seek (GstdSession * session, gchar * action, gchar * args,
 }
 
 static GstdReturnCode
-gstd_parser_event_flush_start (GstdSession * session, gchar * action,
-    gchar * pipeline, gchar ** response)
+gstd_parser_pipeline_unschedule (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
+  gchar **tokens;
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (pipeline, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
-  uri = g_strdup_printf ("/pipelines/%s/event flush_start", pipeline);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/schedule %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "delete", uri, response);
 
   g_free (uri);
+  g_strfreev (tokens);
 
   return ret;
 }
 
 static GstdReturnCode
-gstd_parser_event_flush_stop (GstdSession * session, gchar * action,
-    gchar * args, gchar ** response)
+gstd_parser_rule_create (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
@@ -755,15 +954,12 @@ gstd_parser_event_flush_stop (GstdSession * session, gchar * action,
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
 
   tokens = g_strsplit (args, " ", 2);
   check_argument (tokens[0], GSTD_BAD_COMMAND);
-  // We don't check for the second token since we want to allow defaults
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
 
-  uri =
-      g_strdup_printf ("/pipelines/%s/event flush_stop %s", tokens[0],
-      tokens[1]);
+  uri = g_strdup_printf ("/pipelines/%s/rules %s", tokens[0], tokens[1]);
   ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
 
   g_free (uri);
@@ -773,77 +969,842 @@ gstd_parser_event_flush_stop (GstdSession * session, gchar * action,
 }
 
 static GstdReturnCode
-gstd_parser_debug_enable (GstdSession * session, gchar * action,
-    gchar * enabled, gchar ** response)
+gstd_parser_rule_delete (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
+  gchar **tokens;
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
-  check_argument (enabled, GSTD_BAD_COMMAND);
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
 
-  uri = g_strdup_printf ("/debug/enable %s", enabled);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+  uri = g_strdup_printf ("/pipelines/%s/rules %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "delete", uri, response);
 
   g_free (uri);
+  g_strfreev (tokens);
 
   return ret;
 }
 
 static GstdReturnCode
-gstd_parser_debug_threshold (GstdSession * session, gchar * action,
-    gchar * threshold, gchar ** response)
+gstd_parser_sync_group_create (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
-
-  check_argument (threshold, GSTD_BAD_COMMAND);
-
-  uri = g_strdup_printf ("/debug/threshold %s", threshold);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
 
+  uri = g_strdup_printf ("/groups %s", args ? args : "");
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
   g_free (uri);
 
   return ret;
 }
 
 static GstdReturnCode
-gstd_parser_debug_color (GstdSession * session, gchar * action, gchar * colored,
-    gchar ** response)
+gstd_parser_sync_group_delete (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
-
-  check_argument (colored, GSTD_BAD_COMMAND);
-
-  uri = g_strdup_printf ("/debug/color %s", colored);
-  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
+  uri = g_strdup_printf ("/groups %s", args);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "delete", uri, response);
   g_free (uri);
 
   return ret;
 }
 
-
 static GstdReturnCode
-gstd_parser_debug_reset (GstdSession * session, gchar * action, gchar * reset,
-    gchar ** response)
+gstd_parser_sync_group_play (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
 {
   GstdReturnCode ret;
   gchar *uri;
 
   g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
 
-  check_argument (reset, GSTD_BAD_COMMAND);
+  uri = g_strdup_printf ("/groups/%s play", args);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+  g_free (uri);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_sync_group_stop (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  uri = g_strdup_printf ("/groups/%s stop", args);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+  g_free (uri);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_link_create (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+
+  uri = g_strdup_printf ("/links %s", args ? args : "");
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+  g_free (uri);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_link_delete (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  uri = g_strdup_printf ("/links %s", args);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "delete", uri, response);
+  g_free (uri);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_recording_start (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/recordings %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_recording_stop (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/recordings %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "delete", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_element_create (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/elements %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_element_delete (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/elements %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "delete", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_element_link (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/topology link %s", tokens[0],
+      tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_element_unlink (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/topology unlink %s", tokens[0],
+      tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_endpoint_create (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/endpoints %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_endpoint_delete (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/endpoints %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "delete", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_element_snapshot (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 3);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+  gstd_parser_element_path (&tokens[1]);
+
+  uri = g_strdup_printf ("/pipelines/%s/elements/%s/snapshot/%s",
+      tokens[0], tokens[1], tokens[2] ? tokens[2] : "format=jpeg");
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_telemetry_create (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/telemetry %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_telemetry_read (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 3);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/telemetry/%s/%s", tokens[0],
+      tokens[1], tokens[2] ? tokens[2] : "all");
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_telemetry_delete (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/telemetry %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "delete", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_list_pipelines (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+
+  uri = g_strdup_printf ("/pipelines");
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+  g_free (uri);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_list_elements (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  uri = g_strdup_printf ("/pipelines/%s/elements/", args);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+  g_free (uri);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_list_properties (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+  gstd_parser_element_path (&tokens[1]);
+
+  uri =
+      g_strdup_printf ("/pipelines/%s/elements/%s/properties", tokens[0],
+      tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_list_signals (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+  gstd_parser_element_path (&tokens[1]);
+
+  uri =
+      g_strdup_printf ("/pipelines/%s/elements/%s/signals", tokens[0],
+      tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_bus_read (GstdSession * session, gchar * action,
+    gchar * pipeline, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (pipeline, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  uri = g_strdup_printf ("/pipelines/%s/bus/message", pipeline);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "read", uri, response);
+
+  g_free (uri);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_bus_filter (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/bus/types %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_bus_timeout (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/bus/timeout %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_bus_policy (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/bus/policy %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_event_eos (GstdSession * session, gchar * action, gchar * pipeline,
+    gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (pipeline, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  uri = g_strdup_printf ("/pipelines/%s/event eos", pipeline);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+
+  g_free (uri);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_event_seek (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  // We don't check for the second token since we want to allow defaults
+
+  uri = g_strdup_printf ("/pipelines/%s/event seek %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_event_rate (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/pipelines/%s/event rate %s", tokens[0], tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_event_force_key_unit (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar *target;
+  gchar **tokens;
+  gchar **options;
+  gchar **names;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  // The target and the options are optional
+
+  options = g_strsplit (tokens[1] ? tokens[1] : "", " ", 2);
+
+  /* Without a target the event is sent to the whole pipeline */
+  if (!options[0] || !g_ascii_strcasecmp (options[0], "upstream") ||
+      !g_ascii_strcasecmp (options[0], "downstream")) {
+    target = g_strdup_printf ("/pipelines/%s", tokens[0]);
+    uri = g_strdup_printf ("%s/event force_key_unit %s", target,
+        tokens[1] ? tokens[1] : "");
+  } else {
+    names = g_strsplit (options[0], ".", 2);
+    gstd_parser_element_path (&names[0]);
+    if (names[1]) {
+      target = g_strdup_printf ("/pipelines/%s/elements/%s/pads/%s",
+          tokens[0], names[0], names[1]);
+    } else {
+      target = g_strdup_printf ("/pipelines/%s/elements/%s", tokens[0],
+          names[0]);
+    }
+    g_strfreev (names);
+    uri = g_strdup_printf ("%s/event force_key_unit %s", target,
+        options[1] ? options[1] : "");
+  }
+
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+
+  g_free (uri);
+  g_free (target);
+  g_strfreev (options);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_event_flush_start (GstdSession * session, gchar * action,
+    gchar * pipeline, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (pipeline, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  uri = g_strdup_printf ("/pipelines/%s/event flush_start", pipeline);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+
+  g_free (uri);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_event_flush_stop (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+  gchar **tokens;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  tokens = g_strsplit (args, " ", 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  // We don't check for the second token since we want to allow defaults
+
+  uri =
+      g_strdup_printf ("/pipelines/%s/event flush_stop %s", tokens[0],
+      tokens[1]);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "create", uri, response);
+
+  g_free (uri);
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_debug_enable (GstdSession * session, gchar * action,
+    gchar * enabled, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  check_argument (enabled, GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/debug/enable %s", enabled);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+
+  g_free (uri);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_debug_threshold (GstdSession * session, gchar * action,
+    gchar * threshold, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  check_argument (threshold, GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/debug/threshold %s", threshold);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+
+  g_free (uri);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_debug_color (GstdSession * session, gchar * action, gchar * colored,
+    gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  check_argument (colored, GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/debug/color %s", colored);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+
+  g_free (uri);
+
+  return ret;
+}
+
+
+static GstdReturnCode
+gstd_parser_debug_reset (GstdSession * session, gchar * action, gchar * reset,
+    gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  check_argument (reset, GSTD_BAD_COMMAND);
 
   uri = g_strdup_printf ("/debug/reset %s", reset);
   ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
@@ -853,6 +1814,26 @@ gstd_parser_debug_reset (GstdSession * session, gchar * action, gchar * reset,
   return ret;
 }
 
+static GstdReturnCode
+gstd_parser_debug_tracers (GstdSession * session, gchar * action,
+    gchar * tracers, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar *uri;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  check_argument (tracers, GSTD_BAD_COMMAND);
+
+  uri = g_strdup_printf ("/debug/tracers %s", tracers);
+  ret = gstd_parser_parse_raw_cmd (session, (gchar *) "update", uri, response);
+
+  g_free (uri);
+
+  return ret;
+}
+
 
 static GstdReturnCode
 gstd_parser_signal_connect (GstdSession * session, gchar * action,
@@ -870,6 +1851,7 @@ gstd_parser_signal_connect (GstdSession * session, gchar * action,
   check_argument (tokens[0], GSTD_BAD_COMMAND);
   check_argument (tokens[1], GSTD_BAD_COMMAND);
   check_argument (tokens[2], GSTD_BAD_COMMAND);
+  gstd_parser_element_path (&tokens[1]);
 
   uri = g_strdup_printf ("/pipelines/%s/elements/%s/signals/%s/callback",
       tokens[0], tokens[1], tokens[2]);
@@ -898,6 +1880,7 @@ gstd_parser_signal_disconnect (GstdSession * session, gchar * action,
   check_argument (tokens[0], GSTD_BAD_COMMAND);
   check_argument (tokens[1], GSTD_BAD_COMMAND);
   check_argument (tokens[2], GSTD_BAD_COMMAND);
+  gstd_parser_element_path (&tokens[1]);
 
   uri = g_strdup_printf ("/pipelines/%s/elements/%s/signals/%s/disconnect",
       tokens[0], tokens[1], tokens[2]);
@@ -928,6 +1911,7 @@ gstd_parser_signal_timeout (GstdSession * session, gchar * action, gchar * args,
   check_argument (tokens[1], GSTD_BAD_COMMAND);
   check_argument (tokens[2], GSTD_BAD_COMMAND);
   check_argument (tokens[3], GSTD_BAD_COMMAND);
+  gstd_parser_element_path (&tokens[1]);
 
   uri = g_strdup_printf ("/pipelines/%s/elements/%s/signals/%s/timeout %s",
       tokens[0], tokens[1], tokens[2], tokens[3]);
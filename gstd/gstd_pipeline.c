@@ -33,6 +33,22 @@
 #include "gstd_list_reader.h"
 #include "gstd_property_reader.h"
 #include "gstd_state.h"
+#include "gstd_task_pool.h"
+#include "gstd_pipeline_scheduling.h"
+#include "gstd_pipeline_stats.h"
+#include "gstd_pipeline_watchdog.h"
+#include "gstd_pipeline_batch.h"
+#include "gstd_pipeline_schedule.h"
+#include "gstd_scheduled_command.h"
+#include "gstd_pipeline_rules.h"
+#include "gstd_pipeline_rule.h"
+#include "gstd_pipeline_recorder.h"
+#include "gstd_pipeline_recording.h"
+#include "gstd_pipeline_topology.h"
+#include "gstd_pipeline_dataplane.h"
+#include "gstd_pipeline_endpoint.h"
+#include "gstd_pipeline_telemetry.h"
+#include "gstd_telemetry_series.h"
 
 enum
 {
@@ -45,6 +61,19 @@ enum
   PROP_DURATION,
   PROP_GRAPH,
   PROP_VERBOSE,
+  PROP_TASK_POOL,
+  PROP_SCHEDULING,
+  PROP_STATS,
+  PROP_PAD_STATS,
+  PROP_WATCHDOG,
+  PROP_LOOP,
+  PROP_BATCH,
+  PROP_SCHEDULE,
+  PROP_RULES,
+  PROP_RECORDINGS,
+  PROP_TOPOLOGY,
+  PROP_ENDPOINTS,
+  PROP_TELEMETRY,
   N_PROPERTIES                  // NOT A PROPERTY
 };
 
@@ -52,6 +81,9 @@ enum
 #define GSTD_PIPELINE_DEFAULT_STATE GSTD_PIPELINE_NULL
 #define GSTD_PIPELINE_DEFAULT_GRAPH NULL
 #define GSTD_PIPELINE_DEFAULT_VERBOSE FALSE
+#define GSTD_PIPELINE_DEFAULT_TASK_POOL GSTD_TASK_POOL_POLICY_DEFAULT
+#define GSTD_PIPELINE_DEFAULT_PAD_STATS FALSE
+#define GSTD_PIPELINE_DEFAULT_LOOP FALSE
 
 /* Gstd Pipeline debugging category */
 GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_debug);
@@ -61,6 +93,14 @@ GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_debug);
 
 #define FB_NAME "pipeline%d"
 
+/* Exchanges a published part of the pipeline with a new one, must be
+   called with the object lock held */
+#define gstd_pipeline_swap(field, value) G_STMT_START { \
+    gpointer _previous = (field);                       \
+    (field) = (value);                                  \
+    (value) = _previous;                                \
+  } G_STMT_END
+
 /**
  * GstdPipeline:
  * A wrapper for the conventional pipeline
@@ -120,6 +160,97 @@ struct _GstdPipeline
    * Id to enable/disable deep notify logging (similar to adding -v to get-launch-1.0)
    */
   gulong deep_notify_id;
+
+  /**
+   * Where the streaming threads of the pipeline are taken from
+   */
+  GstdTaskPoolPolicy task_pool;
+
+  /**
+   * The CPU set and priorities of the streaming threads
+   */
+  GstdPipelineScheduling *scheduling;
+
+  /**
+   * The runtime statistics of the pipeline
+   */
+  GstdPipelineStats *stats;
+
+  /**
+   * Whether the buffer flow of every source pad is measured
+   */
+  gboolean pad_stats;
+
+  /**
+   * Detects stalls and errors and recovers the pipeline from them
+   */
+  GstdPipelineWatchdog *watchdog;
+
+  /**
+   * Whether the media is looped with segment seeks
+   */
+  gboolean loop;
+
+  /**
+   * Whether the looping segment seek was already issued
+   */
+  gboolean loop_armed;
+
+  /**
+   * Sequence number of the last looping segment seek, to tell the
+   * ASYNC_DONE it causes apart from the ones of client seeks
+   */
+  guint loop_seqnum;
+
+  /**
+   * Whether the clock and base time are imposed by a sync group
+   */
+  gboolean synced;
+
+  /**
+   * Property updates applied together at a buffer boundary
+   */
+  GstdPipelineBatch *batch;
+
+  /**
+   * Commands executed by the daemon at a given deadline, and their
+   * creator/deleter
+   */
+  GstdList *schedule;
+  GstdPipelineSchedule *scheduler;
+
+  /**
+   * Commands run by the daemon on messages and signals, and their
+   * creator/deleter
+   */
+  GstdList *rules;
+  GstdPipelineRules *ruler;
+
+  /**
+   * Branches attached to tees while running, and their creator/deleter
+   */
+  GstdList *recordings;
+  GstdPipelineRecorder *recorder;
+
+  /**
+   * Links and unlinks elements, and adds and removes them through the
+   * element list
+   */
+  GstdPipelineTopology *topology;
+
+  /**
+   * Shared memory rings feeding from appsinks or into appsrcs, and
+   * their creator/deleter
+   */
+  GstdList *endpoints;
+  GstdPipelineDataplane *dataplane;
+
+  /**
+   * Element properties sampled into in-memory time series, and their
+   * creator/deleter
+   */
+  GstdList *telemetry;
+  GstdPipelineTelemetry *sampler;
 };
 
 struct _GstdPipelineClass
@@ -136,9 +267,21 @@ static void
 gstd_pipeline_set_property (GObject *, guint, const GValue *, GParamSpec *);
 static void gstd_pipeline_dispose (GObject *);
 static GstdReturnCode
-gstd_pipeline_create (GstdPipeline *, const gchar *, gint, const gchar *);
+gstd_pipeline_create (GstdPipeline *, const gchar *, gint, const gchar *,
+    GstdList *, GstElement **);
 static GstdReturnCode gstd_pipeline_fill_elements (GstdPipeline *,
-    GstElement *);
+    GstdList *, GstElement *);
+static GstBusSyncReply gstd_pipeline_bus_sync_handler (GstBus *, GstMessage *,
+    gpointer);
+static void gstd_pipeline_stream_status (GstdPipeline *, GstMessage *);
+static void gstd_pipeline_set_pad_stats (GstdPipeline *, gboolean);
+static GstdList *gstd_pipeline_elements_new (GstdPipeline *);
+static void gstd_pipeline_teardown (GstdPipeline *);
+static void gstd_pipeline_release (GstdPipeline *);
+static GstElement *gstd_pipeline_ref_pipeline (GstdPipeline *);
+static GstdPipelineBus *gstd_pipeline_ref_bus (GstdPipeline *);
+static gboolean gstd_pipeline_loop_arm (gpointer);
+static gboolean gstd_pipeline_loop_restart (gpointer);
 
 static void
 gstd_pipeline_class_init (GstdPipelineClass * klass)
@@ -203,6 +346,97 @@ gstd_pipeline_class_init (GstdPipelineClass * klass)
       "Verbose state for the media stream pipeline",
       GSTD_PIPELINE_DEFAULT_VERBOSE, G_PARAM_READWRITE | GSTD_PARAM_READ);
 
+  properties[PROP_TASK_POOL] =
+      g_param_spec_enum ("task-pool", "Task Pool",
+      "Where the streaming threads of the pipeline are taken from. "
+      "Changes apply to the streaming tasks created afterwards",
+      GSTD_TYPE_TASK_POOL_POLICY, GSTD_PIPELINE_DEFAULT_TASK_POOL,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_SCHEDULING] =
+      g_param_spec_object ("scheduling", "Scheduling",
+      "The CPU set and priorities of the streaming threads",
+      GSTD_TYPE_PIPELINE_SCHEDULING,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_STATS] =
+      g_param_spec_object ("stats", "Stats",
+      "The runtime statistics of the pipeline",
+      GSTD_TYPE_PIPELINE_STATS,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_PAD_STATS] =
+      g_param_spec_boolean ("pad-stats", "Pad Stats",
+      "Measure the buffer flow of every source pad in the pipeline",
+      GSTD_PIPELINE_DEFAULT_PAD_STATS,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_WATCHDOG] =
+      g_param_spec_object ("watchdog", "Watchdog",
+      "Detects stalls and errors and recovers the pipeline from them",
+      GSTD_TYPE_PIPELINE_WATCHDOG,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_LOOP] =
+      g_param_spec_boolean ("loop", "Loop",
+      "Loop the media seamlessly, using segment seeks handled by the daemon",
+      GSTD_PIPELINE_DEFAULT_LOOP,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_BATCH] =
+      g_param_spec_object ("batch", "Batch",
+      "Property updates applied together at the next buffer or at a "
+      "running time",
+      GSTD_TYPE_PIPELINE_BATCH,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_SCHEDULE] =
+      g_param_spec_object ("schedule", "Schedule",
+      "Commands executed by the daemon at a running time or wall clock "
+      "deadline",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_CREATE |
+      GSTD_PARAM_READ | GSTD_PARAM_DELETE);
+
+  properties[PROP_RULES] =
+      g_param_spec_object ("rules", "Rules",
+      "Commands run by the daemon when a message is posted or a signal "
+      "is emitted",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_CREATE |
+      GSTD_PARAM_READ | GSTD_PARAM_DELETE);
+
+  properties[PROP_RECORDINGS] =
+      g_param_spec_object ("recordings", "Recordings",
+      "Branches attached to a tee of the running pipeline",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_CREATE |
+      GSTD_PARAM_READ | GSTD_PARAM_DELETE);
+
+  properties[PROP_TOPOLOGY] =
+      g_param_spec_object ("topology", "Topology",
+      "Links and unlinks the elements of the running pipeline",
+      GSTD_TYPE_PIPELINE_TOPOLOGY,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_ENDPOINTS] =
+      g_param_spec_object ("endpoints", "Endpoints",
+      "Shared memory rings other processes exchange data through",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_CREATE |
+      GSTD_PARAM_READ | GSTD_PARAM_DELETE);
+
+  properties[PROP_TELEMETRY] =
+      g_param_spec_object ("telemetry", "Telemetry",
+      "Element properties sampled at a fixed interval into time series",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_CREATE |
+      GSTD_PARAM_READ | GSTD_PARAM_DELETE);
+
   g_object_class_install_properties (object_class, N_PROPERTIES, properties);
 
   /* Initialize debug category with nice colors */
@@ -222,12 +456,69 @@ gstd_pipeline_init (GstdPipeline * self)
   self->state = NULL;
   self->graph = NULL;
   self->deep_notify_id = 0;
-
-  self->elements = g_object_new (GSTD_TYPE_LIST, "name", "elements",
-      "node-type", GSTD_TYPE_ELEMENT, "flags", GSTD_PARAM_READ, NULL);
-
-  gstd_object_set_reader (GSTD_OBJECT (self->elements),
+  self->task_pool = GSTD_PIPELINE_DEFAULT_TASK_POOL;
+  self->scheduling = gstd_pipeline_scheduling_new ();
+  self->stats = gstd_pipeline_stats_new ();
+  self->pad_stats = GSTD_PIPELINE_DEFAULT_PAD_STATS;
+  self->watchdog = gstd_pipeline_watchdog_new (self);
+  self->loop = GSTD_PIPELINE_DEFAULT_LOOP;
+  self->loop_armed = FALSE;
+  self->loop_seqnum = 0;
+  self->synced = FALSE;
+  self->batch = gstd_pipeline_batch_new ();
+  self->scheduler = gstd_pipeline_schedule_new ();
+  self->schedule = g_object_new (GSTD_TYPE_LIST, "name", "schedule",
+      "node-type", GSTD_TYPE_SCHEDULED_COMMAND, "flags",
+      GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_DELETE, NULL);
+  gstd_object_set_creator (GSTD_OBJECT (self->schedule),
+      GSTD_ICREATOR (g_object_ref (self->scheduler)));
+  gstd_object_set_reader (GSTD_OBJECT (self->schedule),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+  gstd_object_set_deleter (GSTD_OBJECT (self->schedule),
+      GSTD_IDELETER (g_object_ref (self->scheduler)));
+  self->ruler = gstd_pipeline_rules_new ();
+  self->rules = g_object_new (GSTD_TYPE_LIST, "name", "rules",
+      "node-type", GSTD_TYPE_PIPELINE_RULE, "flags",
+      GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_DELETE, NULL);
+  gstd_object_set_creator (GSTD_OBJECT (self->rules),
+      GSTD_ICREATOR (g_object_ref (self->ruler)));
+  gstd_object_set_reader (GSTD_OBJECT (self->rules),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+  gstd_object_set_deleter (GSTD_OBJECT (self->rules),
+      GSTD_IDELETER (g_object_ref (self->ruler)));
+  self->recorder = gstd_pipeline_recorder_new ();
+  self->recordings = g_object_new (GSTD_TYPE_LIST, "name", "recordings",
+      "node-type", GSTD_TYPE_PIPELINE_RECORDING, "flags",
+      GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_DELETE, NULL);
+  gstd_object_set_creator (GSTD_OBJECT (self->recordings),
+      GSTD_ICREATOR (g_object_ref (self->recorder)));
+  gstd_object_set_reader (GSTD_OBJECT (self->recordings),
       g_object_new (GSTD_TYPE_LIST_READER, NULL));
+  gstd_object_set_deleter (GSTD_OBJECT (self->recordings),
+      GSTD_IDELETER (g_object_ref (self->recorder)));
+  self->dataplane = gstd_pipeline_dataplane_new ();
+  self->endpoints = g_object_new (GSTD_TYPE_LIST, "name", "endpoints",
+      "node-type", GSTD_TYPE_PIPELINE_ENDPOINT, "flags",
+      GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_DELETE, NULL);
+  gstd_object_set_creator (GSTD_OBJECT (self->endpoints),
+      GSTD_ICREATOR (g_object_ref (self->dataplane)));
+  gstd_object_set_reader (GSTD_OBJECT (self->endpoints),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+  gstd_object_set_deleter (GSTD_OBJECT (self->endpoints),
+      GSTD_IDELETER (g_object_ref (self->dataplane)));
+  self->sampler = gstd_pipeline_telemetry_new ();
+  self->telemetry = g_object_new (GSTD_TYPE_LIST, "name", "telemetry",
+      "node-type", GSTD_TYPE_TELEMETRY_SERIES, "flags",
+      GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_DELETE, NULL);
+  gstd_object_set_creator (GSTD_OBJECT (self->telemetry),
+      GSTD_ICREATOR (g_object_ref (self->sampler)));
+  gstd_object_set_reader (GSTD_OBJECT (self->telemetry),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+  gstd_object_set_deleter (GSTD_OBJECT (self->telemetry),
+      GSTD_IDELETER (g_object_ref (self->sampler)));
+  self->topology = gstd_pipeline_topology_new ();
+  self->elements = gstd_pipeline_elements_new (self);
+
   gstd_object_set_reader (GSTD_OBJECT (self),
       g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
 }
@@ -237,44 +528,356 @@ gstd_pipeline_build (GstdPipeline * object)
 {
   GstdPipeline *self = object;
   GstdReturnCode ret;
+  GstElement *pipeline = NULL;
+  GstdList *elements;
+  GstdEventHandler *event_handler;
+  GstdPipelineBus *pipeline_bus;
+  GstdState *state;
+  GstBus *bus;
+  GstBin *bin;
+  GstdList *list;
+
+  elements = gstd_pipeline_elements_new (self);
 
   ret =
       gstd_pipeline_create (self, GSTD_OBJECT_NAME (self), 0,
-      self->description);
+      self->description, elements, &pipeline);
   if (GSTD_EOK != ret)
     goto out;
 
-  self->event_handler = gstd_event_handler_new (G_OBJECT (self->pipeline));
-  if (!self->event_handler) {
+  event_handler = gstd_event_handler_new (G_OBJECT (pipeline));
+  if (!event_handler) {
     ret = GSTD_BAD_VALUE;
-    goto out1;
+    goto out;
   }
 
-  self->pipeline_bus =
-      gstd_pipeline_bus_new (gst_pipeline_get_bus (GST_PIPELINE
-          (self->pipeline)));
+  bus = gst_pipeline_get_bus (GST_PIPELINE (pipeline));
+
+  /* Some messages need to be handled right away in the thread that
+     posted them, before they reach the bus queue */
+  gst_bus_set_sync_handler (bus, gstd_pipeline_bus_sync_handler, self, NULL);
 
-  if (!self->pipeline_bus) {
+  pipeline_bus = gstd_pipeline_bus_new (bus);
+
+  if (!pipeline_bus) {
     ret = GSTD_BAD_VALUE;
-    goto out2;
+    goto out1;
   }
 
-  goto out;
+  state = gstd_state_new (pipeline);
+  bin = GST_BIN (pipeline);
+  list = elements;
+
+  /* Published all at once. Readers in other threads take their own
+     references, so whatever was published before stays valid for them
+     after the swap */
+  GST_OBJECT_LOCK (self);
+  gstd_pipeline_swap (self->pipeline, pipeline);
+  gstd_pipeline_swap (self->elements, elements);
+  gstd_pipeline_swap (self->event_handler, event_handler);
+  gstd_pipeline_swap (self->pipeline_bus, pipeline_bus);
+  gstd_pipeline_swap (self->state, state);
+  self->deep_notify_id = 0;
+  GST_OBJECT_UNLOCK (self);
+
+  gstd_pipeline_stats_watch (self->stats, bin);
+  gstd_pipeline_watchdog_watch (self->watchdog, bin);
+  gstd_pipeline_batch_watch (self->batch, bin);
+  gstd_pipeline_schedule_watch (self->scheduler, bin);
+  gstd_pipeline_rules_watch (self->ruler, bin);
+  gstd_pipeline_recorder_watch (self->recorder, bin);
+  gstd_pipeline_topology_watch (self->topology, bin, list);
+  gstd_pipeline_dataplane_watch (self->dataplane, bin);
+  gstd_pipeline_telemetry_watch (self->sampler, bin);
+
+  /* The previous parts, already torn down if this is a rebuild */
+  if (pipeline) {
+    gst_object_unref (pipeline);
+  }
+  g_object_unref (elements);
+  if (event_handler) {
+    g_object_unref (event_handler);
+  }
+  if (pipeline_bus) {
+    g_object_unref (pipeline_bus);
+  }
+  if (state) {
+    g_object_unref (state);
+  }
 
-out2:
-  g_object_unref (self->event_handler);
-  self->event_handler = NULL;
+  return GSTD_EOK;
 
 out1:
-  g_object_unref (self->elements);
-  self->elements = NULL;
-  g_object_unref (self->pipeline);
-  self->pipeline = NULL;
+  gst_bus_set_sync_handler (bus, NULL, NULL, NULL);
+  gst_object_unref (bus);
+  g_object_unref (event_handler);
 
 out:
+  g_object_unref (elements);
+  if (pipeline) {
+    gst_object_unref (pipeline);
+  }
   return ret;
 }
 
+GstdReturnCode
+gstd_pipeline_rename (GstdPipeline * object, const gchar * name)
+{
+  GstdPipeline *self = object;
+  GstElement *pipeline;
+  gboolean renamed;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (name, GSTD_NULL_ARGUMENT);
+
+  pipeline = gstd_pipeline_ref_pipeline (self);
+  g_return_val_if_fail (pipeline, GSTD_MISSING_INITIALIZATION);
+
+  /* Top level pipelines are never parented, so this shouldn't fail */
+  renamed = gst_object_set_name (GST_OBJECT (pipeline), name);
+  gst_object_unref (pipeline);
+
+  if (!renamed) {
+    GST_ERROR_OBJECT (self, "Unable to rename pipeline to \"%s\"", name);
+    return GSTD_BAD_VALUE;
+  }
+
+  GST_INFO_OBJECT (self, "Renaming pipeline \"%s\" to \"%s\"",
+      GSTD_OBJECT_NAME (self), name);
+
+  g_free (GSTD_OBJECT_NAME (self));
+  GSTD_OBJECT_NAME (self) = g_strdup (name);
+
+  return GSTD_EOK;
+}
+
+GstdReturnCode
+gstd_pipeline_rebuild (GstdPipeline * object)
+{
+  GstdPipeline *self = object;
+  GstdReturnCode ret;
+  GstElement *pipeline;
+  GstState target;
+  gboolean verbose;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (self->description, GSTD_MISSING_INITIALIZATION);
+
+  GST_INFO_OBJECT (self, "Rebuilding pipeline \"%s\"", GSTD_OBJECT_NAME (self));
+
+  target = GST_STATE_NULL;
+  pipeline = gstd_pipeline_ref_pipeline (self);
+  if (pipeline) {
+    /* Client state changes on the old pipeline wait for the rebuild
+       to complete, and are not lost in the middle of it */
+    GST_STATE_LOCK (pipeline);
+    GST_OBJECT_LOCK (pipeline);
+    target = GST_STATE_TARGET (pipeline);
+    GST_OBJECT_UNLOCK (pipeline);
+  }
+
+  GST_OBJECT_LOCK (self);
+  verbose = 0 != self->deep_notify_id;
+  GST_OBJECT_UNLOCK (self);
+
+  /* The old pipeline stays published, stopped, until the new one
+     replaces it. Clients find the new elements under the same names */
+  gstd_pipeline_teardown (self);
+
+  ret = gstd_pipeline_build (self);
+
+  if (pipeline) {
+    GST_STATE_UNLOCK (pipeline);
+    gst_object_unref (pipeline);
+  }
+
+  if (GSTD_EOK != ret) {
+    GST_ERROR_OBJECT (self, "Unable to rebuild pipeline \"%s\"",
+        GSTD_OBJECT_NAME (self));
+    return ret;
+  }
+
+  gstd_pipeline_set_pad_stats (self, self->pad_stats);
+
+  pipeline = gstd_pipeline_ref_pipeline (self);
+
+#if GST_VERSION_MINOR >= 10
+  if (verbose) {
+    GST_OBJECT_LOCK (self);
+    self->deep_notify_id =
+        gst_element_add_property_deep_notify_watch (pipeline, NULL, TRUE);
+    GST_OBJECT_UNLOCK (self);
+  }
+#endif
+
+  if (GST_STATE_NULL != target &&
+      GST_STATE_CHANGE_FAILURE == gst_element_set_state (pipeline, target)) {
+    GST_ERROR_OBJECT (self, "Unable to restore the state of \"%s\"",
+        GSTD_OBJECT_NAME (self));
+    ret = GSTD_STATE_ERROR;
+  }
+  gst_object_unref (pipeline);
+
+  return ret;
+}
+
+GstdReturnCode
+gstd_pipeline_set_sync (GstdPipeline * object, GstClock * clock,
+    GstClockTime base_time)
+{
+  GstdPipeline *self = object;
+  GstElement *pipeline;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE (self), GSTD_NULL_ARGUMENT);
+
+  pipeline = gstd_pipeline_ref_pipeline (self);
+  if (!pipeline) {
+    GST_ERROR_OBJECT (self, "No pipeline to synchronize");
+    return GSTD_NO_PIPELINE;
+  }
+
+  g_atomic_int_set (&self->synced, NULL != clock);
+
+  if (!clock) {
+    GST_INFO_OBJECT (self, "Releasing the clock of \"%s\"",
+        GSTD_OBJECT_NAME (self));
+    gst_pipeline_auto_clock (GST_PIPELINE (pipeline));
+    gst_element_set_start_time (pipeline, 0);
+    gst_object_unref (pipeline);
+    return GSTD_EOK;
+  }
+
+  GST_INFO_OBJECT (self, "Slaving \"%s\" to %" GST_PTR_FORMAT
+      " with base time %" GST_TIME_FORMAT, GSTD_OBJECT_NAME (self), clock,
+      GST_TIME_ARGS (base_time));
+
+  /* Without a start time the pipeline keeps the base time we
+     distribute instead of picking its own on every PLAYING */
+  gst_pipeline_use_clock (GST_PIPELINE (pipeline), clock);
+  gst_element_set_start_time (pipeline, GST_CLOCK_TIME_NONE);
+  gst_element_set_base_time (pipeline, base_time);
+  gst_object_unref (pipeline);
+
+  return GSTD_EOK;
+}
+
+static GstdList *
+gstd_pipeline_elements_new (GstdPipeline * self)
+{
+  GstdList *elements;
+
+  elements = g_object_new (GSTD_TYPE_LIST, "name", "elements",
+      "node-type", GSTD_TYPE_ELEMENT, "flags",
+      GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_DELETE, NULL);
+
+  gstd_object_set_creator (GSTD_OBJECT (elements),
+      GSTD_ICREATOR (g_object_ref (self->topology)));
+  gstd_object_set_reader (GSTD_OBJECT (elements),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+  gstd_object_set_deleter (GSTD_OBJECT (elements),
+      GSTD_IDELETER (g_object_ref (self->topology)));
+
+  return elements;
+}
+
+/* Stops the GStreamer pipeline and the daemon features watching it.
+   The pipeline stays published until replaced or released */
+static void
+gstd_pipeline_teardown (GstdPipeline * self)
+{
+  GstElement *pipeline;
+  GstBus *bus;
+
+  pipeline = gstd_pipeline_ref_pipeline (self);
+  if (!pipeline) {
+    return;
+  }
+
+  bus = gst_pipeline_get_bus (GST_PIPELINE (pipeline));
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+
+  gstd_pipeline_watchdog_unwatch (self->watchdog);
+  gstd_pipeline_batch_unwatch (self->batch);
+  gstd_pipeline_schedule_unwatch (self->scheduler);
+  gstd_pipeline_rules_unwatch (self->ruler);
+  gstd_pipeline_recorder_unwatch (self->recorder);
+  gstd_pipeline_topology_unwatch (self->topology);
+  gstd_pipeline_dataplane_unwatch (self->dataplane);
+  gstd_pipeline_telemetry_unwatch (self->sampler);
+  gstd_pipeline_stats_unwatch (self->stats);
+  gst_bus_set_sync_handler (bus, NULL, NULL, NULL);
+  gst_object_unref (bus);
+
+  gst_object_unref (pipeline);
+}
+
+static void
+gstd_pipeline_release (GstdPipeline * self)
+{
+  GstElement *pipeline = NULL;
+  GstdList *elements = NULL;
+  GstdEventHandler *event_handler = NULL;
+  GstdPipelineBus *pipeline_bus = NULL;
+  GstdState *state = NULL;
+
+  GST_OBJECT_LOCK (self);
+  gstd_pipeline_swap (self->pipeline, pipeline);
+  gstd_pipeline_swap (self->elements, elements);
+  gstd_pipeline_swap (self->event_handler, event_handler);
+  gstd_pipeline_swap (self->pipeline_bus, pipeline_bus);
+  gstd_pipeline_swap (self->state, state);
+  /* The notify watch goes away with the pipeline */
+  self->deep_notify_id = 0;
+  GST_OBJECT_UNLOCK (self);
+
+  if (pipeline_bus) {
+    g_object_unref (pipeline_bus);
+  }
+  if (event_handler) {
+    g_object_unref (event_handler);
+  }
+  if (state) {
+    g_object_unref (state);
+  }
+  if (elements) {
+    g_object_unref (elements);
+  }
+  if (pipeline) {
+    gst_object_unref (pipeline);
+  }
+}
+
+/* The published parts may be replaced by a rebuild at any time, other
+   threads must hold their own reference while using them */
+static GstElement *
+gstd_pipeline_ref_pipeline (GstdPipeline * self)
+{
+  GstElement *pipeline = NULL;
+
+  GST_OBJECT_LOCK (self);
+  if (self->pipeline) {
+    pipeline = gst_object_ref (self->pipeline);
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  return pipeline;
+}
+
+static GstdPipelineBus *
+gstd_pipeline_ref_bus (GstdPipeline * self)
+{
+  GstdPipelineBus *pipeline_bus = NULL;
+
+  GST_OBJECT_LOCK (self);
+  if (self->pipeline_bus) {
+    pipeline_bus = g_object_ref (self->pipeline_bus);
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  return pipeline_bus;
+}
+
 static void
 gstd_pipeline_dispose (GObject * object)
 {
@@ -282,11 +885,9 @@ gstd_pipeline_dispose (GObject * object)
 
   GST_INFO_OBJECT (self, "Disposing %s pipeline", GSTD_OBJECT_NAME (self));
 
-  /* Stop the pipe if playing */
-  if (self->state) {
-    gstd_object_update (GSTD_OBJECT (self->state), "NULL");
-    g_object_unref (self->state);
-    self->state = NULL;
+  /* Wait for any recovery in progress before tearing down */
+  if (self->watchdog) {
+    gstd_pipeline_watchdog_stop (self->watchdog);
   }
 
   if (self->description) {
@@ -294,29 +895,88 @@ gstd_pipeline_dispose (GObject * object)
     self->description = NULL;
   }
 
-  if (self->pipeline_bus) {
-    g_object_unref (self->pipeline_bus);
-    self->pipeline_bus = NULL;
+  /* Stop the pipe if playing */
+  gstd_pipeline_teardown (self);
+  gstd_pipeline_release (self);
+
+  if (self->graph) {
+    g_object_unref (self->graph);
+    self->graph = NULL;
   }
 
-  if (self->event_handler) {
-    g_object_unref (self->event_handler);
-    self->event_handler = NULL;
+  if (self->scheduling) {
+    g_object_unref (self->scheduling);
+    self->scheduling = NULL;
   }
 
-  if (self->pipeline) {
-    gst_object_unref (self->pipeline);
-    self->pipeline = NULL;
+  if (self->stats) {
+    g_object_unref (self->stats);
+    self->stats = NULL;
   }
 
-  if (self->elements) {
-    g_object_unref (self->elements);
-    self->elements = NULL;
+  if (self->watchdog) {
+    g_object_unref (self->watchdog);
+    self->watchdog = NULL;
   }
 
-  if (self->graph) {
-    g_object_unref (self->graph);
-    self->graph = NULL;
+  if (self->batch) {
+    g_object_unref (self->batch);
+    self->batch = NULL;
+  }
+
+  if (self->schedule) {
+    g_object_unref (self->schedule);
+    self->schedule = NULL;
+  }
+
+  if (self->scheduler) {
+    g_object_unref (self->scheduler);
+    self->scheduler = NULL;
+  }
+
+  if (self->rules) {
+    g_object_unref (self->rules);
+    self->rules = NULL;
+  }
+
+  if (self->ruler) {
+    g_object_unref (self->ruler);
+    self->ruler = NULL;
+  }
+
+  if (self->recordings) {
+    g_object_unref (self->recordings);
+    self->recordings = NULL;
+  }
+
+  if (self->recorder) {
+    g_object_unref (self->recorder);
+    self->recorder = NULL;
+  }
+
+  if (self->topology) {
+    g_object_unref (self->topology);
+    self->topology = NULL;
+  }
+
+  if (self->endpoints) {
+    g_object_unref (self->endpoints);
+    self->endpoints = NULL;
+  }
+
+  if (self->dataplane) {
+    g_object_unref (self->dataplane);
+    self->dataplane = NULL;
+  }
+
+  if (self->telemetry) {
+    g_object_unref (self->telemetry);
+    self->telemetry = NULL;
+  }
+
+  if (self->sampler) {
+    g_object_unref (self->sampler);
+    self->sampler = NULL;
   }
   G_OBJECT_CLASS (gstd_pipeline_parent_class)->dispose (object);
 }
@@ -326,6 +986,7 @@ gstd_pipeline_get_property (GObject * object,
     guint property_id, GValue * value, GParamSpec * pspec)
 {
   GstdPipeline *self = GSTD_PIPELINE (object);
+  GstElement *pipeline;
   gchar *dot;
 
   switch (property_id) {
@@ -335,53 +996,133 @@ gstd_pipeline_get_property (GObject * object,
       g_value_set_string (value, self->description);
       break;
     case PROP_ELEMENTS:
+      GST_OBJECT_LOCK (self);
       GST_DEBUG_OBJECT (self, "Returning element list %p", self->elements);
       g_value_set_object (value, self->elements);
+      GST_OBJECT_UNLOCK (self);
       break;
     case PROP_PIPELINE_BUS:
+      GST_OBJECT_LOCK (self);
       GST_DEBUG_OBJECT (self, "Returning pipeline bus %p", self->pipeline_bus);
       g_value_set_object (value, self->pipeline_bus);
+      GST_OBJECT_UNLOCK (self);
       break;
     case PROP_STATE:
+      GST_OBJECT_LOCK (self);
       GST_DEBUG_OBJECT (self, "Returning pipeline state %p", self->state);
       g_value_set_object (value, self->state);
+      GST_OBJECT_UNLOCK (self);
       break;
     case PROP_EVENT:
+      GST_OBJECT_LOCK (self);
       GST_DEBUG_OBJECT (self, "Returning event handler %p",
           self->event_handler);
       g_value_set_object (value, self->event_handler);
+      GST_OBJECT_UNLOCK (self);
       break;
     case PROP_GRAPH:
       GST_DEBUG_OBJECT (self, "Returning graph handler %p", self->graph);
-      dot = gst_debug_bin_to_dot_data (GST_BIN (self->pipeline),
-          GST_DEBUG_GRAPH_SHOW_ALL);
-      g_value_set_string (value, dot);
-      g_free (dot);
+      pipeline = gstd_pipeline_ref_pipeline (self);
+      dot = pipeline ? gst_debug_bin_to_dot_data (GST_BIN (pipeline),
+          GST_DEBUG_GRAPH_SHOW_ALL) : NULL;
+      g_value_take_string (value, dot);
+      if (pipeline) {
+        gst_object_unref (pipeline);
+      }
       break;
 
     case PROP_VERBOSE:
+      GST_OBJECT_LOCK (self);
       GST_DEBUG_OBJECT (self, "Returning verbose handler %lu",
           self->deep_notify_id);
       g_value_set_boolean (value, 0 != self->deep_notify_id);
+      GST_OBJECT_UNLOCK (self);
+      break;
+
+    case PROP_TASK_POOL:
+      GST_DEBUG_OBJECT (self, "Returning task pool policy %d",
+          self->task_pool);
+      g_value_set_enum (value, g_atomic_int_get (&self->task_pool));
+      break;
+
+    case PROP_SCHEDULING:
+      GST_DEBUG_OBJECT (self, "Returning scheduling %p", self->scheduling);
+      g_value_set_object (value, self->scheduling);
+      break;
+
+    case PROP_STATS:
+      GST_DEBUG_OBJECT (self, "Returning stats %p", self->stats);
+      g_value_set_object (value, self->stats);
+      break;
+
+    case PROP_PAD_STATS:
+      GST_DEBUG_OBJECT (self, "Returning pad stats %d", self->pad_stats);
+      g_value_set_boolean (value, self->pad_stats);
+      break;
+
+    case PROP_WATCHDOG:
+      GST_DEBUG_OBJECT (self, "Returning watchdog %p", self->watchdog);
+      g_value_set_object (value, self->watchdog);
+      break;
+
+    case PROP_LOOP:
+      GST_DEBUG_OBJECT (self, "Returning loop %d", self->loop);
+      g_value_set_boolean (value, g_atomic_int_get (&self->loop));
+      break;
+    case PROP_BATCH:
+      GST_DEBUG_OBJECT (self, "Returning batch %p", self->batch);
+      g_value_set_object (value, self->batch);
+      break;
+    case PROP_SCHEDULE:
+      GST_DEBUG_OBJECT (self, "Returning schedule %p", self->schedule);
+      g_value_set_object (value, self->schedule);
+      break;
+    case PROP_RULES:
+      GST_DEBUG_OBJECT (self, "Returning rules %p", self->rules);
+      g_value_set_object (value, self->rules);
+      break;
+    case PROP_RECORDINGS:
+      GST_DEBUG_OBJECT (self, "Returning recordings %p", self->recordings);
+      g_value_set_object (value, self->recordings);
+      break;
+    case PROP_TOPOLOGY:
+      GST_DEBUG_OBJECT (self, "Returning topology %p", self->topology);
+      g_value_set_object (value, self->topology);
+      break;
+    case PROP_ENDPOINTS:
+      GST_DEBUG_OBJECT (self, "Returning endpoints %p", self->endpoints);
+      g_value_set_object (value, self->endpoints);
+      break;
+    case PROP_TELEMETRY:
+      GST_DEBUG_OBJECT (self, "Returning telemetry %p", self->telemetry);
+      g_value_set_object (value, self->telemetry);
       break;
 
     case PROP_POSITION:
-      if (!gst_element_query_position (self->pipeline, GST_FORMAT_TIME,
+      pipeline = gstd_pipeline_ref_pipeline (self);
+      if (!pipeline || !gst_element_query_position (pipeline, GST_FORMAT_TIME,
               &self->position)) {
         /* if the query could not be performed. return 0 */
         self->position = G_GINT64_CONSTANT (0);
       }
+      if (pipeline) {
+        gst_object_unref (pipeline);
+      }
 
       GST_DEBUG_OBJECT (self, "Returning pipeline position %" GST_TIME_FORMAT,
           GST_TIME_ARGS (self->position));
       g_value_set_int64 (value, self->position);
       break;
     case PROP_DURATION:
-      if (!gst_element_query_duration (self->pipeline, GST_FORMAT_TIME,
+      pipeline = gstd_pipeline_ref_pipeline (self);
+      if (!pipeline || !gst_element_query_duration (pipeline, GST_FORMAT_TIME,
               &self->duration)) {
         /* if the query could not be performed. return 0 */
         self->duration = G_GINT64_CONSTANT (0);
       }
+      if (pipeline) {
+        gst_object_unref (pipeline);
+      }
 
       GST_DEBUG_OBJECT (self, "Returning pipeline duration %" GST_TIME_FORMAT,
           GST_TIME_ARGS (self->duration));
@@ -401,7 +1142,9 @@ gstd_pipeline_set_property (GObject * object,
   GstdPipeline *self = GSTD_PIPELINE (object);
 #if GST_VERSION_MINOR >= 10
   gboolean verbose = FALSE;
+  GstElement *pipeline;
 #endif
+  GstdState *state;
 
   switch (property_id) {
     case PROP_DESCRIPTION:
@@ -413,28 +1156,58 @@ gstd_pipeline_set_property (GObject * object,
       break;
 
     case PROP_STATE:
-      if (self->state) {
-        g_object_unref (self->state);
+      state = g_value_dup_object (value);
+      GST_OBJECT_LOCK (self);
+      gstd_pipeline_swap (self->state, state);
+      GST_OBJECT_UNLOCK (self);
+      if (state) {
+        g_object_unref (state);
       }
-      self->state = g_value_get_object (value);
       break;
 
 #if GST_VERSION_MINOR >= 10
     case PROP_VERBOSE:
       verbose = g_value_get_boolean (value);
 
+      /* Serialized with the rebuild, which replaces both */
+      GST_OBJECT_LOCK (self);
+      pipeline = self->pipeline;
       if (verbose == FALSE && self->deep_notify_id != 0) {
-        g_signal_handler_disconnect (self->pipeline, self->deep_notify_id);
+        g_signal_handler_disconnect (pipeline, self->deep_notify_id);
         self->deep_notify_id = 0;
       }
-      if (verbose == TRUE && self->deep_notify_id == 0) {
+      if (verbose == TRUE && self->deep_notify_id == 0 && pipeline) {
         self->deep_notify_id =
-            gst_element_add_property_deep_notify_watch (self->pipeline, NULL,
-            TRUE);
+            gst_element_add_property_deep_notify_watch (pipeline, NULL, TRUE);
       }
+      GST_OBJECT_UNLOCK (self);
       break;
 #endif
 
+    case PROP_TASK_POOL:
+      g_atomic_int_set (&self->task_pool, g_value_get_enum (value));
+      GST_INFO_OBJECT (self, "Changed task pool policy to %d",
+          self->task_pool);
+      break;
+
+    case PROP_PAD_STATS:
+      self->pad_stats = g_value_get_boolean (value);
+      gstd_pipeline_set_pad_stats (self, self->pad_stats);
+      GST_INFO_OBJECT (self, "Changed pad stats to %d", self->pad_stats);
+      break;
+
+    case PROP_LOOP:
+      g_atomic_int_set (&self->loop, g_value_get_boolean (value));
+      GST_INFO_OBJECT (self, "Changed loop to %d", self->loop);
+
+      /* A prerolled pipeline won't post ASYNC_DONE again by itself.
+         Seeks are issued from the main context, as the bus ones */
+      if (self->loop) {
+        g_main_context_invoke_full (NULL, G_PRIORITY_DEFAULT,
+            gstd_pipeline_loop_arm, g_object_ref (self), g_object_unref);
+      }
+      break;
+
     default:
       /* We don't have any other property... */
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -450,9 +1223,9 @@ gstd_pipeline_set_property (GObject * object,
  * \param name A unique name to assign to the pipeline. If empty or
  * NULL, a unique name will be generated.
  * \param description A gst-launch like description of the pipeline.
- * \param newpipe A double pointer to hold the newly created GstdPipeline.
- * It may be passed NULL to ignore output values. This pointer will be
- * NULL in case of failure. Do not free this pointer!
+ * \param elements The list to fill with the elements of the pipeline.
+ * \param out A pointer to hold the newly created GstPipeline. It will
+ * be NULL if the description can't be parsed. Free after usage.
  *
  * \return A GstdReturnCode with the return status.
  *
@@ -460,36 +1233,36 @@ gstd_pipeline_set_property (GObject * object,
  */
 static GstdReturnCode
 gstd_pipeline_create (GstdPipeline * self, const gchar * name,
-    const gint index, const gchar * description)
+    const gint index, const gchar * description, GstdList * elements,
+    GstElement ** out)
 {
   GError *error;
   gchar *pipename;
   GstParseFlags flags;
+  GstElement *pipeline;
 
   g_return_val_if_fail (self, GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (index != -1, GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (description, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (out, GSTD_NULL_ARGUMENT);
+
+  *out = NULL;
 
   error = NULL;
   flags = GST_PARSE_FLAG_FATAL_ERRORS | GST_PARSE_FLAG_NO_SINGLE_ELEMENT_BINS;
-  self->pipeline = gst_parse_launch_full (description, NULL, flags, &error);
-  if (!self->pipeline)
+  pipeline = gst_parse_launch_full (description, NULL, flags, &error);
+  if (!pipeline)
     goto wrong_pipeline;
 
   /* Single element descriptions (i.e.: playbin) aren't returned in a
      pipeline. This is a problem for us since we concepts like the bus
      which are directly related to a GstPipeline */
-  if (!GST_IS_PIPELINE (self->pipeline)) {
-    GstElement *element = self->pipeline;
-    self->pipeline = gst_pipeline_new (GST_OBJECT_NAME (element));
-    gst_bin_add (GST_BIN (self->pipeline), element);
+  if (!GST_IS_PIPELINE (pipeline)) {
+    GstElement *element = pipeline;
+    pipeline = gst_pipeline_new (GST_OBJECT_NAME (element));
+    gst_bin_add (GST_BIN (pipeline), element);
   }
 
-  if (self->state) {
-    g_object_unref (self->state);
-  }
-  self->state = gstd_state_new (self->pipeline);
-
   /* If the user didn't provide a name or provided an empty name
    * assign the fallback using the idex */
   if (!name || name[0] == '\0') {
@@ -499,13 +1272,15 @@ gstd_pipeline_create (GstdPipeline * self, const gchar * name,
   }
 
   /* Set the updated name */
-  gst_object_set_name (GST_OBJECT (self->pipeline), pipename);
+  gst_object_set_name (GST_OBJECT (pipeline), pipename);
   g_free (pipename);
 
   GST_INFO_OBJECT (self, "Created pipeline \"%s\": \"%s\"",
       GSTD_OBJECT_NAME (self), description);
 
-  return gstd_pipeline_fill_elements (self, self->pipeline);
+  *out = pipeline;
+
+  return gstd_pipeline_fill_elements (self, elements, pipeline);
 
 wrong_pipeline:
   {
@@ -518,7 +1293,8 @@ wrong_pipeline:
 }
 
 static GstdReturnCode
-gstd_pipeline_fill_elements (GstdPipeline * self, GstElement * element)
+gstd_pipeline_fill_elements (GstdPipeline * self, GstdList * elements,
+    GstElement * element)
 {
   GstPipeline *pipe;
   GstIterator *it;
@@ -551,7 +1327,7 @@ gstd_pipeline_fill_elements (GstdPipeline * self, GstElement * element)
 
         gstd_element = g_object_new (GSTD_TYPE_ELEMENT, "name",
             GST_OBJECT_NAME (gste), "gstelement", gste, NULL);
-        gstd_list_append_child (self->elements, GSTD_OBJECT (gstd_element));
+        gstd_list_append_child (elements, GSTD_OBJECT (gstd_element));
 
         g_value_reset (&item);
         break;
@@ -587,3 +1363,249 @@ noiter:
     return GSTD_NO_PIPELINE;
   }
 }
+
+static GstBusSyncReply
+gstd_pipeline_bus_sync_handler (GstBus * bus, GstMessage * message,
+    gpointer user_data)
+{
+  GstdPipeline *self = GSTD_PIPELINE (user_data);
+  GstBusSyncReply reply = GST_BUS_PASS;
+  GstdPipelineBus *pipeline_bus;
+  GstElement *pipeline;
+  GstState state;
+
+  gstd_pipeline_rules_handle (self->ruler, message);
+
+  switch (GST_MESSAGE_TYPE (message)) {
+    case GST_MESSAGE_STREAM_STATUS:
+      gstd_pipeline_stream_status (self, message);
+      break;
+    case GST_MESSAGE_ERROR:
+      gstd_pipeline_watchdog_error (self->watchdog, message);
+      break;
+    case GST_MESSAGE_BUFFERING:
+    case GST_MESSAGE_CLOCK_LOST:
+    case GST_MESSAGE_LATENCY:
+    case GST_MESSAGE_REQUEST_STATE:
+      pipeline_bus = gstd_pipeline_ref_bus (self);
+      pipeline = gstd_pipeline_ref_pipeline (self);
+      if (pipeline_bus && pipeline) {
+        gstd_pipeline_bus_handle (pipeline_bus, pipeline, message);
+      }
+      if (pipeline_bus) {
+        g_object_unref (pipeline_bus);
+      }
+      if (pipeline) {
+        gst_object_unref (pipeline);
+      }
+      break;
+    case GST_MESSAGE_ASYNC_DONE:
+      /* Prerolls and client flushing seeks, which replace the looping
+         segment, arm it again. Our own seeks are already armed */
+      if (g_atomic_int_get (&self->loop) && GST_MESSAGE_SEQNUM (message) !=
+          (guint32) g_atomic_int_get (&self->loop_seqnum)) {
+        g_atomic_int_set (&self->loop_armed, FALSE);
+        g_main_context_invoke_full (NULL, G_PRIORITY_DEFAULT,
+            gstd_pipeline_loop_arm, g_object_ref (self), g_object_unref);
+      }
+      break;
+    case GST_MESSAGE_SEGMENT_DONE:
+      /* Segment seeks issued by clients are theirs to handle */
+      if (g_atomic_int_get (&self->loop_armed)) {
+        g_main_context_invoke_full (NULL, G_PRIORITY_DEFAULT,
+            gstd_pipeline_loop_restart, g_object_ref (self), g_object_unref);
+      }
+      break;
+    case GST_MESSAGE_STATE_CHANGED:
+      /* Only compared, the message source holds its own reference */
+      GST_OBJECT_LOCK (self);
+      pipeline = self->pipeline;
+      GST_OBJECT_UNLOCK (self);
+      if (GST_MESSAGE_SRC (message) == GST_OBJECT (pipeline)) {
+        gst_message_parse_state_changed (message, NULL, &state, NULL);
+        if (state <= GST_STATE_READY) {
+          g_atomic_int_set (&self->loop_armed, FALSE);
+        }
+
+        /* Stopped on its own, outside of its group. The group base time
+           would be stale by the time it plays again */
+        if (state <= GST_STATE_READY &&
+            g_atomic_int_compare_and_exchange (&self->synced, TRUE, FALSE)) {
+          GST_INFO_OBJECT (self, "Left its sync group by stopping");
+          gstd_pipeline_set_sync (self, NULL, 0);
+        }
+      }
+      break;
+    case GST_MESSAGE_QOS:
+      gstd_pipeline_stats_qos (self->stats, message);
+
+      /* Raw QoS messages would otherwise pile up in the bus */
+      pipeline_bus = gstd_pipeline_ref_bus (self);
+      if (!pipeline_bus || !(GST_MESSAGE_QOS &
+              gstd_pipeline_bus_get_types (pipeline_bus))) {
+        reply = GST_BUS_DROP;
+      }
+      if (pipeline_bus) {
+        g_object_unref (pipeline_bus);
+      }
+      break;
+    default:
+      break;
+  }
+
+  return reply;
+}
+
+static void
+gstd_pipeline_stream_status (GstdPipeline * self, GstMessage * message)
+{
+  GstStreamStatusType type;
+  GstElement *owner;
+  const GValue *value;
+  GstTask *task;
+  GstTaskPool *pool;
+
+  gst_message_parse_stream_status (message, &type, &owner);
+
+  /* Enter and leave are posted from the streaming thread itself */
+  if (GST_STREAM_STATUS_TYPE_ENTER == type) {
+    gstd_pipeline_stats_thread_enter (self->stats, GSTD_OBJECT_NAME (self),
+        owner);
+    gstd_pipeline_scheduling_enter (self->scheduling, owner);
+    return;
+  }
+
+  if (GST_STREAM_STATUS_TYPE_LEAVE == type) {
+    gstd_pipeline_scheduling_leave (self->scheduling, owner);
+    gstd_pipeline_stats_thread_leave (self->stats, owner);
+    return;
+  }
+
+  if (GST_STREAM_STATUS_TYPE_CREATE != type) {
+    return;
+  }
+
+  if (GSTD_TASK_POOL_POLICY_SHARED != g_atomic_int_get (&self->task_pool)) {
+    return;
+  }
+
+  value = gst_message_get_stream_status_object (message);
+  if (!value || !G_VALUE_HOLDS (value, GST_TYPE_TASK)) {
+    return;
+  }
+
+  task = g_value_get_object (value);
+  pool = gstd_task_pool_get_default ();
+
+  GST_DEBUG_OBJECT (self, "Assigning shared task pool to \"%s\" task",
+      GST_OBJECT_NAME (owner));
+  gst_task_set_pool (task, pool);
+
+  gst_object_unref (pool);
+}
+
+static void
+gstd_pipeline_set_pad_stats (GstdPipeline * self, gboolean enabled)
+{
+  GstdList *list = NULL;
+  GList *elements;
+  GList *element;
+
+  GST_OBJECT_LOCK (self);
+  if (self->elements) {
+    list = g_object_ref (self->elements);
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  if (!list) {
+    return;
+  }
+
+  GST_OBJECT_LOCK (list);
+  elements = g_list_copy_deep (list->list, (GCopyFunc) g_object_ref, NULL);
+  GST_OBJECT_UNLOCK (list);
+  g_object_unref (list);
+
+  for (element = elements; element; element = element->next) {
+    gstd_element_set_pad_stats (GSTD_ELEMENT (element->data), enabled);
+  }
+  g_list_free_full (elements, g_object_unref);
+}
+
+static gboolean
+gstd_pipeline_loop_arm (gpointer user_data)
+{
+  GstdPipeline *self = GSTD_PIPELINE (user_data);
+  GstElement *pipeline;
+  GstEvent *event;
+  gint64 position;
+
+  if (!g_atomic_int_get (&self->loop) ||
+      !g_atomic_int_compare_and_exchange (&self->loop_armed, FALSE, TRUE)) {
+    return G_SOURCE_REMOVE;
+  }
+
+  /* Not prerolled yet, its ASYNC_DONE will arm it */
+  pipeline = gstd_pipeline_ref_pipeline (self);
+  if (!pipeline || GST_STATE (pipeline) < GST_STATE_PAUSED) {
+    g_atomic_int_set (&self->loop_armed, FALSE);
+    if (pipeline) {
+      gst_object_unref (pipeline);
+    }
+    return G_SOURCE_REMOVE;
+  }
+
+  if (!gst_element_query_position (pipeline, GST_FORMAT_TIME, &position)) {
+    position = 0;
+  }
+
+  /* Segment seeks post SEGMENT_DONE instead of EOS when done */
+  GST_INFO_OBJECT (self, "Looping from %" GST_TIME_FORMAT,
+      GST_TIME_ARGS (position));
+  event = gst_event_new_seek (1.0, GST_FORMAT_TIME,
+      GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_SEGMENT, GST_SEEK_TYPE_SET,
+      position, GST_SEEK_TYPE_NONE, GST_CLOCK_TIME_NONE);
+  g_atomic_int_set (&self->loop_seqnum, gst_event_get_seqnum (event));
+  if (!gst_element_send_event (pipeline, event)) {
+    GST_WARNING_OBJECT (self, "Unable to loop \"%s\"",
+        GSTD_OBJECT_NAME (self));
+    g_atomic_int_set (&self->loop_armed, FALSE);
+  }
+  gst_object_unref (pipeline);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+gstd_pipeline_loop_restart (gpointer user_data)
+{
+  GstdPipeline *self = GSTD_PIPELINE (user_data);
+  GstElement *pipeline;
+
+  pipeline = gstd_pipeline_ref_pipeline (self);
+  if (!pipeline) {
+    return G_SOURCE_REMOVE;
+  }
+
+  /* Looping was disabled meanwhile, finish as a regular stream would */
+  if (!g_atomic_int_get (&self->loop)) {
+    GST_INFO_OBJECT (self, "Done looping");
+    g_atomic_int_set (&self->loop_armed, FALSE);
+    gst_element_send_event (pipeline, gst_event_new_eos ());
+    gst_object_unref (pipeline);
+    return G_SOURCE_REMOVE;
+  }
+
+  /* Without a flush the new segment is queued right after the current
+     one, so there is no gap */
+  GST_DEBUG_OBJECT (self, "Restarting loop");
+  if (!gst_element_seek (pipeline, 1.0, GST_FORMAT_TIME,
+          GST_SEEK_FLAG_SEGMENT, GST_SEEK_TYPE_SET, 0, GST_SEEK_TYPE_NONE,
+          GST_CLOCK_TIME_NONE)) {
+    GST_WARNING_OBJECT (self, "Unable to restart loop of \"%s\"",
+        GSTD_OBJECT_NAME (self));
+  }
+  gst_object_unref (pipeline);
+
+  return G_SOURCE_REMOVE;
+}
@@ -46,5 +46,36 @@ GType gstd_pipeline_get_type (void);
 
 GstdReturnCode gstd_pipeline_build (GstdPipeline * object);
 
+GstdReturnCode gstd_pipeline_rename (GstdPipeline * object,
+    const gchar * name);
+
+/**
+ * gstd_pipeline_rebuild:
+ * @object: The pipeline to rebuild
+ *
+ * Tears down the GStreamer pipeline and builds it again from its
+ * description, restoring the state it was targeting. The elements are
+ * replaced by new ones under the same names.
+ *
+ * Returns: A GstdReturnCode with the rebuild status.
+ */
+GstdReturnCode gstd_pipeline_rebuild (GstdPipeline * object);
+
+/**
+ * gstd_pipeline_set_sync:
+ * @object: The pipeline to synchronize
+ * @clock: (nullable): The clock to share, or NULL to release it
+ * @base_time: The base time to run against @clock
+ *
+ * Forces the pipeline to use @clock and @base_time so that it shares
+ * its running time with other pipelines configured alike. Passing a
+ * NULL clock restores the automatic clock and base time selection,
+ * which also happens once the pipeline drops below PAUSED.
+ *
+ * Returns: A GstdReturnCode with the status of the operation.
+ */
+GstdReturnCode gstd_pipeline_set_sync (GstdPipeline * object,
+    GstClock * clock, GstClockTime base_time);
+
 G_END_DECLS
 #endif // __GSTD_PIPELINE_H__
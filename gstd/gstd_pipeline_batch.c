@@ -0,0 +1,619 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_pipeline_batch.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pipeline Batch debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_batch_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_batch_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+enum
+{
+  PROP_PENDING = 1,
+  PROP_APPLIED,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+typedef struct _GstdBatchSet GstdBatchSet;
+typedef struct _GstdBatchTransaction GstdBatchTransaction;
+
+struct _GstdBatchSet
+{
+  GstElement *element;
+  GParamSpec *pspec;
+  GValue value;
+};
+
+struct _GstdBatchTransaction
+{
+  /**
+   * Held until the transaction is freed, a probe callback may still
+   * be running after the probe was removed
+   */
+  GstdPipelineBatch *batch;
+
+  /**
+   * The pad whose buffers trigger the transaction, if any
+   */
+  GstPad *pad;
+  gulong id;
+
+  /**
+   * Running time the transaction is applied at, or
+   * GST_CLOCK_TIME_NONE for the next buffer
+   */
+  GstClockTime at;
+
+  GList *sets;
+};
+
+/**
+ * GstdPipelineBatch:
+ * Queues property sets across elements of a pipeline and applies them
+ * together from the streaming thread, right before a buffer goes
+ * through the trigger pad. A transaction is submitted as a single
+ * update:
+ *
+ *   update <batch> [at=<running-time>] [pad=<element.pad>]
+ *       <element>.<property>=<value> [<element>.<property>=<value> ...]
+ *
+ * The trigger pad defaults to the first pad of the first element in
+ * the transaction. With at= the transaction waits for the first buffer
+ * whose running time reaches the given one, in nanoseconds. Values with
+ * spaces may be quoted.
+ */
+struct _GstdPipelineBatch
+{
+  GstdObject parent;
+
+  /**
+   * The GStreamer pipeline the elements are looked up in
+   */
+  GstBin *bin;
+
+  /**
+   * Transactions waiting for their buffer
+   */
+  GList *pending;
+
+  /**
+   * Amount of transactions applied so far
+   */
+  guint applied;
+};
+
+struct _GstdPipelineBatchClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPipelineBatch, gstd_pipeline_batch, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pipeline_batch_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_pipeline_batch_dispose (GObject *);
+static GstdReturnCode gstd_pipeline_batch_update (GstdObject *, const gchar *);
+static GstdReturnCode gstd_pipeline_batch_parse (GstdPipelineBatch *,
+    GstBin *, GstdBatchTransaction *, const gchar *);
+static GstdReturnCode gstd_pipeline_batch_parse_set (GstdPipelineBatch *,
+    GstBin *, GstdBatchTransaction *, gchar *);
+static GstPad *gstd_pipeline_batch_find_pad (GstdPipelineBatch *, GstBin *,
+    const gchar *);
+static GstPadProbeReturn gstd_pipeline_batch_probe (GstPad *,
+    GstPadProbeInfo *, gpointer);
+static GstClockTime gstd_pipeline_batch_running_time (GstPad *,
+    GstPadProbeInfo *);
+static gboolean gstd_pipeline_batch_claim (GstdBatchTransaction *);
+static void gstd_pipeline_batch_apply (GstdBatchTransaction *);
+static void gstd_batch_transaction_free (gpointer);
+
+static void
+gstd_pipeline_batch_class_init (GstdPipelineBatchClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GstdObjectClass *gstdc = GSTD_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->get_property = gstd_pipeline_batch_get_property;
+  object_class->dispose = gstd_pipeline_batch_dispose;
+
+  properties[PROP_PENDING] =
+      g_param_spec_uint ("pending", "Pending",
+      "Transactions waiting for their buffer to be applied",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_APPLIED] =
+      g_param_spec_uint ("applied", "Applied",
+      "Transactions applied so far",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  gstdc->update = GST_DEBUG_FUNCPTR (gstd_pipeline_batch_update);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_batch_debug, "gstdpipelinebatch",
+      debug_color, "Gstd Pipeline Batch category");
+}
+
+static void
+gstd_pipeline_batch_init (GstdPipelineBatch * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline batch");
+
+  self->bin = NULL;
+  self->pending = NULL;
+  self->applied = 0;
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+GstdPipelineBatch *
+gstd_pipeline_batch_new (void)
+{
+  return GSTD_PIPELINE_BATCH (g_object_new (GSTD_TYPE_PIPELINE_BATCH,
+          "name", "batch", NULL));
+}
+
+static void
+gstd_pipeline_batch_dispose (GObject * object)
+{
+  GstdPipelineBatch *self = GSTD_PIPELINE_BATCH (object);
+
+  GST_INFO_OBJECT (self, "Disposing pipeline batch");
+
+  gstd_pipeline_batch_unwatch (self);
+
+  G_OBJECT_CLASS (gstd_pipeline_batch_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_batch_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineBatch *self = GSTD_PIPELINE_BATCH (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (property_id) {
+    case PROP_PENDING:
+      g_value_set_uint (value, g_list_length (self->pending));
+      break;
+    case PROP_APPLIED:
+      g_value_set_uint (value, self->applied);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+void
+gstd_pipeline_batch_watch (GstdPipelineBatch * self, GstBin * bin)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_BATCH (self));
+  g_return_if_fail (GST_IS_BIN (bin));
+
+  GST_OBJECT_LOCK (self);
+  if (self->bin) {
+    GST_OBJECT_UNLOCK (self);
+    GST_ERROR_OBJECT (self, "Already watching a pipeline");
+    return;
+  }
+
+  self->bin = gst_object_ref (bin);
+  GST_OBJECT_UNLOCK (self);
+}
+
+void
+gstd_pipeline_batch_unwatch (GstdPipelineBatch * self)
+{
+  GstdBatchTransaction *transaction;
+  GList *pending;
+  GList *iter;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_BATCH (self));
+
+  GST_OBJECT_LOCK (self);
+  pending = self->pending;
+  self->pending = NULL;
+  if (self->bin) {
+    gst_object_unref (self->bin);
+    self->bin = NULL;
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  /* Once out of the pending list the probes can't claim the
+     transactions anymore, so removing the probe is what frees them */
+  for (iter = pending; iter; iter = iter->next) {
+    transaction = iter->data;
+    GST_INFO_OBJECT (self, "Discarding transaction on %s:%s",
+        GST_DEBUG_PAD_NAME (transaction->pad));
+    gst_pad_remove_probe (transaction->pad, transaction->id);
+  }
+  g_list_free (pending);
+}
+
+static GstdReturnCode
+gstd_pipeline_batch_update (GstdObject * object, const gchar * value)
+{
+  GstdPipelineBatch *self;
+  GstdBatchTransaction *transaction;
+  GstdReturnCode ret;
+  GstBin *bin;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE_BATCH (object), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (value, GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_BATCH (object);
+
+  GST_OBJECT_LOCK (self);
+  bin = self->bin ? gst_object_ref (self->bin) : NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!bin) {
+    GST_ERROR_OBJECT (self, "No pipeline to update");
+    return GSTD_NO_PIPELINE;
+  }
+
+  transaction = g_slice_new0 (GstdBatchTransaction);
+  transaction->batch = g_object_ref (self);
+  transaction->at = GST_CLOCK_TIME_NONE;
+
+  /* Everything is validated and deserialized before anything is
+     queued, so a transaction is either taken as a whole or rejected */
+  ret = gstd_pipeline_batch_parse (self, bin, transaction, value);
+  if (GSTD_EOK != ret) {
+    gstd_batch_transaction_free (transaction);
+    goto out;
+  }
+
+  /* Nothing is flowing, so there is no frame to tear */
+  if (!GST_CLOCK_TIME_IS_VALID (transaction->at)
+      && GST_STATE (bin) < GST_STATE_PAUSED) {
+    GST_INFO_OBJECT (self, "Pipeline is not streaming, applying right away");
+    gstd_pipeline_batch_apply (transaction);
+    gstd_batch_transaction_free (transaction);
+
+    GST_OBJECT_LOCK (self);
+    self->applied++;
+    GST_OBJECT_UNLOCK (self);
+
+    goto out;
+  }
+
+  GST_INFO_OBJECT (self, "Queueing %u property sets on %s:%s",
+      g_list_length (transaction->sets), GST_DEBUG_PAD_NAME (transaction->pad));
+
+  /* The transaction must be pending before the probe may fire */
+  GST_OBJECT_LOCK (self);
+  if (self->bin != bin) {
+    GST_OBJECT_UNLOCK (self);
+    GST_ERROR_OBJECT (self, "Pipeline was torn down during the update");
+    gstd_batch_transaction_free (transaction);
+    ret = GSTD_NO_PIPELINE;
+    goto out;
+  }
+  self->pending = g_list_append (self->pending, transaction);
+  transaction->id = gst_pad_add_probe (transaction->pad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      gstd_pipeline_batch_probe, transaction, gstd_batch_transaction_free);
+  GST_OBJECT_UNLOCK (self);
+
+out:
+  gst_object_unref (bin);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_pipeline_batch_parse (GstdPipelineBatch * self, GstBin * bin,
+    GstdBatchTransaction * transaction, const gchar * description)
+{
+  GstdReturnCode ret = GSTD_EOK;
+  GError *error = NULL;
+  gchar **tokens = NULL;
+  gchar **token;
+  gchar *pad = NULL;
+  gchar *end;
+
+  if (!g_shell_parse_argv (description, NULL, &tokens, &error)) {
+    GST_ERROR_OBJECT (self, "Malformed transaction: %s", error->message);
+    g_error_free (error);
+    return GSTD_BAD_VALUE;
+  }
+
+  for (token = tokens; *token && GSTD_EOK == ret; token++) {
+    if (g_str_has_prefix (*token, "at=")) {
+      transaction->at = g_ascii_strtoull (*token + 3, &end, 10);
+      if (end == *token + 3 || '\0' != *end) {
+        GST_ERROR_OBJECT (self, "Invalid running time \"%s\"", *token + 3);
+        ret = GSTD_BAD_VALUE;
+      }
+    } else if (g_str_has_prefix (*token, "pad=")) {
+      pad = *token + 4;
+    } else {
+      ret = gstd_pipeline_batch_parse_set (self, bin, transaction, *token);
+    }
+  }
+
+  if (GSTD_EOK == ret && !transaction->sets) {
+    GST_ERROR_OBJECT (self, "No property sets in transaction");
+    ret = GSTD_BAD_VALUE;
+  }
+
+  if (GSTD_EOK == ret) {
+    if (pad) {
+      transaction->pad = gstd_pipeline_batch_find_pad (self, bin, pad);
+    } else {
+      /* Trigger with the frames entering the first element */
+      GstdBatchSet *first = transaction->sets->data;
+      GstElement *element = first->element;
+
+      GST_OBJECT_LOCK (element);
+      if (element->sinkpads) {
+        transaction->pad = gst_object_ref (element->sinkpads->data);
+      } else if (element->srcpads) {
+        transaction->pad = gst_object_ref (element->srcpads->data);
+      }
+      GST_OBJECT_UNLOCK (element);
+    }
+
+    if (!transaction->pad) {
+      GST_ERROR_OBJECT (self, "Unable to find a pad to trigger the "
+          "transaction on");
+      ret = GSTD_NO_RESOURCE;
+    }
+  }
+
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_pipeline_batch_parse_set (GstdPipelineBatch * self, GstBin * bin,
+    GstdBatchTransaction * transaction, gchar * token)
+{
+  GstdBatchSet *set;
+  GstElement *element;
+  GParamSpec *pspec;
+  gchar *equal;
+  gchar *dot;
+
+  equal = strchr (token, '=');
+  if (equal) {
+    *equal = '\0';
+  }
+  dot = strrchr (token, '.');
+
+  if (!equal || !dot) {
+    GST_ERROR_OBJECT (self, "Malformed property set \"%s\", expected "
+        "element.property=value", token);
+    return GSTD_BAD_VALUE;
+  }
+  *dot = '\0';
+
+  element = gst_bin_get_by_name (bin, token);
+  if (!element) {
+    GST_ERROR_OBJECT (self, "No element named \"%s\"", token);
+    return GSTD_NO_RESOURCE;
+  }
+
+  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (element), dot + 1);
+  if (!pspec || !(pspec->flags & G_PARAM_WRITABLE)) {
+    GST_ERROR_OBJECT (self, "Element \"%s\" has no writable property \"%s\"",
+        token, dot + 1);
+    gst_object_unref (element);
+    return GSTD_NO_RESOURCE;
+  }
+
+  /* GObject would only warn about it once the buffer arrives */
+  if (pspec->flags & G_PARAM_CONSTRUCT_ONLY) {
+    GST_ERROR_OBJECT (self, "Property %s.%s can only be set on construction",
+        token, pspec->name);
+    gst_object_unref (element);
+    return GSTD_BAD_VALUE;
+  }
+
+  set = g_slice_new0 (GstdBatchSet);
+  set->element = element;
+  set->pspec = pspec;
+  g_value_init (&set->value, pspec->value_type);
+
+  /* Keep the sets in order so that later ones win */
+  transaction->sets = g_list_append (transaction->sets, set);
+
+  if (!gst_value_deserialize (&set->value, equal + 1)) {
+    GST_ERROR_OBJECT (self, "Invalid value \"%s\" for %s.%s", equal + 1,
+        token, pspec->name);
+    return GSTD_BAD_VALUE;
+  }
+
+  return GSTD_EOK;
+}
+
+static GstPad *
+gstd_pipeline_batch_find_pad (GstdPipelineBatch * self, GstBin * bin,
+    const gchar * name)
+{
+  GstElement *element;
+  GstPad *pad;
+  gchar *element_name;
+  gchar *dot;
+
+  element_name = g_strdup (name);
+  dot = strrchr (element_name, '.');
+  if (!dot) {
+    GST_ERROR_OBJECT (self, "Malformed pad \"%s\", expected element.pad",
+        name);
+    g_free (element_name);
+    return NULL;
+  }
+  *dot = '\0';
+
+  element = gst_bin_get_by_name (bin, element_name);
+  pad = element ? gst_element_get_static_pad (element, dot + 1) : NULL;
+
+  if (element) {
+    gst_object_unref (element);
+  }
+  g_free (element_name);
+
+  return pad;
+}
+
+static GstClockTime
+gstd_pipeline_batch_running_time (GstPad * pad, GstPadProbeInfo * info)
+{
+  GstBuffer *buffer = NULL;
+  GstBufferList *list;
+  GstEvent *event;
+  const GstSegment *segment;
+  GstClockTime timestamp;
+  GstClockTime running_time = GST_CLOCK_TIME_NONE;
+
+  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER) {
+    buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+  } else {
+    list = GST_PAD_PROBE_INFO_BUFFER_LIST (info);
+    if (gst_buffer_list_length (list) > 0) {
+      buffer = gst_buffer_list_get (list, 0);
+    }
+  }
+
+  if (!buffer) {
+    return GST_CLOCK_TIME_NONE;
+  }
+
+  timestamp = GST_BUFFER_PTS_IS_VALID (buffer) ?
+      GST_BUFFER_PTS (buffer) : GST_BUFFER_DTS (buffer);
+
+  event = gst_pad_get_sticky_event (pad, GST_EVENT_SEGMENT, 0);
+  if (event) {
+    gst_event_parse_segment (event, &segment);
+    if (GST_FORMAT_TIME == segment->format) {
+      running_time = gst_segment_to_running_time (segment, GST_FORMAT_TIME,
+          timestamp);
+    }
+    gst_event_unref (event);
+  }
+
+  return running_time;
+}
+
+static GstPadProbeReturn
+gstd_pipeline_batch_probe (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstdBatchTransaction *transaction = user_data;
+  GstClockTime running_time;
+
+  if (GST_CLOCK_TIME_IS_VALID (transaction->at)) {
+    running_time = gstd_pipeline_batch_running_time (pad, info);
+
+    /* Buffers that can't be placed in time don't hold the
+       transaction back */
+    if (GST_CLOCK_TIME_IS_VALID (running_time)
+        && running_time < transaction->at) {
+      return GST_PAD_PROBE_OK;
+    }
+  }
+
+  /* A discarded transaction is freed when its probe is removed */
+  if (!gstd_pipeline_batch_claim (transaction)) {
+    return GST_PAD_PROBE_OK;
+  }
+
+  gstd_pipeline_batch_apply (transaction);
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
+static gboolean
+gstd_pipeline_batch_claim (GstdBatchTransaction * transaction)
+{
+  GstdPipelineBatch *self = transaction->batch;
+  GList *found;
+
+  GST_OBJECT_LOCK (self);
+  found = g_list_find (self->pending, transaction);
+  if (found) {
+    self->pending = g_list_delete_link (self->pending, found);
+    self->applied++;
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  return NULL != found;
+}
+
+static void
+gstd_pipeline_batch_apply (GstdBatchTransaction * transaction)
+{
+  GstdBatchSet *set;
+  GList *iter;
+
+  for (iter = transaction->sets; iter; iter = iter->next) {
+    set = iter->data;
+    GST_DEBUG_OBJECT (transaction->batch, "Setting %s.%s",
+        GST_OBJECT_NAME (set->element), set->pspec->name);
+    g_object_set_property (G_OBJECT (set->element), set->pspec->name,
+        &set->value);
+  }
+}
+
+static void
+gstd_batch_set_free (gpointer data)
+{
+  GstdBatchSet *set = data;
+
+  g_value_unset (&set->value);
+  gst_object_unref (set->element);
+  g_slice_free (GstdBatchSet, set);
+}
+
+static void
+gstd_batch_transaction_free (gpointer data)
+{
+  GstdBatchTransaction *transaction = data;
+
+  g_list_free_full (transaction->sets, gstd_batch_set_free);
+  if (transaction->pad) {
+    gst_object_unref (transaction->pad);
+  }
+  g_object_unref (transaction->batch);
+  g_slice_free (GstdBatchTransaction, transaction);
+}
@@ -0,0 +1,78 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_BATCH_H__
+#define __GSTD_PIPELINE_BATCH_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_BATCH \
+  (gstd_pipeline_batch_get_type())
+#define GSTD_PIPELINE_BATCH(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_BATCH,GstdPipelineBatch))
+#define GSTD_PIPELINE_BATCH_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_BATCH,GstdPipelineBatchClass))
+#define GSTD_IS_PIPELINE_BATCH(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_BATCH))
+#define GSTD_IS_PIPELINE_BATCH_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_BATCH))
+#define GSTD_PIPELINE_BATCH_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_BATCH, GstdPipelineBatchClass))
+typedef struct _GstdPipelineBatch GstdPipelineBatch;
+typedef struct _GstdPipelineBatchClass GstdPipelineBatchClass;
+GType gstd_pipeline_batch_get_type (void);
+
+/**
+ * gstd_pipeline_batch_new: (constructor)
+ *
+ * Creates a new queue of transactional property updates.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineBatch.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineBatch *gstd_pipeline_batch_new (void);
+
+/**
+ * gstd_pipeline_batch_watch:
+ * @object: The batch
+ * @bin: The GStreamer pipeline whose elements are updated
+ *
+ * Sets the pipeline the element names of the transactions are looked
+ * up in.
+ */
+void gstd_pipeline_batch_watch (GstdPipelineBatch * object, GstBin * bin);
+
+/**
+ * gstd_pipeline_batch_unwatch:
+ * @object: The batch
+ *
+ * Discards the transactions still waiting for their buffer, typically
+ * before the GStreamer pipeline is torn down.
+ */
+void gstd_pipeline_batch_unwatch (GstdPipelineBatch * object);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_BATCH_H__
@@ -0,0 +1,216 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_pipeline_bulk.h"
+#include "gstd_object.h"
+
+/* Gstd Pipeline Bulk debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_bulk_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_bulk_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/* Upper bound of concurrent state changes in a single bulk operation */
+#define GSTD_PIPELINE_BULK_MAX_WORKERS 8
+
+#define GSTD_PIPELINE_BULK_SEPARATORS " ,"
+#define GSTD_PIPELINE_BULK_TRIGGERS "*?" GSTD_PIPELINE_BULK_SEPARATORS
+
+typedef struct _GstdPipelineBulkJob GstdPipelineBulkJob;
+
+struct _GstdPipelineBulkJob
+{
+  GstdObject *pipeline;
+  const gchar *state;
+  GstdReturnCode ret;
+};
+
+static void gstd_pipeline_bulk_init_debug (void);
+static gboolean gstd_pipeline_bulk_match (gchar ** patterns,
+    const gchar * name);
+static void gstd_pipeline_bulk_func (gpointer data, gpointer user_data);
+static void gstd_pipeline_bulk_job_free (GstdPipelineBulkJob * job);
+
+static void
+gstd_pipeline_bulk_init_debug (void)
+{
+  static gsize initialized = 0;
+  guint debug_color;
+
+  if (g_once_init_enter (&initialized)) {
+    /* Initialize debug category with nice colors */
+    debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+    GST_DEBUG_CATEGORY_INIT (gstd_pipeline_bulk_debug, "gstdpipelinebulk",
+        debug_color, "Gstd Pipeline Bulk category");
+    g_once_init_leave (&initialized, 1);
+  }
+}
+
+static gboolean
+gstd_pipeline_bulk_match (gchar ** patterns, const gchar * name)
+{
+  gchar **pattern;
+
+  for (pattern = patterns; *pattern; pattern++) {
+    /* Consecutive separators yield empty tokens */
+    if ('\0' == (*pattern)[0])
+      continue;
+
+    if (g_pattern_match_simple (*pattern, name))
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+static void
+gstd_pipeline_bulk_func (gpointer data, gpointer user_data)
+{
+  GstdPipelineBulkJob *job = data;
+  GstdObject *state;
+
+  job->ret = gstd_object_read (job->pipeline, "state", &state);
+  if (job->ret)
+    return;
+
+  job->ret = gstd_object_update (state, job->state);
+  g_object_unref (state);
+
+  GST_DEBUG ("Set \"%s\" to %s: %s", GSTD_OBJECT_NAME (job->pipeline),
+      job->state, gstd_return_code_to_string (job->ret));
+}
+
+static void
+gstd_pipeline_bulk_job_free (GstdPipelineBulkJob * job)
+{
+  g_object_unref (job->pipeline);
+  g_free (job);
+}
+
+gboolean
+gstd_pipeline_bulk_is_bulk (const gchar * names)
+{
+  g_return_val_if_fail (names, FALSE);
+
+  return NULL != strpbrk (names, GSTD_PIPELINE_BULK_TRIGGERS);
+}
+
+GstdReturnCode
+gstd_pipeline_bulk_set_state (GstdList * pipelines, const gchar * names,
+    const gchar * state, gchar ** response)
+{
+  GstdIFormatter *formatter;
+  GstdPipelineBulkJob *job;
+  GThreadPool *workers;
+  GList *jobs = NULL;
+  GValue code = G_VALUE_INIT;
+  GList *iter;
+  gchar **patterns;
+  GstdReturnCode ret = GSTD_EOK;
+  guint n_jobs;
+
+  g_return_val_if_fail (GSTD_IS_LIST (pipelines), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (names, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (state, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  gstd_pipeline_bulk_init_debug ();
+
+  patterns = g_strsplit_set (names, GSTD_PIPELINE_BULK_SEPARATORS, -1);
+
+  /* Take a snapshot of the matches, so the list isn't locked while
+     the state changes are in progress */
+  GST_OBJECT_LOCK (pipelines);
+  for (iter = pipelines->list; iter; iter = iter->next) {
+    if (!gstd_pipeline_bulk_match (patterns, GSTD_OBJECT_NAME (iter->data)))
+      continue;
+
+    job = g_new0 (GstdPipelineBulkJob, 1);
+    job->pipeline = g_object_ref (iter->data);
+    job->state = state;
+    job->ret = GSTD_EOK;
+    jobs = g_list_append (jobs, job);
+  }
+  GST_OBJECT_UNLOCK (pipelines);
+
+  g_strfreev (patterns);
+
+  n_jobs = g_list_length (jobs);
+  if (0 == n_jobs) {
+    GST_ERROR ("No pipeline matches \"%s\"", names);
+    return GSTD_NO_PIPELINE;
+  }
+
+  GST_INFO ("Setting %u pipelines matching \"%s\" to %s", n_jobs, names,
+      state);
+
+  workers = g_thread_pool_new (gstd_pipeline_bulk_func, NULL,
+      MIN (n_jobs, GSTD_PIPELINE_BULK_MAX_WORKERS), TRUE, NULL);
+
+  for (iter = jobs; iter; iter = iter->next) {
+    g_thread_pool_push (workers, iter->data, NULL);
+  }
+
+  /* Wait for every state change to finish */
+  g_thread_pool_free (workers, FALSE, TRUE);
+
+  formatter = g_object_new (GSTD_OBJECT (pipelines)->formatter_factory, NULL);
+
+  gstd_iformatter_begin_object (formatter);
+  gstd_iformatter_set_member_name (formatter, "pipelines");
+  gstd_iformatter_begin_array (formatter);
+
+  for (iter = jobs; iter; iter = iter->next) {
+    job = iter->data;
+
+    gstd_iformatter_begin_object (formatter);
+    gstd_iformatter_set_member_name (formatter, "name");
+    gstd_iformatter_set_string_value (formatter,
+        GSTD_OBJECT_NAME (job->pipeline));
+    g_value_init (&code, G_TYPE_INT);
+    g_value_set_int (&code, job->ret);
+    gstd_iformatter_set_member_name (formatter, "code");
+    gstd_iformatter_set_value (formatter, &code);
+    g_value_unset (&code);
+    gstd_iformatter_set_member_name (formatter, "description");
+    gstd_iformatter_set_string_value (formatter,
+        gstd_return_code_to_string (job->ret));
+    gstd_iformatter_end_object (formatter);
+
+    if (GSTD_EOK == ret && GSTD_EOK != job->ret)
+      ret = job->ret;
+  }
+
+  gstd_iformatter_end_array (formatter);
+  gstd_iformatter_end_object (formatter);
+
+  gstd_iformatter_generate (formatter, response);
+  g_object_unref (formatter);
+
+  g_list_free_full (jobs, (GDestroyNotify) gstd_pipeline_bulk_job_free);
+
+  return ret;
+}
@@ -0,0 +1,58 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_BULK_H__
+#define __GSTD_PIPELINE_BULK_H__
+
+#include <glib.h>
+
+#include "gstd_return_codes.h"
+#include "gstd_list.h"
+
+G_BEGIN_DECLS
+
+/**
+ * gstd_pipeline_bulk_is_bulk:
+ * @names: The pipeline names as provided by the user
+ *
+ * Checks whether @names refers to several pipelines, either as a
+ * glob (cam_*) or as a space or comma separated list.
+ *
+ * Returns: TRUE if @names should be handled as a bulk operation.
+ */
+gboolean gstd_pipeline_bulk_is_bulk (const gchar * names);
+
+/**
+ * gstd_pipeline_bulk_set_state:
+ * @pipelines: The list of pipelines to look the names up in
+ * @names: A glob or list of pipeline names
+ * @state: The state to set the matching pipelines to
+ * @response: (out): A per-pipeline summary of the results
+ *
+ * Changes the state of every pipeline matching @names concurrently,
+ * using a bounded amount of workers.
+ *
+ * Returns: GSTD_EOK if every state change succeeded, the code of
+ * the first failure otherwise.
+ */
+GstdReturnCode gstd_pipeline_bulk_set_state (GstdList * pipelines,
+    const gchar * names, const gchar * state, gchar ** response);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_BULK_H__
@@ -29,6 +29,7 @@ enum
   PROP_MESSAGE = 1,
   PROP_TIMEOUT,
   PROP_TYPES,
+  PROP_POLICY,
   N_PROPERTIES                  // NOT A PROPERTY
 };
 
@@ -40,7 +41,13 @@ struct _GstdPipelineBus
   GObject *bus;
   gint64 timeout;
   gint types;
+  gint policy;
 
+  /**
+   * Whether the pipeline was paused by the buffering policy. Only
+   * accessed from the main context
+   */
+  gboolean buffering;
 };
 
 struct _GstdPipelineBusClass
@@ -65,6 +72,35 @@ GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_bus_debug);
 #define GSTD_PIPELINE_BUS_TIMEOUT_MIN -1
 #define GSTD_PIPELINE_BUS_TIMEOUT_MAX G_MAXINT64
 #define GSTD_PIPELINE_BUS_TYPES_DEFAULT (GST_MESSAGE_ERROR | GST_MESSAGE_WARNING | GST_MESSAGE_INFO)
+#define GSTD_PIPELINE_BUS_POLICY_DEFAULT (GSTD_BUS_POLICY_BUFFERING | GSTD_BUS_POLICY_CLOCK_LOST | GSTD_BUS_POLICY_LATENCY)
+
+typedef struct _GstdBusPolicyAction GstdBusPolicyAction;
+
+struct _GstdBusPolicyAction
+{
+  GstdPipelineBus *self;
+  GstElement *pipeline;
+  GstMessage *message;
+};
+
+GType
+gstd_bus_policy_get_type (void)
+{
+  static GType policy_type = 0;
+  static const GFlagsValue policy_types[] = {
+    {GSTD_BUS_POLICY_BUFFERING, "GSTD_BUS_POLICY_BUFFERING", "buffering"},
+    {GSTD_BUS_POLICY_CLOCK_LOST, "GSTD_BUS_POLICY_CLOCK_LOST", "clock-lost"},
+    {GSTD_BUS_POLICY_LATENCY, "GSTD_BUS_POLICY_LATENCY", "latency"},
+    {GSTD_BUS_POLICY_REQUEST_STATE, "GSTD_BUS_POLICY_REQUEST_STATE",
+        "request-state"},
+    {0, NULL, NULL}
+  };
+
+  if (!policy_type) {
+    policy_type = g_flags_register_static ("GstdBusPolicy", policy_types);
+  }
+  return policy_type;
+}
 
 static void
 gstd_pipeline_bus_class_init (GstdPipelineBusClass * klass)
@@ -100,6 +136,14 @@ gstd_pipeline_bus_class_init (GstdPipelineBusClass * klass)
       GSTD_PIPELINE_BUS_TYPES_DEFAULT,
       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+  properties[PROP_POLICY] =
+      g_param_spec_flags ("policy",
+      "Policy",
+      "The messages the daemon reacts to on its own, as gst-launch does",
+      GSTD_TYPE_BUS_POLICY,
+      GSTD_PIPELINE_BUS_POLICY_DEFAULT,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (object_class, N_PROPERTIES, properties);
 
   /* Initialize debug category with nice colors */
@@ -115,6 +159,8 @@ gstd_pipeline_bus_init (GstdPipelineBus * self)
 
   self->timeout = GSTD_PIPELINE_BUS_TIMEOUT_DEFAULT;
   self->types = GSTD_PIPELINE_BUS_TYPES_DEFAULT;
+  self->policy = GSTD_PIPELINE_BUS_POLICY_DEFAULT;
+  self->buffering = FALSE;
 
   gstd_object_set_reader (GSTD_OBJECT (self),
       g_object_new (GSTD_TYPE_MSG_READER, NULL));
@@ -146,9 +192,13 @@ gstd_pipeline_bus_set_property (GObject * object,
       GST_INFO_OBJECT (self, "Timeout changed to: %li", self->timeout);
       break;
     case PROP_TYPES:
-      self->types = g_value_get_flags (value);
+      g_atomic_int_set (&self->types, g_value_get_flags (value));
       GST_INFO_OBJECT (self, "Types changed to: 0x%x", self->types);
       break;
+    case PROP_POLICY:
+      g_atomic_int_set (&self->policy, g_value_get_flags (value));
+      GST_INFO_OBJECT (self, "Policy changed to: 0x%x", self->policy);
+      break;
     default:
       /* We don't have any other property... */
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -175,7 +225,11 @@ gstd_pipeline_bus_get_property (GObject * object,
       break;
     case PROP_TYPES:
       GST_DEBUG_OBJECT (self, "Returning types 0x%x", self->types);
-      g_value_set_flags (value, self->types);
+      g_value_set_flags (value, g_atomic_int_get (&self->types));
+      break;
+    case PROP_POLICY:
+      GST_DEBUG_OBJECT (self, "Returning policy 0x%x", self->policy);
+      g_value_set_flags (value, g_atomic_int_get (&self->policy));
       break;
     default:
       /* We don't have any other property... */
@@ -203,3 +257,146 @@ gstd_pipeline_bus_get_bus (GstdPipelineBus * self)
 
   return gst_object_ref (self->bus);
 }
+
+gint
+gstd_pipeline_bus_get_types (GstdPipelineBus * self)
+{
+  g_return_val_if_fail (self, 0);
+
+  return g_atomic_int_get (&self->types);
+}
+
+static gboolean
+gstd_pipeline_bus_is_live (GstElement * pipeline)
+{
+  GstQuery *query;
+  gboolean live = FALSE;
+
+  query = gst_query_new_latency ();
+  if (gst_element_query (pipeline, query)) {
+    gst_query_parse_latency (query, &live, NULL, NULL);
+  }
+  gst_query_unref (query);
+
+  return live;
+}
+
+static void
+gstd_pipeline_bus_buffering (GstdPipelineBus * self, GstElement * pipeline,
+    GstMessage * message)
+{
+  gint percent;
+
+  gst_message_parse_buffering (message, &percent);
+
+  if (percent < 100) {
+    /* Live pipelines can't be paused without losing data */
+    if (!self->buffering &&
+        GST_STATE_PLAYING == GST_STATE_TARGET (pipeline) &&
+        !gstd_pipeline_bus_is_live (pipeline)) {
+      GST_INFO_OBJECT (self, "Buffering, pausing pipeline");
+      self->buffering = TRUE;
+      gst_element_set_state (pipeline, GST_STATE_PAUSED);
+    }
+  } else if (self->buffering) {
+    self->buffering = FALSE;
+
+    /* Don't override a state change requested meanwhile */
+    if (GST_STATE_PAUSED == GST_STATE_TARGET (pipeline)) {
+      GST_INFO_OBJECT (self, "Done buffering, resuming pipeline");
+      gst_element_set_state (pipeline, GST_STATE_PLAYING);
+    }
+  }
+}
+
+static gboolean
+gstd_pipeline_bus_apply_policy (gpointer user_data)
+{
+  GstdBusPolicyAction *action = user_data;
+  GstdPipelineBus *self = action->self;
+  GstElement *pipeline = action->pipeline;
+  GstState state;
+
+  switch (GST_MESSAGE_TYPE (action->message)) {
+    case GST_MESSAGE_BUFFERING:
+      gstd_pipeline_bus_buffering (self, pipeline, action->message);
+      break;
+    case GST_MESSAGE_CLOCK_LOST:
+      if (GST_STATE_PLAYING == GST_STATE_TARGET (pipeline)) {
+        GST_INFO_OBJECT (self, "Clock lost, selecting a new one");
+        gst_element_set_state (pipeline, GST_STATE_PAUSED);
+        gst_element_set_state (pipeline, GST_STATE_PLAYING);
+      }
+      break;
+    case GST_MESSAGE_LATENCY:
+      GST_DEBUG_OBJECT (self, "Recalculating latency");
+      gst_bin_recalculate_latency (GST_BIN (pipeline));
+      break;
+    case GST_MESSAGE_REQUEST_STATE:
+      gst_message_parse_request_state (action->message, &state);
+      GST_INFO_OBJECT (self, "%s requested state %s",
+          GST_MESSAGE_SRC_NAME (action->message),
+          gst_element_state_get_name (state));
+      gst_element_set_state (pipeline, state);
+      break;
+    default:
+      break;
+  }
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gstd_pipeline_bus_free_action (gpointer user_data)
+{
+  GstdBusPolicyAction *action = user_data;
+
+  g_object_unref (action->self);
+  gst_object_unref (action->pipeline);
+  gst_message_unref (action->message);
+  g_slice_free (GstdBusPolicyAction, action);
+}
+
+void
+gstd_pipeline_bus_handle (GstdPipelineBus * self, GstElement * pipeline,
+    GstMessage * message)
+{
+  GstdBusPolicyAction *action;
+  gint policy;
+  gint flag;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_BUS (self));
+  g_return_if_fail (GST_IS_ELEMENT (pipeline));
+  g_return_if_fail (GST_IS_MESSAGE (message));
+
+  switch (GST_MESSAGE_TYPE (message)) {
+    case GST_MESSAGE_BUFFERING:
+      flag = GSTD_BUS_POLICY_BUFFERING;
+      break;
+    case GST_MESSAGE_CLOCK_LOST:
+      flag = GSTD_BUS_POLICY_CLOCK_LOST;
+      break;
+    case GST_MESSAGE_LATENCY:
+      flag = GSTD_BUS_POLICY_LATENCY;
+      break;
+    case GST_MESSAGE_REQUEST_STATE:
+      flag = GSTD_BUS_POLICY_REQUEST_STATE;
+      break;
+    default:
+      return;
+  }
+
+  policy = g_atomic_int_get (&self->policy);
+  if (!(policy & flag)) {
+    return;
+  }
+
+  action = g_slice_new (GstdBusPolicyAction);
+  action->self = g_object_ref (self);
+  action->pipeline = gst_object_ref (pipeline);
+  action->message = gst_message_ref (message);
+
+  /* State changes can't be done from the streaming threads */
+  g_main_context_invoke_full (NULL, G_PRIORITY_DEFAULT,
+      gstd_pipeline_bus_apply_policy, action, gstd_pipeline_bus_free_action);
+}
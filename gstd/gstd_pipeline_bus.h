@@ -42,6 +42,30 @@ typedef struct _GstdPipelineBusClass GstdPipelineBusClass;
 
 GType gstd_pipeline_bus_get_type (void);
 
+/**
+ * GstdBusPolicy:
+ * @GSTD_BUS_POLICY_BUFFERING: Pause non-live pipelines while buffering
+ * and resume them once done
+ * @GSTD_BUS_POLICY_CLOCK_LOST: Select a new clock when the current one
+ * is lost
+ * @GSTD_BUS_POLICY_LATENCY: Recalculate the latency when an element
+ * requests it
+ * @GSTD_BUS_POLICY_REQUEST_STATE: Honor the state changes requested by
+ * elements
+ *
+ * The messages the daemon reacts to on its own, as gst-launch does.
+ */
+typedef enum
+{
+  GSTD_BUS_POLICY_BUFFERING = (1 << 0),
+  GSTD_BUS_POLICY_CLOCK_LOST = (1 << 1),
+  GSTD_BUS_POLICY_LATENCY = (1 << 2),
+  GSTD_BUS_POLICY_REQUEST_STATE = (1 << 3),
+} GstdBusPolicy;
+
+#define GSTD_TYPE_BUS_POLICY (gstd_bus_policy_get_type ())
+GType gstd_bus_policy_get_type (void);
+
 /**
  * gstd_pipeline_bus_new: (constructor)
  *
@@ -55,6 +79,28 @@ GstdPipelineBus *gstd_pipeline_bus_new (GstBus * bus);
 
 GstBus *gstd_pipeline_bus_get_bus (GstdPipelineBus * self);
 
+/**
+ * gstd_pipeline_bus_get_types:
+ * @self: The pipeline bus
+ *
+ * Returns: The GstMessageType flags of the messages subscribed to.
+ * Safe to be called from any thread.
+ */
+gint gstd_pipeline_bus_get_types (GstdPipelineBus * self);
+
+/**
+ * gstd_pipeline_bus_handle:
+ * @self: The pipeline bus
+ * @pipeline: The pipeline that posted @message
+ * @message: A message posted in the pipeline
+ *
+ * Reacts to @message according to the bus policy. The reaction is
+ * deferred to the main context, so this is safe to be called from the
+ * bus sync handler.
+ */
+void gstd_pipeline_bus_handle (GstdPipelineBus * self, GstElement * pipeline,
+    GstMessage * message);
+
 
 G_END_DECLS
 
@@ -0,0 +1,262 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_pipeline_dataplane.h"
+#include "gstd_pipeline_endpoint.h"
+
+/* Gstd Pipeline Dataplane debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_dataplane_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_dataplane_debug
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/**
+ * GstdPipelineDataplane:
+ * Creates and deletes the shared memory endpoints of a pipeline
+ */
+struct _GstdPipelineDataplane
+{
+  GObject parent;
+
+  GMutex lock;
+
+  /**
+   * The GStreamer pipeline holding the appsinks and appsrcs
+   */
+  GstBin *bin;
+
+  /**
+   * The endpoints created so far
+   */
+  GList *endpoints;
+};
+
+struct _GstdPipelineDataplaneClass
+{
+  GObjectClass parent_class;
+};
+
+/* VTable */
+static void gstd_pipeline_dataplane_dispose (GObject *);
+static void gstd_pipeline_dataplane_finalize (GObject *);
+static GstdReturnCode gstd_pipeline_dataplane_create (GstdICreator * iface,
+    const gchar * name, const gchar * description, GstdObject ** out);
+static GstdReturnCode gstd_pipeline_dataplane_delete (GstdIDeleter * iface,
+    GstdObject * object);
+
+static void
+gstd_icreator_interface_init (GstdICreatorInterface * iface)
+{
+  iface->create = gstd_pipeline_dataplane_create;
+}
+
+static void
+gstd_ideleter_interface_init (GstdIDeleterInterface * iface)
+{
+  iface->delete = gstd_pipeline_dataplane_delete;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GstdPipelineDataplane, gstd_pipeline_dataplane,
+    G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE (GSTD_TYPE_ICREATOR,
+        gstd_icreator_interface_init);
+    G_IMPLEMENT_INTERFACE (GSTD_TYPE_IDELETER, gstd_ideleter_interface_init));
+
+static void
+gstd_pipeline_dataplane_class_init (GstdPipelineDataplaneClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  guint debug_color;
+
+  object_class->dispose = gstd_pipeline_dataplane_dispose;
+  object_class->finalize = gstd_pipeline_dataplane_finalize;
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_dataplane_debug,
+      "gstdpipelinedataplane", debug_color, "Gstd Pipeline Dataplane category");
+}
+
+static void
+gstd_pipeline_dataplane_init (GstdPipelineDataplane * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline dataplane");
+
+  g_mutex_init (&self->lock);
+  self->bin = NULL;
+  self->endpoints = NULL;
+}
+
+GstdPipelineDataplane *
+gstd_pipeline_dataplane_new (void)
+{
+  return GSTD_PIPELINE_DATAPLANE (g_object_new (GSTD_TYPE_PIPELINE_DATAPLANE,
+          NULL));
+}
+
+static void
+gstd_pipeline_dataplane_dispose (GObject * object)
+{
+  GstdPipelineDataplane *self = GSTD_PIPELINE_DATAPLANE (object);
+  GList *endpoints;
+
+  GST_INFO_OBJECT (self, "Disposing pipeline dataplane");
+
+  gstd_pipeline_dataplane_unwatch (self);
+
+  g_mutex_lock (&self->lock);
+  endpoints = self->endpoints;
+  self->endpoints = NULL;
+  g_mutex_unlock (&self->lock);
+
+  g_list_free_full (endpoints, g_object_unref);
+
+  G_OBJECT_CLASS (gstd_pipeline_dataplane_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_dataplane_finalize (GObject * object)
+{
+  GstdPipelineDataplane *self = GSTD_PIPELINE_DATAPLANE (object);
+
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (gstd_pipeline_dataplane_parent_class)->finalize (object);
+}
+
+void
+gstd_pipeline_dataplane_watch (GstdPipelineDataplane * self, GstBin * bin)
+{
+  GList *node;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_DATAPLANE (self));
+  g_return_if_fail (GST_IS_BIN (bin));
+
+  g_mutex_lock (&self->lock);
+  if (self->bin) {
+    g_mutex_unlock (&self->lock);
+    GST_ERROR_OBJECT (self, "Already watching a pipeline");
+    return;
+  }
+
+  self->bin = gst_object_ref (bin);
+
+  /* Endpoints listed before a rebuild move to new rings */
+  for (node = self->endpoints; node; node = node->next) {
+    if (GSTD_EOK != gstd_pipeline_endpoint_attach (node->data, bin)) {
+      GST_WARNING_OBJECT (self, "Unable to attach \"%s\" again",
+          GSTD_OBJECT_NAME (node->data));
+    }
+  }
+  g_mutex_unlock (&self->lock);
+}
+
+void
+gstd_pipeline_dataplane_unwatch (GstdPipelineDataplane * self)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_DATAPLANE (self));
+
+  /* The elements are gone along with the pipeline, the endpoints stay
+     listed until deleted */
+  g_mutex_lock (&self->lock);
+  g_list_foreach (self->endpoints, (GFunc) gstd_pipeline_endpoint_detach,
+      NULL);
+  if (self->bin) {
+    gst_object_unref (self->bin);
+    self->bin = NULL;
+  }
+  g_mutex_unlock (&self->lock);
+}
+
+static GstdReturnCode
+gstd_pipeline_dataplane_create (GstdICreator * iface, const gchar * name,
+    const gchar * description, GstdObject ** out)
+{
+  GstdPipelineDataplane *self;
+  GstdPipelineEndpoint *endpoint;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (out, GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_DATAPLANE (iface);
+  *out = NULL;
+
+  if (NULL == name) {
+    GST_ERROR_OBJECT (self, "Endpoint name not provided");
+    return GSTD_MISSING_NAME;
+  }
+
+  if (NULL == description) {
+    GST_ERROR_OBJECT (self, "Endpoint element not provided");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  endpoint = gstd_pipeline_endpoint_new (name, description);
+  *out = GSTD_OBJECT (endpoint);
+
+  g_mutex_lock (&self->lock);
+  if (!self->bin) {
+    g_mutex_unlock (&self->lock);
+    GST_ERROR_OBJECT (self, "No pipeline to exchange data with");
+    return GSTD_NO_PIPELINE;
+  }
+
+  ret = gstd_pipeline_endpoint_attach (endpoint, self->bin);
+  if (GSTD_EOK == ret) {
+    self->endpoints =
+        g_list_append (self->endpoints, g_object_ref (endpoint));
+  }
+  g_mutex_unlock (&self->lock);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_pipeline_dataplane_delete (GstdIDeleter * iface, GstdObject * object)
+{
+  GstdPipelineDataplane *self;
+  GList *found;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_PIPELINE_ENDPOINT (object),
+      GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_DATAPLANE (iface);
+
+  g_mutex_lock (&self->lock);
+  found = g_list_find (self->endpoints, object);
+  if (found) {
+    self->endpoints = g_list_delete_link (self->endpoints, found);
+  }
+  g_mutex_unlock (&self->lock);
+
+  gstd_pipeline_endpoint_detach (GSTD_PIPELINE_ENDPOINT (object));
+
+  if (found) {
+    g_object_unref (object);
+  }
+
+  /* Release the reference held by the list */
+  g_object_unref (object);
+
+  return GSTD_EOK;
+}
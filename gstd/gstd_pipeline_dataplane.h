@@ -0,0 +1,77 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_DATAPLANE_H__
+#define __GSTD_PIPELINE_DATAPLANE_H__
+
+#include <gst/gst.h>
+#include <gstd_object.h>
+
+G_BEGIN_DECLS
+#define GSTD_TYPE_PIPELINE_DATAPLANE \
+  (gstd_pipeline_dataplane_get_type())
+#define GSTD_PIPELINE_DATAPLANE(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_DATAPLANE,GstdPipelineDataplane))
+#define GSTD_PIPELINE_DATAPLANE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_DATAPLANE,GstdPipelineDataplaneClass))
+#define GSTD_IS_PIPELINE_DATAPLANE(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_DATAPLANE))
+#define GSTD_IS_PIPELINE_DATAPLANE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_DATAPLANE))
+#define GSTD_PIPELINE_DATAPLANE_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_DATAPLANE, GstdPipelineDataplaneClass))
+
+typedef struct _GstdPipelineDataplane GstdPipelineDataplane;
+typedef struct _GstdPipelineDataplaneClass GstdPipelineDataplaneClass;
+
+GType gstd_pipeline_dataplane_get_type (void);
+
+/**
+ * gstd_pipeline_dataplane_new: (constructor)
+ *
+ * Creates the creator/deleter of the shared memory endpoints of a
+ * pipeline.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineDataplane.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineDataplane *gstd_pipeline_dataplane_new (void);
+
+/**
+ * gstd_pipeline_dataplane_watch:
+ * @object: The dataplane
+ * @bin: The GStreamer pipeline
+ *
+ * Sets the pipeline new endpoints look their elements up in, and
+ * attaches the existing endpoints to it, each to a new ring.
+ */
+void gstd_pipeline_dataplane_watch (GstdPipelineDataplane * object,
+    GstBin * bin);
+
+/**
+ * gstd_pipeline_dataplane_unwatch:
+ * @object: The dataplane
+ *
+ * Detaches the endpoints, typically before the GStreamer pipeline
+ * is torn down along with their elements.
+ */
+void gstd_pipeline_dataplane_unwatch (GstdPipelineDataplane * object);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_DATAPLANE_H__
@@ -0,0 +1,943 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <glib/gstdio.h>
+
+#include "gstd_pipeline_endpoint.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pipeline Endpoint debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_endpoint_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_endpoint_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+#define GSTD_PIPELINE_ENDPOINT_DEFAULT_SLOTS 4
+#define GSTD_PIPELINE_ENDPOINT_DEFAULT_SLOT_SIZE (8 * 1024 * 1024)
+
+/* How often the push side looks for slots written by the client */
+#define GSTD_PIPELINE_ENDPOINT_POLL_INTERVAL (2 * G_TIME_SPAN_MILLISECOND)
+
+/* Attempts to read the caps before giving up on a client that never
+   finishes writing them */
+#define GSTD_PIPELINE_ENDPOINT_CAPS_RETRIES 1000
+
+/* The buffer flags that make sense to carry across processes */
+#define GSTD_PIPELINE_ENDPOINT_FLAGS (GST_BUFFER_FLAG_LIVE | \
+    GST_BUFFER_FLAG_DISCONT | GST_BUFFER_FLAG_RESYNC | \
+    GST_BUFFER_FLAG_GAP | GST_BUFFER_FLAG_DROPPABLE | \
+    GST_BUFFER_FLAG_DELTA_UNIT | GST_BUFFER_FLAG_HEADER | \
+    GST_BUFFER_FLAG_MARKER)
+
+enum
+{
+  PROP_ELEMENT = 1,
+  PROP_DIRECTION,
+  PROP_PATH,
+  PROP_SLOTS,
+  PROP_SLOT_SIZE,
+  PROP_CAPS,
+  PROP_SAMPLES,
+  PROP_DROPPED,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/**
+ * GstdPipelineEndpointMapping:
+ * A mapped ring, alive while the endpoint or any buffer wrapping one
+ * of its slots uses it
+ */
+typedef struct
+{
+  gint refcount;
+  gpointer base;
+  gsize size;
+} GstdPipelineEndpointMapping;
+
+/**
+ * GstdPipelineEndpoint:
+ * Moves data between an appsink or appsrc and a ring of slots in a
+ * shared memory file, so that other processes on the same host can
+ * pull samples out of, or push buffers into, a running pipeline.
+ */
+struct _GstdPipelineEndpoint
+{
+  GstdObject parent;
+
+  gchar *element_name;
+  guint slots;
+  guint slot_size;
+
+  /**
+   * Whether the client pushes into an appsrc, rather than pulling
+   * from an appsink
+   */
+  gboolean push;
+
+  /**
+   * The ring file and its mapping, replaced on every attach
+   */
+  gchar *path;
+  GstdPipelineEndpointMapping *mapping;
+  GstdEndpointHeader *header;
+
+  /**
+   * The layout of the ring. The header has a copy for the client, but
+   * it's writable by it and never read back
+   */
+  guint64 slot_offset;
+  guint64 slot_stride;
+
+  /**
+   * The caps of the data, as last seen in the ring or in a sample
+   */
+  gchar *caps;
+  GstCaps *last_caps;
+
+  guint64 samples;
+  guint64 dropped;
+
+  /**
+   * The next slot to write or read, and the last caps sequence seen
+   * by the push thread. Only the appsink streaming thread or the
+   * push thread touch them
+   */
+  guint64 position;
+  gint caps_seq;
+
+  GstElement *element;
+  gulong sample_id;
+  gulong eos_id;
+
+  GMutex lock;
+  GCond cond;
+  GThread *thread;
+  gboolean running;
+};
+
+struct _GstdPipelineEndpointClass
+{
+  GstdObjectClass parent_class;
+};
+
+/**
+ * GstdPipelineEndpointRelease:
+ * Hands a slot back to the client once the buffer wrapping it is
+ * freed
+ */
+typedef struct
+{
+  GstdPipelineEndpoint *self;
+  GstdPipelineEndpointMapping *mapping;
+  GstdEndpointSlot *slot;
+} GstdPipelineEndpointRelease;
+
+G_DEFINE_TYPE (GstdPipelineEndpoint, gstd_pipeline_endpoint,
+    GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pipeline_endpoint_get_property (GObject *, guint, GValue *,
+    GParamSpec *);
+static void gstd_pipeline_endpoint_dispose (GObject *);
+static void gstd_pipeline_endpoint_finalize (GObject *);
+static GstdReturnCode gstd_pipeline_endpoint_map (GstdPipelineEndpoint *,
+    const gchar *);
+static gint gstd_pipeline_endpoint_open (const gchar *);
+static GstdPipelineEndpointMapping
+    * gstd_pipeline_endpoint_mapping_ref (GstdPipelineEndpointMapping *);
+static void gstd_pipeline_endpoint_mapping_unref (GstdPipelineEndpointMapping
+    *);
+static gint gstd_pipeline_endpoint_read_caps (GstdPipelineEndpoint *,
+    gchar **);
+static GstdEndpointSlot *gstd_pipeline_endpoint_slot (GstdPipelineEndpoint *,
+    guint64);
+static GstFlowReturn gstd_pipeline_endpoint_new_sample (GstElement *,
+    gpointer);
+static void gstd_pipeline_endpoint_eos (GstElement *, gpointer);
+static void gstd_pipeline_endpoint_write (GstdPipelineEndpoint *,
+    GstSample *);
+static gpointer gstd_pipeline_endpoint_push_loop (gpointer);
+static void gstd_pipeline_endpoint_push (GstdPipelineEndpoint *,
+    GstElement *, GstdEndpointSlot *);
+static void gstd_pipeline_endpoint_release (gpointer);
+static void gstd_pipeline_endpoint_set_caps (GstdPipelineEndpoint *,
+    GstElement *, gint);
+
+static void
+gstd_pipeline_endpoint_class_init (GstdPipelineEndpointClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->get_property = gstd_pipeline_endpoint_get_property;
+  object_class->dispose = gstd_pipeline_endpoint_dispose;
+  object_class->finalize = gstd_pipeline_endpoint_finalize;
+
+  properties[PROP_ELEMENT] =
+      g_param_spec_string ("element", "Element",
+      "The appsink or appsrc data is exchanged with",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_DIRECTION] =
+      g_param_spec_string ("direction", "Direction",
+      "Whether clients pull samples from the ring or push buffers into it",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_PATH] =
+      g_param_spec_string ("path", "Path",
+      "The shared memory file clients map the ring from",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_SLOTS] =
+      g_param_spec_uint ("slots", "Slots",
+      "The amount of slots in the ring",
+      1, G_MAXUINT, GSTD_PIPELINE_ENDPOINT_DEFAULT_SLOTS,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_SLOT_SIZE] =
+      g_param_spec_uint ("slot-size", "Slot size",
+      "The maximum size in bytes of the data in a slot",
+      1, G_MAXUINT, GSTD_PIPELINE_ENDPOINT_DEFAULT_SLOT_SIZE,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_CAPS] =
+      g_param_spec_string ("caps", "Caps",
+      "The caps of the data going through the ring",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_SAMPLES] =
+      g_param_spec_uint64 ("samples", "Samples",
+      "The amount of slots exchanged so far",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_DROPPED] =
+      g_param_spec_uint64 ("dropped", "Dropped",
+      "Samples dropped because the ring was full or they didn't fit a slot",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_endpoint_debug,
+      "gstdpipelineendpoint", debug_color, "Gstd Pipeline Endpoint category");
+}
+
+static void
+gstd_pipeline_endpoint_init (GstdPipelineEndpoint * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline endpoint");
+
+  self->element_name = NULL;
+  self->slots = GSTD_PIPELINE_ENDPOINT_DEFAULT_SLOTS;
+  self->slot_size = GSTD_PIPELINE_ENDPOINT_DEFAULT_SLOT_SIZE;
+  self->push = FALSE;
+  self->path = NULL;
+  self->mapping = NULL;
+  self->header = NULL;
+  self->caps = NULL;
+  self->last_caps = NULL;
+  self->samples = 0;
+  self->dropped = 0;
+  self->position = 0;
+  self->caps_seq = 0;
+  self->slot_offset = 0;
+  self->slot_stride = 0;
+  self->element = NULL;
+  self->sample_id = 0;
+  self->eos_id = 0;
+  self->thread = NULL;
+  self->running = FALSE;
+
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond);
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+GstdPipelineEndpoint *
+gstd_pipeline_endpoint_new (const gchar * name, const gchar * description)
+{
+  GstdPipelineEndpoint *self;
+  gchar **tokens;
+
+  g_return_val_if_fail (name, NULL);
+  g_return_val_if_fail (description, NULL);
+
+  self = GSTD_PIPELINE_ENDPOINT (g_object_new (GSTD_TYPE_PIPELINE_ENDPOINT,
+          "name", name, NULL));
+
+  tokens = g_strsplit (description, " ", 3);
+  self->element_name = g_strdup (tokens[0]);
+  if (tokens[0] && tokens[1]) {
+    self->slots = g_ascii_strtoull (tokens[1], NULL, 10);
+    if (tokens[2]) {
+      self->slot_size = g_ascii_strtoull (tokens[2], NULL, 10);
+    }
+  }
+  g_strfreev (tokens);
+
+  return self;
+}
+
+static void
+gstd_pipeline_endpoint_dispose (GObject * object)
+{
+  GstdPipelineEndpoint *self = GSTD_PIPELINE_ENDPOINT (object);
+
+  GST_INFO_OBJECT (self, "Disposing pipeline endpoint");
+
+  gstd_pipeline_endpoint_detach (self);
+
+  G_OBJECT_CLASS (gstd_pipeline_endpoint_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_endpoint_finalize (GObject * object)
+{
+  GstdPipelineEndpoint *self = GSTD_PIPELINE_ENDPOINT (object);
+
+  if (self->mapping) {
+    gstd_pipeline_endpoint_mapping_unref (self->mapping);
+  }
+
+  if (self->last_caps) {
+    gst_caps_unref (self->last_caps);
+  }
+
+  g_free (self->element_name);
+  g_free (self->path);
+  g_free (self->caps);
+
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond);
+
+  G_OBJECT_CLASS (gstd_pipeline_endpoint_parent_class)->finalize (object);
+}
+
+static void
+gstd_pipeline_endpoint_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineEndpoint *self = GSTD_PIPELINE_ENDPOINT (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (property_id) {
+    case PROP_ELEMENT:
+      g_value_set_string (value, self->element_name);
+      break;
+    case PROP_DIRECTION:
+      g_value_set_string (value, self->push ? "push" : "pull");
+      break;
+    case PROP_PATH:
+      g_value_set_string (value, self->path);
+      break;
+    case PROP_SLOTS:
+      g_value_set_uint (value, self->slots);
+      break;
+    case PROP_SLOT_SIZE:
+      g_value_set_uint (value, self->slot_size);
+      break;
+    case PROP_CAPS:
+      g_value_set_string (value, self->caps);
+      break;
+    case PROP_SAMPLES:
+      g_value_set_uint64 (value, self->samples);
+      break;
+    case PROP_DROPPED:
+      g_value_set_uint64 (value, self->dropped);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static GstdReturnCode
+gstd_pipeline_endpoint_map (GstdPipelineEndpoint * self, const gchar * prefix)
+{
+  const gchar *dir;
+  gchar *filename;
+  guint64 offset;
+  guint64 stride;
+  guint64 size;
+  gpointer ring;
+  gint fd;
+
+  offset = GST_ROUND_UP_64 (sizeof (GstdEndpointHeader));
+  stride = GST_ROUND_UP_64 (sizeof (GstdEndpointSlot) + self->slot_size);
+  size = offset + stride * self->slots;
+
+  if (stride > G_MAXUINT32 || size / stride < self->slots) {
+    GST_ERROR_OBJECT (self, "A ring of %u slots of %u bytes is too large",
+        self->slots, self->slot_size);
+    return GSTD_BAD_VALUE;
+  }
+
+  /* tmpfs backed whenever possible, so the ring never hits the disk */
+  dir = g_file_test ("/dev/shm", G_FILE_TEST_IS_DIR) ? "/dev/shm" :
+      g_get_tmp_dir ();
+  filename = g_strdup_printf ("gstd-%d-%s-%s", getpid (), prefix,
+      GSTD_OBJECT_NAME (self));
+  g_free (self->path);
+  self->path = g_build_filename (dir, filename, NULL);
+  g_free (filename);
+
+  fd = gstd_pipeline_endpoint_open (self->path);
+  if (fd < 0) {
+    GST_ERROR_OBJECT (self, "Unable to create \"%s\": %s", self->path,
+        g_strerror (errno));
+    return GSTD_IPC_ERROR;
+  }
+
+  ring = MAP_FAILED;
+  if (0 == ftruncate (fd, size)) {
+    ring = mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close (fd);
+
+  if (MAP_FAILED == ring) {
+    GST_ERROR_OBJECT (self, "Unable to map %" G_GUINT64_FORMAT " bytes of "
+        "\"%s\": %s", size, self->path, g_strerror (errno));
+    g_unlink (self->path);
+    return GSTD_IPC_ERROR;
+  }
+
+  self->mapping = g_new (GstdPipelineEndpointMapping, 1);
+  self->mapping->refcount = 1;
+  self->mapping->base = ring;
+  self->mapping->size = size;
+  self->header = (GstdEndpointHeader *) ring;
+  self->slot_offset = offset;
+  self->slot_stride = stride;
+
+  /* A fresh file reads as zeroes, so every slot starts FREE */
+  self->header->slots = self->slots;
+  self->header->slot_size = self->slot_size;
+  self->header->slot_offset = offset;
+  self->header->slot_stride = stride;
+  self->header->version = GSTD_ENDPOINT_VERSION;
+  g_atomic_int_set ((gint *) & self->header->magic, GSTD_ENDPOINT_MAGIC);
+
+  GST_INFO_OBJECT (self, "Mapped a ring of %u slots of %u bytes from \"%s\"",
+      self->slots, self->slot_size, self->path);
+
+  return GSTD_EOK;
+}
+
+/* The name is predictable and the directory world writable, never
+   follow or reuse whatever is already there */
+static gint
+gstd_pipeline_endpoint_open (const gchar * path)
+{
+  gint fd;
+
+  fd = g_open (path, O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW, 0600);
+  if (fd < 0 && EEXIST == errno) {
+    /* Left behind by a previous attach, or placed there on purpose.
+       Unlinking a symlink doesn't touch its target */
+    GST_WARNING ("Removing stale \"%s\"", path);
+    g_unlink (path);
+    fd = g_open (path, O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW, 0600);
+  }
+
+  return fd;
+}
+
+static GstdPipelineEndpointMapping *
+gstd_pipeline_endpoint_mapping_ref (GstdPipelineEndpointMapping * mapping)
+{
+  g_atomic_int_inc (&mapping->refcount);
+
+  return mapping;
+}
+
+static void
+gstd_pipeline_endpoint_mapping_unref (GstdPipelineEndpointMapping * mapping)
+{
+  if (g_atomic_int_dec_and_test (&mapping->refcount)) {
+    munmap (mapping->base, mapping->size);
+    g_free (mapping);
+  }
+}
+
+static GstdEndpointSlot *
+gstd_pipeline_endpoint_slot (GstdPipelineEndpoint * self, guint64 position)
+{
+  guint8 *ring = self->mapping->base;
+
+  return (GstdEndpointSlot *) (ring + self->slot_offset +
+      (position % self->slots) * self->slot_stride);
+}
+
+GstdReturnCode
+gstd_pipeline_endpoint_attach (GstdPipelineEndpoint * self, GstBin * bin)
+{
+  GstElement *element;
+  GstdReturnCode ret;
+  GType type;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE_ENDPOINT (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GST_IS_BIN (bin), GSTD_NULL_ARGUMENT);
+
+  if (!self->element_name) {
+    GST_ERROR_OBJECT (self, "Expected an appsink or appsrc");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  if (0 == self->slots || 0 == self->slot_size) {
+    GST_ERROR_OBJECT (self, "The ring needs at least one non empty slot");
+    return GSTD_BAD_VALUE;
+  }
+
+  if (self->element) {
+    GST_ERROR_OBJECT (self, "Already attached");
+    return GSTD_EXISTING_RESOURCE;
+  }
+
+  element = gst_bin_get_by_name (bin, self->element_name);
+  if (!element) {
+    GST_ERROR_OBJECT (self, "No element named \"%s\"", self->element_name);
+    return GSTD_NO_RESOURCE;
+  }
+
+  /* Tell them apart by their action signals, so that gstd doesn't need
+     to link against the app library */
+  type = G_OBJECT_TYPE (element);
+  if (g_signal_lookup ("pull-sample", type)) {
+    self->push = FALSE;
+  } else if (g_signal_lookup ("push-buffer", type)) {
+    self->push = TRUE;
+  } else {
+    GST_ERROR_OBJECT (self, "\"%s\" is neither an appsink nor an appsrc",
+        self->element_name);
+    gst_object_unref (element);
+    return GSTD_BAD_VALUE;
+  }
+
+  /* Attached again after a rebuild, start over in a new ring. The old
+     one goes away once clients and buffers are done with it */
+  if (self->mapping) {
+    gstd_pipeline_endpoint_mapping_unref (self->mapping);
+    self->mapping = NULL;
+    self->header = NULL;
+  }
+  self->position = 0;
+  self->caps_seq = 0;
+  gst_caps_replace (&self->last_caps, NULL);
+
+  ret = gstd_pipeline_endpoint_map (self, GST_OBJECT_NAME (bin));
+  if (GSTD_EOK != ret) {
+    gst_object_unref (element);
+    return ret;
+  }
+
+  g_mutex_lock (&self->lock);
+  self->element = element;
+
+  if (self->push) {
+    g_atomic_int_set (&self->running, TRUE);
+    self->thread = g_thread_new (GSTD_OBJECT_NAME (self),
+        gstd_pipeline_endpoint_push_loop, self);
+  } else {
+    /* The closures keep the endpoint alive during in-flight emissions */
+    self->sample_id = g_signal_connect_data (element, "new-sample",
+        G_CALLBACK (gstd_pipeline_endpoint_new_sample), g_object_ref (self),
+        (GClosureNotify) g_object_unref, 0);
+    self->eos_id = g_signal_connect_data (element, "eos",
+        G_CALLBACK (gstd_pipeline_endpoint_eos), g_object_ref (self),
+        (GClosureNotify) g_object_unref, 0);
+    g_object_set (element, "emit-signals", TRUE, NULL);
+  }
+  g_mutex_unlock (&self->lock);
+
+  GST_INFO_OBJECT (self, "Clients %s \"%s\" through \"%s\"",
+      self->push ? "push into" : "pull from", self->element_name, self->path);
+
+  return GSTD_EOK;
+}
+
+void
+gstd_pipeline_endpoint_detach (GstdPipelineEndpoint * self)
+{
+  GstElement *element;
+  GThread *thread;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_ENDPOINT (self));
+
+  g_mutex_lock (&self->lock);
+  element = self->element;
+  self->element = NULL;
+  thread = self->thread;
+  self->thread = NULL;
+  /* Also read without the lock while spinning on the caps */
+  g_atomic_int_set (&self->running, FALSE);
+  g_cond_signal (&self->cond);
+  g_mutex_unlock (&self->lock);
+
+  if (thread) {
+    g_thread_join (thread);
+  }
+
+  if (!element) {
+    return;
+  }
+
+  if (!self->push) {
+    g_signal_handler_disconnect (element, self->sample_id);
+    g_signal_handler_disconnect (element, self->eos_id);
+    self->sample_id = 0;
+    self->eos_id = 0;
+    g_object_set (element, "emit-signals", FALSE, NULL);
+
+    /* Let clients know nothing else is coming */
+    g_atomic_int_set (&self->header->eos, TRUE);
+  }
+  gst_object_unref (element);
+
+  /* Only the file goes away, mappings stay valid until unmapped */
+  g_unlink (self->path);
+
+  GST_INFO_OBJECT (self, "Detached from \"%s\"", self->element_name);
+}
+
+static GstFlowReturn
+gstd_pipeline_endpoint_new_sample (GstElement * appsink, gpointer user_data)
+{
+  GstdPipelineEndpoint *self = GSTD_PIPELINE_ENDPOINT (user_data);
+  GstSample *sample = NULL;
+
+  g_signal_emit_by_name (appsink, "pull-sample", &sample);
+
+  /* Flushing or EOS */
+  if (!sample) {
+    return GST_FLOW_OK;
+  }
+
+  gstd_pipeline_endpoint_write (self, sample);
+  gst_sample_unref (sample);
+
+  return GST_FLOW_OK;
+}
+
+static void
+gstd_pipeline_endpoint_eos (GstElement * appsink, gpointer user_data)
+{
+  GstdPipelineEndpoint *self = GSTD_PIPELINE_ENDPOINT (user_data);
+
+  GST_INFO_OBJECT (self, "End of stream reached \"%s\"", self->element_name);
+  g_atomic_int_set (&self->header->eos, TRUE);
+}
+
+static void
+gstd_pipeline_endpoint_write (GstdPipelineEndpoint * self, GstSample * sample)
+{
+  GstdEndpointSlot *slot;
+  GstBuffer *buffer;
+  GstCaps *caps;
+  GstMapInfo map;
+  gchar *caps_str;
+
+  buffer = gst_sample_get_buffer (sample);
+  if (!buffer) {
+    return;
+  }
+
+  slot = gstd_pipeline_endpoint_slot (self, self->position);
+
+  /* Never wait for a slow client, the pipeline would stall */
+  if (GSTD_ENDPOINT_SLOT_FREE != g_atomic_int_get (&slot->state)) {
+    GST_LOG_OBJECT (self, "Ring full, dropping sample");
+    goto drop;
+  }
+
+  if (gst_buffer_get_size (buffer) > self->slot_size) {
+    GST_WARNING_OBJECT (self, "Dropping a sample of %" G_GSIZE_FORMAT
+        " bytes, slots only hold %u", gst_buffer_get_size (buffer),
+        self->slot_size);
+    goto drop;
+  }
+
+  /* Published ahead of the slot, so that the client sees the caps
+     change no later than the first slot it applies to */
+  caps = gst_sample_get_caps (sample);
+  if (caps && (!self->last_caps
+          || !gst_caps_is_equal (caps, self->last_caps))) {
+    gst_caps_replace (&self->last_caps, caps);
+    caps_str = gst_caps_to_string (caps);
+
+    if (strlen (caps_str) >= GSTD_ENDPOINT_CAPS_SIZE) {
+      GST_WARNING_OBJECT (self, "Caps truncated in the ring: %s", caps_str);
+    }
+
+    /* Odd while the caps are being rewritten, see the sequence lock
+       in the ring layout */
+    g_atomic_int_inc (&self->header->caps_seq);
+    g_strlcpy (self->header->caps, caps_str, GSTD_ENDPOINT_CAPS_SIZE);
+    g_atomic_int_inc (&self->header->caps_seq);
+
+    GST_OBJECT_LOCK (self);
+    g_free (self->caps);
+    self->caps = caps_str;
+    GST_OBJECT_UNLOCK (self);
+  }
+
+  if (!gst_buffer_map (buffer, &map, GST_MAP_READ)) {
+    GST_WARNING_OBJECT (self, "Unable to map sample");
+    goto drop;
+  }
+  memcpy (slot + 1, map.data, map.size);
+  slot->size = map.size;
+  gst_buffer_unmap (buffer, &map);
+
+  slot->flags = GST_BUFFER_FLAGS (buffer) & GSTD_PIPELINE_ENDPOINT_FLAGS;
+  slot->caps_seq = g_atomic_int_get (&self->header->caps_seq);
+  slot->pts = GST_BUFFER_PTS (buffer);
+  slot->dts = GST_BUFFER_DTS (buffer);
+  slot->duration = GST_BUFFER_DURATION (buffer);
+  slot->seq = self->position++;
+
+  /* Data after an EOS means the stream was flushed or restarted */
+  if (g_atomic_int_get (&self->header->eos)) {
+    GST_INFO_OBJECT (self, "Stream restarted \"%s\"", self->element_name);
+    g_atomic_int_set (&self->header->eos, FALSE);
+  }
+
+  g_atomic_int_set (&slot->state, GSTD_ENDPOINT_SLOT_READY);
+
+  GST_OBJECT_LOCK (self);
+  self->samples++;
+  GST_OBJECT_UNLOCK (self);
+
+  return;
+
+drop:
+  {
+    GST_OBJECT_LOCK (self);
+    self->dropped++;
+    GST_OBJECT_UNLOCK (self);
+  }
+}
+
+static gpointer
+gstd_pipeline_endpoint_push_loop (gpointer user_data)
+{
+  GstdPipelineEndpoint *self = GSTD_PIPELINE_ENDPOINT (user_data);
+  GstdEndpointSlot *slot;
+  GstElement *appsrc;
+  gboolean eos = FALSE;
+  gboolean ended;
+  gint64 deadline;
+
+  GST_DEBUG_OBJECT (self, "Waiting for slots from the client");
+
+  /* Detach clears the element before joining this thread */
+  g_mutex_lock (&self->lock);
+  appsrc = gst_object_ref (self->element);
+  while (self->running) {
+    /* Read ahead of the slot, clients end the stream after writing
+       their last slot and it must be pushed first */
+    ended = g_atomic_int_get (&self->header->eos);
+    slot = gstd_pipeline_endpoint_slot (self, self->position);
+
+    if (GSTD_ENDPOINT_SLOT_READY == g_atomic_int_get (&slot->state)) {
+      g_mutex_unlock (&self->lock);
+      gstd_pipeline_endpoint_push (self, appsrc, slot);
+      g_mutex_lock (&self->lock);
+      continue;
+    }
+
+    /* The client may restart the stream after ending it */
+    if (eos && !ended) {
+      eos = FALSE;
+    }
+
+    if (!eos && ended) {
+      GST_INFO_OBJECT (self, "The client ended the stream");
+      eos = TRUE;
+      g_mutex_unlock (&self->lock);
+      g_signal_emit_by_name (appsrc, "end-of-stream", NULL);
+      g_mutex_lock (&self->lock);
+      continue;
+    }
+
+    deadline = g_get_monotonic_time () + GSTD_PIPELINE_ENDPOINT_POLL_INTERVAL;
+    g_cond_wait_until (&self->cond, &self->lock, deadline);
+  }
+  g_mutex_unlock (&self->lock);
+
+  gst_object_unref (appsrc);
+
+  return NULL;
+}
+
+static void
+gstd_pipeline_endpoint_push (GstdPipelineEndpoint * self, GstElement * appsrc,
+    GstdEndpointSlot * slot)
+{
+  GstdPipelineEndpointRelease *release;
+  GstFlowReturn flow;
+  GstBuffer *buffer;
+
+  /* The caps in the header apply from the first slot tagged with their
+     sequence. Slots tagged with older caps keep the current ones */
+  if ((gint) slot->caps_seq != self->caps_seq) {
+    gstd_pipeline_endpoint_set_caps (self, appsrc, slot->caps_seq);
+  }
+
+  g_atomic_int_set (&slot->state, GSTD_ENDPOINT_SLOT_BUSY);
+
+  release = g_new (GstdPipelineEndpointRelease, 1);
+  release->self = g_object_ref (self);
+  release->mapping = gstd_pipeline_endpoint_mapping_ref (self->mapping);
+  release->slot = slot;
+
+  /* The buffer wraps the slot, the client gets it back once the
+     pipeline is done with it */
+  buffer = gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY, slot + 1,
+      self->slot_size, 0, MIN (slot->size, self->slot_size), release,
+      gstd_pipeline_endpoint_release);
+  GST_BUFFER_FLAGS (buffer) = slot->flags & GSTD_PIPELINE_ENDPOINT_FLAGS;
+  GST_BUFFER_PTS (buffer) = slot->pts;
+  GST_BUFFER_DTS (buffer) = slot->dts;
+  GST_BUFFER_DURATION (buffer) = slot->duration;
+
+  self->position++;
+
+  g_signal_emit_by_name (appsrc, "push-buffer", buffer, &flow);
+  gst_buffer_unref (buffer);
+
+  GST_OBJECT_LOCK (self);
+  if (GST_FLOW_OK == flow) {
+    self->samples++;
+  } else {
+    self->dropped++;
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  if (GST_FLOW_OK != flow) {
+    GST_DEBUG_OBJECT (self, "Unable to push slot: %s",
+        gst_flow_get_name (flow));
+  }
+}
+
+static void
+gstd_pipeline_endpoint_release (gpointer user_data)
+{
+  GstdPipelineEndpointRelease *release = user_data;
+
+  g_atomic_int_set (&release->slot->state, GSTD_ENDPOINT_SLOT_FREE);
+  gstd_pipeline_endpoint_mapping_unref (release->mapping);
+  g_object_unref (release->self);
+  g_free (release);
+}
+
+/* Copies the caps out of the header under its sequence lock. Returns
+   an odd sequence and no caps if the client keeps them locked or the
+   endpoint is being detached */
+static gint
+gstd_pipeline_endpoint_read_caps (GstdPipelineEndpoint * self,
+    gchar ** caps_str)
+{
+  gint before;
+  gint after;
+  guint retries;
+
+  *caps_str = NULL;
+
+  for (retries = 0; retries < GSTD_PIPELINE_ENDPOINT_CAPS_RETRIES &&
+      g_atomic_int_get (&self->running); retries++) {
+    before = g_atomic_int_get (&self->header->caps_seq);
+    if (before & 1) {
+      g_thread_yield ();
+      continue;
+    }
+
+    *caps_str = g_strndup (self->header->caps, GSTD_ENDPOINT_CAPS_SIZE);
+    after = g_atomic_int_get (&self->header->caps_seq);
+    if (before == after) {
+      return before;
+    }
+
+    g_free (*caps_str);
+    *caps_str = NULL;
+  }
+
+  return -1;
+}
+
+static void
+gstd_pipeline_endpoint_set_caps (GstdPipelineEndpoint * self,
+    GstElement * appsrc, gint slot_seq)
+{
+  GstCaps *caps;
+  gchar *caps_str;
+  gint caps_seq;
+
+  caps_seq = gstd_pipeline_endpoint_read_caps (self, &caps_str);
+  if (!caps_str) {
+    GST_WARNING_OBJECT (self, "Unable to read the caps of slot %"
+        G_GUINT64_FORMAT ", keeping the current ones", self->position);
+    return;
+  }
+
+  if (caps_seq != slot_seq) {
+    /* Rewritten again since the slot, the caps it was written under
+       are gone */
+    GST_WARNING_OBJECT (self, "Missed the caps of slot %" G_GUINT64_FORMAT
+        ", keeping the current ones", self->position);
+    self->caps_seq = slot_seq;
+    g_free (caps_str);
+    return;
+  }
+
+  self->caps_seq = caps_seq;
+  caps = gst_caps_from_string (caps_str);
+
+  if (!caps) {
+    GST_WARNING_OBJECT (self, "Ignoring invalid caps \"%s\"", caps_str);
+    g_free (caps_str);
+    return;
+  }
+
+  GST_INFO_OBJECT (self, "Client caps changed to %" GST_PTR_FORMAT, caps);
+  g_object_set (appsrc, "caps", caps, NULL);
+  gst_caps_unref (caps);
+
+  GST_OBJECT_LOCK (self);
+  g_free (self->caps);
+  self->caps = caps_str;
+  GST_OBJECT_UNLOCK (self);
+}
@@ -0,0 +1,186 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_ENDPOINT_H__
+#define __GSTD_PIPELINE_ENDPOINT_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_ENDPOINT \
+  (gstd_pipeline_endpoint_get_type())
+#define GSTD_PIPELINE_ENDPOINT(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_ENDPOINT,GstdPipelineEndpoint))
+#define GSTD_PIPELINE_ENDPOINT_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_ENDPOINT,GstdPipelineEndpointClass))
+#define GSTD_IS_PIPELINE_ENDPOINT(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_ENDPOINT))
+#define GSTD_IS_PIPELINE_ENDPOINT_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_ENDPOINT))
+#define GSTD_PIPELINE_ENDPOINT_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_ENDPOINT, GstdPipelineEndpointClass))
+typedef struct _GstdPipelineEndpoint GstdPipelineEndpoint;
+typedef struct _GstdPipelineEndpointClass GstdPipelineEndpointClass;
+GType gstd_pipeline_endpoint_get_type (void);
+
+/*
+ * Shared ring layout. The ring file starts with a GstdEndpointHeader,
+ * followed by header->slots slots placed header->slot_stride bytes
+ * apart starting at header->slot_offset. Each slot starts with a
+ * GstdEndpointSlot followed by up to header->slot_size bytes of data.
+ *
+ * Slots are written and read in order. The writer waits for the next
+ * slot to be FREE, fills it and flips it to READY. The reader waits
+ * for the next slot to be READY, and flips it back to FREE once done
+ * with the data. The state is always accessed atomically, the rest of
+ * the slot belongs to whoever currently owns it.
+ *
+ * The caps are guarded by a sequence lock. The writer makes caps_seq
+ * odd, rewrites the caps and makes it even again. Readers retry while
+ * caps_seq is odd or changed during their copy. Every slot carries the
+ * caps_seq its data was written under, so a reader applies the caps
+ * in the header only from the first slot tagged with their sequence.
+ * The header only holds the latest caps: a reader finding a slot with
+ * a sequence it never saw, older than the header's, missed a caps
+ * change and should drop it.
+ *
+ * When the pipeline is rebuilt, the ring file is replaced by a new one
+ * at the same path, after setting eos in the old one. Pull clients
+ * seeing eos should map the path again.
+ */
+#define GSTD_ENDPOINT_MAGIC 0x44545347  /* "GSTD" */
+#define GSTD_ENDPOINT_VERSION 2
+#define GSTD_ENDPOINT_CAPS_SIZE 1024
+
+/**
+ * GstdEndpointSlotState:
+ * @GSTD_ENDPOINT_SLOT_FREE: The slot may be written
+ * @GSTD_ENDPOINT_SLOT_READY: The slot holds data not yet read
+ * @GSTD_ENDPOINT_SLOT_BUSY: The data is being read by gstd
+ *
+ * The ownership of a slot of the shared ring.
+ */
+typedef enum
+{
+  GSTD_ENDPOINT_SLOT_FREE,
+  GSTD_ENDPOINT_SLOT_READY,
+  GSTD_ENDPOINT_SLOT_BUSY,
+} GstdEndpointSlotState;
+
+/**
+ * GstdEndpointHeader:
+ * @magic: GSTD_ENDPOINT_MAGIC
+ * @version: GSTD_ENDPOINT_VERSION
+ * @slots: The amount of slots in the ring
+ * @slot_size: The maximum amount of data per slot
+ * @slot_offset: Where the first slot starts
+ * @slot_stride: The distance between slots
+ * @caps_seq: Sequence lock of @caps, odd while they are being written
+ * @eos: Set by the writer once no more slots will be written, cleared
+ * if the stream restarts
+ * @caps: The caps of the data, as a string
+ *
+ * The start of the shared ring.
+ */
+typedef struct
+{
+  guint32 magic;
+  guint32 version;
+  guint32 slots;
+  guint32 slot_size;
+  guint32 slot_offset;
+  guint32 slot_stride;
+  gint caps_seq;
+  gint eos;
+  gchar caps[GSTD_ENDPOINT_CAPS_SIZE];
+} GstdEndpointHeader;
+
+/**
+ * GstdEndpointSlot:
+ * @state: A #GstdEndpointSlotState
+ * @size: The amount of data in the slot
+ * @flags: The #GstBufferFlags of the data
+ * @caps_seq: The even caps_seq of the caps the data was written under
+ * @pts: The presentation timestamp, or GST_CLOCK_TIME_NONE
+ * @dts: The decoding timestamp, or GST_CLOCK_TIME_NONE
+ * @duration: The duration, or GST_CLOCK_TIME_NONE
+ * @seq: The position of the slot in the stream, starting at 0
+ *
+ * The metadata at the start of every slot.
+ */
+typedef struct
+{
+  gint state;
+  guint32 size;
+  guint32 flags;
+  guint32 caps_seq;
+  guint64 pts;
+  guint64 dts;
+  guint64 duration;
+  guint64 seq;
+} GstdEndpointSlot;
+
+/**
+ * gstd_pipeline_endpoint_new: (constructor)
+ * @name: The name of the endpoint
+ * @description: The appsink or appsrc to exchange data with, optionally
+ * followed by the amount of slots and the slot size in bytes, as in
+ * "<element> [<slots> [<slot-size>]]"
+ *
+ * Creates a new endpoint, not yet attached.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineEndpoint.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineEndpoint *gstd_pipeline_endpoint_new (const gchar * name,
+    const gchar * description);
+
+/**
+ * gstd_pipeline_endpoint_attach:
+ * @object: The endpoint
+ * @bin: The GStreamer pipeline holding the element
+ *
+ * Creates the shared ring and starts moving data between it and the
+ * element. Samples pulled from an appsink are written to the ring,
+ * slots written by the client are pushed into an appsrc.
+ *
+ * Returns: A GstdReturnCode with the status of the operation.
+ */
+GstdReturnCode gstd_pipeline_endpoint_attach (GstdPipelineEndpoint *
+    object, GstBin * bin);
+
+/**
+ * gstd_pipeline_endpoint_detach:
+ * @object: The endpoint
+ *
+ * Stops moving data and removes the ring file. Clients that already
+ * mapped the ring keep it until they unmap it, and so does gstd while
+ * buffers wrapping its slots are alive. The endpoint may be attached
+ * again, to a new ring.
+ */
+void gstd_pipeline_endpoint_detach (GstdPipelineEndpoint * object);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_ENDPOINT_H__
@@ -0,0 +1,470 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_pipeline_latency.h"
+#include "gstd_latency_stats.h"
+#include "gstd_list.h"
+#include "gstd_list_reader.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pipeline Latency debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_latency_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_latency_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/* The category GStreamer tracers log their records to */
+#define GSTD_PIPELINE_LATENCY_TRACER_CATEGORY "GST_TRACER"
+
+enum
+{
+  PROP_WINDOW = 1,
+  PROP_PATHS,
+  PROP_ELEMENTS,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/**
+ * GstdPipelineLatency:
+ * End to end and per element latency of a pipeline
+ */
+struct _GstdPipelineLatency
+{
+  GstdObject parent;
+
+  /**
+   * The amount of recent samples new entries keep
+   */
+  guint window;
+
+  /**
+   * Latency from each source to each sink
+   */
+  GstdList *paths;
+
+  /**
+   * Latency introduced by each element
+   */
+  GstdList *elements;
+
+  /**
+   * The watched pipeline
+   */
+  GstBin *bin;
+};
+
+struct _GstdPipelineLatencyClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPipelineLatency, gstd_pipeline_latency, GSTD_TYPE_OBJECT);
+
+/* Elements being watched, mapped to their aggregator. Elements are
+   only used as keys and never dereferenced from the records */
+static GMutex watched_lock;
+static GHashTable *watched = NULL;
+
+/* VTable */
+static void
+gstd_pipeline_latency_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void
+gstd_pipeline_latency_get_property (GObject *, guint, GValue *,
+    GParamSpec *);
+static void gstd_pipeline_latency_dispose (GObject *);
+static void gstd_pipeline_latency_add (GstdPipelineLatency *, GstdList *,
+    const gchar *, guint64);
+static void gstd_pipeline_latency_element_added (GstBin *, GstBin *,
+    GstElement *, gpointer);
+static void gstd_pipeline_latency_element_removed (GstBin *, GstBin *,
+    GstElement *, gpointer);
+static void gstd_pipeline_latency_log (GstDebugCategory *, GstDebugLevel,
+    const gchar *, const gchar *, gint, GObject *, GstDebugMessage *,
+    gpointer) G_GNUC_NO_INSTRUMENT;
+
+static void
+gstd_pipeline_latency_class_init (GstdPipelineLatencyClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_pipeline_latency_set_property;
+  object_class->get_property = gstd_pipeline_latency_get_property;
+  object_class->dispose = gstd_pipeline_latency_dispose;
+
+  properties[PROP_WINDOW] =
+      g_param_spec_uint ("window",
+      "Window",
+      "The amount of recent samples percentiles are computed over. "
+      "Applies to the paths and elements measured afterwards",
+      1, G_MAXUINT16, GSTD_LATENCY_STATS_DEFAULT_WINDOW,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_PATHS] =
+      g_param_spec_object ("paths",
+      "Paths",
+      "The latency from each source to each sink, as reported by the "
+      "latency tracer",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_ELEMENTS] =
+      g_param_spec_object ("elements",
+      "Elements",
+      "The latency introduced by each element, as reported by the "
+      "latency tracer with flags=element",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_latency_debug, "gstdpipelinelatency",
+      debug_color, "Gstd Pipeline Latency category");
+}
+
+static void
+gstd_pipeline_latency_init (GstdPipelineLatency * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline latency");
+
+  self->window = GSTD_LATENCY_STATS_DEFAULT_WINDOW;
+  self->bin = NULL;
+
+  self->paths = g_object_new (GSTD_TYPE_LIST, "name", "paths",
+      "node-type", GSTD_TYPE_LATENCY_STATS, "flags", GSTD_PARAM_READ, NULL);
+  self->elements = g_object_new (GSTD_TYPE_LIST, "name", "elements",
+      "node-type", GSTD_TYPE_LATENCY_STATS, "flags", GSTD_PARAM_READ, NULL);
+
+  gstd_object_set_reader (GSTD_OBJECT (self->paths),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+  gstd_object_set_reader (GSTD_OBJECT (self->elements),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_pipeline_latency_dispose (GObject * object)
+{
+  GstdPipelineLatency *self = GSTD_PIPELINE_LATENCY (object);
+
+  gstd_pipeline_latency_unwatch (self);
+
+  if (self->paths) {
+    g_object_unref (self->paths);
+    self->paths = NULL;
+  }
+
+  if (self->elements) {
+    g_object_unref (self->elements);
+    self->elements = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_pipeline_latency_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_latency_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineLatency *self = GSTD_PIPELINE_LATENCY (object);
+
+  switch (property_id) {
+    case PROP_WINDOW:
+      g_value_set_uint (value, g_atomic_int_get (&self->window));
+      break;
+    case PROP_PATHS:
+      GST_DEBUG_OBJECT (self, "Returning path list %p", self->paths);
+      g_value_set_object (value, self->paths);
+      break;
+    case PROP_ELEMENTS:
+      GST_DEBUG_OBJECT (self, "Returning element list %p", self->elements);
+      g_value_set_object (value, self->elements);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_pipeline_latency_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineLatency *self = GSTD_PIPELINE_LATENCY (object);
+
+  switch (property_id) {
+    case PROP_WINDOW:
+      g_atomic_int_set (&self->window, g_value_get_uint (value));
+      GST_INFO_OBJECT (self, "Changed window to %u", self->window);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+GstdPipelineLatency *
+gstd_pipeline_latency_new (void)
+{
+  return GSTD_PIPELINE_LATENCY (g_object_new (GSTD_TYPE_PIPELINE_LATENCY,
+          "name", "latency", NULL));
+}
+
+static void
+gstd_pipeline_latency_track (GstdPipelineLatency * self, GstElement * element)
+{
+  g_mutex_lock (&watched_lock);
+  g_hash_table_insert (watched, element, self);
+  g_mutex_unlock (&watched_lock);
+}
+
+static void
+gstd_pipeline_latency_untrack (GstdPipelineLatency * self,
+    GstElement * element)
+{
+  g_mutex_lock (&watched_lock);
+  if (self == g_hash_table_lookup (watched, element)) {
+    g_hash_table_remove (watched, element);
+  }
+  g_mutex_unlock (&watched_lock);
+}
+
+void
+gstd_pipeline_latency_watch (GstdPipelineLatency * self, GstBin * bin)
+{
+  static gsize consumer = 0;
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  gboolean done;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_LATENCY (self));
+  g_return_if_fail (GST_IS_BIN (bin));
+  g_return_if_fail (NULL == self->bin);
+
+  /* A single consumer serves every pipeline */
+  if (g_once_init_enter (&consumer)) {
+    watched = g_hash_table_new (g_direct_hash, g_direct_equal);
+    gst_debug_add_log_function (gstd_pipeline_latency_log, NULL, NULL);
+    g_once_init_leave (&consumer, 1);
+  }
+
+  self->bin = gst_object_ref (bin);
+  gstd_pipeline_latency_track (self, GST_ELEMENT (bin));
+
+#if GST_CHECK_VERSION(1,10,0)
+  g_signal_connect (bin, "deep-element-added",
+      G_CALLBACK (gstd_pipeline_latency_element_added), self);
+  g_signal_connect (bin, "deep-element-removed",
+      G_CALLBACK (gstd_pipeline_latency_element_removed), self);
+#endif
+
+  it = gst_bin_iterate_recurse (bin);
+  done = FALSE;
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:
+        gstd_pipeline_latency_track (self, g_value_get_object (&item));
+        g_value_reset (&item);
+        break;
+      case GST_ITERATOR_RESYNC:
+        gst_iterator_resync (it);
+        break;
+      case GST_ITERATOR_ERROR:
+        GST_ERROR_OBJECT (self, "Unknown element iterator error");
+        done = TRUE;
+        break;
+      case GST_ITERATOR_DONE:
+        done = TRUE;
+        break;
+    }
+  }
+  g_value_unset (&item);
+  gst_iterator_free (it);
+}
+
+static gboolean
+gstd_pipeline_latency_is_owner (gpointer key, gpointer value,
+    gpointer user_data)
+{
+  return value == user_data;
+}
+
+void
+gstd_pipeline_latency_unwatch (GstdPipelineLatency * self)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_LATENCY (self));
+
+  if (!self->bin) {
+    return;
+  }
+
+  g_signal_handlers_disconnect_by_data (self->bin, self);
+
+  g_mutex_lock (&watched_lock);
+  g_hash_table_foreach_remove (watched, gstd_pipeline_latency_is_owner, self);
+  g_mutex_unlock (&watched_lock);
+
+  gst_object_unref (self->bin);
+  self->bin = NULL;
+}
+
+static void
+gstd_pipeline_latency_element_added (GstBin * bin, GstBin * sub_bin,
+    GstElement * element, gpointer user_data)
+{
+  gstd_pipeline_latency_track (GSTD_PIPELINE_LATENCY (user_data), element);
+}
+
+static void
+gstd_pipeline_latency_element_removed (GstBin * bin, GstBin * sub_bin,
+    GstElement * element, gpointer user_data)
+{
+  gstd_pipeline_latency_untrack (GSTD_PIPELINE_LATENCY (user_data), element);
+}
+
+static void
+gstd_pipeline_latency_add (GstdPipelineLatency * self, GstdList * list,
+    const gchar * name, guint64 latency)
+{
+  GstdObject *stats;
+
+  stats = gstd_list_find_child (list, name);
+  if (!stats) {
+    stats = GSTD_OBJECT (gstd_latency_stats_new (name,
+            g_atomic_int_get (&self->window)));
+
+    /* Another streaming thread may have beaten us */
+    if (gstd_list_append_child (list, stats)) {
+      g_object_ref (stats);
+    } else {
+      g_object_unref (stats);
+      stats = gstd_list_find_child (list, name);
+    }
+  }
+
+  if (stats) {
+    gstd_latency_stats_add (GSTD_LATENCY_STATS (stats), latency);
+    g_object_unref (stats);
+  }
+}
+
+static GstdPipelineLatency *
+gstd_pipeline_latency_lookup (const GstStructure * record, const gchar * field)
+{
+  GstdPipelineLatency *self = NULL;
+  const gchar *id;
+  gpointer element;
+
+  /* Ids are the element addresses, as printed with %p */
+  id = gst_structure_get_string (record, field);
+  if (!id) {
+    return NULL;
+  }
+
+  element = GSIZE_TO_POINTER (g_ascii_strtoull (id, NULL, 16));
+
+  g_mutex_lock (&watched_lock);
+  self = g_hash_table_lookup (watched, element);
+  if (self) {
+    g_object_ref (self);
+  }
+  g_mutex_unlock (&watched_lock);
+
+  return self;
+}
+
+static void
+gstd_pipeline_latency_log (GstDebugCategory * category, GstDebugLevel level,
+    const gchar * file, const gchar * function, gint line, GObject * object,
+    GstDebugMessage * message, gpointer user_data)
+{
+  GstdPipelineLatency *self = NULL;
+  GstStructure *record;
+  const gchar *text;
+  guint64 latency;
+  gchar *name;
+
+  if (GST_LEVEL_TRACE != level
+      || strcmp (gst_debug_category_get_name (category),
+          GSTD_PIPELINE_LATENCY_TRACER_CATEGORY)) {
+    return;
+  }
+
+  text = gst_debug_message_get (message);
+  if (!g_str_has_prefix (text, "latency,")
+      && !g_str_has_prefix (text, "element-latency,")) {
+    return;
+  }
+
+  record = gst_structure_from_string (text, NULL);
+  if (!record) {
+    return;
+  }
+
+  if (!gst_structure_get_uint64 (record, "time", &latency)) {
+    goto out;
+  }
+
+  if (gst_structure_has_name (record, "latency")) {
+    /* End to end latency is attributed to the sink's pipeline */
+    self = gstd_pipeline_latency_lookup (record, "sink-element-id");
+    if (!self) {
+      goto out;
+    }
+
+    name = g_strdup_printf ("%s.%s->%s.%s",
+        gst_structure_get_string (record, "src-element"),
+        gst_structure_get_string (record, "src"),
+        gst_structure_get_string (record, "sink-element"),
+        gst_structure_get_string (record, "sink"));
+    gstd_pipeline_latency_add (self, self->paths, name, latency);
+    g_free (name);
+  } else {
+    const gchar *element = gst_structure_get_string (record, "element");
+
+    self = gstd_pipeline_latency_lookup (record, "element-id");
+    if (!self) {
+      goto out;
+    }
+
+    if (element) {
+      gstd_pipeline_latency_add (self, self->elements, element, latency);
+    }
+  }
+
+  g_object_unref (self);
+
+out:
+  gst_structure_free (record);
+}
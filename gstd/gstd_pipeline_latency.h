@@ -0,0 +1,81 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_LATENCY_H__
+#define __GSTD_PIPELINE_LATENCY_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_LATENCY \
+  (gstd_pipeline_latency_get_type())
+#define GSTD_PIPELINE_LATENCY(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_LATENCY,GstdPipelineLatency))
+#define GSTD_PIPELINE_LATENCY_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_LATENCY,GstdPipelineLatencyClass))
+#define GSTD_IS_PIPELINE_LATENCY(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_LATENCY))
+#define GSTD_IS_PIPELINE_LATENCY_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_LATENCY))
+#define GSTD_PIPELINE_LATENCY_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_LATENCY, GstdPipelineLatencyClass))
+typedef struct _GstdPipelineLatency GstdPipelineLatency;
+typedef struct _GstdPipelineLatencyClass GstdPipelineLatencyClass;
+GType gstd_pipeline_latency_get_type (void);
+
+/**
+ * gstd_pipeline_latency_new: (constructor)
+ *
+ * Creates a new object to aggregate the latency tracer records of a
+ * pipeline.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineLatency.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineLatency *gstd_pipeline_latency_new (void);
+
+/**
+ * gstd_pipeline_latency_watch:
+ * @object: The latency aggregator
+ * @bin: The pipeline whose elements are measured
+ *
+ * Starts attributing the latency records of the elements in @bin,
+ * including the ones added afterwards, to @object. Records are only
+ * produced once the latency tracer is enabled, see /debug/tracers.
+ */
+void gstd_pipeline_latency_watch (GstdPipelineLatency * object,
+    GstBin * bin);
+
+/**
+ * gstd_pipeline_latency_unwatch:
+ * @object: The latency aggregator
+ *
+ * Stops attributing latency records to @object. Must be called before
+ * disposing the watched pipeline.
+ */
+void gstd_pipeline_latency_unwatch (GstdPipelineLatency * object);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_LATENCY_H__
@@ -0,0 +1,663 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_pipeline_link.h"
+#include "gstd_property_reader.h"
+#include "gstd_session.h"
+
+/* Gstd Pipeline Link debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_link_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_link_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+enum
+{
+  PROP_PRODUCER = 1,
+  PROP_CONSUMER,
+  PROP_CAPS,
+  PROP_BUFFERS,
+  PROP_DROPPED,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+#define GSTD_PIPELINE_LINK_DEFAULT_ENDPOINT NULL
+
+/**
+ * GstdPipelineLink:
+ * Forwards the buffers flowing through a pad of a producer pipeline
+ * into an appsrc of a consumer pipeline. Endpoints are addressed as:
+ *
+ *   producer: <pipeline>.<element>[.<pad>]
+ *   consumer: <pipeline>.<appsrc>
+ *
+ * The pad defaults to the sink pad of the element, or its source pad
+ * if it has none, so any element (typically a fakesink or appsink
+ * right after the decoder) may act as producer. Several links sharing
+ * the same producer fan the stream out to several consumers.
+ *
+ * Buffers are handed over by reference: only their metadata is copied
+ * to translate the timestamps to the running time of the consumer, the
+ * memory is shared by every consumer. Both pipelines are expected to
+ * run on the system clock, so the producer running time is shifted by
+ * the difference of their base times. Caps changes, flushes and EOS
+ * are forwarded to the appsrc. When the appsrc queue is full the buffer
+ * is dropped for that consumer only, so a stalled consumer never blocks
+ * the producer.
+ */
+struct _GstdPipelineLink
+{
+  GstdObject parent;
+
+  gchar *producer;
+  gchar *consumer;
+
+  /**
+   * The producer pad the probe is installed on
+   */
+  GstPad *pad;
+  gulong probe;
+
+  /**
+   * The consumer appsrc
+   */
+  GstElement *appsrc;
+
+  /**
+   * The top level pipelines, whose base times relate both running times
+   */
+  GstElement *producer_top;
+  GstElement *consumer_top;
+
+  /**
+   * The last segment seen on the producer pad
+   */
+  GstSegment segment;
+
+  gchar *caps;
+  guint64 buffers;
+  guint64 dropped;
+};
+
+struct _GstdPipelineLinkClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPipelineLink, gstd_pipeline_link, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pipeline_link_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void
+gstd_pipeline_link_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void gstd_pipeline_link_dispose (GObject *);
+static void gstd_pipeline_link_finalize (GObject *);
+static GstdReturnCode gstd_pipeline_link_resolve (GstdPipelineLink *,
+    GstdSession *, const gchar *, GstElement **, gchar **);
+static GstPad *gstd_pipeline_link_find_pad (GstElement *, const gchar *);
+static GstPadProbeReturn gstd_pipeline_link_probe (GstPad *,
+    GstPadProbeInfo *, gpointer);
+static void gstd_pipeline_link_event (GstdPipelineLink *, GstElement *,
+    GstEvent *);
+static void gstd_pipeline_link_set_caps (GstdPipelineLink *, GstElement *,
+    GstCaps *);
+static void gstd_pipeline_link_push (GstdPipelineLink *, GstElement *,
+    GstBuffer *);
+static GstElement *gstd_pipeline_link_toplevel (GstElement *);
+static GstClockTime gstd_pipeline_link_shift (GstClockTime,
+    GstClockTimeDiff);
+
+static void
+gstd_pipeline_link_class_init (GstdPipelineLinkClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_pipeline_link_set_property;
+  object_class->get_property = gstd_pipeline_link_get_property;
+  object_class->dispose = gstd_pipeline_link_dispose;
+  object_class->finalize = gstd_pipeline_link_finalize;
+
+  properties[PROP_PRODUCER] =
+      g_param_spec_string ("producer",
+      "Producer",
+      "The producer endpoint as <pipeline>.<element>[.<pad>]",
+      GSTD_PIPELINE_LINK_DEFAULT_ENDPOINT,
+      G_PARAM_CONSTRUCT_ONLY |
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_CONSUMER] =
+      g_param_spec_string ("consumer",
+      "Consumer",
+      "The consumer endpoint as <pipeline>.<appsrc>",
+      GSTD_PIPELINE_LINK_DEFAULT_ENDPOINT,
+      G_PARAM_CONSTRUCT_ONLY |
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_CAPS] =
+      g_param_spec_string ("caps",
+      "Caps",
+      "The caps currently forwarded to the consumer",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_BUFFERS] =
+      g_param_spec_uint64 ("buffers",
+      "Buffers",
+      "Buffers handed over to the consumer",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_DROPPED] =
+      g_param_spec_uint64 ("dropped",
+      "Dropped",
+      "Buffers dropped because the consumer was full or not running",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_link_debug, "gstdpipelinelink",
+      debug_color, "Gstd Pipeline Link category");
+}
+
+static void
+gstd_pipeline_link_init (GstdPipelineLink * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline link");
+
+  self->producer = GSTD_PIPELINE_LINK_DEFAULT_ENDPOINT;
+  self->consumer = GSTD_PIPELINE_LINK_DEFAULT_ENDPOINT;
+  self->pad = NULL;
+  self->probe = 0;
+  self->appsrc = NULL;
+  self->producer_top = NULL;
+  self->consumer_top = NULL;
+  self->caps = NULL;
+  self->buffers = 0;
+  self->dropped = 0;
+  gst_segment_init (&self->segment, GST_FORMAT_TIME);
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_pipeline_link_dispose (GObject * object)
+{
+  GstdPipelineLink *self = GSTD_PIPELINE_LINK (object);
+
+  GST_INFO_OBJECT (self, "Disposing pipeline link");
+
+  gstd_pipeline_link_detach (self);
+
+  G_OBJECT_CLASS (gstd_pipeline_link_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_link_finalize (GObject * object)
+{
+  GstdPipelineLink *self = GSTD_PIPELINE_LINK (object);
+
+  g_free (self->producer);
+  g_free (self->consumer);
+  g_free (self->caps);
+
+  G_OBJECT_CLASS (gstd_pipeline_link_parent_class)->finalize (object);
+}
+
+static void
+gstd_pipeline_link_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineLink *self = GSTD_PIPELINE_LINK (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (property_id) {
+    case PROP_PRODUCER:
+      g_value_set_string (value, self->producer);
+      break;
+    case PROP_CONSUMER:
+      g_value_set_string (value, self->consumer);
+      break;
+    case PROP_CAPS:
+      g_value_set_string (value, self->caps);
+      break;
+    case PROP_BUFFERS:
+      g_value_set_uint64 (value, self->buffers);
+      break;
+    case PROP_DROPPED:
+      g_value_set_uint64 (value, self->dropped);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gstd_pipeline_link_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineLink *self = GSTD_PIPELINE_LINK (object);
+
+  switch (property_id) {
+    case PROP_PRODUCER:
+      g_free (self->producer);
+      self->producer = g_value_dup_string (value);
+      GST_INFO_OBJECT (self, "Changed producer to \"%s\"", self->producer);
+      break;
+    case PROP_CONSUMER:
+      g_free (self->consumer);
+      self->consumer = g_value_dup_string (value);
+      GST_INFO_OBJECT (self, "Changed consumer to \"%s\"", self->consumer);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+GstdReturnCode
+gstd_pipeline_link_attach (GstdPipelineLink * object)
+{
+  GstdPipelineLink *self = object;
+  GstdSession *session;
+  GstdReturnCode ret;
+  GstElement *producer;
+  GstElement *appsrc;
+  GstEvent *segment;
+  GstCaps *caps;
+  GstPad *pad;
+  gchar *padname;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE_LINK (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (self->producer, GSTD_MISSING_INITIALIZATION);
+  g_return_val_if_fail (self->consumer, GSTD_MISSING_INITIALIZATION);
+
+  producer = NULL;
+  appsrc = NULL;
+  padname = NULL;
+  pad = NULL;
+
+  session = GSTD_SESSION (g_object_new (GSTD_TYPE_SESSION, NULL));
+
+  ret = gstd_pipeline_link_resolve (self, session, self->producer, &producer,
+      &padname);
+  if (ret) {
+    goto out;
+  }
+
+  ret = gstd_pipeline_link_resolve (self, session, self->consumer, &appsrc,
+      NULL);
+  if (ret) {
+    goto out;
+  }
+
+  if (!g_signal_lookup ("push-buffer", G_OBJECT_TYPE (appsrc))) {
+    GST_ERROR_OBJECT (self, "The consumer \"%s\" is not an appsrc",
+        self->consumer);
+    ret = GSTD_BAD_VALUE;
+    goto out;
+  }
+
+  pad = gstd_pipeline_link_find_pad (producer, padname);
+  if (!pad) {
+    GST_ERROR_OBJECT (self, "No pad to take buffers from in \"%s\"",
+        self->producer);
+    ret = GSTD_NO_RESOURCE;
+    goto out;
+  }
+
+  /* Timestamps are translated to the consumer running time */
+  g_object_set (appsrc, "format", GST_FORMAT_TIME, NULL);
+
+  /* A producer that is already running won't send its caps and
+     segment again, so start from the sticky ones */
+  caps = gst_pad_get_current_caps (pad);
+  if (caps) {
+    gstd_pipeline_link_set_caps (self, appsrc, caps);
+    gst_caps_unref (caps);
+  }
+
+  segment = gst_pad_get_sticky_event (pad, GST_EVENT_SEGMENT, 0);
+  if (segment) {
+    gst_event_copy_segment (segment, &self->segment);
+    gst_event_unref (segment);
+  }
+
+  GST_OBJECT_LOCK (self);
+  self->pad = gst_object_ref (pad);
+  self->appsrc = gst_object_ref (appsrc);
+  self->producer_top = gstd_pipeline_link_toplevel (producer);
+  self->consumer_top = gstd_pipeline_link_toplevel (appsrc);
+  GST_OBJECT_UNLOCK (self);
+
+  /* The probe keeps the link alive for as long as it is installed */
+  self->probe = gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER |
+      GST_PAD_PROBE_TYPE_BUFFER_LIST | GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM |
+      GST_PAD_PROBE_TYPE_EVENT_FLUSH, gstd_pipeline_link_probe,
+      g_object_ref (self), g_object_unref);
+
+  GST_INFO_OBJECT (self, "Linked %s:%s to \"%s\"", GST_DEBUG_PAD_NAME (pad),
+      self->consumer);
+
+out:
+  if (pad) {
+    gst_object_unref (pad);
+  }
+  if (appsrc) {
+    gst_object_unref (appsrc);
+  }
+  if (producer) {
+    gst_object_unref (producer);
+  }
+  g_free (padname);
+  g_object_unref (session);
+
+  return ret;
+}
+
+void
+gstd_pipeline_link_detach (GstdPipelineLink * object)
+{
+  GstdPipelineLink *self = object;
+  GstElement *producer_top;
+  GstElement *consumer_top;
+  GstElement *appsrc;
+  GstPad *pad;
+  gulong probe;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_LINK (self));
+
+  GST_OBJECT_LOCK (self);
+  pad = self->pad;
+  probe = self->probe;
+  appsrc = self->appsrc;
+  producer_top = self->producer_top;
+  consumer_top = self->consumer_top;
+  self->pad = NULL;
+  self->probe = 0;
+  self->appsrc = NULL;
+  self->producer_top = NULL;
+  self->consumer_top = NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  if (pad) {
+    GST_INFO_OBJECT (self, "Unlinking %s:%s from \"%s\"",
+        GST_DEBUG_PAD_NAME (pad), self->consumer);
+    gst_pad_remove_probe (pad, probe);
+    gst_object_unref (pad);
+  }
+
+  if (appsrc) {
+    gst_object_unref (appsrc);
+  }
+  if (producer_top) {
+    gst_object_unref (producer_top);
+  }
+  if (consumer_top) {
+    gst_object_unref (consumer_top);
+  }
+}
+
+static GstdReturnCode
+gstd_pipeline_link_resolve (GstdPipelineLink * self, GstdSession * session,
+    const gchar * endpoint, GstElement ** element, gchar ** padname)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+  gchar **tokens;
+  gchar *uri;
+
+  // Tokens have the form {<pipeline>, <element>, [pad]}
+  tokens = g_strsplit (endpoint, ".", 3);
+  if (!tokens[0] || !tokens[1]) {
+    GST_ERROR_OBJECT (self, "Malformed endpoint \"%s\"", endpoint);
+    g_strfreev (tokens);
+    return GSTD_BAD_VALUE;
+  }
+
+  uri = g_strdup_printf ("/pipelines/%s/elements/%s", tokens[0], tokens[1]);
+  ret = gstd_get_by_uri (session, uri, &node);
+  g_free (uri);
+
+  if (ret) {
+    GST_ERROR_OBJECT (self, "Endpoint \"%s\" doesn't exist", endpoint);
+    g_strfreev (tokens);
+    return GSTD_NO_RESOURCE;
+  }
+
+  g_object_get (node, "gstelement", element, NULL);
+  g_object_unref (node);
+
+  if (padname) {
+    *padname = g_strdup (tokens[2]);
+  }
+  g_strfreev (tokens);
+
+  return GSTD_EOK;
+}
+
+static GstPad *
+gstd_pipeline_link_find_pad (GstElement * element, const gchar * padname)
+{
+  GstPad *pad;
+
+  if (padname) {
+    return gst_element_get_static_pad (element, padname);
+  }
+
+  pad = gst_element_get_static_pad (element, "sink");
+  if (!pad) {
+    pad = gst_element_get_static_pad (element, "src");
+  }
+
+  return pad;
+}
+
+static GstPadProbeReturn
+gstd_pipeline_link_probe (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstdPipelineLink *self = GSTD_PIPELINE_LINK (user_data);
+  GstBufferList *list;
+  GstElement *appsrc;
+  guint i;
+
+  GST_OBJECT_LOCK (self);
+  appsrc = self->appsrc ? gst_object_ref (self->appsrc) : NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  /* Detached while the buffer was on its way */
+  if (!appsrc) {
+    return GST_PAD_PROBE_OK;
+  }
+
+  if (GST_PAD_PROBE_INFO_TYPE (info) & (GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM |
+          GST_PAD_PROBE_TYPE_EVENT_FLUSH)) {
+    gstd_pipeline_link_event (self, appsrc, GST_PAD_PROBE_INFO_EVENT (info));
+  } else if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER) {
+    gstd_pipeline_link_push (self, appsrc, GST_PAD_PROBE_INFO_BUFFER (info));
+  } else if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    list = GST_PAD_PROBE_INFO_BUFFER_LIST (info);
+    for (i = 0; i < gst_buffer_list_length (list); i++) {
+      gstd_pipeline_link_push (self, appsrc, gst_buffer_list_get (list, i));
+    }
+  }
+
+  gst_object_unref (appsrc);
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+gstd_pipeline_link_event (GstdPipelineLink * self, GstElement * appsrc,
+    GstEvent * event)
+{
+  GstFlowReturn flow;
+  GstCaps *caps;
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_CAPS:
+      gst_event_parse_caps (event, &caps);
+      gstd_pipeline_link_set_caps (self, appsrc, caps);
+      break;
+    case GST_EVENT_SEGMENT:
+      GST_OBJECT_LOCK (self);
+      gst_event_copy_segment (event, &self->segment);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case GST_EVENT_FLUSH_START:
+    case GST_EVENT_FLUSH_STOP:
+      /* The appsrc drops its queue and lets the consumer flush too */
+      GST_DEBUG_OBJECT (self, "Forwarding %s", GST_EVENT_TYPE_NAME (event));
+      gst_element_send_event (appsrc, gst_event_copy (event));
+      break;
+    case GST_EVENT_EOS:
+      GST_INFO_OBJECT (self, "Forwarding EOS");
+      g_signal_emit_by_name (appsrc, "end-of-stream", &flow);
+      break;
+    default:
+      break;
+  }
+}
+
+static void
+gstd_pipeline_link_set_caps (GstdPipelineLink * self, GstElement * appsrc,
+    GstCaps * caps)
+{
+  gchar *str;
+
+  str = gst_caps_to_string (caps);
+  GST_INFO_OBJECT (self, "Forwarding caps %s", str);
+
+  /* The appsrc pushes the new caps downstream before its next buffer,
+     so the consumer renegotiates in place */
+  g_object_set (appsrc, "caps", caps, NULL);
+
+  GST_OBJECT_LOCK (self);
+  g_free (self->caps);
+  self->caps = str;
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gstd_pipeline_link_push (GstdPipelineLink * self, GstElement * appsrc,
+    GstBuffer * buffer)
+{
+  GstClockTimeDiff offset;
+  GstFlowReturn flow;
+  GstClockTime pts;
+  GstClockTime dts;
+  guint64 level;
+  guint64 max;
+
+  g_object_get (appsrc, "current-level-bytes", &level, "max-bytes", &max,
+      NULL);
+  if (max && level >= max) {
+    GST_LOG_OBJECT (self, "Consumer full, dropping %" GST_PTR_FORMAT, buffer);
+    GST_OBJECT_LOCK (self);
+    self->dropped++;
+    GST_OBJECT_UNLOCK (self);
+    return;
+  }
+
+  pts = GST_BUFFER_PTS (buffer);
+  dts = GST_BUFFER_DTS (buffer);
+
+  GST_OBJECT_LOCK (self);
+  if (GST_FORMAT_TIME == self->segment.format) {
+    pts = gst_segment_to_running_time (&self->segment, GST_FORMAT_TIME, pts);
+    dts = gst_segment_to_running_time (&self->segment, GST_FORMAT_TIME, dts);
+  }
+
+  /* Same clock time, seen from the consumer base time */
+  offset = 0;
+  if (self->producer_top && self->consumer_top) {
+    offset = GST_CLOCK_DIFF (gst_element_get_base_time (self->consumer_top),
+        gst_element_get_base_time (self->producer_top));
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  pts = gstd_pipeline_link_shift (pts, offset);
+  dts = gstd_pipeline_link_shift (dts, offset);
+
+  if (pts == GST_BUFFER_PTS (buffer) && dts == GST_BUFFER_DTS (buffer)) {
+    buffer = gst_buffer_ref (buffer);
+  } else {
+    /* Only the metadata is copied, the memory is shared */
+    buffer = gst_buffer_copy (buffer);
+    GST_BUFFER_PTS (buffer) = pts;
+    GST_BUFFER_DTS (buffer) = dts;
+  }
+
+  g_signal_emit_by_name (appsrc, "push-buffer", buffer, &flow);
+  gst_buffer_unref (buffer);
+
+  GST_OBJECT_LOCK (self);
+  if (GST_FLOW_OK == flow) {
+    self->buffers++;
+  } else {
+    self->dropped++;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+/* Returns the outermost bin holding the element */
+static GstElement *
+gstd_pipeline_link_toplevel (GstElement * element)
+{
+  GstObject *top;
+  GstObject *parent;
+
+  top = gst_object_ref (GST_OBJECT (element));
+  while ((parent = gst_object_get_parent (top))) {
+    gst_object_unref (top);
+    top = parent;
+  }
+
+  return GST_ELEMENT (top);
+}
+
+static GstClockTime
+gstd_pipeline_link_shift (GstClockTime time, GstClockTimeDiff offset)
+{
+  if (!GST_CLOCK_TIME_IS_VALID (time)) {
+    return time;
+  }
+
+  /* Earlier than the consumer start, it will be late anyway */
+  if (offset < 0 && time < (GstClockTime) (-offset)) {
+    return 0;
+  }
+
+  return time + offset;
+}
@@ -0,0 +1,115 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_pipeline_link_creator.h"
+#include "gstd_pipeline_link.h"
+
+/* Gstd Core debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_link_creator_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_link_creator_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+static GstdReturnCode gstd_pipeline_link_creator_create (GstdICreator * iface,
+    const gchar * name, const gchar * description, GstdObject ** out);
+
+typedef struct _GstdPipelineLinkCreatorClass GstdPipelineLinkCreatorClass;
+
+/**
+ * GstdPipelineLinkCreator:
+ * A creator for links between pipelines
+ */
+struct _GstdPipelineLinkCreator
+{
+  GObject parent;
+};
+
+struct _GstdPipelineLinkCreatorClass
+{
+  GObjectClass parent_class;
+};
+
+
+static void
+gstd_icreator_interface_init (GstdICreatorInterface * iface)
+{
+  iface->create = gstd_pipeline_link_creator_create;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GstdPipelineLinkCreator, gstd_pipeline_link_creator,
+    G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE (GSTD_TYPE_ICREATOR,
+        gstd_icreator_interface_init));
+
+static void
+gstd_pipeline_link_creator_class_init (GstdPipelineLinkCreatorClass * klass)
+{
+  guint debug_color;
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_link_creator_debug,
+      "gstdpipelinelinkcreator", debug_color,
+      "Gstd Pipeline Link Creator category");
+}
+
+static void
+gstd_pipeline_link_creator_init (GstdPipelineLinkCreator * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline link creator");
+}
+
+static GstdReturnCode
+gstd_pipeline_link_creator_create (GstdICreator * iface, const gchar * name,
+    const gchar * description, GstdObject ** out)
+{
+  GstdPipelineLink *link;
+  gchar **endpoints;
+  *out = NULL;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+
+  if (NULL == name) {
+    GST_ERROR_OBJECT (iface, "Link name not provided");
+    return GSTD_MISSING_NAME;
+  }
+
+  if (NULL == description) {
+    GST_ERROR_OBJECT (iface, "Link endpoints not provided");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  // Endpoints have the form {<producer>, <consumer>}
+  endpoints = g_strsplit (description, " ", 2);
+  if (!endpoints[0] || !endpoints[1]) {
+    GST_ERROR_OBJECT (iface, "Expected a producer and a consumer endpoint");
+    g_strfreev (endpoints);
+    return GSTD_BAD_DESCRIPTION;
+  }
+
+  link = g_object_new (GSTD_TYPE_PIPELINE_LINK, "name", name, "producer",
+      g_strstrip (endpoints[0]), "consumer", g_strstrip (endpoints[1]), NULL);
+  *out = GSTD_OBJECT (link);
+  g_strfreev (endpoints);
+
+  return gstd_pipeline_link_attach (link);
+}
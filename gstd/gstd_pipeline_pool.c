@@ -0,0 +1,491 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+
+#include "gstd_pipeline_pool.h"
+#include "gstd_property_reader.h"
+
+enum
+{
+  PROP_DESCRIPTION = 1,
+  PROP_SIZE,
+  PROP_STATE,
+  PROP_AVAILABLE,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+#define GSTD_PIPELINE_POOL_DEFAULT_DESCRIPTION NULL
+#define GSTD_PIPELINE_POOL_DEFAULT_SIZE 1
+#define GSTD_PIPELINE_POOL_MAX_SIZE 64
+#define GSTD_PIPELINE_POOL_DEFAULT_STATE GST_STATE_PAUSED
+
+/* Gstd Pipeline Pool debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_pool_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_pool_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+#define WARM_NAME "%s_warm%u"
+
+/**
+ * GstdPipelinePool:
+ * A set of pre-built pipelines parked in READY or PAUSED, ready
+ * to be handed out
+ */
+struct _GstdPipelinePool
+{
+  GstdObject parent;
+
+  /**
+   * The GstLaunch syntax used to create every instance
+   */
+  gchar *description;
+
+  /**
+   * The amount of warm instances to keep around
+   */
+  guint size;
+
+  /**
+   * The state the warm instances are parked in
+   */
+  GstState state;
+
+  /**
+   * The warm GstdPipelines ready to be handed out
+   */
+  GQueue idle;
+
+  /**
+   * The amount of instances being built in the background
+   */
+  guint pending;
+
+  /**
+   * Counter used to give each warm instance a unique name
+   */
+  guint serial;
+
+  /**
+   * Whether the pool has been built and may be refilled
+   */
+  gboolean built;
+
+  /**
+   * Worker refilling the pool in the background
+   */
+  GThreadPool *refill;
+};
+
+struct _GstdPipelinePoolClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPipelinePool, gstd_pipeline_pool, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pipeline_pool_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void
+gstd_pipeline_pool_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void gstd_pipeline_pool_dispose (GObject *);
+static GstdReturnCode gstd_pipeline_pool_build_instance (GstdPipelinePool *,
+    GstdPipeline **);
+static void gstd_pipeline_pool_refill (GstdPipelinePool *);
+static void gstd_pipeline_pool_refill_func (gpointer, gpointer);
+static void gstd_pipeline_pool_shrink (GstdPipelinePool *);
+
+static void
+gstd_pipeline_pool_class_init (GstdPipelinePoolClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_pipeline_pool_set_property;
+  object_class->get_property = gstd_pipeline_pool_get_property;
+  object_class->dispose = gstd_pipeline_pool_dispose;
+
+  properties[PROP_DESCRIPTION] =
+      g_param_spec_string ("description",
+      "Description",
+      "The gst-launch like description of the pooled pipelines",
+      GSTD_PIPELINE_POOL_DEFAULT_DESCRIPTION,
+      G_PARAM_CONSTRUCT_ONLY |
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_SIZE] =
+      g_param_spec_uint ("size",
+      "Size",
+      "The amount of warm pipelines to keep in the pool",
+      0, GSTD_PIPELINE_POOL_MAX_SIZE, GSTD_PIPELINE_POOL_DEFAULT_SIZE,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_STATE] =
+      g_param_spec_enum ("state",
+      "State",
+      "The state the warm pipelines are parked in (ready or paused)",
+      GST_TYPE_STATE, GSTD_PIPELINE_POOL_DEFAULT_STATE,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_AVAILABLE] =
+      g_param_spec_uint ("available",
+      "Available",
+      "The amount of warm pipelines ready to be handed out",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_pool_debug, "gstdpipelinepool",
+      debug_color, "Gstd Pipeline Pool category");
+}
+
+static void
+gstd_pipeline_pool_init (GstdPipelinePool * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline pool");
+
+  self->description = g_strdup (GSTD_PIPELINE_POOL_DEFAULT_DESCRIPTION);
+  self->size = GSTD_PIPELINE_POOL_DEFAULT_SIZE;
+  self->state = GSTD_PIPELINE_POOL_DEFAULT_STATE;
+  self->pending = 0;
+  self->serial = 0;
+  self->built = FALSE;
+  g_queue_init (&self->idle);
+
+  /* A single worker per pool, so that refills don't compete against
+     the pipelines already running for CPU */
+  self->refill = g_thread_pool_new (gstd_pipeline_pool_refill_func, self, 1,
+      FALSE, NULL);
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_pipeline_pool_dispose (GObject * object)
+{
+  GstdPipelinePool *self = GSTD_PIPELINE_POOL (object);
+  GstdPipeline *pipeline;
+
+  GST_INFO_OBJECT (self, "Disposing %s pool", GSTD_OBJECT_NAME (self));
+
+  /* Drop the queued refills and wait for the one in progress */
+  if (self->refill) {
+    g_thread_pool_free (self->refill, TRUE, TRUE);
+    self->refill = NULL;
+  }
+
+  /* Pipelines are stopped by their own dispose */
+  while ((pipeline = g_queue_pop_head (&self->idle))) {
+    g_object_unref (pipeline);
+  }
+
+  if (self->description) {
+    g_free (self->description);
+    self->description = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_pipeline_pool_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_pool_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelinePool *self = GSTD_PIPELINE_POOL (object);
+
+  switch (property_id) {
+    case PROP_DESCRIPTION:
+      GST_DEBUG_OBJECT (self, "Returning description of \"%s\"",
+          self->description);
+      g_value_set_string (value, self->description);
+      break;
+    case PROP_SIZE:
+      GST_DEBUG_OBJECT (self, "Returning size of %u", self->size);
+      g_value_set_uint (value, self->size);
+      break;
+    case PROP_STATE:
+      GST_DEBUG_OBJECT (self, "Returning state %s",
+          gst_element_state_get_name (self->state));
+      g_value_set_enum (value, self->state);
+      break;
+    case PROP_AVAILABLE:
+      GST_OBJECT_LOCK (self);
+      g_value_set_uint (value, self->idle.length);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_pipeline_pool_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdPipelinePool *self = GSTD_PIPELINE_POOL (object);
+  GstState state;
+
+  switch (property_id) {
+    case PROP_DESCRIPTION:
+      if (self->description)
+        g_free (self->description);
+      self->description = g_value_dup_string (value);
+      GST_INFO_OBJECT (self, "Changed description to \"%s\"",
+          self->description);
+      break;
+    case PROP_SIZE:
+      GST_OBJECT_LOCK (self);
+      self->size = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (self);
+      GST_INFO_OBJECT (self, "Changed size to %u", self->size);
+
+      /* Nothing to refill until the pool has been built */
+      if (self->built) {
+        gstd_pipeline_pool_shrink (self);
+        gstd_pipeline_pool_refill (self);
+      }
+      break;
+    case PROP_STATE:
+      state = g_value_get_enum (value);
+      if (GST_STATE_READY != state && GST_STATE_PAUSED != state) {
+        GST_ERROR_OBJECT (self, "Pipelines can only be parked in READY or "
+            "PAUSED, ignoring %s", gst_element_state_get_name (state));
+        break;
+      }
+      /* Only affects instances built from now on */
+      GST_OBJECT_LOCK (self);
+      self->state = state;
+      GST_OBJECT_UNLOCK (self);
+      GST_INFO_OBJECT (self, "Changed state to %s",
+          gst_element_state_get_name (state));
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static GstdReturnCode
+gstd_pipeline_pool_build_instance (GstdPipelinePool * self,
+    GstdPipeline ** out)
+{
+  GstdPipeline *pipeline;
+  GstdObject *state;
+  GstState target;
+  GstdReturnCode ret;
+  gchar *name;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE_POOL (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (out, GSTD_NULL_ARGUMENT);
+
+  *out = NULL;
+
+  GST_OBJECT_LOCK (self);
+  name = g_strdup_printf (WARM_NAME, GSTD_OBJECT_NAME (self), self->serial++);
+  target = self->state;
+  GST_OBJECT_UNLOCK (self);
+
+  pipeline = g_object_new (GSTD_TYPE_PIPELINE, "name", name, "description",
+      self->description, NULL);
+  g_free (name);
+
+  ret = gstd_pipeline_build (pipeline);
+  if (ret)
+    goto error;
+
+  ret = gstd_object_read (GSTD_OBJECT (pipeline), "state", &state);
+  if (ret)
+    goto error;
+
+  ret = gstd_object_update (state, gst_element_state_get_name (target));
+  g_object_unref (state);
+  if (ret)
+    goto error;
+
+  GST_DEBUG_OBJECT (self, "Built warm instance \"%s\"",
+      GSTD_OBJECT_NAME (pipeline));
+
+  *out = pipeline;
+  return GSTD_EOK;
+
+error:
+  {
+    GST_ERROR_OBJECT (self, "Unable to build a warm instance of \"%s\"",
+        self->description);
+    g_object_unref (pipeline);
+    return ret;
+  }
+}
+
+static void
+gstd_pipeline_pool_refill (GstdPipelinePool * self)
+{
+  guint missing;
+  guint i;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_POOL (self));
+
+  GST_OBJECT_LOCK (self);
+  missing = 0;
+  if (self->size > self->idle.length + self->pending) {
+    missing = self->size - self->idle.length - self->pending;
+  }
+  self->pending += missing;
+  GST_OBJECT_UNLOCK (self);
+
+  GST_DEBUG_OBJECT (self, "Scheduling %u warm instances", missing);
+
+  for (i = 0; i < missing; i++) {
+    g_thread_pool_push (self->refill, self, NULL);
+  }
+}
+
+static void
+gstd_pipeline_pool_refill_func (gpointer data, gpointer user_data)
+{
+  GstdPipelinePool *self = GSTD_PIPELINE_POOL (user_data);
+  GstdPipeline *pipeline;
+
+  gstd_pipeline_pool_build_instance (self, &pipeline);
+
+  GST_OBJECT_LOCK (self);
+  self->pending--;
+  /* The pool may have been shrunk while building */
+  if (pipeline && self->idle.length < self->size) {
+    g_queue_push_tail (&self->idle, pipeline);
+    pipeline = NULL;
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  if (pipeline) {
+    g_object_unref (pipeline);
+  }
+}
+
+static void
+gstd_pipeline_pool_shrink (GstdPipelinePool * self)
+{
+  GList *excess = NULL;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_POOL (self));
+
+  GST_OBJECT_LOCK (self);
+  while (self->idle.length > self->size) {
+    excess = g_list_prepend (excess, g_queue_pop_tail (&self->idle));
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  /* Tearing down a pipeline may block, don't hold the lock meanwhile */
+  g_list_free_full (excess, g_object_unref);
+}
+
+GstdReturnCode
+gstd_pipeline_pool_build (GstdPipelinePool * object)
+{
+  GstdPipelinePool *self = object;
+  GstdPipeline *pipeline;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE_POOL (self), GSTD_NULL_ARGUMENT);
+
+  if (NULL == self->description) {
+    GST_ERROR_OBJECT (self, "Pool description not provided");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  /* Build one instance right away, so a bad description is
+     reported to the user instead of failing in the background */
+  ret = gstd_pipeline_pool_build_instance (self, &pipeline);
+  if (ret)
+    return ret;
+
+  GST_OBJECT_LOCK (self);
+  if (self->size) {
+    g_queue_push_tail (&self->idle, pipeline);
+    pipeline = NULL;
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  if (pipeline) {
+    g_object_unref (pipeline);
+  }
+
+  self->built = TRUE;
+  gstd_pipeline_pool_refill (self);
+
+  return GSTD_EOK;
+}
+
+GstdReturnCode
+gstd_pipeline_pool_take (GstdPipelinePool * object, const gchar * name,
+    GstdPipeline ** pipeline)
+{
+  GstdPipelinePool *self = object;
+  GstdPipeline *warm;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE_POOL (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (name, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (pipeline, GSTD_NULL_ARGUMENT);
+
+  *pipeline = NULL;
+
+  GST_OBJECT_LOCK (self);
+  warm = g_queue_pop_head (&self->idle);
+  GST_OBJECT_UNLOCK (self);
+
+  if (!warm) {
+    GST_WARNING_OBJECT (self, "Pool \"%s\" is exhausted, building \"%s\" "
+        "from scratch", GSTD_OBJECT_NAME (self), name);
+    ret = gstd_pipeline_pool_build_instance (self, &warm);
+    if (ret)
+      goto out;
+  }
+
+  ret = gstd_pipeline_rename (warm, name);
+  if (ret) {
+    g_object_unref (warm);
+    goto out;
+  }
+
+  GST_INFO_OBJECT (self, "Handed out \"%s\" from pool \"%s\"", name,
+      GSTD_OBJECT_NAME (self));
+  *pipeline = warm;
+
+out:
+  gstd_pipeline_pool_refill (self);
+  return ret;
+}
@@ -0,0 +1,76 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_POOL_H__
+#define __GSTD_PIPELINE_POOL_H__
+
+#include <glib-object.h>
+
+#include "gstd_object.h"
+#include "gstd_pipeline.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_POOL \
+  (gstd_pipeline_pool_get_type())
+#define GSTD_PIPELINE_POOL(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_POOL,GstdPipelinePool))
+#define GSTD_PIPELINE_POOL_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_POOL,GstdPipelinePoolClass))
+#define GSTD_IS_PIPELINE_POOL(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_POOL))
+#define GSTD_IS_PIPELINE_POOL_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_POOL))
+#define GSTD_PIPELINE_POOL_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_POOL, GstdPipelinePoolClass))
+typedef struct _GstdPipelinePool GstdPipelinePool;
+typedef struct _GstdPipelinePoolClass GstdPipelinePoolClass;
+GType gstd_pipeline_pool_get_type (void);
+
+/**
+ * gstd_pipeline_pool_build:
+ * @object: The pool to populate
+ *
+ * Builds the first warm instance synchronously, to validate the
+ * template description, and schedules the rest of the pool to be
+ * built in the background.
+ *
+ * Returns: A GstdReturnCode with the build status.
+ */
+GstdReturnCode gstd_pipeline_pool_build (GstdPipelinePool * object);
+
+/**
+ * gstd_pipeline_pool_take:
+ * @object: The pool to take the instance from
+ * @name: The name to assign to the handed out pipeline
+ * @pipeline: (out) (transfer full): The warm pipeline
+ *
+ * Hands out one of the warm instances of the pool renamed as @name.
+ * If the pool is exhausted a new instance is built on the spot. In
+ * any case, the pool is refilled in the background.
+ *
+ * Returns: A GstdReturnCode with the status of the operation.
+ */
+GstdReturnCode gstd_pipeline_pool_take (GstdPipelinePool * object,
+    const gchar * name, GstdPipeline ** pipeline);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_POOL_H__
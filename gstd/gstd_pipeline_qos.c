@@ -0,0 +1,274 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_pipeline_qos.h"
+#include "gstd_qos_stats.h"
+#include "gstd_list.h"
+#include "gstd_list_reader.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pipeline QoS debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_qos_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_qos_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+enum
+{
+  PROP_WINDOW = 1,
+  PROP_ELEMENTS,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/**
+ * GstdPipelineQos:
+ * Per element QoS aggregates of a pipeline. Elements are keyed by their
+ * path below the pipeline with dots as separators, as in "bin.queue",
+ * so equally named elements in different bins are kept apart.
+ */
+struct _GstdPipelineQos
+{
+  GstdObject parent;
+
+  /**
+   * The time span the aggregates are computed over
+   */
+  guint64 window;
+
+  /**
+   * The aggregates of each element that posted QoS messages
+   */
+  GstdList *elements;
+};
+
+struct _GstdPipelineQosClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPipelineQos, gstd_pipeline_qos, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pipeline_qos_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void
+gstd_pipeline_qos_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_pipeline_qos_dispose (GObject *);
+static gchar *gstd_pipeline_qos_key (GstObject *);
+
+static void
+gstd_pipeline_qos_class_init (GstdPipelineQosClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_pipeline_qos_set_property;
+  object_class->get_property = gstd_pipeline_qos_get_property;
+  object_class->dispose = gstd_pipeline_qos_dispose;
+
+  properties[PROP_WINDOW] =
+      g_param_spec_uint64 ("window",
+      "Window",
+      "The time span the aggregates are computed over, in nanoseconds",
+      1, G_MAXUINT64, GSTD_QOS_STATS_DEFAULT_WINDOW,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_ELEMENTS] =
+      g_param_spec_object ("elements",
+      "Elements",
+      "The QoS aggregates of each element that posted QoS messages",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_qos_debug, "gstdpipelineqos",
+      debug_color, "Gstd Pipeline QoS category");
+}
+
+static void
+gstd_pipeline_qos_init (GstdPipelineQos * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline QoS");
+
+  self->window = GSTD_QOS_STATS_DEFAULT_WINDOW;
+
+  self->elements = g_object_new (GSTD_TYPE_LIST, "name", "elements",
+      "node-type", GSTD_TYPE_QOS_STATS, "flags", GSTD_PARAM_READ, NULL);
+
+  gstd_object_set_reader (GSTD_OBJECT (self->elements),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_pipeline_qos_dispose (GObject * object)
+{
+  GstdPipelineQos *self = GSTD_PIPELINE_QOS (object);
+
+  if (self->elements) {
+    g_object_unref (self->elements);
+    self->elements = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_pipeline_qos_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_qos_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineQos *self = GSTD_PIPELINE_QOS (object);
+
+  switch (property_id) {
+    case PROP_WINDOW:
+      GST_OBJECT_LOCK (self);
+      g_value_set_uint64 (value, self->window);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_ELEMENTS:
+      GST_DEBUG_OBJECT (self, "Returning element list %p", self->elements);
+      g_value_set_object (value, self->elements);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_pipeline_qos_set_window (GstdPipelineQos * self, guint64 window)
+{
+  GList *elements;
+  GList *node;
+
+  GST_OBJECT_LOCK (self);
+  self->window = window;
+  GST_OBJECT_UNLOCK (self);
+
+  GST_INFO_OBJECT (self, "Changed window to %" GST_TIME_FORMAT,
+      GST_TIME_ARGS (window));
+
+  GST_OBJECT_LOCK (self->elements);
+  elements = g_list_copy_deep (self->elements->list, (GCopyFunc) g_object_ref,
+      NULL);
+  GST_OBJECT_UNLOCK (self->elements);
+
+  for (node = elements; node; node = node->next) {
+    gstd_qos_stats_set_window (GSTD_QOS_STATS (node->data), window);
+  }
+
+  g_list_free_full (elements, g_object_unref);
+}
+
+static void
+gstd_pipeline_qos_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineQos *self = GSTD_PIPELINE_QOS (object);
+
+  switch (property_id) {
+    case PROP_WINDOW:
+      gstd_pipeline_qos_set_window (self, g_value_get_uint64 (value));
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+GstdPipelineQos *
+gstd_pipeline_qos_new (void)
+{
+  return GSTD_PIPELINE_QOS (g_object_new (GSTD_TYPE_PIPELINE_QOS,
+          "name", "qos", NULL));
+}
+
+void
+gstd_pipeline_qos_add (GstdPipelineQos * self, GstMessage * message)
+{
+  GstdObject *stats;
+  gchar *name;
+  guint64 window;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_QOS (self));
+  g_return_if_fail (GST_IS_MESSAGE (message));
+
+  if (!GST_MESSAGE_SRC (message)) {
+    return;
+  }
+
+  name = gstd_pipeline_qos_key (GST_MESSAGE_SRC (message));
+
+  stats = gstd_list_find_child (self->elements, name);
+  if (!stats) {
+    GST_OBJECT_LOCK (self);
+    window = self->window;
+    GST_OBJECT_UNLOCK (self);
+
+    stats = GSTD_OBJECT (gstd_qos_stats_new (name, window));
+
+    /* Another streaming thread may have beaten us */
+    if (gstd_list_append_child (self->elements, stats)) {
+      g_object_ref (stats);
+    } else {
+      g_object_unref (stats);
+      stats = gstd_list_find_child (self->elements, name);
+    }
+  }
+
+  if (stats) {
+    gstd_qos_stats_add (GSTD_QOS_STATS (stats), message);
+    g_object_unref (stats);
+  }
+  g_free (name);
+}
+
+static gchar *
+gstd_pipeline_qos_key (GstObject * object)
+{
+  gchar *path;
+  gchar *key;
+  gchar *rest;
+
+  /* "/pipeline/bin/queue" becomes "bin.queue", slashes would read as
+     nodes of the URI */
+  path = gst_object_get_path_string (object);
+  rest = strchr (path + 1, '/');
+  key = g_strdup (rest ? rest + 1 : path + 1);
+  g_strdelimit (key, "/", '.');
+  g_free (path);
+
+  return key;
+}
@@ -0,0 +1,71 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_QOS_H__
+#define __GSTD_PIPELINE_QOS_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_QOS \
+  (gstd_pipeline_qos_get_type())
+#define GSTD_PIPELINE_QOS(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_QOS,GstdPipelineQos))
+#define GSTD_PIPELINE_QOS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_QOS,GstdPipelineQosClass))
+#define GSTD_IS_PIPELINE_QOS(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_QOS))
+#define GSTD_IS_PIPELINE_QOS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_QOS))
+#define GSTD_PIPELINE_QOS_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_QOS, GstdPipelineQosClass))
+typedef struct _GstdPipelineQos GstdPipelineQos;
+typedef struct _GstdPipelineQosClass GstdPipelineQosClass;
+GType gstd_pipeline_qos_get_type (void);
+
+/**
+ * gstd_pipeline_qos_new: (constructor)
+ *
+ * Creates a new object to aggregate the QoS messages of the elements
+ * in a pipeline.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineQos. Free
+ * after usage using g_object_unref()
+ */
+GstdPipelineQos *gstd_pipeline_qos_new (void);
+
+/**
+ * gstd_pipeline_qos_add:
+ * @object: The QoS aggregator
+ * @message: A QoS message posted in the pipeline
+ *
+ * Accounts @message in the aggregates of the element that posted it,
+ * keyed by its path below the pipeline, as in "bin.queue". Safe to be
+ * called from the streaming threads.
+ */
+void gstd_pipeline_qos_add (GstdPipelineQos * object, GstMessage * message);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_QOS_H__
@@ -0,0 +1,259 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_pipeline_recorder.h"
+#include "gstd_pipeline_recording.h"
+
+/* Gstd Pipeline Recorder debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_recorder_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_recorder_debug
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/**
+ * GstdPipelineRecorder:
+ * Creates and deletes the recording branches of a pipeline
+ */
+struct _GstdPipelineRecorder
+{
+  GObject parent;
+
+  GMutex lock;
+
+  /**
+   * The GStreamer pipeline branches are attached to
+   */
+  GstBin *bin;
+
+  /**
+   * The recordings created so far
+   */
+  GList *recordings;
+};
+
+struct _GstdPipelineRecorderClass
+{
+  GObjectClass parent_class;
+};
+
+/* VTable */
+static void gstd_pipeline_recorder_dispose (GObject *);
+static void gstd_pipeline_recorder_finalize (GObject *);
+static GstdReturnCode gstd_pipeline_recorder_create (GstdICreator * iface,
+    const gchar * name, const gchar * description, GstdObject ** out);
+static GstdReturnCode gstd_pipeline_recorder_delete (GstdIDeleter * iface,
+    GstdObject * object);
+
+static void
+gstd_icreator_interface_init (GstdICreatorInterface * iface)
+{
+  iface->create = gstd_pipeline_recorder_create;
+}
+
+static void
+gstd_ideleter_interface_init (GstdIDeleterInterface * iface)
+{
+  iface->delete = gstd_pipeline_recorder_delete;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GstdPipelineRecorder, gstd_pipeline_recorder,
+    G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE (GSTD_TYPE_ICREATOR,
+        gstd_icreator_interface_init);
+    G_IMPLEMENT_INTERFACE (GSTD_TYPE_IDELETER, gstd_ideleter_interface_init));
+
+static void
+gstd_pipeline_recorder_class_init (GstdPipelineRecorderClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  guint debug_color;
+
+  object_class->dispose = gstd_pipeline_recorder_dispose;
+  object_class->finalize = gstd_pipeline_recorder_finalize;
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_recorder_debug,
+      "gstdpipelinerecorder", debug_color, "Gstd Pipeline Recorder category");
+}
+
+static void
+gstd_pipeline_recorder_init (GstdPipelineRecorder * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline recorder");
+
+  g_mutex_init (&self->lock);
+  self->bin = NULL;
+  self->recordings = NULL;
+}
+
+GstdPipelineRecorder *
+gstd_pipeline_recorder_new (void)
+{
+  return
+      GSTD_PIPELINE_RECORDER (g_object_new (GSTD_TYPE_PIPELINE_RECORDER, NULL));
+}
+
+static void
+gstd_pipeline_recorder_dispose (GObject * object)
+{
+  GstdPipelineRecorder *self = GSTD_PIPELINE_RECORDER (object);
+  GList *recordings;
+
+  GST_INFO_OBJECT (self, "Disposing pipeline recorder");
+
+  gstd_pipeline_recorder_unwatch (self);
+
+  g_mutex_lock (&self->lock);
+  recordings = self->recordings;
+  self->recordings = NULL;
+  g_mutex_unlock (&self->lock);
+
+  g_list_free_full (recordings, g_object_unref);
+
+  G_OBJECT_CLASS (gstd_pipeline_recorder_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_recorder_finalize (GObject * object)
+{
+  GstdPipelineRecorder *self = GSTD_PIPELINE_RECORDER (object);
+
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (gstd_pipeline_recorder_parent_class)->finalize (object);
+}
+
+void
+gstd_pipeline_recorder_watch (GstdPipelineRecorder * self, GstBin * bin)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_RECORDER (self));
+  g_return_if_fail (GST_IS_BIN (bin));
+
+  g_mutex_lock (&self->lock);
+  if (self->bin) {
+    g_mutex_unlock (&self->lock);
+    GST_ERROR_OBJECT (self, "Already watching a pipeline");
+    return;
+  }
+
+  self->bin = gst_object_ref (bin);
+  g_mutex_unlock (&self->lock);
+}
+
+void
+gstd_pipeline_recorder_unwatch (GstdPipelineRecorder * self)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_RECORDER (self));
+
+  /* The branches are gone along with the pipeline, the recordings stay
+     listed as aborted until deleted */
+  g_mutex_lock (&self->lock);
+  g_list_foreach (self->recordings, (GFunc) gstd_pipeline_recording_abort,
+      NULL);
+  if (self->bin) {
+    gst_object_unref (self->bin);
+    self->bin = NULL;
+  }
+  g_mutex_unlock (&self->lock);
+}
+
+static GstdReturnCode
+gstd_pipeline_recorder_create (GstdICreator * iface, const gchar * name,
+    const gchar * description, GstdObject ** out)
+{
+  GstdPipelineRecorder *self;
+  GstdPipelineRecording *recording;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (out, GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_RECORDER (iface);
+  *out = NULL;
+
+  if (NULL == name) {
+    GST_ERROR_OBJECT (self, "Recording name not provided");
+    return GSTD_MISSING_NAME;
+  }
+
+  if (NULL == description) {
+    GST_ERROR_OBJECT (self, "Recording tee and branch not provided");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  recording = gstd_pipeline_recording_new (name, description);
+  *out = GSTD_OBJECT (recording);
+
+  ret = gstd_pipeline_recording_build (recording);
+  if (GSTD_EOK != ret) {
+    return ret;
+  }
+
+  g_mutex_lock (&self->lock);
+  if (!self->bin) {
+    g_mutex_unlock (&self->lock);
+    GST_ERROR_OBJECT (self, "No pipeline to record from");
+    return GSTD_NO_PIPELINE;
+  }
+
+  ret = gstd_pipeline_recording_start (recording, self->bin);
+  if (GSTD_EOK == ret) {
+    self->recordings =
+        g_list_append (self->recordings, g_object_ref (recording));
+  }
+  g_mutex_unlock (&self->lock);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_pipeline_recorder_delete (GstdIDeleter * iface, GstdObject * object)
+{
+  GstdPipelineRecorder *self;
+  GList *found;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_PIPELINE_RECORDING (object),
+      GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_RECORDER (iface);
+
+  g_mutex_lock (&self->lock);
+  found = g_list_find (self->recordings, object);
+  if (found) {
+    self->recordings = g_list_delete_link (self->recordings, found);
+  }
+  g_mutex_unlock (&self->lock);
+
+  /* Finalizing the file continues in the background, the recording
+     keeps itself alive until the branch is removed */
+  gstd_pipeline_recording_stop (GSTD_PIPELINE_RECORDING (object));
+
+  if (found) {
+    g_object_unref (object);
+  }
+
+  /* Release the reference held by the list */
+  g_object_unref (object);
+
+  return GSTD_EOK;
+}
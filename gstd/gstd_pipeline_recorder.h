@@ -0,0 +1,76 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_RECORDER_H__
+#define __GSTD_PIPELINE_RECORDER_H__
+
+#include <gst/gst.h>
+#include <gstd_object.h>
+
+G_BEGIN_DECLS
+#define GSTD_TYPE_PIPELINE_RECORDER \
+  (gstd_pipeline_recorder_get_type())
+#define GSTD_PIPELINE_RECORDER(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_RECORDER,GstdPipelineRecorder))
+#define GSTD_PIPELINE_RECORDER_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_RECORDER,GstdPipelineRecorderClass))
+#define GSTD_IS_PIPELINE_RECORDER(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_RECORDER))
+#define GSTD_IS_PIPELINE_RECORDER_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_RECORDER))
+#define GSTD_PIPELINE_RECORDER_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_RECORDER, GstdPipelineRecorderClass))
+
+typedef struct _GstdPipelineRecorder GstdPipelineRecorder;
+typedef struct _GstdPipelineRecorderClass GstdPipelineRecorderClass;
+
+GType gstd_pipeline_recorder_get_type (void);
+
+/**
+ * gstd_pipeline_recorder_new: (constructor)
+ *
+ * Creates the creator/deleter of the recording branches of a
+ * pipeline.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineRecorder.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineRecorder *gstd_pipeline_recorder_new (void);
+
+/**
+ * gstd_pipeline_recorder_watch:
+ * @object: The recorder
+ * @bin: The GStreamer pipeline
+ *
+ * Sets the pipeline new recording branches are attached to.
+ */
+void gstd_pipeline_recorder_watch (GstdPipelineRecorder * object,
+    GstBin * bin);
+
+/**
+ * gstd_pipeline_recorder_unwatch:
+ * @object: The recorder
+ *
+ * Aborts the running recordings, typically before the GStreamer
+ * pipeline is torn down along with their branches.
+ */
+void gstd_pipeline_recorder_unwatch (GstdPipelineRecorder * object);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_RECORDER_H__
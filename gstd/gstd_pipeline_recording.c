@@ -0,0 +1,612 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_pipeline_recording.h"
+#include "gstd_event_factory.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pipeline Recording debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_recording_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_recording_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+enum
+{
+  PROP_TEE = 1,
+  PROP_BRANCH,
+  PROP_STATUS,
+  PROP_DROPPED,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/**
+ * GstdPipelineRecording:
+ * A branch attached to a tee of a running pipeline. The branch is
+ * described as a gst-launch fragment ending in a sink, and a queue is
+ * prepended to it so that the EOS sent on detach is handled in the
+ * branch thread, without stalling the tee.
+ */
+struct _GstdPipelineRecording
+{
+  GstdObject parent;
+
+  gchar *tee_name;
+  gchar *branch;
+
+  GstdRecordingStatus status;
+
+  /**
+   * Buffers dropped while waiting for the first keyframe
+   */
+  guint64 dropped;
+
+  /**
+   * The pipeline, tee and tee pad the branch is attached to
+   */
+  GstBin *pipeline;
+  GstElement *tee;
+  GstPad *teepad;
+
+  /**
+   * The branch and its ghost sink pad
+   */
+  GstElement *bin;
+  GstPad *sinkpad;
+
+  /**
+   * Sinks in the branch the EOS hasn't reached yet
+   */
+  guint pending;
+};
+
+struct _GstdPipelineRecordingClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPipelineRecording, gstd_pipeline_recording,
+    GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pipeline_recording_get_property (GObject *, guint, GValue *,
+    GParamSpec *);
+static void gstd_pipeline_recording_dispose (GObject *);
+static void gstd_pipeline_recording_finalize (GObject *);
+static GstPadProbeReturn gstd_pipeline_recording_gate (GstPad *,
+    GstPadProbeInfo *, gpointer);
+static GstPadProbeReturn gstd_pipeline_recording_unlink (GstPad *,
+    GstPadProbeInfo *, gpointer);
+static GstPadProbeReturn gstd_pipeline_recording_eos (GstPad *,
+    GstPadProbeInfo *, gpointer);
+static gboolean gstd_pipeline_recording_finish (gpointer);
+static void gstd_pipeline_recording_watch_sinks (GstdPipelineRecording *);
+static void gstd_pipeline_recording_remove (GstdPipelineRecording *);
+
+GType
+gstd_recording_status_get_type (void)
+{
+  static GType status_type = 0;
+  static const GEnumValue status_types[] = {
+    {GSTD_RECORDING_STATUS_WAITING, "GSTD_RECORDING_STATUS_WAITING",
+        "waiting"},
+    {GSTD_RECORDING_STATUS_RECORDING, "GSTD_RECORDING_STATUS_RECORDING",
+        "recording"},
+    {GSTD_RECORDING_STATUS_FINALIZING, "GSTD_RECORDING_STATUS_FINALIZING",
+        "finalizing"},
+    {GSTD_RECORDING_STATUS_FINISHED, "GSTD_RECORDING_STATUS_FINISHED",
+        "finished"},
+    {GSTD_RECORDING_STATUS_ABORTED, "GSTD_RECORDING_STATUS_ABORTED",
+        "aborted"},
+    {0, NULL, NULL}
+  };
+
+  if (!status_type) {
+    status_type =
+        g_enum_register_static ("GstdRecordingStatus", status_types);
+  }
+  return status_type;
+}
+
+static void
+gstd_pipeline_recording_class_init (GstdPipelineRecordingClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->get_property = gstd_pipeline_recording_get_property;
+  object_class->dispose = gstd_pipeline_recording_dispose;
+  object_class->finalize = gstd_pipeline_recording_finalize;
+
+  properties[PROP_TEE] =
+      g_param_spec_string ("tee", "Tee",
+      "The tee the branch is attached to",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_BRANCH] =
+      g_param_spec_string ("branch", "Branch",
+      "The description of the recording branch",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_STATUS] =
+      g_param_spec_enum ("status", "Status",
+      "The progress of the recording",
+      GSTD_TYPE_RECORDING_STATUS, GSTD_RECORDING_STATUS_WAITING,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_DROPPED] =
+      g_param_spec_uint64 ("dropped", "Dropped",
+      "Buffers dropped while waiting for the first keyframe",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_recording_debug,
+      "gstdpipelinerecording", debug_color, "Gstd Pipeline Recording category");
+}
+
+static void
+gstd_pipeline_recording_init (GstdPipelineRecording * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline recording");
+
+  self->tee_name = NULL;
+  self->branch = NULL;
+  self->status = GSTD_RECORDING_STATUS_WAITING;
+  self->dropped = 0;
+  self->pipeline = NULL;
+  self->tee = NULL;
+  self->teepad = NULL;
+  self->bin = NULL;
+  self->sinkpad = NULL;
+  self->pending = 0;
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+GstdPipelineRecording *
+gstd_pipeline_recording_new (const gchar * name, const gchar * description)
+{
+  GstdPipelineRecording *self;
+  gchar **tokens;
+
+  g_return_val_if_fail (name, NULL);
+  g_return_val_if_fail (description, NULL);
+
+  self = GSTD_PIPELINE_RECORDING (g_object_new (GSTD_TYPE_PIPELINE_RECORDING,
+          "name", name, NULL));
+
+  tokens = g_strsplit (description, " ", 2);
+  self->tee_name = g_strdup (tokens[0]);
+  self->branch = g_strdup (tokens[1]);
+  g_strfreev (tokens);
+
+  return self;
+}
+
+static void
+gstd_pipeline_recording_dispose (GObject * object)
+{
+  GstdPipelineRecording *self = GSTD_PIPELINE_RECORDING (object);
+
+  GST_INFO_OBJECT (self, "Disposing pipeline recording");
+
+  gstd_pipeline_recording_abort (self);
+
+  G_OBJECT_CLASS (gstd_pipeline_recording_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_recording_finalize (GObject * object)
+{
+  GstdPipelineRecording *self = GSTD_PIPELINE_RECORDING (object);
+
+  g_free (self->tee_name);
+  g_free (self->branch);
+
+  G_OBJECT_CLASS (gstd_pipeline_recording_parent_class)->finalize (object);
+}
+
+static void
+gstd_pipeline_recording_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineRecording *self = GSTD_PIPELINE_RECORDING (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (property_id) {
+    case PROP_TEE:
+      g_value_set_string (value, self->tee_name);
+      break;
+    case PROP_BRANCH:
+      g_value_set_string (value, self->branch);
+      break;
+    case PROP_STATUS:
+      g_value_set_enum (value, self->status);
+      break;
+    case PROP_DROPPED:
+      g_value_set_uint64 (value, self->dropped);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+GstdReturnCode
+gstd_pipeline_recording_build (GstdPipelineRecording * self)
+{
+  GstElement *bin;
+  GError *error;
+  gchar *description;
+  gchar *name;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE_RECORDING (self), GSTD_NULL_ARGUMENT);
+
+  if (!self->tee_name || !self->branch) {
+    GST_ERROR_OBJECT (self, "Expected a tee followed by the branch");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  error = NULL;
+  description = g_strdup_printf ("queue ! %s", self->branch);
+  bin = gst_parse_bin_from_description (description, TRUE, &error);
+  g_free (description);
+
+  if (!bin) {
+    GST_ERROR_OBJECT (self, "Unable to create the branch: %s",
+        error ? error->message : "unknown error");
+    g_clear_error (&error);
+    return GSTD_BAD_DESCRIPTION;
+  }
+  g_clear_error (&error);
+
+  name = g_strdup_printf ("%s-recording", GSTD_OBJECT_NAME (self));
+  gst_object_set_name (GST_OBJECT (bin), name);
+  g_free (name);
+
+  self->bin = gst_object_ref_sink (bin);
+  self->sinkpad = gst_element_get_static_pad (self->bin, "sink");
+
+  if (!self->sinkpad) {
+    GST_ERROR_OBJECT (self, "The branch doesn't take any input");
+    return GSTD_BAD_DESCRIPTION;
+  }
+
+  return GSTD_EOK;
+}
+
+GstdReturnCode
+gstd_pipeline_recording_start (GstdPipelineRecording * self, GstBin * bin)
+{
+  GstElement *tee;
+  GstPad *teepad;
+  GstEvent *event;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE_RECORDING (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GST_IS_BIN (bin), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (self->bin, GSTD_MISSING_INITIALIZATION);
+
+  tee = gst_bin_get_by_name (bin, self->tee_name);
+  if (!tee) {
+    GST_ERROR_OBJECT (self, "No element named \"%s\"", self->tee_name);
+    return GSTD_NO_RESOURCE;
+  }
+#if GST_CHECK_VERSION(1,20,0)
+  teepad = gst_element_request_pad_simple (tee, "src_%u");
+#else
+  teepad = gst_element_get_request_pad (tee, "src_%u");
+#endif
+
+  if (!teepad) {
+    GST_ERROR_OBJECT (self, "\"%s\" is not a tee", self->tee_name);
+    gst_object_unref (tee);
+    return GSTD_BAD_VALUE;
+  }
+
+  if (!gst_bin_add (bin, self->bin)) {
+    GST_ERROR_OBJECT (self, "The pipeline already has a branch named %s",
+        GST_OBJECT_NAME (self->bin));
+    gst_element_release_request_pad (tee, teepad);
+    gst_object_unref (teepad);
+    gst_object_unref (tee);
+    return GSTD_EXISTING_RESOURCE;
+  }
+
+  GST_OBJECT_LOCK (self);
+  self->pipeline = gst_object_ref (bin);
+  self->tee = tee;
+  self->teepad = teepad;
+  GST_OBJECT_UNLOCK (self);
+
+  gstd_pipeline_recording_watch_sinks (self);
+
+  /* Gate before linking, so that the branch starts on a keyframe */
+  gst_pad_add_probe (teepad, GST_PAD_PROBE_TYPE_BUFFER |
+      GST_PAD_PROBE_TYPE_BUFFER_LIST, gstd_pipeline_recording_gate,
+      g_object_ref (self), g_object_unref);
+
+  if (!gst_element_sync_state_with_parent (self->bin)) {
+    GST_ERROR_OBJECT (self, "Unable to start the branch");
+    gstd_pipeline_recording_remove (self);
+    return GSTD_STATE_ERROR;
+  }
+
+  if (GST_PAD_LINK_OK != gst_pad_link (teepad, self->sinkpad)) {
+    GST_ERROR_OBJECT (self, "Unable to link the branch to \"%s\"",
+        self->tee_name);
+    gstd_pipeline_recording_remove (self);
+    return GSTD_BAD_VALUE;
+  }
+
+  /* Don't wait for the next natural keyframe */
+  event = gstd_event_factory_make ("force_key_unit", "upstream");
+  if (event) {
+    gst_pad_send_event (teepad, event);
+  }
+
+  GST_INFO_OBJECT (self, "Attached recording to %s:%s",
+      GST_DEBUG_PAD_NAME (teepad));
+
+  return GSTD_EOK;
+}
+
+void
+gstd_pipeline_recording_stop (GstdPipelineRecording * self)
+{
+  GstPad *teepad;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_RECORDING (self));
+
+  GST_OBJECT_LOCK (self);
+  if (!self->teepad || (GSTD_RECORDING_STATUS_WAITING != self->status &&
+          GSTD_RECORDING_STATUS_RECORDING != self->status)) {
+    GST_OBJECT_UNLOCK (self);
+    return;
+  }
+  self->status = GSTD_RECORDING_STATUS_FINALIZING;
+  teepad = gst_object_ref (self->teepad);
+  GST_OBJECT_UNLOCK (self);
+
+  GST_INFO_OBJECT (self, "Detaching recording from %s:%s",
+      GST_DEBUG_PAD_NAME (teepad));
+
+  /* Unlink between buffers, the other branches keep flowing */
+  gst_pad_add_probe (teepad, GST_PAD_PROBE_TYPE_IDLE,
+      gstd_pipeline_recording_unlink, g_object_ref (self), g_object_unref);
+  gst_object_unref (teepad);
+}
+
+void
+gstd_pipeline_recording_abort (GstdPipelineRecording * self)
+{
+  GstElement *bin;
+  GstElement *tee;
+  GstPad *sinkpad;
+  GstPad *teepad;
+  GstBin *pipeline;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_RECORDING (self));
+
+  GST_OBJECT_LOCK (self);
+  if (GSTD_RECORDING_STATUS_FINISHED != self->status) {
+    self->status = GSTD_RECORDING_STATUS_ABORTED;
+  }
+  sinkpad = self->sinkpad;
+  bin = self->bin;
+  teepad = self->teepad;
+  tee = self->tee;
+  pipeline = self->pipeline;
+  self->sinkpad = NULL;
+  self->bin = NULL;
+  self->teepad = NULL;
+  self->tee = NULL;
+  self->pipeline = NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  /* Dropping the branch also releases the references held by the
+     probes installed in it */
+  if (sinkpad) {
+    gst_object_unref (sinkpad);
+  }
+  if (bin) {
+    gst_object_unref (bin);
+  }
+  if (teepad) {
+    gst_object_unref (teepad);
+  }
+  if (tee) {
+    gst_object_unref (tee);
+  }
+  if (pipeline) {
+    gst_object_unref (pipeline);
+  }
+}
+
+static void
+gstd_pipeline_recording_watch_sinks (GstdPipelineRecording * self)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  GstElement *sink;
+  GstPad *pad;
+  gboolean done;
+
+  it = gst_bin_iterate_sinks (GST_BIN (self->bin));
+  done = FALSE;
+
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:
+        sink = g_value_get_object (&item);
+        pad = gst_element_get_static_pad (sink, "sink");
+        if (pad) {
+          GST_OBJECT_LOCK (self);
+          self->pending++;
+          GST_OBJECT_UNLOCK (self);
+          gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+              gstd_pipeline_recording_eos, g_object_ref (self),
+              g_object_unref);
+          gst_object_unref (pad);
+        }
+        g_value_reset (&item);
+        break;
+      case GST_ITERATOR_RESYNC:
+        gst_iterator_resync (it);
+        break;
+      default:
+        done = TRUE;
+        break;
+    }
+  }
+
+  g_value_unset (&item);
+  gst_iterator_free (it);
+}
+
+static GstPadProbeReturn
+gstd_pipeline_recording_gate (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstdPipelineRecording *self = GSTD_PIPELINE_RECORDING (user_data);
+  GstBuffer *buffer;
+
+  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    buffer = gst_buffer_list_get (GST_PAD_PROBE_INFO_BUFFER_LIST (info), 0);
+  } else {
+    buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+  }
+
+  GST_OBJECT_LOCK (self);
+  if (GSTD_RECORDING_STATUS_WAITING != self->status) {
+    GST_OBJECT_UNLOCK (self);
+    return GST_PAD_PROBE_REMOVE;
+  }
+
+  if (buffer && GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_DELTA_UNIT)) {
+    self->dropped++;
+    GST_OBJECT_UNLOCK (self);
+    return GST_PAD_PROBE_DROP;
+  }
+
+  self->status = GSTD_RECORDING_STATUS_RECORDING;
+  GST_OBJECT_UNLOCK (self);
+
+  GST_INFO_OBJECT (self, "Recording from %" GST_PTR_FORMAT, buffer);
+
+  /* Removing the probe lets this buffer through */
+  return GST_PAD_PROBE_REMOVE;
+}
+
+static GstPadProbeReturn
+gstd_pipeline_recording_unlink (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstdPipelineRecording *self = GSTD_PIPELINE_RECORDING (user_data);
+  GstPad *sinkpad;
+
+  GST_OBJECT_LOCK (self);
+  sinkpad = self->sinkpad ? gst_object_ref (self->sinkpad) : NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  if (sinkpad) {
+    gst_pad_unlink (pad, sinkpad);
+
+    /* Only the branch sees the EOS, the queue takes it to the sink. A
+       branch that already got the stream EOS won't take another one */
+    if (!gst_pad_send_event (sinkpad, gst_event_new_eos ())) {
+      g_idle_add_full (G_PRIORITY_HIGH, gstd_pipeline_recording_finish,
+          g_object_ref (self), g_object_unref);
+    }
+    gst_object_unref (sinkpad);
+  }
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
+static GstPadProbeReturn
+gstd_pipeline_recording_eos (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstdPipelineRecording *self = GSTD_PIPELINE_RECORDING (user_data);
+  gboolean done;
+
+  if (GST_EVENT_EOS != GST_EVENT_TYPE (GST_PAD_PROBE_INFO_EVENT (info))) {
+    return GST_PAD_PROBE_OK;
+  }
+
+  /* The stream itself may end while recording, only our EOS counts */
+  GST_OBJECT_LOCK (self);
+  if (GSTD_RECORDING_STATUS_FINALIZING != self->status) {
+    GST_OBJECT_UNLOCK (self);
+    return GST_PAD_PROBE_OK;
+  }
+  done = 0 == --self->pending;
+  GST_OBJECT_UNLOCK (self);
+
+  /* The branch can't be removed from its own streaming thread */
+  if (done) {
+    g_idle_add_full (G_PRIORITY_HIGH, gstd_pipeline_recording_finish,
+        g_object_ref (self), g_object_unref);
+  }
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
+static gboolean
+gstd_pipeline_recording_finish (gpointer user_data)
+{
+  GstdPipelineRecording *self = GSTD_PIPELINE_RECORDING (user_data);
+
+  GST_OBJECT_LOCK (self);
+  if (GSTD_RECORDING_STATUS_FINALIZING != self->status) {
+    GST_OBJECT_UNLOCK (self);
+    return G_SOURCE_REMOVE;
+  }
+  self->status = GSTD_RECORDING_STATUS_FINISHED;
+  GST_OBJECT_UNLOCK (self);
+
+  GST_INFO_OBJECT (self, "Recording finalized");
+
+  gstd_pipeline_recording_remove (self);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gstd_pipeline_recording_remove (GstdPipelineRecording * self)
+{
+  gst_element_set_state (self->bin, GST_STATE_NULL);
+  gst_bin_remove (self->pipeline, self->bin);
+  gst_element_release_request_pad (self->tee, self->teepad);
+
+  gstd_pipeline_recording_abort (self);
+}
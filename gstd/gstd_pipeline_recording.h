@@ -0,0 +1,132 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_RECORDING_H__
+#define __GSTD_PIPELINE_RECORDING_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_RECORDING \
+  (gstd_pipeline_recording_get_type())
+#define GSTD_PIPELINE_RECORDING(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_RECORDING,GstdPipelineRecording))
+#define GSTD_PIPELINE_RECORDING_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_RECORDING,GstdPipelineRecordingClass))
+#define GSTD_IS_PIPELINE_RECORDING(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_RECORDING))
+#define GSTD_IS_PIPELINE_RECORDING_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_RECORDING))
+#define GSTD_PIPELINE_RECORDING_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_RECORDING, GstdPipelineRecordingClass))
+typedef struct _GstdPipelineRecording GstdPipelineRecording;
+typedef struct _GstdPipelineRecordingClass GstdPipelineRecordingClass;
+GType gstd_pipeline_recording_get_type (void);
+
+/**
+ * GstdRecordingStatus:
+ * @GSTD_RECORDING_STATUS_WAITING: Attached, dropping buffers until the
+ * first keyframe
+ * @GSTD_RECORDING_STATUS_RECORDING: Buffers are flowing into the branch
+ * @GSTD_RECORDING_STATUS_FINALIZING: Detached, waiting for the EOS to
+ * reach the end of the branch
+ * @GSTD_RECORDING_STATUS_FINISHED: The branch was finalized and removed
+ * @GSTD_RECORDING_STATUS_ABORTED: The pipeline was torn down before the
+ * recording was stopped
+ *
+ * The progress of a recording branch.
+ */
+typedef enum
+{
+  GSTD_RECORDING_STATUS_WAITING,
+  GSTD_RECORDING_STATUS_RECORDING,
+  GSTD_RECORDING_STATUS_FINALIZING,
+  GSTD_RECORDING_STATUS_FINISHED,
+  GSTD_RECORDING_STATUS_ABORTED,
+} GstdRecordingStatus;
+
+#define GSTD_TYPE_RECORDING_STATUS (gstd_recording_status_get_type ())
+GType gstd_recording_status_get_type (void);
+
+/**
+ * gstd_pipeline_recording_new: (constructor)
+ * @name: The name of the recording
+ * @description: The tee to attach to followed by the branch, as in
+ * "<tee> <element> ! ... ! <sink>"
+ *
+ * Creates a new recording, not yet attached.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineRecording.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineRecording *gstd_pipeline_recording_new (const gchar * name,
+    const gchar * description);
+
+/**
+ * gstd_pipeline_recording_build:
+ * @object: The recording
+ *
+ * Parses the description and creates the branch.
+ *
+ * Returns: A GstdReturnCode with the build status.
+ */
+GstdReturnCode gstd_pipeline_recording_build (GstdPipelineRecording *
+    object);
+
+/**
+ * gstd_pipeline_recording_start:
+ * @object: The recording
+ * @bin: The GStreamer pipeline holding the tee
+ *
+ * Adds the branch to @bin and links it to a new pad of the tee, while
+ * the pipeline keeps running. Buffers are dropped until a keyframe
+ * arrives, which is requested upstream right away.
+ *
+ * Returns: A GstdReturnCode with the status of the operation.
+ */
+GstdReturnCode gstd_pipeline_recording_start (GstdPipelineRecording *
+    object, GstBin * bin);
+
+/**
+ * gstd_pipeline_recording_stop:
+ * @object: The recording
+ *
+ * Unlinks the branch from the tee and sends an EOS into it only. Once
+ * the EOS reaches the end of the branch, the branch is removed from
+ * the pipeline.
+ */
+void gstd_pipeline_recording_stop (GstdPipelineRecording * object);
+
+/**
+ * gstd_pipeline_recording_abort:
+ * @object: The recording
+ *
+ * Forgets the branch without finalizing it, for when the whole
+ * pipeline is being torn down.
+ */
+void gstd_pipeline_recording_abort (GstdPipelineRecording * object);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_RECORDING_H__
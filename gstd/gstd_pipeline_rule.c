@@ -0,0 +1,581 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_pipeline_rule.h"
+#include "gstd_scheduled_command.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pipeline Rule debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_rule_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_rule_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/* Field matched against the name of the message structure */
+#define GSTD_PIPELINE_RULE_STRUCTURE_FIELD "structure"
+
+enum
+{
+  PROP_TRIGGER = 1,
+  PROP_COMMANDS,
+  PROP_HITS,
+  PROP_CODE,
+  PROP_RESPONSE,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/**
+ * GstdPipelineRule:
+ * Runs a list of parser commands whenever a bus message or a signal
+ * emission matches its trigger:
+ *
+ *   message=<type>[@<source>][,<field>=<value>...] <command>[; <command>...]
+ *   signal=<element>.<signal> <command>[; <command>...]
+ *
+ * Message types are GstMessageType nicks, such as eos, error or
+ * element. The "structure" field matches the name of the message
+ * structure, any other field is compared with its serialized value.
+ * Only signals without a return value can be used. Commands run in
+ * order from the main context and stop at the first failure.
+ */
+struct _GstdPipelineRule
+{
+  GstdObject parent;
+
+  gchar *trigger;
+  gchar *commands;
+
+  /**
+   * The parsed commands
+   */
+  gchar **command_list;
+
+  /**
+   * Message trigger: type, source name and fields to match
+   */
+  GstMessageType type;
+  gchar *source;
+  GstStructure *fields;
+
+  /**
+   * Signal trigger: element and signal names, and the connection
+   */
+  gchar *element;
+  gchar *signal;
+  GstElement *target;
+  gulong handler;
+
+  guint hits;
+  GstdReturnCode code;
+  gchar *response;
+};
+
+struct _GstdPipelineRuleClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPipelineRule, gstd_pipeline_rule, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pipeline_rule_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_pipeline_rule_dispose (GObject *);
+static void gstd_pipeline_rule_finalize (GObject *);
+static GstdReturnCode gstd_pipeline_rule_parse_message (GstdPipelineRule *,
+    const gchar *);
+static GstdReturnCode gstd_pipeline_rule_parse_signal (GstdPipelineRule *,
+    const gchar *);
+static gboolean gstd_pipeline_rule_match_field (GQuark, const GValue *,
+    gpointer);
+static void gstd_pipeline_rule_fire (GstdPipelineRule *);
+static void gstd_pipeline_rule_marshal (GClosure *, GValue *, guint,
+    const GValue *, gpointer, gpointer);
+static gboolean gstd_pipeline_rule_execute (gpointer);
+
+static void
+gstd_pipeline_rule_class_init (GstdPipelineRuleClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->get_property = gstd_pipeline_rule_get_property;
+  object_class->dispose = gstd_pipeline_rule_dispose;
+  object_class->finalize = gstd_pipeline_rule_finalize;
+
+  properties[PROP_TRIGGER] =
+      g_param_spec_string ("trigger", "Trigger",
+      "The message or signal that triggers the rule",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_COMMANDS] =
+      g_param_spec_string ("commands", "Commands",
+      "The commands run when the rule triggers, separated by ';'",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_HITS] =
+      g_param_spec_uint ("hits", "Hits",
+      "Times the rule was triggered",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_CODE] =
+      g_param_spec_int ("code", "Code",
+      "The return code of the last command run",
+      G_MININT, G_MAXINT, GSTD_EOK,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_RESPONSE] =
+      g_param_spec_string ("response", "Response",
+      "The response of the last command run",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_rule_debug, "gstdpipelinerule",
+      debug_color, "Gstd Pipeline Rule category");
+}
+
+static void
+gstd_pipeline_rule_init (GstdPipelineRule * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline rule");
+
+  self->trigger = NULL;
+  self->commands = NULL;
+  self->command_list = NULL;
+  self->type = GST_MESSAGE_UNKNOWN;
+  self->source = NULL;
+  self->fields = NULL;
+  self->element = NULL;
+  self->signal = NULL;
+  self->target = NULL;
+  self->handler = 0;
+  self->hits = 0;
+  self->code = GSTD_EOK;
+  self->response = NULL;
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+GstdPipelineRule *
+gstd_pipeline_rule_new (const gchar * name, const gchar * description)
+{
+  GstdPipelineRule *self;
+  gchar **tokens;
+
+  g_return_val_if_fail (name, NULL);
+  g_return_val_if_fail (description, NULL);
+
+  self = GSTD_PIPELINE_RULE (g_object_new (GSTD_TYPE_PIPELINE_RULE,
+          "name", name, NULL));
+
+  tokens = g_strsplit (description, " ", 2);
+  self->trigger = g_strdup (tokens[0]);
+  self->commands = g_strdup (tokens[1]);
+  g_strfreev (tokens);
+
+  return self;
+}
+
+static void
+gstd_pipeline_rule_dispose (GObject * object)
+{
+  GstdPipelineRule *self = GSTD_PIPELINE_RULE (object);
+
+  GST_INFO_OBJECT (self, "Disposing pipeline rule");
+
+  gstd_pipeline_rule_unbind (self);
+
+  G_OBJECT_CLASS (gstd_pipeline_rule_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_rule_finalize (GObject * object)
+{
+  GstdPipelineRule *self = GSTD_PIPELINE_RULE (object);
+
+  g_free (self->trigger);
+  g_free (self->commands);
+  g_strfreev (self->command_list);
+  g_free (self->source);
+  g_free (self->element);
+  g_free (self->signal);
+  g_free (self->response);
+
+  if (self->fields) {
+    gst_structure_free (self->fields);
+  }
+
+  G_OBJECT_CLASS (gstd_pipeline_rule_parent_class)->finalize (object);
+}
+
+static void
+gstd_pipeline_rule_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineRule *self = GSTD_PIPELINE_RULE (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (property_id) {
+    case PROP_TRIGGER:
+      g_value_set_string (value, self->trigger);
+      break;
+    case PROP_COMMANDS:
+      g_value_set_string (value, self->commands);
+      break;
+    case PROP_HITS:
+      g_value_set_uint (value, self->hits);
+      break;
+    case PROP_CODE:
+      g_value_set_int (value, self->code);
+      break;
+    case PROP_RESPONSE:
+      g_value_set_string (value, self->response);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+GstdReturnCode
+gstd_pipeline_rule_build (GstdPipelineRule * self)
+{
+  GstdReturnCode ret;
+  gchar **command;
+  gint count = 0;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE_RULE (self), GSTD_NULL_ARGUMENT);
+
+  if (!self->trigger || !self->commands) {
+    GST_ERROR_OBJECT (self, "Expected a trigger followed by the commands");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  if (g_str_has_prefix (self->trigger, "message=")) {
+    ret = gstd_pipeline_rule_parse_message (self, self->trigger + 8);
+  } else if (g_str_has_prefix (self->trigger, "signal=")) {
+    ret = gstd_pipeline_rule_parse_signal (self, self->trigger + 7);
+  } else {
+    GST_ERROR_OBJECT (self, "Unknown trigger \"%s\", expected message= or "
+        "signal=", self->trigger);
+    ret = GSTD_BAD_VALUE;
+  }
+
+  if (GSTD_EOK != ret) {
+    return ret;
+  }
+
+  self->command_list = g_strsplit (self->commands, ";", -1);
+  for (command = self->command_list; *command; command++) {
+    g_strstrip (*command);
+    if ('\0' != **command) {
+      count++;
+    }
+  }
+
+  if (0 == count) {
+    GST_ERROR_OBJECT (self, "No commands to run");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  return GSTD_EOK;
+}
+
+static GstdReturnCode
+gstd_pipeline_rule_parse_message (GstdPipelineRule * self,
+    const gchar * trigger)
+{
+  GFlagsClass *types;
+  GFlagsValue *type;
+  gchar **tokens;
+  gchar **token;
+  gchar *at;
+  gchar *equal;
+  GstdReturnCode ret = GSTD_EOK;
+
+  tokens = g_strsplit (trigger, ",", -1);
+
+  at = strchr (tokens[0], '@');
+  if (at) {
+    *at = '\0';
+    self->source = g_strdup (at + 1);
+  }
+
+  types = g_type_class_ref (GST_TYPE_MESSAGE_TYPE);
+  type = g_flags_get_value_by_nick (types, tokens[0]);
+  if (type) {
+    self->type = type->value;
+  } else {
+    GST_ERROR_OBJECT (self, "Unknown message type \"%s\"", tokens[0]);
+    ret = GSTD_BAD_VALUE;
+  }
+  g_type_class_unref (types);
+
+  self->fields = gst_structure_new_empty ("fields");
+  for (token = tokens + 1; *token && GSTD_EOK == ret; token++) {
+    equal = strchr (*token, '=');
+    if (!equal) {
+      GST_ERROR_OBJECT (self, "Malformed field \"%s\", expected field=value",
+          *token);
+      ret = GSTD_BAD_VALUE;
+      break;
+    }
+    *equal = '\0';
+    gst_structure_set (self->fields, *token, G_TYPE_STRING, equal + 1, NULL);
+  }
+
+  g_strfreev (tokens);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_pipeline_rule_parse_signal (GstdPipelineRule * self,
+    const gchar * trigger)
+{
+  const gchar *dot;
+
+  dot = strrchr (trigger, '.');
+  if (!dot || dot == trigger || '\0' == dot[1]) {
+    GST_ERROR_OBJECT (self, "Malformed signal \"%s\", expected "
+        "element.signal", trigger);
+    return GSTD_BAD_VALUE;
+  }
+
+  self->element = g_strndup (trigger, dot - trigger);
+  self->signal = g_strdup (dot + 1);
+
+  return GSTD_EOK;
+}
+
+static gboolean
+gstd_pipeline_rule_match_field (GQuark field, const GValue * expected,
+    gpointer user_data)
+{
+  const GstStructure *structure = user_data;
+  const gchar *name = g_quark_to_string (field);
+  const GValue *value;
+  gchar *serialized;
+  gboolean match;
+
+  if (!g_strcmp0 (name, GSTD_PIPELINE_RULE_STRUCTURE_FIELD)) {
+    return structure && !g_strcmp0 (gst_structure_get_name (structure),
+        g_value_get_string (expected));
+  }
+
+  value = structure ? gst_structure_id_get_value (structure, field) : NULL;
+  if (!value) {
+    return FALSE;
+  }
+
+  if (G_VALUE_HOLDS_STRING (value)) {
+    return !g_strcmp0 (g_value_get_string (value),
+        g_value_get_string (expected));
+  }
+
+  serialized = gst_value_serialize (value);
+  match = !g_strcmp0 (serialized, g_value_get_string (expected));
+  g_free (serialized);
+
+  return match;
+}
+
+void
+gstd_pipeline_rule_handle (GstdPipelineRule * self, GstMessage * message)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_RULE (self));
+  g_return_if_fail (GST_IS_MESSAGE (message));
+
+  if (GST_MESSAGE_UNKNOWN == self->type
+      || GST_MESSAGE_TYPE (message) != self->type) {
+    return;
+  }
+
+  if (self->source
+      && g_strcmp0 (self->source, GST_MESSAGE_SRC_NAME (message))) {
+    return;
+  }
+
+  if (!gst_structure_foreach (self->fields, gstd_pipeline_rule_match_field,
+          (gpointer) gst_message_get_structure (message))) {
+    return;
+  }
+
+  GST_DEBUG_OBJECT (self, "Triggered by %" GST_PTR_FORMAT, message);
+  gstd_pipeline_rule_fire (self);
+}
+
+void
+gstd_pipeline_rule_bind (GstdPipelineRule * self, GstBin * bin)
+{
+  GstElement *element;
+  GClosure *closure;
+  GSignalQuery query;
+  guint signal_id;
+  GQuark detail;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_RULE (self));
+  g_return_if_fail (GST_IS_BIN (bin));
+
+  if (!self->signal) {
+    return;
+  }
+
+  element = gst_bin_get_by_name (bin, self->element);
+  if (!element) {
+    GST_WARNING_OBJECT (self, "No element named \"%s\" to bind to",
+        self->element);
+    return;
+  }
+
+  if (!g_signal_parse_name (self->signal, G_OBJECT_TYPE (element),
+          &signal_id, &detail, TRUE)) {
+    GST_WARNING_OBJECT (self, "Element \"%s\" has no signal \"%s\"",
+        self->element, self->signal);
+    gst_object_unref (element);
+    return;
+  }
+
+  /* The commands run later and have nothing to return, the emitter
+     would get an unset value */
+  g_signal_query (signal_id, &query);
+  if (G_TYPE_NONE != (query.return_type & ~G_SIGNAL_TYPE_STATIC_SCOPE)) {
+    GST_WARNING_OBJECT (self, "Signal \"%s\" of \"%s\" returns a value, "
+        "only signals without one can trigger rules", self->signal,
+        self->element);
+    gst_object_unref (element);
+    return;
+  }
+
+  GST_OBJECT_LOCK (self);
+  if (self->target) {
+    GST_OBJECT_UNLOCK (self);
+    GST_ERROR_OBJECT (self, "Rule is already bound");
+    gst_object_unref (element);
+    return;
+  }
+
+  /* The rule is held while the closure runs, an emission may be in
+     flight while the rule is unbound */
+  closure = g_closure_new_simple (sizeof (GClosure), self);
+  g_closure_set_marshal (closure, gstd_pipeline_rule_marshal);
+  g_object_watch_closure (G_OBJECT (self), closure);
+
+  self->target = element;
+  self->handler = g_signal_connect_closure_by_id (element, signal_id, detail,
+      closure, FALSE);
+  GST_OBJECT_UNLOCK (self);
+
+  GST_INFO_OBJECT (self, "Bound to %s::%s", self->element, self->signal);
+}
+
+void
+gstd_pipeline_rule_unbind (GstdPipelineRule * self)
+{
+  GstElement *target;
+  gulong handler;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_RULE (self));
+
+  GST_OBJECT_LOCK (self);
+  target = self->target;
+  handler = self->handler;
+  self->target = NULL;
+  self->handler = 0;
+  GST_OBJECT_UNLOCK (self);
+
+  if (target) {
+    g_signal_handler_disconnect (target, handler);
+    gst_object_unref (target);
+  }
+}
+
+static void
+gstd_pipeline_rule_marshal (GClosure * closure, GValue * return_value,
+    guint n_param_values, const GValue * param_values,
+    gpointer invocation_hint, gpointer marshal_data)
+{
+  GstdPipelineRule *self = GSTD_PIPELINE_RULE (closure->data);
+
+  GST_DEBUG_OBJECT (self, "Triggered by signal \"%s\"", self->signal);
+  gstd_pipeline_rule_fire (self);
+}
+
+static void
+gstd_pipeline_rule_fire (GstdPipelineRule * self)
+{
+  GST_OBJECT_LOCK (self);
+  self->hits++;
+  GST_OBJECT_UNLOCK (self);
+
+  /* Messages and signals come from streaming threads, where commands
+     changing the pipeline state would deadlock. The commands are always
+     queued, even if the main context is the one posting the message */
+  g_idle_add_full (G_PRIORITY_HIGH, gstd_pipeline_rule_execute,
+      g_object_ref (self), g_object_unref);
+}
+
+static gboolean
+gstd_pipeline_rule_execute (gpointer user_data)
+{
+  GstdPipelineRule *self = GSTD_PIPELINE_RULE (user_data);
+  GstdReturnCode code = GSTD_EOK;
+  gchar *response = NULL;
+  gchar **command;
+
+  for (command = self->command_list; *command; command++) {
+    if ('\0' == **command) {
+      continue;
+    }
+
+    g_free (response);
+    response = NULL;
+
+    code = gstd_scheduled_command_run (*command, &response);
+    GST_INFO_OBJECT (self, "Executed \"%s\": %s", *command,
+        gstd_return_code_to_string (code));
+
+    if (GSTD_EOK != code) {
+      break;
+    }
+  }
+
+  GST_OBJECT_LOCK (self);
+  self->code = code;
+  g_free (self->response);
+  self->response = response;
+  GST_OBJECT_UNLOCK (self);
+
+  return G_SOURCE_REMOVE;
+}
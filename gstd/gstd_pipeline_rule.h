@@ -0,0 +1,104 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_RULE_H__
+#define __GSTD_PIPELINE_RULE_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_RULE \
+  (gstd_pipeline_rule_get_type())
+#define GSTD_PIPELINE_RULE(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_RULE,GstdPipelineRule))
+#define GSTD_PIPELINE_RULE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_RULE,GstdPipelineRuleClass))
+#define GSTD_IS_PIPELINE_RULE(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_RULE))
+#define GSTD_IS_PIPELINE_RULE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_RULE))
+#define GSTD_PIPELINE_RULE_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_RULE, GstdPipelineRuleClass))
+typedef struct _GstdPipelineRule GstdPipelineRule;
+typedef struct _GstdPipelineRuleClass GstdPipelineRuleClass;
+GType gstd_pipeline_rule_get_type (void);
+
+/**
+ * gstd_pipeline_rule_new: (constructor)
+ * @name: The name of the rule
+ * @description: The trigger followed by the commands to run, as in
+ * "message=eos pipeline_play next"
+ *
+ * Creates a new rule, which must be built before it can trigger.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineRule.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineRule *gstd_pipeline_rule_new (const gchar * name,
+    const gchar * description);
+
+/**
+ * gstd_pipeline_rule_build:
+ * @object: The rule
+ *
+ * Parses the trigger and the commands of the rule.
+ *
+ * Returns: A GstdReturnCode with the parsing status.
+ */
+GstdReturnCode gstd_pipeline_rule_build (GstdPipelineRule * object);
+
+/**
+ * gstd_pipeline_rule_handle:
+ * @object: The rule
+ * @message: A message posted in the pipeline
+ *
+ * Runs the commands of the rule, from the main context, if @message
+ * matches its trigger. Safe to be called from the bus sync handler.
+ */
+void gstd_pipeline_rule_handle (GstdPipelineRule * object,
+    GstMessage * message);
+
+/**
+ * gstd_pipeline_rule_bind:
+ * @object: The rule
+ * @bin: The GStreamer pipeline
+ *
+ * Connects signal triggers to the element they refer to in @bin. Rules
+ * triggered by messages ignore this call, and signals that return a
+ * value are never connected.
+ */
+void gstd_pipeline_rule_bind (GstdPipelineRule * object, GstBin * bin);
+
+/**
+ * gstd_pipeline_rule_unbind:
+ * @object: The rule
+ *
+ * Disconnects signal triggers, typically before the GStreamer pipeline
+ * is torn down.
+ */
+void gstd_pipeline_rule_unbind (GstdPipelineRule * object);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_RULE_H__
@@ -0,0 +1,262 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_pipeline_rules.h"
+#include "gstd_pipeline_rule.h"
+
+/* Gstd Pipeline Rules debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_rules_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_rules_debug
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/**
+ * GstdPipelineRules:
+ * Creates and deletes the rules of a pipeline, and hands them the
+ * messages posted in it
+ */
+struct _GstdPipelineRules
+{
+  GObject parent;
+
+  GMutex lock;
+
+  /**
+   * The GStreamer pipeline signal triggers are bound to
+   */
+  GstBin *bin;
+
+  /**
+   * The rules created so far
+   */
+  GList *rules;
+};
+
+struct _GstdPipelineRulesClass
+{
+  GObjectClass parent_class;
+};
+
+/* VTable */
+static void gstd_pipeline_rules_dispose (GObject *);
+static void gstd_pipeline_rules_finalize (GObject *);
+static GstdReturnCode gstd_pipeline_rules_create (GstdICreator * iface,
+    const gchar * name, const gchar * description, GstdObject ** out);
+static GstdReturnCode gstd_pipeline_rules_delete (GstdIDeleter * iface,
+    GstdObject * object);
+
+static void
+gstd_icreator_interface_init (GstdICreatorInterface * iface)
+{
+  iface->create = gstd_pipeline_rules_create;
+}
+
+static void
+gstd_ideleter_interface_init (GstdIDeleterInterface * iface)
+{
+  iface->delete = gstd_pipeline_rules_delete;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GstdPipelineRules, gstd_pipeline_rules,
+    G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE (GSTD_TYPE_ICREATOR,
+        gstd_icreator_interface_init);
+    G_IMPLEMENT_INTERFACE (GSTD_TYPE_IDELETER, gstd_ideleter_interface_init));
+
+static void
+gstd_pipeline_rules_class_init (GstdPipelineRulesClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  guint debug_color;
+
+  object_class->dispose = gstd_pipeline_rules_dispose;
+  object_class->finalize = gstd_pipeline_rules_finalize;
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_rules_debug, "gstdpipelinerules",
+      debug_color, "Gstd Pipeline Rules category");
+}
+
+static void
+gstd_pipeline_rules_init (GstdPipelineRules * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline rules");
+
+  g_mutex_init (&self->lock);
+  self->bin = NULL;
+  self->rules = NULL;
+}
+
+GstdPipelineRules *
+gstd_pipeline_rules_new (void)
+{
+  return GSTD_PIPELINE_RULES (g_object_new (GSTD_TYPE_PIPELINE_RULES, NULL));
+}
+
+static void
+gstd_pipeline_rules_dispose (GObject * object)
+{
+  GstdPipelineRules *self = GSTD_PIPELINE_RULES (object);
+  GList *rules;
+
+  GST_INFO_OBJECT (self, "Disposing pipeline rules");
+
+  gstd_pipeline_rules_unwatch (self);
+
+  g_mutex_lock (&self->lock);
+  rules = self->rules;
+  self->rules = NULL;
+  g_mutex_unlock (&self->lock);
+
+  g_list_free_full (rules, g_object_unref);
+
+  G_OBJECT_CLASS (gstd_pipeline_rules_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_rules_finalize (GObject * object)
+{
+  GstdPipelineRules *self = GSTD_PIPELINE_RULES (object);
+
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (gstd_pipeline_rules_parent_class)->finalize (object);
+}
+
+void
+gstd_pipeline_rules_watch (GstdPipelineRules * self, GstBin * bin)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_RULES (self));
+  g_return_if_fail (GST_IS_BIN (bin));
+
+  g_mutex_lock (&self->lock);
+  if (self->bin) {
+    g_mutex_unlock (&self->lock);
+    GST_ERROR_OBJECT (self, "Already watching a pipeline");
+    return;
+  }
+
+  self->bin = gst_object_ref (bin);
+  g_list_foreach (self->rules, (GFunc) gstd_pipeline_rule_bind, bin);
+  g_mutex_unlock (&self->lock);
+}
+
+void
+gstd_pipeline_rules_unwatch (GstdPipelineRules * self)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_RULES (self));
+
+  g_mutex_lock (&self->lock);
+  g_list_foreach (self->rules, (GFunc) gstd_pipeline_rule_unbind, NULL);
+  if (self->bin) {
+    gst_object_unref (self->bin);
+    self->bin = NULL;
+  }
+  g_mutex_unlock (&self->lock);
+}
+
+void
+gstd_pipeline_rules_handle (GstdPipelineRules * self, GstMessage * message)
+{
+  GList *iter;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_RULES (self));
+  g_return_if_fail (GST_IS_MESSAGE (message));
+
+  g_mutex_lock (&self->lock);
+  for (iter = self->rules; iter; iter = iter->next) {
+    gstd_pipeline_rule_handle (GSTD_PIPELINE_RULE (iter->data), message);
+  }
+  g_mutex_unlock (&self->lock);
+}
+
+static GstdReturnCode
+gstd_pipeline_rules_create (GstdICreator * iface, const gchar * name,
+    const gchar * description, GstdObject ** out)
+{
+  GstdPipelineRules *self;
+  GstdPipelineRule *rule;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (out, GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_RULES (iface);
+  *out = NULL;
+
+  if (NULL == name) {
+    GST_ERROR_OBJECT (self, "Rule name not provided");
+    return GSTD_MISSING_NAME;
+  }
+
+  if (NULL == description) {
+    GST_ERROR_OBJECT (self, "Rule trigger and commands not provided");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  rule = gstd_pipeline_rule_new (name, description);
+  *out = GSTD_OBJECT (rule);
+
+  ret = gstd_pipeline_rule_build (rule);
+  if (GSTD_EOK != ret) {
+    return ret;
+  }
+
+  g_mutex_lock (&self->lock);
+  self->rules = g_list_append (self->rules, g_object_ref (rule));
+  if (self->bin) {
+    gstd_pipeline_rule_bind (rule, self->bin);
+  }
+  g_mutex_unlock (&self->lock);
+
+  return GSTD_EOK;
+}
+
+static GstdReturnCode
+gstd_pipeline_rules_delete (GstdIDeleter * iface, GstdObject * object)
+{
+  GstdPipelineRules *self;
+  GList *found;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_PIPELINE_RULE (object), GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_RULES (iface);
+
+  g_mutex_lock (&self->lock);
+  found = g_list_find (self->rules, object);
+  if (found) {
+    self->rules = g_list_delete_link (self->rules, found);
+  }
+  g_mutex_unlock (&self->lock);
+
+  gstd_pipeline_rule_unbind (GSTD_PIPELINE_RULE (object));
+
+  if (found) {
+    g_object_unref (object);
+  }
+
+  /* Release the reference held by the list */
+  g_object_unref (object);
+
+  return GSTD_EOK;
+}
@@ -0,0 +1,86 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_RULES_H__
+#define __GSTD_PIPELINE_RULES_H__
+
+#include <gst/gst.h>
+#include <gstd_object.h>
+
+G_BEGIN_DECLS
+#define GSTD_TYPE_PIPELINE_RULES \
+  (gstd_pipeline_rules_get_type())
+#define GSTD_PIPELINE_RULES(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_RULES,GstdPipelineRules))
+#define GSTD_PIPELINE_RULES_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_RULES,GstdPipelineRulesClass))
+#define GSTD_IS_PIPELINE_RULES(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_RULES))
+#define GSTD_IS_PIPELINE_RULES_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_RULES))
+#define GSTD_PIPELINE_RULES_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_RULES, GstdPipelineRulesClass))
+
+typedef struct _GstdPipelineRules GstdPipelineRules;
+typedef struct _GstdPipelineRulesClass GstdPipelineRulesClass;
+
+GType gstd_pipeline_rules_get_type (void);
+
+/**
+ * gstd_pipeline_rules_new: (constructor)
+ *
+ * Creates the creator/deleter of the rules of a pipeline, which also
+ * dispatches the pipeline messages to them.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineRules.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineRules *gstd_pipeline_rules_new (void);
+
+/**
+ * gstd_pipeline_rules_watch:
+ * @object: The rules
+ * @bin: The GStreamer pipeline
+ *
+ * Binds the signal triggered rules to the elements of @bin.
+ */
+void gstd_pipeline_rules_watch (GstdPipelineRules * object, GstBin * bin);
+
+/**
+ * gstd_pipeline_rules_unwatch:
+ * @object: The rules
+ *
+ * Unbinds the signal triggered rules, typically before the GStreamer
+ * pipeline is torn down. The rules are kept for the next pipeline.
+ */
+void gstd_pipeline_rules_unwatch (GstdPipelineRules * object);
+
+/**
+ * gstd_pipeline_rules_handle:
+ * @object: The rules
+ * @message: A message posted in the pipeline
+ *
+ * Triggers the rules matching @message. Safe to be called from the bus
+ * sync handler.
+ */
+void gstd_pipeline_rules_handle (GstdPipelineRules * object,
+    GstMessage * message);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_RULES_H__
@@ -0,0 +1,357 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_pipeline_schedule.h"
+#include "gstd_scheduled_command.h"
+
+/* Gstd Pipeline Schedule debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_schedule_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_schedule_debug
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/**
+ * GstdPipelineSchedule:
+ * Creates commands that the daemon executes itself once a deadline is
+ * reached, so that they land in time regardless of the client load:
+ *
+ *   create <schedule> <name> [+]<running-time> <command>
+ *   create <schedule> <name> wall=[+]<time> <command>
+ *
+ * Running time deadlines wait on the pipeline clock, which must be
+ * PLAYING. Wall clock deadlines are nanoseconds since the epoch. A
+ * leading '+' makes the deadline relative to the current time.
+ * Deleting a command that didn't run yet unschedules it.
+ */
+struct _GstdPipelineSchedule
+{
+  GObject parent;
+
+  GMutex lock;
+
+  /**
+   * The GStreamer pipeline whose clock is waited on
+   */
+  GstBin *bin;
+
+  /**
+   * Real time clock for wall clock deadlines, created on demand
+   */
+  GstClock *wall_clock;
+
+  /**
+   * The commands scheduled so far
+   */
+  GList *commands;
+};
+
+struct _GstdPipelineScheduleClass
+{
+  GObjectClass parent_class;
+};
+
+/* VTable */
+static void gstd_pipeline_schedule_dispose (GObject *);
+static void gstd_pipeline_schedule_finalize (GObject *);
+static GstdReturnCode gstd_pipeline_schedule_create (GstdICreator * iface,
+    const gchar * name, const gchar * description, GstdObject ** out);
+static GstdReturnCode gstd_pipeline_schedule_delete (GstdIDeleter * iface,
+    GstdObject * object);
+static GstdReturnCode gstd_pipeline_schedule_get_clock (GstdPipelineSchedule *
+    self, const gchar * deadline, GstClock ** clock, GstClockTime * base_time,
+    GstClockTime * time, gboolean * pipeline_time);
+
+static void
+gstd_icreator_interface_init (GstdICreatorInterface * iface)
+{
+  iface->create = gstd_pipeline_schedule_create;
+}
+
+static void
+gstd_ideleter_interface_init (GstdIDeleterInterface * iface)
+{
+  iface->delete = gstd_pipeline_schedule_delete;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GstdPipelineSchedule, gstd_pipeline_schedule,
+    G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE (GSTD_TYPE_ICREATOR,
+        gstd_icreator_interface_init);
+    G_IMPLEMENT_INTERFACE (GSTD_TYPE_IDELETER, gstd_ideleter_interface_init));
+
+static void
+gstd_pipeline_schedule_class_init (GstdPipelineScheduleClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  guint debug_color;
+
+  object_class->dispose = gstd_pipeline_schedule_dispose;
+  object_class->finalize = gstd_pipeline_schedule_finalize;
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_schedule_debug,
+      "gstdpipelineschedule", debug_color, "Gstd Pipeline Schedule category");
+}
+
+static void
+gstd_pipeline_schedule_init (GstdPipelineSchedule * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline schedule");
+
+  g_mutex_init (&self->lock);
+  self->bin = NULL;
+  self->wall_clock = NULL;
+  self->commands = NULL;
+}
+
+GstdPipelineSchedule *
+gstd_pipeline_schedule_new (void)
+{
+  return GSTD_PIPELINE_SCHEDULE (g_object_new (GSTD_TYPE_PIPELINE_SCHEDULE,
+          NULL));
+}
+
+static void
+gstd_pipeline_schedule_dispose (GObject * object)
+{
+  GstdPipelineSchedule *self = GSTD_PIPELINE_SCHEDULE (object);
+  GList *commands;
+
+  GST_INFO_OBJECT (self, "Disposing pipeline schedule");
+
+  gstd_pipeline_schedule_unwatch (self);
+
+  g_mutex_lock (&self->lock);
+  commands = self->commands;
+  self->commands = NULL;
+  g_mutex_unlock (&self->lock);
+
+  g_list_foreach (commands, (GFunc) gstd_scheduled_command_cancel, NULL);
+  g_list_free_full (commands, g_object_unref);
+
+  if (self->wall_clock) {
+    gst_object_unref (self->wall_clock);
+    self->wall_clock = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_pipeline_schedule_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_schedule_finalize (GObject * object)
+{
+  GstdPipelineSchedule *self = GSTD_PIPELINE_SCHEDULE (object);
+
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (gstd_pipeline_schedule_parent_class)->finalize (object);
+}
+
+void
+gstd_pipeline_schedule_watch (GstdPipelineSchedule * self, GstBin * bin)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_SCHEDULE (self));
+  g_return_if_fail (GST_IS_BIN (bin));
+
+  g_mutex_lock (&self->lock);
+  if (self->bin) {
+    g_mutex_unlock (&self->lock);
+    GST_ERROR_OBJECT (self, "Already watching a pipeline");
+    return;
+  }
+
+  self->bin = gst_object_ref (bin);
+  g_mutex_unlock (&self->lock);
+}
+
+void
+gstd_pipeline_schedule_unwatch (GstdPipelineSchedule * self)
+{
+  GstdScheduledCommand *command;
+  GList *iter;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_SCHEDULE (self));
+
+  g_mutex_lock (&self->lock);
+  if (self->bin) {
+    gst_object_unref (self->bin);
+    self->bin = NULL;
+  }
+
+  /* Running times are meaningless for the next pipeline */
+  for (iter = self->commands; iter; iter = iter->next) {
+    command = GSTD_SCHEDULED_COMMAND (iter->data);
+    if (gstd_scheduled_command_is_pipeline_time (command)) {
+      gstd_scheduled_command_cancel (command);
+    }
+  }
+  g_mutex_unlock (&self->lock);
+}
+
+static GstdReturnCode
+gstd_pipeline_schedule_get_clock (GstdPipelineSchedule * self,
+    const gchar * deadline, GstClock ** clock, GstClockTime * base_time,
+    GstClockTime * time, gboolean * pipeline_time)
+{
+  gboolean relative;
+  gchar *end;
+
+  *pipeline_time = !g_str_has_prefix (deadline, "wall=");
+  if (!*pipeline_time) {
+    deadline += 5;
+  }
+
+  relative = '+' == deadline[0];
+  if (relative) {
+    deadline++;
+  }
+
+  *time = g_ascii_strtoull (deadline, &end, 10);
+  if (end == deadline || '\0' != *end) {
+    GST_ERROR_OBJECT (self, "Invalid deadline \"%s\"", deadline);
+    return GSTD_BAD_VALUE;
+  }
+
+  g_mutex_lock (&self->lock);
+  if (*pipeline_time) {
+    if (!self->bin) {
+      g_mutex_unlock (&self->lock);
+      GST_ERROR_OBJECT (self, "No pipeline to schedule on");
+      return GSTD_NO_PIPELINE;
+    }
+
+    *clock = gst_element_get_clock (GST_ELEMENT (self->bin));
+    *base_time = gst_element_get_base_time (GST_ELEMENT (self->bin));
+  } else {
+    if (!self->wall_clock) {
+      self->wall_clock = g_object_new (GST_TYPE_SYSTEM_CLOCK, "clock-type",
+          GST_CLOCK_TYPE_REALTIME, NULL);
+      gst_object_ref_sink (self->wall_clock);
+    }
+
+    *clock = gst_object_ref (self->wall_clock);
+    *base_time = 0;
+  }
+  g_mutex_unlock (&self->lock);
+
+  if (!*clock) {
+    GST_ERROR_OBJECT (self, "The pipeline has no clock, running time "
+        "deadlines need it to be playing");
+    return GSTD_STATE_ERROR;
+  }
+
+  if (relative) {
+    *time += gst_clock_get_time (*clock) - *base_time;
+  }
+
+  return GSTD_EOK;
+}
+
+static GstdReturnCode
+gstd_pipeline_schedule_create (GstdICreator * iface, const gchar * name,
+    const gchar * description, GstdObject ** out)
+{
+  GstdPipelineSchedule *self;
+  GstdScheduledCommand *command;
+  GstClock *clock = NULL;
+  GstClockTime base_time;
+  GstClockTime deadline;
+  gboolean pipeline_time;
+  gchar **tokens;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (out, GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_SCHEDULE (iface);
+  *out = NULL;
+
+  if (NULL == name) {
+    GST_ERROR_OBJECT (self, "Scheduled command name not provided");
+    return GSTD_MISSING_NAME;
+  }
+
+  if (NULL == description) {
+    GST_ERROR_OBJECT (self, "Deadline and command not provided");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  tokens = g_strsplit (description, " ", 2);
+  if (!tokens[0] || !tokens[1]) {
+    GST_ERROR_OBJECT (self, "Expected a deadline followed by a command");
+    g_strfreev (tokens);
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  ret = gstd_pipeline_schedule_get_clock (self, tokens[0], &clock,
+      &base_time, &deadline, &pipeline_time);
+  if (GSTD_EOK != ret) {
+    g_strfreev (tokens);
+    return ret;
+  }
+
+  command = gstd_scheduled_command_new (name, tokens[1]);
+  *out = GSTD_OBJECT (command);
+  g_strfreev (tokens);
+
+  if (!gstd_scheduled_command_arm (command, clock, base_time, deadline,
+          pipeline_time)) {
+    GST_ERROR_OBJECT (self, "Unable to wait for the deadline");
+    gst_object_unref (clock);
+    return GSTD_BAD_VALUE;
+  }
+  gst_object_unref (clock);
+
+  g_mutex_lock (&self->lock);
+  self->commands = g_list_prepend (self->commands, g_object_ref (command));
+  g_mutex_unlock (&self->lock);
+
+  return GSTD_EOK;
+}
+
+static GstdReturnCode
+gstd_pipeline_schedule_delete (GstdIDeleter * iface, GstdObject * object)
+{
+  GstdPipelineSchedule *self;
+  GList *found;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_SCHEDULED_COMMAND (object),
+      GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_SCHEDULE (iface);
+
+  gstd_scheduled_command_cancel (GSTD_SCHEDULED_COMMAND (object));
+
+  g_mutex_lock (&self->lock);
+  found = g_list_find (self->commands, object);
+  if (found) {
+    self->commands = g_list_delete_link (self->commands, found);
+    g_object_unref (object);
+  }
+  g_mutex_unlock (&self->lock);
+
+  /* Release the reference held by the list */
+  g_object_unref (object);
+
+  return GSTD_EOK;
+}
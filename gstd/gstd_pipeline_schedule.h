@@ -0,0 +1,77 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_SCHEDULE_H__
+#define __GSTD_PIPELINE_SCHEDULE_H__
+
+#include <gst/gst.h>
+#include <gstd_object.h>
+
+G_BEGIN_DECLS
+#define GSTD_TYPE_PIPELINE_SCHEDULE \
+  (gstd_pipeline_schedule_get_type())
+#define GSTD_PIPELINE_SCHEDULE(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_SCHEDULE,GstdPipelineSchedule))
+#define GSTD_PIPELINE_SCHEDULE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_SCHEDULE,GstdPipelineScheduleClass))
+#define GSTD_IS_PIPELINE_SCHEDULE(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_SCHEDULE))
+#define GSTD_IS_PIPELINE_SCHEDULE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_SCHEDULE))
+#define GSTD_PIPELINE_SCHEDULE_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_SCHEDULE, GstdPipelineScheduleClass))
+
+typedef struct _GstdPipelineSchedule GstdPipelineSchedule;
+typedef struct _GstdPipelineScheduleClass GstdPipelineScheduleClass;
+
+GType gstd_pipeline_schedule_get_type (void);
+
+/**
+ * gstd_pipeline_schedule_new: (constructor)
+ *
+ * Creates the creator/deleter of the scheduled commands of a pipeline.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineSchedule.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineSchedule *gstd_pipeline_schedule_new (void);
+
+/**
+ * gstd_pipeline_schedule_watch:
+ * @object: The schedule
+ * @bin: The GStreamer pipeline whose clock running time deadlines are
+ * waited on
+ *
+ * Sets the pipeline running time deadlines refer to.
+ */
+void gstd_pipeline_schedule_watch (GstdPipelineSchedule * object,
+    GstBin * bin);
+
+/**
+ * gstd_pipeline_schedule_unwatch:
+ * @object: The schedule
+ *
+ * Cancels the commands waiting on a running time deadline, typically
+ * before the GStreamer pipeline is torn down. Wall clock deadlines are
+ * kept.
+ */
+void gstd_pipeline_schedule_unwatch (GstdPipelineSchedule * object);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_SCHEDULE_H__
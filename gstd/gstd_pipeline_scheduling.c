@@ -0,0 +1,602 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <errno.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <gst/gst.h>
+
+#include "gstd_pipeline_scheduling.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pipeline Scheduling debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_scheduling_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_scheduling_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+enum
+{
+  PROP_CPUS = 1,
+  PROP_NICE,
+  PROP_PRIORITY,
+  PROP_THREADS,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+#define GSTD_PIPELINE_SCHEDULING_DEFAULT_CPUS NULL
+#define GSTD_PIPELINE_SCHEDULING_DEFAULT_NICE 0
+#define GSTD_PIPELINE_SCHEDULING_DEFAULT_PRIORITY 0
+
+/**
+ * GstdThreadDefaults:
+ * The scheduling a streaming thread had before the policy was applied,
+ * restored when it leaves
+ */
+typedef struct
+{
+  gint nice;
+  gint policy;
+  gint priority;
+#ifdef __linux__
+  gboolean has_cpus;
+  cpu_set_t cpus;
+#endif
+} GstdThreadDefaults;
+
+/**
+ * GstdThreadPolicy:
+ * A copy of the settings, applied to the threads without holding the
+ * object lock
+ */
+typedef struct
+{
+  gboolean is_default;
+  gint nice;
+  gint priority;
+#ifdef __linux__
+  gboolean has_cpus;
+  cpu_set_t cpus;
+#endif
+} GstdThreadPolicy;
+
+/**
+ * GstdPipelineScheduling:
+ * The CPU set and priorities applied to the streaming threads of a
+ * pipeline
+ */
+struct _GstdPipelineScheduling
+{
+  GstdObject parent;
+
+  /**
+   * The CPUs the streaming threads may run on, as in "0-3,6". NULL
+   * or empty for any CPU
+   */
+  gchar *cpus;
+
+  /**
+   * The nice value of the streaming threads
+   */
+  gint nice;
+
+  /**
+   * The SCHED_FIFO priority of the streaming threads, 0 to keep the
+   * regular time sharing scheduler
+   */
+  gint priority;
+
+  /**
+   * The streaming threads currently running, by thread id, along with
+   * their GstdThreadDefaults
+   */
+  GHashTable *threads;
+
+  /**
+   * Protects the threads and serializes applying the policy to them,
+   * so they end up with the latest settings. Taken before the object
+   * lock
+   */
+  GMutex lock;
+};
+
+struct _GstdPipelineSchedulingClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPipelineScheduling, gstd_pipeline_scheduling,
+    GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pipeline_scheduling_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void
+gstd_pipeline_scheduling_get_property (GObject *, guint, GValue *,
+    GParamSpec *);
+static void gstd_pipeline_scheduling_dispose (GObject *);
+static void gstd_pipeline_scheduling_finalize (GObject *);
+static gboolean gstd_pipeline_scheduling_is_default (GstdPipelineScheduling *);
+static gboolean gstd_pipeline_scheduling_valid_cpus (const gchar *);
+static void gstd_pipeline_scheduling_snapshot (GstdPipelineScheduling *,
+    GstdThreadPolicy *);
+#ifdef __linux__
+static gboolean gstd_pipeline_scheduling_parse_cpus (const gchar *,
+    cpu_set_t *);
+static void gstd_pipeline_scheduling_save (GstdPipelineScheduling *, gint,
+    GstdThreadDefaults *);
+#endif
+static void gstd_pipeline_scheduling_apply (GstdPipelineScheduling *, gint,
+    const GstdThreadPolicy *, const GstdThreadDefaults *, gboolean);
+static void gstd_pipeline_scheduling_apply_all (GstdPipelineScheduling *,
+    const GstdThreadPolicy *);
+
+static void
+gstd_pipeline_scheduling_class_init (GstdPipelineSchedulingClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_pipeline_scheduling_set_property;
+  object_class->get_property = gstd_pipeline_scheduling_get_property;
+  object_class->dispose = gstd_pipeline_scheduling_dispose;
+  object_class->finalize = gstd_pipeline_scheduling_finalize;
+
+  properties[PROP_CPUS] =
+      g_param_spec_string ("cpus",
+      "CPUs",
+      "The CPUs the streaming threads may run on, as in \"0-3,6\". "
+      "Empty for the CPUs each thread had. Malformed sets are refused",
+      GSTD_PIPELINE_SCHEDULING_DEFAULT_CPUS,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_NICE] =
+      g_param_spec_int ("nice",
+      "Nice",
+      "The nice value of the streaming threads",
+      -20, 19, GSTD_PIPELINE_SCHEDULING_DEFAULT_NICE,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_PRIORITY] =
+      g_param_spec_int ("priority",
+      "Priority",
+      "The SCHED_FIFO priority of the streaming threads, 0 to keep the "
+      "time sharing scheduler",
+      0, 99, GSTD_PIPELINE_SCHEDULING_DEFAULT_PRIORITY,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_THREADS] =
+      g_param_spec_uint ("threads",
+      "Threads",
+      "The amount of streaming threads the policy is applied to",
+      0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS |
+      GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_scheduling_debug,
+      "gstdpipelinescheduling", debug_color,
+      "Gstd Pipeline Scheduling category");
+}
+
+static void
+gstd_pipeline_scheduling_init (GstdPipelineScheduling * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline scheduling");
+
+  self->cpus = g_strdup (GSTD_PIPELINE_SCHEDULING_DEFAULT_CPUS);
+  self->nice = GSTD_PIPELINE_SCHEDULING_DEFAULT_NICE;
+  self->priority = GSTD_PIPELINE_SCHEDULING_DEFAULT_PRIORITY;
+  self->threads = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, g_free);
+  g_mutex_init (&self->lock);
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_pipeline_scheduling_dispose (GObject * object)
+{
+  GstdPipelineScheduling *self = GSTD_PIPELINE_SCHEDULING (object);
+
+  GST_INFO_OBJECT (self, "Disposing pipeline scheduling");
+
+  if (self->cpus) {
+    g_free (self->cpus);
+    self->cpus = NULL;
+  }
+
+  if (self->threads) {
+    g_hash_table_unref (self->threads);
+    self->threads = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_pipeline_scheduling_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_scheduling_finalize (GObject * object)
+{
+  GstdPipelineScheduling *self = GSTD_PIPELINE_SCHEDULING (object);
+
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (gstd_pipeline_scheduling_parent_class)->finalize (object);
+}
+
+static void
+gstd_pipeline_scheduling_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineScheduling *self = GSTD_PIPELINE_SCHEDULING (object);
+
+  /* The threads are protected by their own lock */
+  if (PROP_THREADS == property_id) {
+    g_mutex_lock (&self->lock);
+    g_value_set_uint (value, g_hash_table_size (self->threads));
+    g_mutex_unlock (&self->lock);
+    return;
+  }
+
+  GST_OBJECT_LOCK (self);
+  switch (property_id) {
+    case PROP_CPUS:
+      GST_DEBUG_OBJECT (self, "Returning cpus \"%s\"", self->cpus);
+      g_value_set_string (value, self->cpus);
+      break;
+    case PROP_NICE:
+      GST_DEBUG_OBJECT (self, "Returning nice %d", self->nice);
+      g_value_set_int (value, self->nice);
+      break;
+    case PROP_PRIORITY:
+      GST_DEBUG_OBJECT (self, "Returning priority %d", self->priority);
+      g_value_set_int (value, self->priority);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gstd_pipeline_scheduling_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineScheduling *self = GSTD_PIPELINE_SCHEDULING (object);
+  GstdThreadPolicy policy;
+  const gchar *cpus;
+
+  g_mutex_lock (&self->lock);
+  GST_OBJECT_LOCK (self);
+  switch (property_id) {
+    case PROP_CPUS:
+      cpus = g_value_get_string (value);
+      if (!gstd_pipeline_scheduling_valid_cpus (cpus)) {
+        GST_ERROR_OBJECT (self, "Malformed cpu set \"%s\", keeping \"%s\"",
+            cpus, self->cpus);
+        GST_OBJECT_UNLOCK (self);
+        g_mutex_unlock (&self->lock);
+        return;
+      }
+      g_free (self->cpus);
+      self->cpus = g_strdup (cpus);
+      GST_INFO_OBJECT (self, "Changed cpus to \"%s\"", self->cpus);
+      break;
+    case PROP_NICE:
+      self->nice = g_value_get_int (value);
+      GST_INFO_OBJECT (self, "Changed nice to %d", self->nice);
+      break;
+    case PROP_PRIORITY:
+      self->priority = g_value_get_int (value);
+      GST_INFO_OBJECT (self, "Changed priority to %d", self->priority);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      GST_OBJECT_UNLOCK (self);
+      g_mutex_unlock (&self->lock);
+      return;
+  }
+  gstd_pipeline_scheduling_snapshot (self, &policy);
+  GST_OBJECT_UNLOCK (self);
+
+  /* Reach the threads that are already running */
+  gstd_pipeline_scheduling_apply_all (self, &policy);
+  g_mutex_unlock (&self->lock);
+}
+
+GstdPipelineScheduling *
+gstd_pipeline_scheduling_new (void)
+{
+  return GSTD_PIPELINE_SCHEDULING (g_object_new
+      (GSTD_TYPE_PIPELINE_SCHEDULING, "name", "scheduling", NULL));
+}
+
+void
+gstd_pipeline_scheduling_enter (GstdPipelineScheduling * self,
+    GstElement * owner)
+{
+#ifdef __linux__
+  GstdThreadDefaults *defaults;
+  GstdThreadPolicy policy;
+  gint tid;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_SCHEDULING (self));
+
+  tid = (gint) syscall (SYS_gettid);
+
+  g_mutex_lock (&self->lock);
+  /* A thread entering again keeps the defaults it had the first time */
+  defaults = g_hash_table_lookup (self->threads, GINT_TO_POINTER (tid));
+  if (!defaults) {
+    defaults = g_new0 (GstdThreadDefaults, 1);
+    gstd_pipeline_scheduling_save (self, tid, defaults);
+    g_hash_table_insert (self->threads, GINT_TO_POINTER (tid), defaults);
+  }
+
+  GST_OBJECT_LOCK (self);
+  gstd_pipeline_scheduling_snapshot (self, &policy);
+  GST_OBJECT_UNLOCK (self);
+
+  if (!policy.is_default) {
+    GST_DEBUG_OBJECT (self, "Applying policy to thread %d of \"%s\"", tid,
+        owner ? GST_OBJECT_NAME (owner) : "unknown");
+    gstd_pipeline_scheduling_apply (self, tid, &policy, defaults, FALSE);
+  }
+  g_mutex_unlock (&self->lock);
+#endif
+}
+
+void
+gstd_pipeline_scheduling_leave (GstdPipelineScheduling * self,
+    GstElement * owner)
+{
+#ifdef __linux__
+  GstdThreadDefaults *defaults;
+  GstdThreadPolicy policy;
+  gint tid;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_SCHEDULING (self));
+
+  tid = (gint) syscall (SYS_gettid);
+
+  g_mutex_lock (&self->lock);
+  GST_OBJECT_LOCK (self);
+  gstd_pipeline_scheduling_snapshot (self, &policy);
+  GST_OBJECT_UNLOCK (self);
+
+  /* The thread may go back to a shared pool, don't let the policy
+     leak into whoever picks it up next */
+  defaults = g_hash_table_lookup (self->threads, GINT_TO_POINTER (tid));
+  if (defaults && !policy.is_default) {
+    GST_DEBUG_OBJECT (self, "Restoring defaults of thread %d of \"%s\"", tid,
+        owner ? GST_OBJECT_NAME (owner) : "unknown");
+    gstd_pipeline_scheduling_apply (self, tid, &policy, defaults, TRUE);
+  }
+  g_hash_table_remove (self->threads, GINT_TO_POINTER (tid));
+  g_mutex_unlock (&self->lock);
+#endif
+}
+
+/* Must be called with the object lock held */
+static gboolean
+gstd_pipeline_scheduling_is_default (GstdPipelineScheduling * self)
+{
+  return (!self->cpus || '\0' == self->cpus[0]) &&
+      GSTD_PIPELINE_SCHEDULING_DEFAULT_NICE == self->nice &&
+      GSTD_PIPELINE_SCHEDULING_DEFAULT_PRIORITY == self->priority;
+}
+
+/* Must be called with the object lock held */
+static void
+gstd_pipeline_scheduling_snapshot (GstdPipelineScheduling * self,
+    GstdThreadPolicy * policy)
+{
+  policy->is_default = gstd_pipeline_scheduling_is_default (self);
+  policy->nice = self->nice;
+  policy->priority = self->priority;
+#ifdef __linux__
+  /* Already validated when set */
+  policy->has_cpus = self->cpus && '\0' != self->cpus[0] &&
+      gstd_pipeline_scheduling_parse_cpus (self->cpus, &policy->cpus);
+#endif
+}
+
+#ifdef __linux__
+static gboolean
+gstd_pipeline_scheduling_parse_cpus (const gchar * cpus, cpu_set_t * set)
+{
+  gchar **ranges;
+  gchar **range;
+  gboolean ret = TRUE;
+
+  CPU_ZERO (set);
+
+  ranges = g_strsplit (cpus, ",", -1);
+  for (range = ranges; *range && ret; range++) {
+    gchar *end;
+    guint64 first;
+    guint64 last;
+
+    first = g_ascii_strtoull (*range, &end, 10);
+    if (end == *range) {
+      ret = FALSE;
+      break;
+    }
+
+    last = first;
+    if ('-' == *end) {
+      gchar *start = end + 1;
+      last = g_ascii_strtoull (start, &end, 10);
+      if (end == start) {
+        ret = FALSE;
+        break;
+      }
+    }
+
+    if ('\0' != *end || last < first || last >= CPU_SETSIZE) {
+      ret = FALSE;
+      break;
+    }
+
+    for (; first <= last; first++) {
+      CPU_SET (first, set);
+    }
+  }
+  g_strfreev (ranges);
+
+  return ret;
+}
+#endif
+
+static gboolean
+gstd_pipeline_scheduling_valid_cpus (const gchar * cpus)
+{
+#ifdef __linux__
+  cpu_set_t set;
+
+  return !cpus || '\0' == cpus[0] ||
+      gstd_pipeline_scheduling_parse_cpus (cpus, &set);
+#else
+  /* Never applied anyway */
+  return TRUE;
+#endif
+}
+
+#ifdef __linux__
+static void
+gstd_pipeline_scheduling_save (GstdPipelineScheduling * self, gint tid,
+    GstdThreadDefaults * defaults)
+{
+  struct sched_param param = { 0, };
+
+  /* -1 is a valid nice value, only errno tells failures apart */
+  errno = 0;
+  defaults->nice = getpriority (PRIO_PROCESS, tid);
+  if (-1 == defaults->nice && errno) {
+    GST_WARNING_OBJECT (self, "Unable to get nice of thread %d: %s", tid,
+        g_strerror (errno));
+    defaults->nice = GSTD_PIPELINE_SCHEDULING_DEFAULT_NICE;
+  }
+
+  defaults->policy = sched_getscheduler (tid);
+  if (defaults->policy < 0 || sched_getparam (tid, &param)) {
+    GST_WARNING_OBJECT (self, "Unable to get priority of thread %d: %s",
+        tid, g_strerror (errno));
+    defaults->policy = SCHED_OTHER;
+    param.sched_priority = 0;
+  }
+  defaults->priority = param.sched_priority;
+
+  /* Threads may be pinned on their own, don't assume the process CPUs */
+  defaults->has_cpus =
+      0 == sched_getaffinity (tid, sizeof (defaults->cpus), &defaults->cpus);
+  if (!defaults->has_cpus) {
+    GST_WARNING_OBJECT (self, "Unable to get affinity of thread %d: %s",
+        tid, g_strerror (errno));
+  }
+}
+#endif
+
+/* Must be called with the threads lock held, but not the object lock */
+static void
+gstd_pipeline_scheduling_apply (GstdPipelineScheduling * self, gint tid,
+    const GstdThreadPolicy * settings, const GstdThreadDefaults * defaults,
+    gboolean restore)
+{
+#ifdef __linux__
+  struct sched_param param = { 0, };
+  const cpu_set_t *set;
+  gint nice;
+  gint policy;
+
+  /* Going back to the defaults gives the thread its own settings back */
+  restore = restore || settings->is_default;
+
+  nice = restore ? defaults->nice : settings->nice;
+  if (restore) {
+    param.sched_priority = defaults->priority;
+    policy = defaults->policy;
+  } else {
+    param.sched_priority = settings->priority;
+    policy = param.sched_priority ? SCHED_FIFO : SCHED_OTHER;
+  }
+
+  /* Without a set of its own the thread gets the CPUs it had */
+  set = !restore && settings->has_cpus ? &settings->cpus :
+      defaults->has_cpus ? &defaults->cpus : NULL;
+  if (set && sched_setaffinity (tid, sizeof (*set), set)) {
+    GST_WARNING_OBJECT (self, "Unable to set affinity of thread %d: %s",
+        tid, g_strerror (errno));
+  }
+
+  /* Real time threads must be demoted before the nice value matters */
+  if (sched_setscheduler (tid, policy, &param)) {
+    GST_WARNING_OBJECT (self, "Unable to set priority %d of thread %d: %s",
+        param.sched_priority, tid, g_strerror (errno));
+  }
+
+  /* On Linux the nice value is a per thread attribute */
+  if (setpriority (PRIO_PROCESS, tid, nice)) {
+    GST_WARNING_OBJECT (self, "Unable to set nice %d of thread %d: %s",
+        nice, tid, g_strerror (errno));
+  }
+#else
+  GST_WARNING_OBJECT (self, "Thread scheduling is not supported on this "
+      "platform");
+#endif
+}
+
+/* Must be called with the threads lock held, but not the object lock */
+static void
+gstd_pipeline_scheduling_apply_all (GstdPipelineScheduling * self,
+    const GstdThreadPolicy * policy)
+{
+  GHashTableIter iter;
+  gpointer tid;
+  gpointer defaults;
+
+  g_hash_table_iter_init (&iter, self->threads);
+  while (g_hash_table_iter_next (&iter, &tid, &defaults)) {
+    gstd_pipeline_scheduling_apply (self, GPOINTER_TO_INT (tid), policy,
+        defaults, FALSE);
+  }
+}
@@ -0,0 +1,84 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_SCHEDULING_H__
+#define __GSTD_PIPELINE_SCHEDULING_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_SCHEDULING \
+  (gstd_pipeline_scheduling_get_type())
+#define GSTD_PIPELINE_SCHEDULING(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_SCHEDULING,GstdPipelineScheduling))
+#define GSTD_PIPELINE_SCHEDULING_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_SCHEDULING,GstdPipelineSchedulingClass))
+#define GSTD_IS_PIPELINE_SCHEDULING(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_SCHEDULING))
+#define GSTD_IS_PIPELINE_SCHEDULING_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_SCHEDULING))
+#define GSTD_PIPELINE_SCHEDULING_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_SCHEDULING, GstdPipelineSchedulingClass))
+typedef struct _GstdPipelineScheduling GstdPipelineScheduling;
+typedef struct _GstdPipelineSchedulingClass GstdPipelineSchedulingClass;
+GType gstd_pipeline_scheduling_get_type (void);
+
+/**
+ * gstd_pipeline_scheduling_new: (constructor)
+ *
+ * Creates a new object to handle the scheduling policy of the
+ * streaming threads of a pipeline.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineScheduling.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineScheduling *gstd_pipeline_scheduling_new (void);
+
+/**
+ * gstd_pipeline_scheduling_enter:
+ * @object: The scheduling policy to apply
+ * @owner: The element owning the streaming thread
+ *
+ * Applies the policy to the calling thread and keeps track of it, so
+ * that later changes reach it as well. Must be called from the
+ * streaming thread itself, typically on STREAM_STATUS ENTER.
+ */
+void gstd_pipeline_scheduling_enter (GstdPipelineScheduling * object,
+    GstElement * owner);
+
+/**
+ * gstd_pipeline_scheduling_leave:
+ * @object: The scheduling policy that was applied
+ * @owner: The element owning the streaming thread
+ *
+ * Restores the process defaults in the calling thread and stops
+ * tracking it. Must be called from the streaming thread itself,
+ * typically on STREAM_STATUS LEAVE.
+ */
+void gstd_pipeline_scheduling_leave (GstdPipelineScheduling * object,
+    GstElement * owner);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_SCHEDULING_H__
@@ -0,0 +1,478 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <gst/gst.h>
+
+#include "gstd_pipeline_stats.h"
+#include "gstd_pipeline_thread.h"
+#include "gstd_pipeline_latency.h"
+#include "gstd_pipeline_qos.h"
+#include "gstd_list.h"
+#include "gstd_list_reader.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pipeline Stats debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_stats_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_stats_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/* Linux thread names are limited to 16 bytes, including the NUL */
+#define GSTD_PIPELINE_STATS_THREAD_NAME_LEN 16
+
+enum
+{
+  PROP_THREADS = 1,
+  PROP_CPU_TIME,
+  PROP_CONTEXT_SWITCHES,
+  PROP_RSS,
+  PROP_LATENCY,
+  PROP_QOS,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/**
+ * GstdPipelineStats:
+ * The runtime statistics of a pipeline
+ */
+struct _GstdPipelineStats
+{
+  GstdObject parent;
+
+  /**
+   * The streaming threads currently running in the pipeline
+   */
+  GstdList *threads;
+
+  /**
+   * The usage of the threads that already left
+   */
+  guint64 retired_cpu_time;
+  guint64 retired_switches;
+
+  /**
+   * The names the threads had before entering, by thread id, given
+   * back when they leave
+   */
+  GHashTable *names;
+
+  /**
+   * The latency tracer results of the pipeline
+   */
+  GstdPipelineLatency *latency;
+
+  /**
+   * The QoS aggregates of the pipeline
+   */
+  GstdPipelineQos *qos;
+};
+
+struct _GstdPipelineStatsClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPipelineStats, gstd_pipeline_stats, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pipeline_stats_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_pipeline_stats_dispose (GObject *);
+static void gstd_pipeline_stats_get_usage (GstdPipelineStats *, guint64 *,
+    guint64 *);
+static guint64 gstd_pipeline_stats_get_rss (void);
+static gint gstd_pipeline_stats_get_tid (void);
+
+static void
+gstd_pipeline_stats_class_init (GstdPipelineStatsClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->get_property = gstd_pipeline_stats_get_property;
+  object_class->dispose = gstd_pipeline_stats_dispose;
+
+  properties[PROP_THREADS] =
+      g_param_spec_object ("threads",
+      "Threads",
+      "The streaming threads running in the pipeline",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_CPU_TIME] =
+      g_param_spec_uint64 ("cpu-time",
+      "CPU Time",
+      "The CPU time spent by the streaming threads, in nanoseconds",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_CONTEXT_SWITCHES] =
+      g_param_spec_uint64 ("context-switches",
+      "Context Switches",
+      "The context switches of the streaming threads",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_RSS] =
+      g_param_spec_uint64 ("rss",
+      "RSS",
+      "The resident memory of the whole daemon in bytes. Threads share "
+      "the address space so memory can't be attributed to a pipeline",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_LATENCY] =
+      g_param_spec_object ("latency",
+      "Latency",
+      "The latency tracer results of the pipeline",
+      GSTD_TYPE_PIPELINE_LATENCY,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_QOS] =
+      g_param_spec_object ("qos",
+      "QoS",
+      "The sliding window aggregates of the QoS messages of each element",
+      GSTD_TYPE_PIPELINE_QOS,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_stats_debug, "gstdpipelinestats",
+      debug_color, "Gstd Pipeline Stats category");
+}
+
+static void
+gstd_pipeline_stats_init (GstdPipelineStats * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline stats");
+
+  self->threads = g_object_new (GSTD_TYPE_LIST, "name", "threads",
+      "node-type", GSTD_TYPE_PIPELINE_THREAD, "flags", GSTD_PARAM_READ, NULL);
+  self->latency = gstd_pipeline_latency_new ();
+  self->qos = gstd_pipeline_qos_new ();
+  self->retired_cpu_time = 0;
+  self->retired_switches = 0;
+  self->names = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+      g_free);
+
+  gstd_object_set_reader (GSTD_OBJECT (self->threads),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_pipeline_stats_dispose (GObject * object)
+{
+  GstdPipelineStats *self = GSTD_PIPELINE_STATS (object);
+
+  GST_INFO_OBJECT (self, "Disposing pipeline stats");
+
+  if (self->threads) {
+    g_object_unref (self->threads);
+    self->threads = NULL;
+  }
+
+  if (self->latency) {
+    g_object_unref (self->latency);
+    self->latency = NULL;
+  }
+
+  if (self->qos) {
+    g_object_unref (self->qos);
+    self->qos = NULL;
+  }
+
+  if (self->names) {
+    g_hash_table_unref (self->names);
+    self->names = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_pipeline_stats_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_stats_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineStats *self = GSTD_PIPELINE_STATS (object);
+  guint64 cpu_time;
+  guint64 switches;
+
+  switch (property_id) {
+    case PROP_THREADS:
+      GST_DEBUG_OBJECT (self, "Returning thread list %p", self->threads);
+      g_value_set_object (value, self->threads);
+      break;
+    case PROP_CPU_TIME:
+      gstd_pipeline_stats_get_usage (self, &cpu_time, NULL);
+      g_value_set_uint64 (value, cpu_time);
+      break;
+    case PROP_CONTEXT_SWITCHES:
+      gstd_pipeline_stats_get_usage (self, NULL, &switches);
+      g_value_set_uint64 (value, switches);
+      break;
+    case PROP_RSS:
+      g_value_set_uint64 (value, gstd_pipeline_stats_get_rss ());
+      break;
+    case PROP_LATENCY:
+      GST_DEBUG_OBJECT (self, "Returning latency %p", self->latency);
+      g_value_set_object (value, self->latency);
+      break;
+    case PROP_QOS:
+      GST_DEBUG_OBJECT (self, "Returning QoS %p", self->qos);
+      g_value_set_object (value, self->qos);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+GstdPipelineStats *
+gstd_pipeline_stats_new (void)
+{
+  return GSTD_PIPELINE_STATS (g_object_new (GSTD_TYPE_PIPELINE_STATS,
+          "name", "stats", NULL));
+}
+
+void
+gstd_pipeline_stats_watch (GstdPipelineStats * self, GstBin * bin)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_STATS (self));
+  g_return_if_fail (GST_IS_BIN (bin));
+
+  gstd_pipeline_latency_watch (self->latency, bin);
+}
+
+void
+gstd_pipeline_stats_unwatch (GstdPipelineStats * self)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_STATS (self));
+
+  gstd_pipeline_latency_unwatch (self->latency);
+}
+
+void
+gstd_pipeline_stats_qos (GstdPipelineStats * self, GstMessage * message)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_STATS (self));
+  g_return_if_fail (GST_IS_MESSAGE (message));
+
+  gstd_pipeline_qos_add (self->qos, message);
+}
+
+void
+gstd_pipeline_stats_thread_enter (GstdPipelineStats * self,
+    const gchar * pipeline, GstElement * owner)
+{
+  GstdPipelineThread *thread;
+  const gchar *element;
+  gchar *tidname;
+  gint tid;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_STATS (self));
+
+  tid = gstd_pipeline_stats_get_tid ();
+  if (!tid) {
+    return;
+  }
+
+  element = owner ? GST_OBJECT_NAME (owner) : "unknown";
+
+  /* A thread may enter again without leaving when it changes owner */
+  tidname = g_strdup_printf ("%d", tid);
+  thread = GSTD_PIPELINE_THREAD (gstd_list_find_child (self->threads,
+          tidname));
+  g_free (tidname);
+
+  if (!thread) {
+    thread = gstd_pipeline_thread_new (tid);
+    if (!gstd_list_append_child (self->threads, GSTD_OBJECT (thread))) {
+      g_object_unref (thread);
+      return;
+    }
+    g_object_ref (thread);
+  }
+
+  gstd_pipeline_thread_enter (thread, element);
+  g_object_unref (thread);
+
+#ifdef __linux__
+  {
+    gchar name[GSTD_PIPELINE_STATS_THREAD_NAME_LEN] = { 0, };
+
+    /* Pooled threads serve others after leaving, keep the name they
+       had the first time */
+    GST_OBJECT_LOCK (self);
+    if (!g_hash_table_contains (self->names, GINT_TO_POINTER (tid)) &&
+        !prctl (PR_GET_NAME, name, 0, 0, 0)) {
+      g_hash_table_insert (self->names, GINT_TO_POINTER (tid),
+          g_strndup (name, sizeof (name)));
+    }
+    GST_OBJECT_UNLOCK (self);
+
+    g_snprintf (name, sizeof (name), "%s:%s", pipeline, element);
+    prctl (PR_SET_NAME, name, 0, 0, 0);
+  }
+#endif
+
+  GST_DEBUG_OBJECT (self, "Thread %d entered \"%s:%s\"", tid, pipeline,
+      element);
+}
+
+void
+gstd_pipeline_stats_thread_leave (GstdPipelineStats * self,
+    GstElement * owner)
+{
+  GstdObject *thread;
+  guint64 cpu_time;
+  guint64 voluntary;
+  guint64 involuntary;
+  gchar *tidname;
+  gchar *name;
+  gint tid;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_STATS (self));
+
+  tid = gstd_pipeline_stats_get_tid ();
+  if (!tid) {
+    return;
+  }
+
+  tidname = g_strdup_printf ("%d", tid);
+  thread = gstd_list_find_child (self->threads, tidname);
+
+  if (thread) {
+    gstd_pipeline_thread_leave (GSTD_PIPELINE_THREAD (thread));
+    gstd_pipeline_thread_get_usage (GSTD_PIPELINE_THREAD (thread),
+        &cpu_time, &voluntary, &involuntary);
+
+    /* Tids are recycled, pruning keeps the list to the live threads.
+       Folding and unlisting at once keeps the totals from jumping. */
+    GST_OBJECT_LOCK (self);
+    self->retired_cpu_time += cpu_time;
+    self->retired_switches += voluntary + involuntary;
+    gstd_list_remove_child (self->threads, tidname);
+    GST_OBJECT_UNLOCK (self);
+
+    g_object_unref (thread);
+  }
+  g_free (tidname);
+
+  GST_OBJECT_LOCK (self);
+  name = g_hash_table_lookup (self->names, GINT_TO_POINTER (tid));
+  g_hash_table_steal (self->names, GINT_TO_POINTER (tid));
+  GST_OBJECT_UNLOCK (self);
+
+#ifdef __linux__
+  if (name) {
+    prctl (PR_SET_NAME, name, 0, 0, 0);
+  }
+#endif
+  g_free (name);
+
+  GST_DEBUG_OBJECT (self, "Thread %d left \"%s\"", tid,
+      owner ? GST_OBJECT_NAME (owner) : "unknown");
+}
+
+static void
+gstd_pipeline_stats_get_usage (GstdPipelineStats * self, guint64 * cpu_time,
+    guint64 * switches)
+{
+  GList *threads;
+  GList *thread;
+  guint64 total_cpu_time = 0;
+  guint64 total_switches = 0;
+
+  /* Hold a reference so usage can be sampled without the list lock */
+  GST_OBJECT_LOCK (self);
+  GST_OBJECT_LOCK (self->threads);
+  threads = g_list_copy_deep (self->threads->list, (GCopyFunc) g_object_ref,
+      NULL);
+  GST_OBJECT_UNLOCK (self->threads);
+  total_cpu_time = self->retired_cpu_time;
+  total_switches = self->retired_switches;
+  GST_OBJECT_UNLOCK (self);
+
+  for (thread = threads; thread; thread = thread->next) {
+    guint64 thread_cpu_time;
+    guint64 voluntary;
+    guint64 involuntary;
+
+    gstd_pipeline_thread_get_usage (GSTD_PIPELINE_THREAD (thread->data),
+        &thread_cpu_time, &voluntary, &involuntary);
+
+    total_cpu_time += thread_cpu_time;
+    total_switches += voluntary + involuntary;
+  }
+  g_list_free_full (threads, g_object_unref);
+
+  if (cpu_time) {
+    *cpu_time = total_cpu_time;
+  }
+  if (switches) {
+    *switches = total_switches;
+  }
+}
+
+static guint64
+gstd_pipeline_stats_get_rss (void)
+{
+  guint64 rss = 0;
+#ifdef __linux__
+  gchar *contents = NULL;
+  gchar **fields;
+
+  /* The second field is the resident set in pages */
+  if (g_file_get_contents ("/proc/self/statm", &contents, NULL, NULL)) {
+    fields = g_strsplit (contents, " ", -1);
+    if (g_strv_length (fields) > 1) {
+      rss = g_ascii_strtoull (fields[1], NULL, 10) * sysconf (_SC_PAGESIZE);
+    }
+    g_strfreev (fields);
+  }
+  g_free (contents);
+#endif
+  return rss;
+}
+
+static gint
+gstd_pipeline_stats_get_tid (void)
+{
+#ifdef __linux__
+  return (gint) syscall (SYS_gettid);
+#else
+  return 0;
+#endif
+}
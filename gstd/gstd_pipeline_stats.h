@@ -0,0 +1,115 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_STATS_H__
+#define __GSTD_PIPELINE_STATS_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_STATS \
+  (gstd_pipeline_stats_get_type())
+#define GSTD_PIPELINE_STATS(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_STATS,GstdPipelineStats))
+#define GSTD_PIPELINE_STATS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_STATS,GstdPipelineStatsClass))
+#define GSTD_IS_PIPELINE_STATS(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_STATS))
+#define GSTD_IS_PIPELINE_STATS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_STATS))
+#define GSTD_PIPELINE_STATS_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_STATS, GstdPipelineStatsClass))
+typedef struct _GstdPipelineStats GstdPipelineStats;
+typedef struct _GstdPipelineStatsClass GstdPipelineStatsClass;
+GType gstd_pipeline_stats_get_type (void);
+
+/**
+ * gstd_pipeline_stats_new: (constructor)
+ *
+ * Creates a new object to hold the runtime statistics of a pipeline.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineStats.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineStats *gstd_pipeline_stats_new (void);
+
+/**
+ * gstd_pipeline_stats_thread_enter:
+ * @object: The stats of the pipeline
+ * @pipeline: The name of the pipeline
+ * @owner: The element owning the streaming thread
+ *
+ * Starts accounting the calling thread to the pipeline and names it
+ * after @pipeline and @owner. Must be called from the streaming thread
+ * itself, typically on STREAM_STATUS ENTER.
+ */
+void gstd_pipeline_stats_thread_enter (GstdPipelineStats * object,
+    const gchar * pipeline, GstElement * owner);
+
+/**
+ * gstd_pipeline_stats_thread_leave:
+ * @object: The stats of the pipeline
+ * @owner: The element owning the streaming thread
+ *
+ * Stops accounting the calling thread to the pipeline and unlists it.
+ * Its usage is kept in the pipeline totals and it gets back the name it
+ * had before entering. Must be called from the streaming thread
+ * itself, typically on STREAM_STATUS LEAVE.
+ */
+void gstd_pipeline_stats_thread_leave (GstdPipelineStats * object,
+    GstElement * owner);
+
+/**
+ * gstd_pipeline_stats_watch:
+ * @object: The stats of the pipeline
+ * @bin: The GStreamer pipeline
+ *
+ * Starts collecting the statistics that are gathered from the
+ * pipeline elements, such as the latency tracer records.
+ */
+void gstd_pipeline_stats_watch (GstdPipelineStats * object, GstBin * bin);
+
+/**
+ * gstd_pipeline_stats_unwatch:
+ * @object: The stats of the pipeline
+ *
+ * Stops collecting statistics from the pipeline elements. Must be
+ * called before disposing the GStreamer pipeline.
+ */
+void gstd_pipeline_stats_unwatch (GstdPipelineStats * object);
+
+/**
+ * gstd_pipeline_stats_qos:
+ * @object: The stats of the pipeline
+ * @message: A QoS message posted in the pipeline
+ *
+ * Accounts @message in the QoS aggregates of the element that posted
+ * it. Safe to be called from the bus sync handler.
+ */
+void gstd_pipeline_stats_qos (GstdPipelineStats * object,
+    GstMessage * message);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_STATS_H__
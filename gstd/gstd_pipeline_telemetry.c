@@ -0,0 +1,367 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_pipeline_telemetry.h"
+#include "gstd_telemetry_series.h"
+
+/* Gstd Pipeline Telemetry debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_telemetry_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_telemetry_debug
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/**
+ * GstdPipelineTelemetry:
+ * Creates and deletes the telemetry series of a pipeline, and samples
+ * all of them from a single thread. The thread starts along with the
+ * first series and exits once the last one is deleted.
+ */
+struct _GstdPipelineTelemetry
+{
+  GObject parent;
+
+  GMutex lock;
+  GCond cond;
+
+  /**
+   * The GStreamer pipeline holding the sampled elements
+   */
+  GstBin *bin;
+
+  /**
+   * The series created so far
+   */
+  GList *series;
+
+  GThread *thread;
+  gboolean running;
+  gboolean stopping;
+};
+
+struct _GstdPipelineTelemetryClass
+{
+  GObjectClass parent_class;
+};
+
+/* VTable */
+static void gstd_pipeline_telemetry_dispose (GObject *);
+static void gstd_pipeline_telemetry_finalize (GObject *);
+static GstdReturnCode gstd_pipeline_telemetry_create (GstdICreator * iface,
+    const gchar * name, const gchar * description, GstdObject ** out);
+static GstdReturnCode gstd_pipeline_telemetry_delete (GstdIDeleter * iface,
+    GstdObject * object);
+static void gstd_pipeline_telemetry_start (GstdPipelineTelemetry *);
+static gpointer gstd_pipeline_telemetry_func (gpointer);
+static void gstd_pipeline_telemetry_interval_changed (GObject *,
+    GParamSpec *, gpointer);
+
+static void
+gstd_icreator_interface_init (GstdICreatorInterface * iface)
+{
+  iface->create = gstd_pipeline_telemetry_create;
+}
+
+static void
+gstd_ideleter_interface_init (GstdIDeleterInterface * iface)
+{
+  iface->delete = gstd_pipeline_telemetry_delete;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GstdPipelineTelemetry, gstd_pipeline_telemetry,
+    G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE (GSTD_TYPE_ICREATOR,
+        gstd_icreator_interface_init);
+    G_IMPLEMENT_INTERFACE (GSTD_TYPE_IDELETER, gstd_ideleter_interface_init));
+
+static void
+gstd_pipeline_telemetry_class_init (GstdPipelineTelemetryClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  guint debug_color;
+
+  object_class->dispose = gstd_pipeline_telemetry_dispose;
+  object_class->finalize = gstd_pipeline_telemetry_finalize;
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_telemetry_debug,
+      "gstdpipelinetelemetry", debug_color, "Gstd Pipeline Telemetry category");
+}
+
+static void
+gstd_pipeline_telemetry_init (GstdPipelineTelemetry * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline telemetry");
+
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond);
+  self->bin = NULL;
+  self->series = NULL;
+  self->thread = NULL;
+  self->running = FALSE;
+  self->stopping = FALSE;
+}
+
+GstdPipelineTelemetry *
+gstd_pipeline_telemetry_new (void)
+{
+  return GSTD_PIPELINE_TELEMETRY (g_object_new (GSTD_TYPE_PIPELINE_TELEMETRY,
+          NULL));
+}
+
+static void
+gstd_pipeline_telemetry_dispose (GObject * object)
+{
+  GstdPipelineTelemetry *self = GSTD_PIPELINE_TELEMETRY (object);
+  GThread *thread;
+  GList *series;
+  GList *node;
+
+  GST_INFO_OBJECT (self, "Disposing pipeline telemetry");
+
+  g_mutex_lock (&self->lock);
+  self->stopping = TRUE;
+  thread = self->thread;
+  self->thread = NULL;
+  g_cond_signal (&self->cond);
+  g_mutex_unlock (&self->lock);
+
+  if (thread) {
+    g_thread_join (thread);
+  }
+
+  gstd_pipeline_telemetry_unwatch (self);
+
+  g_mutex_lock (&self->lock);
+  series = self->series;
+  self->series = NULL;
+  g_mutex_unlock (&self->lock);
+
+  /* Series may outlive us in the client's hands */
+  for (node = series; node; node = node->next) {
+    g_signal_handlers_disconnect_by_data (node->data, self);
+  }
+  g_list_free_full (series, g_object_unref);
+
+  G_OBJECT_CLASS (gstd_pipeline_telemetry_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_telemetry_finalize (GObject * object)
+{
+  GstdPipelineTelemetry *self = GSTD_PIPELINE_TELEMETRY (object);
+
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond);
+
+  G_OBJECT_CLASS (gstd_pipeline_telemetry_parent_class)->finalize (object);
+}
+
+void
+gstd_pipeline_telemetry_watch (GstdPipelineTelemetry * self, GstBin * bin)
+{
+  GstdTelemetrySeries *series;
+  GList *node;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_TELEMETRY (self));
+  g_return_if_fail (GST_IS_BIN (bin));
+
+  g_mutex_lock (&self->lock);
+  if (self->bin) {
+    g_mutex_unlock (&self->lock);
+    GST_ERROR_OBJECT (self, "Already watching a pipeline");
+    return;
+  }
+
+  self->bin = gst_object_ref (bin);
+
+  /* Series outliving a rebuild resume on the new elements, those whose
+     element is gone stay detached with their history */
+  for (node = self->series; node; node = node->next) {
+    series = GSTD_TELEMETRY_SERIES (node->data);
+    if (GSTD_EOK != gstd_telemetry_series_attach (series, bin)) {
+      GST_WARNING_OBJECT (self, "Unable to resume \"%s\"",
+          GSTD_OBJECT_NAME (series));
+    }
+  }
+
+  if (self->series) {
+    gstd_pipeline_telemetry_start (self);
+    g_cond_signal (&self->cond);
+  }
+  g_mutex_unlock (&self->lock);
+}
+
+void
+gstd_pipeline_telemetry_unwatch (GstdPipelineTelemetry * self)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_TELEMETRY (self));
+
+  /* The elements are gone along with the pipeline, the series stay
+     listed with their history until deleted */
+  g_mutex_lock (&self->lock);
+  g_list_foreach (self->series, (GFunc) gstd_telemetry_series_detach, NULL);
+  if (self->bin) {
+    gst_object_unref (self->bin);
+    self->bin = NULL;
+  }
+  g_mutex_unlock (&self->lock);
+}
+
+/* Called with the lock held */
+static void
+gstd_pipeline_telemetry_start (GstdPipelineTelemetry * self)
+{
+  if (self->running || self->stopping) {
+    return;
+  }
+
+  /* A thread that ran out of series has already given up the lock */
+  if (self->thread) {
+    g_thread_join (self->thread);
+  }
+
+  self->running = TRUE;
+  self->thread = g_thread_new ("gstd-telemetry",
+      gstd_pipeline_telemetry_func, self);
+}
+
+static gpointer
+gstd_pipeline_telemetry_func (gpointer data)
+{
+  GstdPipelineTelemetry *self = GSTD_PIPELINE_TELEMETRY (data);
+  GList *node;
+  gint64 now;
+  gint64 next;
+  gint64 due;
+
+  g_mutex_lock (&self->lock);
+  while (!self->stopping && self->series) {
+    now = g_get_monotonic_time ();
+    next = now + G_TIME_SPAN_SECOND;
+
+    for (node = self->series; node; node = node->next) {
+      due = gstd_telemetry_series_poll (node->data, now);
+      next = MIN (next, due);
+    }
+
+    /* Woken up early whenever the series change */
+    g_cond_wait_until (&self->cond, &self->lock, next);
+  }
+  self->running = FALSE;
+  g_mutex_unlock (&self->lock);
+
+  return NULL;
+}
+
+static void
+gstd_pipeline_telemetry_interval_changed (GObject * series,
+    GParamSpec * pspec, gpointer data)
+{
+  GstdPipelineTelemetry *self = GSTD_PIPELINE_TELEMETRY (data);
+
+  /* The thread may be sleeping on the old interval */
+  g_mutex_lock (&self->lock);
+  g_cond_signal (&self->cond);
+  g_mutex_unlock (&self->lock);
+}
+
+static GstdReturnCode
+gstd_pipeline_telemetry_create (GstdICreator * iface, const gchar * name,
+    const gchar * description, GstdObject ** out)
+{
+  GstdPipelineTelemetry *self;
+  GstdTelemetrySeries *series;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (out, GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_TELEMETRY (iface);
+  *out = NULL;
+
+  if (NULL == name) {
+    GST_ERROR_OBJECT (self, "Series name not provided");
+    return GSTD_MISSING_NAME;
+  }
+
+  if (NULL == description) {
+    GST_ERROR_OBJECT (self, "Series element and property not provided");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  series = gstd_telemetry_series_new (name, description);
+  *out = GSTD_OBJECT (series);
+
+  g_mutex_lock (&self->lock);
+  if (!self->bin) {
+    g_mutex_unlock (&self->lock);
+    GST_ERROR_OBJECT (self, "No pipeline to sample");
+    return GSTD_NO_PIPELINE;
+  }
+
+  ret = gstd_telemetry_series_attach (series, self->bin);
+  if (GSTD_EOK == ret) {
+    self->series = g_list_append (self->series, g_object_ref (series));
+    g_signal_connect (series, "notify::interval",
+        G_CALLBACK (gstd_pipeline_telemetry_interval_changed), self);
+    gstd_pipeline_telemetry_start (self);
+    /* Take the first sample right away */
+    g_cond_signal (&self->cond);
+  }
+  g_mutex_unlock (&self->lock);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_pipeline_telemetry_delete (GstdIDeleter * iface, GstdObject * object)
+{
+  GstdPipelineTelemetry *self;
+  GList *found;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_TELEMETRY_SERIES (object),
+      GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_TELEMETRY (iface);
+
+  g_mutex_lock (&self->lock);
+  found = g_list_find (self->series, object);
+  if (found) {
+    self->series = g_list_delete_link (self->series, found);
+    /* Let the thread exit once there is nothing left to sample */
+    g_cond_signal (&self->cond);
+  }
+  g_mutex_unlock (&self->lock);
+
+  g_signal_handlers_disconnect_by_data (object, self);
+  gstd_telemetry_series_detach (GSTD_TELEMETRY_SERIES (object));
+
+  if (found) {
+    g_object_unref (object);
+  }
+
+  /* Release the reference held by the list */
+  g_object_unref (object);
+
+  return GSTD_EOK;
+}
@@ -0,0 +1,78 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_TELEMETRY_H__
+#define __GSTD_PIPELINE_TELEMETRY_H__
+
+#include <gst/gst.h>
+#include <gstd_object.h>
+
+G_BEGIN_DECLS
+#define GSTD_TYPE_PIPELINE_TELEMETRY \
+  (gstd_pipeline_telemetry_get_type())
+#define GSTD_PIPELINE_TELEMETRY(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_TELEMETRY,GstdPipelineTelemetry))
+#define GSTD_PIPELINE_TELEMETRY_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_TELEMETRY,GstdPipelineTelemetryClass))
+#define GSTD_IS_PIPELINE_TELEMETRY(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_TELEMETRY))
+#define GSTD_IS_PIPELINE_TELEMETRY_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_TELEMETRY))
+#define GSTD_PIPELINE_TELEMETRY_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_TELEMETRY, GstdPipelineTelemetryClass))
+
+typedef struct _GstdPipelineTelemetry GstdPipelineTelemetry;
+typedef struct _GstdPipelineTelemetryClass GstdPipelineTelemetryClass;
+
+GType gstd_pipeline_telemetry_get_type (void);
+
+/**
+ * gstd_pipeline_telemetry_new: (constructor)
+ *
+ * Creates the creator/deleter of the telemetry series of a pipeline,
+ * which also samples them.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineTelemetry.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineTelemetry *gstd_pipeline_telemetry_new (void);
+
+/**
+ * gstd_pipeline_telemetry_watch:
+ * @object: The telemetry
+ * @bin: The GStreamer pipeline
+ *
+ * Sets the pipeline new series look their elements up in. Series kept
+ * across a rebuild are attached to the new elements and resume.
+ */
+void gstd_pipeline_telemetry_watch (GstdPipelineTelemetry * object,
+    GstBin * bin);
+
+/**
+ * gstd_pipeline_telemetry_unwatch:
+ * @object: The telemetry
+ *
+ * Detaches the series, typically before the GStreamer pipeline is
+ * torn down along with their elements. The sampled points are kept
+ * until the series are deleted.
+ */
+void gstd_pipeline_telemetry_unwatch (GstdPipelineTelemetry * object);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_TELEMETRY_H__
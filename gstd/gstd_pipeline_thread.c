@@ -0,0 +1,408 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_pipeline_thread.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pipeline Thread debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_thread_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_thread_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+enum
+{
+  PROP_TID = 1,
+  PROP_ELEMENT,
+  PROP_CPU_TIME,
+  PROP_VOLUNTARY_SWITCHES,
+  PROP_INVOLUNTARY_SWITCHES,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+#define GSTD_PIPELINE_THREAD_DEFAULT_TID 0
+#define GSTD_PIPELINE_THREAD_DEFAULT_ELEMENT NULL
+
+typedef struct _GstdPipelineThreadUsage GstdPipelineThreadUsage;
+
+struct _GstdPipelineThreadUsage
+{
+  guint64 cpu_time;
+  guint64 voluntary;
+  guint64 involuntary;
+};
+
+/**
+ * GstdPipelineThread:
+ * The resources a streaming thread spends on behalf of a pipeline
+ */
+struct _GstdPipelineThread
+{
+  GstdObject parent;
+
+  /**
+   * The kernel id of the thread
+   */
+  gint tid;
+
+  /**
+   * The element owning the thread the last time it entered
+   */
+  gchar *element;
+
+  /**
+   * Whether the thread is currently running for the pipeline
+   */
+  gboolean running;
+
+  /**
+   * The usage accumulated by the previous runs
+   */
+  GstdPipelineThreadUsage spent;
+
+  /**
+   * The usage of the thread when it entered the pipeline. Threads may
+   * come from a pool and have served others before
+   */
+  GstdPipelineThreadUsage baseline;
+};
+
+struct _GstdPipelineThreadClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPipelineThread, gstd_pipeline_thread, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pipeline_thread_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void
+gstd_pipeline_thread_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_pipeline_thread_dispose (GObject *);
+static gboolean gstd_pipeline_thread_sample (gint, GstdPipelineThreadUsage *);
+
+static void
+gstd_pipeline_thread_class_init (GstdPipelineThreadClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_pipeline_thread_set_property;
+  object_class->get_property = gstd_pipeline_thread_get_property;
+  object_class->dispose = gstd_pipeline_thread_dispose;
+
+  properties[PROP_TID] =
+      g_param_spec_int ("tid",
+      "TID",
+      "The kernel id of the thread",
+      0, G_MAXINT, GSTD_PIPELINE_THREAD_DEFAULT_TID,
+      G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+      GSTD_PARAM_READ);
+
+  properties[PROP_ELEMENT] =
+      g_param_spec_string ("element",
+      "Element",
+      "The element owning the thread",
+      GSTD_PIPELINE_THREAD_DEFAULT_ELEMENT,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_CPU_TIME] =
+      g_param_spec_uint64 ("cpu-time",
+      "CPU Time",
+      "The CPU time spent by the thread on the pipeline, in nanoseconds",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_VOLUNTARY_SWITCHES] =
+      g_param_spec_uint64 ("voluntary-switches",
+      "Voluntary Switches",
+      "The times the thread yielded the CPU, typically to wait for data",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_INVOLUNTARY_SWITCHES] =
+      g_param_spec_uint64 ("involuntary-switches",
+      "Involuntary Switches",
+      "The times the thread was preempted by the scheduler",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_thread_debug, "gstdpipelinethread",
+      debug_color, "Gstd Pipeline Thread category");
+}
+
+static void
+gstd_pipeline_thread_init (GstdPipelineThread * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline thread");
+
+  self->tid = GSTD_PIPELINE_THREAD_DEFAULT_TID;
+  self->element = g_strdup (GSTD_PIPELINE_THREAD_DEFAULT_ELEMENT);
+  self->running = FALSE;
+  memset (&self->spent, 0, sizeof (self->spent));
+  memset (&self->baseline, 0, sizeof (self->baseline));
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_pipeline_thread_dispose (GObject * object)
+{
+  GstdPipelineThread *self = GSTD_PIPELINE_THREAD (object);
+
+  if (self->element) {
+    g_free (self->element);
+    self->element = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_pipeline_thread_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_thread_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineThread *self = GSTD_PIPELINE_THREAD (object);
+  guint64 cpu_time;
+  guint64 voluntary;
+  guint64 involuntary;
+
+  switch (property_id) {
+    case PROP_TID:
+      g_value_set_int (value, self->tid);
+      break;
+    case PROP_ELEMENT:
+      GST_OBJECT_LOCK (self);
+      g_value_set_string (value, self->element);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_CPU_TIME:
+      gstd_pipeline_thread_get_usage (self, &cpu_time, NULL, NULL);
+      g_value_set_uint64 (value, cpu_time);
+      break;
+    case PROP_VOLUNTARY_SWITCHES:
+      gstd_pipeline_thread_get_usage (self, NULL, &voluntary, NULL);
+      g_value_set_uint64 (value, voluntary);
+      break;
+    case PROP_INVOLUNTARY_SWITCHES:
+      gstd_pipeline_thread_get_usage (self, NULL, NULL, &involuntary);
+      g_value_set_uint64 (value, involuntary);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_pipeline_thread_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineThread *self = GSTD_PIPELINE_THREAD (object);
+
+  switch (property_id) {
+    case PROP_TID:
+      self->tid = g_value_get_int (value);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+GstdPipelineThread *
+gstd_pipeline_thread_new (gint tid)
+{
+  GstdPipelineThread *self;
+  gchar *name;
+
+  name = g_strdup_printf ("%d", tid);
+  self = GSTD_PIPELINE_THREAD (g_object_new (GSTD_TYPE_PIPELINE_THREAD,
+          "name", name, "tid", tid, NULL));
+  g_free (name);
+
+  return self;
+}
+
+void
+gstd_pipeline_thread_enter (GstdPipelineThread * self, const gchar * element)
+{
+  GstdPipelineThreadUsage baseline = { 0, };
+
+  g_return_if_fail (GSTD_IS_PIPELINE_THREAD (self));
+
+  gstd_pipeline_thread_sample (self->tid, &baseline);
+
+  GST_OBJECT_LOCK (self);
+  g_free (self->element);
+  self->element = g_strdup (element);
+  self->baseline = baseline;
+  self->running = TRUE;
+  GST_OBJECT_UNLOCK (self);
+}
+
+void
+gstd_pipeline_thread_leave (GstdPipelineThread * self)
+{
+  guint64 cpu_time;
+  guint64 voluntary;
+  guint64 involuntary;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_THREAD (self));
+
+  /* Fold the current run into the accumulated usage */
+  gstd_pipeline_thread_get_usage (self, &cpu_time, &voluntary, &involuntary);
+
+  GST_OBJECT_LOCK (self);
+  self->spent.cpu_time = cpu_time;
+  self->spent.voluntary = voluntary;
+  self->spent.involuntary = involuntary;
+  self->running = FALSE;
+  GST_OBJECT_UNLOCK (self);
+}
+
+void
+gstd_pipeline_thread_get_usage (GstdPipelineThread * self,
+    guint64 * cpu_time, guint64 * voluntary, guint64 * involuntary)
+{
+  GstdPipelineThreadUsage current = { 0, };
+  GstdPipelineThreadUsage usage;
+  gboolean running;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_THREAD (self));
+
+  GST_OBJECT_LOCK (self);
+  running = self->running;
+  GST_OBJECT_UNLOCK (self);
+
+  if (running) {
+    running = gstd_pipeline_thread_sample (self->tid, &current);
+  }
+
+  GST_OBJECT_LOCK (self);
+  usage = self->spent;
+  if (running && self->running) {
+    usage.cpu_time += current.cpu_time - self->baseline.cpu_time;
+    usage.voluntary += current.voluntary - self->baseline.voluntary;
+    usage.involuntary += current.involuntary - self->baseline.involuntary;
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  if (cpu_time) {
+    *cpu_time = usage.cpu_time;
+  }
+  if (voluntary) {
+    *voluntary = usage.voluntary;
+  }
+  if (involuntary) {
+    *involuntary = usage.involuntary;
+  }
+}
+
+static gboolean
+gstd_pipeline_thread_sample (gint tid, GstdPipelineThreadUsage * usage)
+{
+#ifdef __linux__
+  gchar *filename;
+  gchar *contents = NULL;
+  gchar *fields;
+  gchar **tokens;
+  gchar **lines;
+  gchar **line;
+  gboolean ret = FALSE;
+  glong ticks;
+
+  g_return_val_if_fail (usage, FALSE);
+
+  ticks = sysconf (_SC_CLK_TCK);
+
+  /* The command name may contain spaces, fields start after the
+     closing parenthesis, with the state being the 3rd one */
+  filename = g_strdup_printf ("/proc/self/task/%d/stat", tid);
+  if (!g_file_get_contents (filename, &contents, NULL, NULL)) {
+    GST_DEBUG ("Unable to read %s", filename);
+    goto out;
+  }
+
+  fields = strrchr (contents, ')');
+  if (!fields) {
+    goto out;
+  }
+
+  tokens = g_strsplit (fields + 2, " ", -1);
+  /* utime and stime are the 14th and 15th fields */
+  if (g_strv_length (tokens) > 12 && ticks > 0) {
+    guint64 utime = g_ascii_strtoull (tokens[11], NULL, 10);
+    guint64 stime = g_ascii_strtoull (tokens[12], NULL, 10);
+    usage->cpu_time = gst_util_uint64_scale (utime + stime, GST_SECOND, ticks);
+    ret = TRUE;
+  }
+  g_strfreev (tokens);
+
+  g_free (filename);
+  g_free (contents);
+  contents = NULL;
+
+  filename = g_strdup_printf ("/proc/self/task/%d/status", tid);
+  if (!g_file_get_contents (filename, &contents, NULL, NULL)) {
+    GST_DEBUG ("Unable to read %s", filename);
+    goto out;
+  }
+
+  lines = g_strsplit (contents, "\n", -1);
+  for (line = lines; *line; line++) {
+    if (g_str_has_prefix (*line, "voluntary_ctxt_switches:")) {
+      usage->voluntary = g_ascii_strtoull (strchr (*line, ':') + 1, NULL, 10);
+    } else if (g_str_has_prefix (*line, "nonvoluntary_ctxt_switches:")) {
+      usage->involuntary =
+          g_ascii_strtoull (strchr (*line, ':') + 1, NULL, 10);
+    }
+  }
+  g_strfreev (lines);
+
+out:
+  g_free (filename);
+  g_free (contents);
+
+  return ret;
+#else
+  return FALSE;
+#endif
+}
@@ -0,0 +1,92 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_THREAD_H__
+#define __GSTD_PIPELINE_THREAD_H__
+
+#include <glib-object.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_THREAD \
+  (gstd_pipeline_thread_get_type())
+#define GSTD_PIPELINE_THREAD(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_THREAD,GstdPipelineThread))
+#define GSTD_PIPELINE_THREAD_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_THREAD,GstdPipelineThreadClass))
+#define GSTD_IS_PIPELINE_THREAD(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_THREAD))
+#define GSTD_IS_PIPELINE_THREAD_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_THREAD))
+#define GSTD_PIPELINE_THREAD_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_THREAD, GstdPipelineThreadClass))
+typedef struct _GstdPipelineThread GstdPipelineThread;
+typedef struct _GstdPipelineThreadClass GstdPipelineThreadClass;
+GType gstd_pipeline_thread_get_type (void);
+
+/**
+ * gstd_pipeline_thread_new: (constructor)
+ * @tid: The kernel id of the streaming thread
+ *
+ * Creates a new object to account the resources a streaming thread
+ * spends on behalf of a pipeline. The object is named after @tid.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineThread.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineThread *gstd_pipeline_thread_new (gint tid);
+
+/**
+ * gstd_pipeline_thread_enter:
+ * @object: The thread entering the pipeline
+ * @element: The name of the element owning the thread
+ *
+ * Starts accounting the thread usage, from now on it is attributed to
+ * the pipeline.
+ */
+void gstd_pipeline_thread_enter (GstdPipelineThread * object,
+    const gchar * element);
+
+/**
+ * gstd_pipeline_thread_leave:
+ * @object: The thread leaving the pipeline
+ *
+ * Stops accounting the thread usage, keeping what was spent so far.
+ */
+void gstd_pipeline_thread_leave (GstdPipelineThread * object);
+
+/**
+ * gstd_pipeline_thread_get_usage:
+ * @object: The thread to query
+ * @cpu_time: (out) (optional): The CPU time spent, in nanoseconds
+ * @voluntary: (out) (optional): The voluntary context switches
+ * @involuntary: (out) (optional): The involuntary context switches
+ *
+ * Retrieves the resources the thread has spent on behalf of the
+ * pipeline so far.
+ */
+void gstd_pipeline_thread_get_usage (GstdPipelineThread * object,
+    guint64 * cpu_time, guint64 * voluntary, guint64 * involuntary);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_THREAD_H__
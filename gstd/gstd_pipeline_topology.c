@@ -0,0 +1,893 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_pipeline_topology.h"
+#include "gstd_element.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pipeline Topology debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_topology_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_topology_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/* How long to wait for the data in flight before unlinking anyway */
+#define GSTD_PIPELINE_TOPOLOGY_UNLINK_TIMEOUT (G_TIME_SPAN_SECOND)
+
+enum
+{
+  PROP_LINKS = 1,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+typedef struct _GstdUnlinkBarrier GstdUnlinkBarrier;
+
+/* Counts the pads still waiting to be unlinked from their probe. Once
+   cancelled, the probes left are removed by the waiter instead */
+struct _GstdUnlinkBarrier
+{
+  gint refcount;
+  GMutex lock;
+  GCond cond;
+  guint pending;
+  gboolean cancelled;
+  GPtrArray *pads;
+  gboolean *done;
+};
+
+/**
+ * GstdPipelineTopology:
+ * Changes the topology of a running pipeline:
+ *
+ *   create /pipelines/<p>/elements <name> <description>
+ *   delete /pipelines/<p>/elements <name>
+ *   update /pipelines/<p>/topology link <src>[.<pad>] <sink>[.<pad>]
+ *   update /pipelines/<p>/topology unlink <src>[.<pad>] <sink>[.<pad>]
+ *
+ * Pads are unlinked from an idle probe, once the buffer in flight, if
+ * any, has been pushed. Request pads left unlinked are released. New
+ * elements follow the state of the pipeline, except for sources, which
+ * wait until they are linked so they don't push into nothing.
+ */
+struct _GstdPipelineTopology
+{
+  GstdObject parent;
+
+  /**
+   * The GStreamer pipeline and the element list mirroring it
+   */
+  GstBin *bin;
+  GstdList *elements;
+  gulong added_id;
+  gulong removed_id;
+
+  /**
+   * The element being added or removed by us, which the list is
+   * updated for by the creator and deleter directly
+   */
+  GstElement *pending;
+};
+
+struct _GstdPipelineTopologyClass
+{
+  GstdObjectClass parent_class;
+};
+
+/* VTable */
+static void
+gstd_pipeline_topology_get_property (GObject *, guint, GValue *,
+    GParamSpec *);
+static void gstd_pipeline_topology_dispose (GObject *);
+static GstdReturnCode gstd_pipeline_topology_update (GstdObject *,
+    const gchar *);
+static GstdReturnCode gstd_pipeline_topology_create (GstdICreator *,
+    const gchar *, const gchar *, GstdObject **);
+static GstdReturnCode gstd_pipeline_topology_delete (GstdIDeleter *,
+    GstdObject *);
+static GstdReturnCode gstd_pipeline_topology_link (GstdPipelineTopology *,
+    GstBin *, const gchar *, const gchar *);
+static GstdReturnCode gstd_pipeline_topology_unlink (GstdPipelineTopology *,
+    GstBin *, const gchar *, const gchar *);
+static GstElement *gstd_pipeline_topology_find (GstdPipelineTopology *,
+    GstBin *, const gchar *, gchar **);
+static void gstd_pipeline_topology_collect (GstElement *, GstPadDirection,
+    GstElement *, const gchar *, const gchar *, GPtrArray *);
+static void gstd_pipeline_topology_unlink_pads (GstdPipelineTopology *,
+    GPtrArray *);
+static GstPadProbeReturn gstd_pipeline_topology_idle (GstPad *,
+    GstPadProbeInfo *, gpointer);
+static void gstd_pipeline_topology_release (GstPad *);
+static gchar *gstd_pipeline_topology_links (GstdPipelineTopology *);
+static void gstd_pipeline_topology_element_added (GstBin *, GstElement *,
+    gpointer);
+static void gstd_pipeline_topology_element_removed (GstBin *, GstElement *,
+    gpointer);
+static GstdUnlinkBarrier *gstd_unlink_barrier_new (GPtrArray *);
+static void gstd_unlink_barrier_unref (gpointer);
+
+static void
+gstd_icreator_interface_init (GstdICreatorInterface * iface)
+{
+  iface->create = gstd_pipeline_topology_create;
+}
+
+static void
+gstd_ideleter_interface_init (GstdIDeleterInterface * iface)
+{
+  iface->delete = gstd_pipeline_topology_delete;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GstdPipelineTopology, gstd_pipeline_topology,
+    GSTD_TYPE_OBJECT, G_IMPLEMENT_INTERFACE (GSTD_TYPE_ICREATOR,
+        gstd_icreator_interface_init);
+    G_IMPLEMENT_INTERFACE (GSTD_TYPE_IDELETER, gstd_ideleter_interface_init));
+
+static void
+gstd_pipeline_topology_class_init (GstdPipelineTopologyClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GstdObjectClass *gstdc = GSTD_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->get_property = gstd_pipeline_topology_get_property;
+  object_class->dispose = gstd_pipeline_topology_dispose;
+
+  properties[PROP_LINKS] =
+      g_param_spec_string ("links", "Links",
+      "The links between the elements, as <src>.<pad>:<sink>.<pad>",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  gstdc->update = GST_DEBUG_FUNCPTR (gstd_pipeline_topology_update);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_topology_debug,
+      "gstdpipelinetopology", debug_color, "Gstd Pipeline Topology category");
+}
+
+static void
+gstd_pipeline_topology_init (GstdPipelineTopology * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline topology");
+
+  self->bin = NULL;
+  self->elements = NULL;
+  self->added_id = 0;
+  self->removed_id = 0;
+  self->pending = NULL;
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+GstdPipelineTopology *
+gstd_pipeline_topology_new (void)
+{
+  return GSTD_PIPELINE_TOPOLOGY (g_object_new (GSTD_TYPE_PIPELINE_TOPOLOGY,
+          "name", "topology", NULL));
+}
+
+static void
+gstd_pipeline_topology_dispose (GObject * object)
+{
+  GstdPipelineTopology *self = GSTD_PIPELINE_TOPOLOGY (object);
+
+  GST_INFO_OBJECT (self, "Disposing pipeline topology");
+
+  gstd_pipeline_topology_unwatch (self);
+
+  G_OBJECT_CLASS (gstd_pipeline_topology_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_topology_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineTopology *self = GSTD_PIPELINE_TOPOLOGY (object);
+
+  switch (property_id) {
+    case PROP_LINKS:
+      g_value_take_string (value, gstd_pipeline_topology_links (self));
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+void
+gstd_pipeline_topology_watch (GstdPipelineTopology * self, GstBin * bin,
+    GstdList * elements)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_TOPOLOGY (self));
+  g_return_if_fail (GST_IS_BIN (bin));
+  g_return_if_fail (GSTD_IS_LIST (elements));
+
+  GST_OBJECT_LOCK (self);
+  if (self->bin) {
+    GST_OBJECT_UNLOCK (self);
+    GST_ERROR_OBJECT (self, "Already watching a pipeline");
+    return;
+  }
+
+  self->bin = gst_object_ref (bin);
+  self->elements = elements;
+  GST_OBJECT_UNLOCK (self);
+
+  self->added_id = g_signal_connect (bin, "element-added",
+      G_CALLBACK (gstd_pipeline_topology_element_added), self);
+  self->removed_id = g_signal_connect (bin, "element-removed",
+      G_CALLBACK (gstd_pipeline_topology_element_removed), self);
+}
+
+void
+gstd_pipeline_topology_unwatch (GstdPipelineTopology * self)
+{
+  GstBin *bin;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_TOPOLOGY (self));
+
+  GST_OBJECT_LOCK (self);
+  bin = self->bin;
+  self->bin = NULL;
+  self->elements = NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  if (bin) {
+    g_signal_handler_disconnect (bin, self->added_id);
+    g_signal_handler_disconnect (bin, self->removed_id);
+    self->added_id = 0;
+    self->removed_id = 0;
+    gst_object_unref (bin);
+  }
+}
+
+static GstdReturnCode
+gstd_pipeline_topology_update (GstdObject * object, const gchar * value)
+{
+  GstdPipelineTopology *self = GSTD_PIPELINE_TOPOLOGY (object);
+  GstdReturnCode ret;
+  GstBin *bin;
+  gchar **tokens;
+
+  g_return_val_if_fail (value, GSTD_NULL_ARGUMENT);
+
+  GST_OBJECT_LOCK (self);
+  bin = self->bin ? gst_object_ref (self->bin) : NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!bin) {
+    GST_ERROR_OBJECT (self, "No pipeline to change");
+    return GSTD_NO_PIPELINE;
+  }
+
+  // Tokens have the form {<action>, <src>, <sink>}
+  tokens = g_strsplit (value, " ", 3);
+  if (!tokens[0] || !tokens[1] || !tokens[2]) {
+    GST_ERROR_OBJECT (self, "Expected an action, a source and a sink");
+    ret = GSTD_MISSING_ARGUMENT;
+  } else if (!g_ascii_strcasecmp (tokens[0], "link")) {
+    ret = gstd_pipeline_topology_link (self, bin, tokens[1], tokens[2]);
+  } else if (!g_ascii_strcasecmp (tokens[0], "unlink")) {
+    ret = gstd_pipeline_topology_unlink (self, bin, tokens[1], tokens[2]);
+  } else {
+    GST_ERROR_OBJECT (self, "Unknown action \"%s\", expected link or unlink",
+        tokens[0]);
+    ret = GSTD_BAD_VALUE;
+  }
+
+  g_strfreev (tokens);
+  gst_object_unref (bin);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_pipeline_topology_create (GstdICreator * iface, const gchar * name,
+    const gchar * description, GstdObject ** out)
+{
+  GstdPipelineTopology *self;
+  GstElement *element;
+  GstBin *bin;
+  GError *error;
+  gboolean added;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (out, GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_TOPOLOGY (iface);
+  *out = NULL;
+
+  if (NULL == name) {
+    GST_ERROR_OBJECT (self, "Element name not provided");
+    return GSTD_MISSING_NAME;
+  }
+
+  if (NULL == description) {
+    GST_ERROR_OBJECT (self, "Element description not provided");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  GST_OBJECT_LOCK (self);
+  bin = self->bin ? gst_object_ref (self->bin) : NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!bin) {
+    GST_ERROR_OBJECT (self, "No pipeline to add \"%s\" to", name);
+    return GSTD_NO_PIPELINE;
+  }
+
+  /* Several elements are wrapped in a bin with ghost pads */
+  error = NULL;
+  element = gst_parse_bin_from_description_full (description, TRUE, NULL,
+      GST_PARSE_FLAG_FATAL_ERRORS | GST_PARSE_FLAG_NO_SINGLE_ELEMENT_BINS,
+      &error);
+  if (!element) {
+    GST_ERROR_OBJECT (self, "Unable to create \"%s\": %s", name,
+        error ? error->message : "unknown error");
+    g_clear_error (&error);
+    gst_object_unref (bin);
+    return GSTD_BAD_DESCRIPTION;
+  }
+  g_clear_error (&error);
+
+  gst_object_set_name (GST_OBJECT (element), name);
+
+  /* The list learns about the element from our return value */
+  GST_OBJECT_LOCK (self);
+  self->pending = element;
+  GST_OBJECT_UNLOCK (self);
+
+  added = gst_bin_add (bin, element);
+
+  GST_OBJECT_LOCK (self);
+  self->pending = NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!added) {
+    GST_ERROR_OBJECT (self, "The pipeline already has an element named "
+        "\"%s\"", name);
+    gst_object_unref (bin);
+    return GSTD_EXISTING_RESOURCE;
+  }
+
+  *out = GSTD_OBJECT (g_object_new (GSTD_TYPE_ELEMENT, "name", name,
+          "gstelement", element, NULL));
+
+  GST_INFO_OBJECT (self, "Added \"%s\" to %s", name, GST_OBJECT_NAME (bin));
+
+  if (GST_OBJECT_FLAG_IS_SET (element, GST_ELEMENT_FLAG_SOURCE)) {
+    gst_object_unref (bin);
+    return GSTD_EOK;
+  }
+
+  if (!gst_element_sync_state_with_parent (element)) {
+    GST_ERROR_OBJECT (self, "Unable to start \"%s\"", name);
+
+    /* The list won't know about it, so it can't stay in the pipeline */
+    GST_OBJECT_LOCK (self);
+    self->pending = element;
+    GST_OBJECT_UNLOCK (self);
+
+    gst_element_set_state (element, GST_STATE_NULL);
+    gst_bin_remove (bin, element);
+
+    GST_OBJECT_LOCK (self);
+    self->pending = NULL;
+    GST_OBJECT_UNLOCK (self);
+
+    g_clear_object (out);
+    gst_object_unref (bin);
+    return GSTD_STATE_ERROR;
+  }
+
+  gst_object_unref (bin);
+
+  return GSTD_EOK;
+}
+
+static GstdReturnCode
+gstd_pipeline_topology_delete (GstdIDeleter * iface, GstdObject * object)
+{
+  GstdPipelineTopology *self;
+  GstElement *element;
+  GPtrArray *pads;
+  GstBin *bin;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_ELEMENT (object), GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PIPELINE_TOPOLOGY (iface);
+
+  GST_OBJECT_LOCK (self);
+  bin = self->bin ? gst_object_ref (self->bin) : NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!bin) {
+    GST_ERROR_OBJECT (self, "No pipeline to remove from");
+    return GSTD_NO_PIPELINE;
+  }
+
+  g_object_get (object, "gstelement", &element, NULL);
+
+  /* Stop the data coming in first, then the data going out */
+  pads = g_ptr_array_new_with_free_func (gst_object_unref);
+  gstd_pipeline_topology_collect (element, GST_PAD_SINK, NULL, NULL, NULL,
+      pads);
+  gstd_pipeline_topology_collect (element, GST_PAD_SRC, NULL, NULL, NULL,
+      pads);
+  gstd_pipeline_topology_unlink_pads (self, pads);
+  g_ptr_array_unref (pads);
+
+  /* The list already dropped the element, the signal handler must not
+     touch it */
+  GST_OBJECT_LOCK (self);
+  self->pending = element;
+  GST_OBJECT_UNLOCK (self);
+
+  gst_element_set_state (element, GST_STATE_NULL);
+  gst_bin_remove (bin, element);
+
+  GST_OBJECT_LOCK (self);
+  self->pending = NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  GST_INFO_OBJECT (self, "Removed \"%s\" from %s", GSTD_OBJECT_NAME (object),
+      GST_OBJECT_NAME (bin));
+
+  gst_object_unref (element);
+  gst_object_unref (bin);
+
+  /* Release the reference held by the list */
+  g_object_unref (object);
+
+  return GSTD_EOK;
+}
+
+static GstdReturnCode
+gstd_pipeline_topology_link (GstdPipelineTopology * self, GstBin * bin,
+    const gchar * src, const gchar * sink)
+{
+  GstElement *srcelement;
+  GstElement *sinkelement;
+  GstdReturnCode ret;
+  gchar *srcpad;
+  gchar *sinkpad;
+
+  srcelement = gstd_pipeline_topology_find (self, bin, src, &srcpad);
+  sinkelement = gstd_pipeline_topology_find (self, bin, sink, &sinkpad);
+
+  if (!srcelement || !sinkelement) {
+    ret = GSTD_NO_RESOURCE;
+    goto out;
+  }
+
+  if (!gst_element_link_pads (srcelement, srcpad, sinkelement, sinkpad)) {
+    GST_ERROR_OBJECT (self, "Unable to link \"%s\" to \"%s\"", src, sink);
+    ret = GSTD_BAD_VALUE;
+    goto out;
+  }
+
+  GST_INFO_OBJECT (self, "Linked \"%s\" to \"%s\"", src, sink);
+
+  /* Downstream first, so the data has somewhere to go */
+  if (!gst_element_sync_state_with_parent (sinkelement) ||
+      !gst_element_sync_state_with_parent (srcelement)) {
+    GST_ERROR_OBJECT (self, "Unable to start \"%s\" and \"%s\"", src, sink);
+    ret = GSTD_STATE_ERROR;
+    goto out;
+  }
+
+  ret = GSTD_EOK;
+
+out:
+  if (srcelement) {
+    gst_object_unref (srcelement);
+  }
+  if (sinkelement) {
+    gst_object_unref (sinkelement);
+  }
+  g_free (srcpad);
+  g_free (sinkpad);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_pipeline_topology_unlink (GstdPipelineTopology * self, GstBin * bin,
+    const gchar * src, const gchar * sink)
+{
+  GstElement *srcelement;
+  GstElement *sinkelement;
+  GstdReturnCode ret;
+  GPtrArray *pads;
+  gchar *srcpad;
+  gchar *sinkpad;
+
+  srcelement = gstd_pipeline_topology_find (self, bin, src, &srcpad);
+  sinkelement = gstd_pipeline_topology_find (self, bin, sink, &sinkpad);
+  pads = g_ptr_array_new_with_free_func (gst_object_unref);
+
+  if (!srcelement || !sinkelement) {
+    ret = GSTD_NO_RESOURCE;
+    goto out;
+  }
+
+  gstd_pipeline_topology_collect (srcelement, GST_PAD_SRC, sinkelement,
+      srcpad, sinkpad, pads);
+
+  if (0 == pads->len) {
+    GST_ERROR_OBJECT (self, "\"%s\" isn't linked to \"%s\"", src, sink);
+    ret = GSTD_NO_RESOURCE;
+    goto out;
+  }
+
+  gstd_pipeline_topology_unlink_pads (self, pads);
+
+  GST_INFO_OBJECT (self, "Unlinked \"%s\" from \"%s\"", src, sink);
+  ret = GSTD_EOK;
+
+out:
+  if (srcelement) {
+    gst_object_unref (srcelement);
+  }
+  if (sinkelement) {
+    gst_object_unref (sinkelement);
+  }
+  g_ptr_array_unref (pads);
+  g_free (srcpad);
+  g_free (sinkpad);
+
+  return ret;
+}
+
+static GstElement *
+gstd_pipeline_topology_find (GstdPipelineTopology * self, GstBin * bin,
+    const gchar * endpoint, gchar ** padname)
+{
+  GstElement *element;
+  gchar **tokens;
+
+  // Tokens have the form {<element>, [pad]}
+  tokens = g_strsplit (endpoint, ".", 2);
+  element = gst_bin_get_by_name (bin, tokens[0]);
+  *padname = g_strdup (tokens[1]);
+
+  if (!element) {
+    GST_ERROR_OBJECT (self, "No element named \"%s\"", tokens[0]);
+  }
+
+  g_strfreev (tokens);
+
+  return element;
+}
+
+/* Gathers the source pad of every link of the @direction pads of
+   @owner. With @peer, only the links to that element are gathered,
+   optionally narrowed down to the @padname and @peername pads */
+static void
+gstd_pipeline_topology_collect (GstElement * owner, GstPadDirection direction,
+    GstElement * peer, const gchar * padname, const gchar * peername,
+    GPtrArray * pads)
+{
+  GstPad *other;
+  GstPad *pad;
+  GList *iter;
+
+  GST_OBJECT_LOCK (owner);
+  iter = GST_PAD_SRC == direction ? owner->srcpads : owner->sinkpads;
+  for (; iter; iter = iter->next) {
+    pad = GST_PAD (iter->data);
+    other = GST_PAD_PEER (pad);
+    if (!other) {
+      continue;
+    }
+
+    if (padname && g_strcmp0 (GST_OBJECT_NAME (pad), padname)) {
+      continue;
+    }
+
+    if (peer && GST_ELEMENT (GST_PAD_PARENT (other)) != peer) {
+      continue;
+    }
+
+    if (peername && g_strcmp0 (GST_OBJECT_NAME (other), peername)) {
+      continue;
+    }
+
+    g_ptr_array_add (pads, gst_object_ref (GST_PAD_SRC == direction ? pad :
+            other));
+  }
+  GST_OBJECT_UNLOCK (owner);
+}
+
+static void
+gstd_pipeline_topology_unlink_pads (GstdPipelineTopology * self,
+    GPtrArray * pads)
+{
+  GstdUnlinkBarrier *barrier;
+  GPtrArray *peers;
+  GstPad *pad;
+  GstPad *peer;
+  gint64 deadline;
+  gulong *ids;
+  guint i;
+
+  if (0 == pads->len) {
+    return;
+  }
+
+  /* Remember the sink pads, the links are gone afterwards */
+  peers = g_ptr_array_new_with_free_func (gst_object_unref);
+  for (i = 0; i < pads->len; i++) {
+    peer = gst_pad_get_peer (g_ptr_array_index (pads, i));
+    if (peer) {
+      g_ptr_array_add (peers, peer);
+    }
+  }
+
+  barrier = gstd_unlink_barrier_new (pads);
+  ids = g_new0 (gulong, pads->len);
+
+  for (i = 0; i < pads->len; i++) {
+    g_atomic_int_inc (&barrier->refcount);
+    ids[i] = gst_pad_add_probe (g_ptr_array_index (pads, i),
+        GST_PAD_PROBE_TYPE_IDLE, gstd_pipeline_topology_idle, barrier,
+        gstd_unlink_barrier_unref);
+  }
+
+  deadline = g_get_monotonic_time () + GSTD_PIPELINE_TOPOLOGY_UNLINK_TIMEOUT;
+  g_mutex_lock (&barrier->lock);
+  while (barrier->pending > 0) {
+    if (!g_cond_wait_until (&barrier->cond, &barrier->lock, deadline)) {
+      break;
+    }
+  }
+  /* Probes still armed would unlink whatever gets linked next */
+  barrier->cancelled = TRUE;
+  for (i = 0; i < pads->len; i++) {
+    if (barrier->done[i]) {
+      ids[i] = 0;
+    }
+  }
+  g_mutex_unlock (&barrier->lock);
+
+  for (i = 0; i < pads->len; i++) {
+    if (ids[i]) {
+      gst_pad_remove_probe (g_ptr_array_index (pads, i), ids[i]);
+    }
+  }
+  g_free (ids);
+  gstd_unlink_barrier_unref (barrier);
+
+  /* A stalled downstream never lets the pad go idle */
+  for (i = 0; i < pads->len; i++) {
+    pad = g_ptr_array_index (pads, i);
+    peer = gst_pad_get_peer (pad);
+    if (peer) {
+      GST_WARNING_OBJECT (self, "%s:%s didn't go idle, unlinking anyway",
+          GST_DEBUG_PAD_NAME (pad));
+      gst_pad_unlink (pad, peer);
+      gst_object_unref (peer);
+    }
+  }
+
+  for (i = 0; i < pads->len; i++) {
+    gstd_pipeline_topology_release (g_ptr_array_index (pads, i));
+  }
+  for (i = 0; i < peers->len; i++) {
+    gstd_pipeline_topology_release (g_ptr_array_index (peers, i));
+  }
+
+  g_ptr_array_unref (peers);
+}
+
+static GstPadProbeReturn
+gstd_pipeline_topology_idle (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstdUnlinkBarrier *barrier = user_data;
+  GstPad *peer;
+  guint i;
+
+  g_mutex_lock (&barrier->lock);
+  /* The waiter gave up and removes the probe itself */
+  if (barrier->cancelled) {
+    g_mutex_unlock (&barrier->lock);
+    return GST_PAD_PROBE_OK;
+  }
+
+  peer = gst_pad_get_peer (pad);
+  if (peer) {
+    gst_pad_unlink (pad, peer);
+    gst_object_unref (peer);
+  }
+
+  for (i = 0; i < barrier->pads->len; i++) {
+    if (pad == g_ptr_array_index (barrier->pads, i)) {
+      barrier->done[i] = TRUE;
+    }
+  }
+  barrier->pending--;
+  g_cond_signal (&barrier->cond);
+  g_mutex_unlock (&barrier->lock);
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
+/* Gives request pads back to their element, a tee or a mixer, for
+   instance, once they are no longer linked */
+static void
+gstd_pipeline_topology_release (GstPad * pad)
+{
+  GstPadTemplate *templ;
+  GstElement *element;
+
+  templ = gst_pad_get_pad_template (pad);
+  if (!templ) {
+    return;
+  }
+
+  if (GST_PAD_REQUEST == GST_PAD_TEMPLATE_PRESENCE (templ)) {
+    element = gst_pad_get_parent_element (pad);
+    if (element) {
+      gst_element_release_request_pad (element, pad);
+      gst_object_unref (element);
+    }
+  }
+
+  gst_object_unref (templ);
+}
+
+static gchar *
+gstd_pipeline_topology_links (GstdPipelineTopology * self)
+{
+  GstElement *element;
+  GString *links;
+  GstPad *pad;
+  GstPad *peer;
+  GstBin *bin;
+  GList *children;
+  GList *iter;
+  GList *piter;
+
+  GST_OBJECT_LOCK (self);
+  bin = self->bin ? gst_object_ref (self->bin) : NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!bin) {
+    return NULL;
+  }
+
+  GST_OBJECT_LOCK (bin);
+  children = g_list_copy_deep (bin->children, (GCopyFunc) gst_object_ref,
+      NULL);
+  GST_OBJECT_UNLOCK (bin);
+
+  links = g_string_new (NULL);
+  for (iter = children; iter; iter = iter->next) {
+    element = GST_ELEMENT (iter->data);
+
+    GST_OBJECT_LOCK (element);
+    for (piter = element->srcpads; piter; piter = piter->next) {
+      pad = GST_PAD (piter->data);
+      peer = GST_PAD_PEER (pad);
+      if (!peer || !GST_PAD_PARENT (peer)) {
+        continue;
+      }
+      g_string_append_printf (links, "%s%s.%s:%s.%s", links->len ? ", " : "",
+          GST_OBJECT_NAME (element), GST_OBJECT_NAME (pad),
+          GST_OBJECT_NAME (GST_PAD_PARENT (peer)), GST_OBJECT_NAME (peer));
+    }
+    GST_OBJECT_UNLOCK (element);
+  }
+
+  g_list_free_full (children, gst_object_unref);
+  gst_object_unref (bin);
+
+  return g_string_free (links, FALSE);
+}
+
+static void
+gstd_pipeline_topology_element_added (GstBin * bin, GstElement * element,
+    gpointer user_data)
+{
+  GstdPipelineTopology *self = GSTD_PIPELINE_TOPOLOGY (user_data);
+  GstdObject *node;
+  GstdList *elements;
+
+  GST_OBJECT_LOCK (self);
+  elements = element == self->pending ? NULL : self->elements;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!elements) {
+    return;
+  }
+
+  GST_DEBUG_OBJECT (self, "Registering new element \"%s\"",
+      GST_OBJECT_NAME (element));
+
+  node = GSTD_OBJECT (g_object_new (GSTD_TYPE_ELEMENT, "name",
+          GST_OBJECT_NAME (element), "gstelement", element, NULL));
+  if (!gstd_list_append_child (elements, node)) {
+    g_object_unref (node);
+  }
+}
+
+static void
+gstd_pipeline_topology_element_removed (GstBin * bin, GstElement * element,
+    gpointer user_data)
+{
+  GstdPipelineTopology *self = GSTD_PIPELINE_TOPOLOGY (user_data);
+  GstdList *elements;
+
+  GST_OBJECT_LOCK (self);
+  elements = element == self->pending ? NULL : self->elements;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!elements) {
+    return;
+  }
+
+  GST_DEBUG_OBJECT (self, "Unregistering element \"%s\"",
+      GST_OBJECT_NAME (element));
+
+  gstd_list_remove_child (elements, GST_OBJECT_NAME (element));
+}
+
+static GstdUnlinkBarrier *
+gstd_unlink_barrier_new (GPtrArray * pads)
+{
+  GstdUnlinkBarrier *barrier;
+
+  barrier = g_slice_new (GstdUnlinkBarrier);
+  barrier->refcount = 1;
+  barrier->pending = pads->len;
+  barrier->cancelled = FALSE;
+  barrier->pads = g_ptr_array_ref (pads);
+  barrier->done = g_new0 (gboolean, pads->len);
+  g_mutex_init (&barrier->lock);
+  g_cond_init (&barrier->cond);
+
+  return barrier;
+}
+
+static void
+gstd_unlink_barrier_unref (gpointer data)
+{
+  GstdUnlinkBarrier *barrier = data;
+
+  if (!g_atomic_int_dec_and_test (&barrier->refcount)) {
+    return;
+  }
+
+  g_mutex_clear (&barrier->lock);
+  g_cond_clear (&barrier->cond);
+  g_ptr_array_unref (barrier->pads);
+  g_free (barrier->done);
+  g_slice_free (GstdUnlinkBarrier, barrier);
+}
@@ -0,0 +1,83 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_TOPOLOGY_H__
+#define __GSTD_PIPELINE_TOPOLOGY_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+#include "gstd_list.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_TOPOLOGY \
+  (gstd_pipeline_topology_get_type())
+#define GSTD_PIPELINE_TOPOLOGY(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_TOPOLOGY,GstdPipelineTopology))
+#define GSTD_PIPELINE_TOPOLOGY_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_TOPOLOGY,GstdPipelineTopologyClass))
+#define GSTD_IS_PIPELINE_TOPOLOGY(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_TOPOLOGY))
+#define GSTD_IS_PIPELINE_TOPOLOGY_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_TOPOLOGY))
+#define GSTD_PIPELINE_TOPOLOGY_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_TOPOLOGY, GstdPipelineTopologyClass))
+typedef struct _GstdPipelineTopology GstdPipelineTopology;
+typedef struct _GstdPipelineTopologyClass GstdPipelineTopologyClass;
+GType gstd_pipeline_topology_get_type (void);
+
+/**
+ * gstd_pipeline_topology_new: (constructor)
+ *
+ * Creates the object that adds, removes, links and unlinks the
+ * elements of a pipeline while it runs. It is also the creator and
+ * deleter of the element list of the pipeline.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineTopology.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineTopology *gstd_pipeline_topology_new (void);
+
+/**
+ * gstd_pipeline_topology_watch:
+ * @object: The topology
+ * @bin: The GStreamer pipeline
+ * @elements: The element list of the pipeline
+ *
+ * Keeps @elements in sync with the elements added to and removed from
+ * @bin, by gstd or by the pipeline itself. @elements isn't referenced.
+ */
+void gstd_pipeline_topology_watch (GstdPipelineTopology * object,
+    GstBin * bin, GstdList * elements);
+
+/**
+ * gstd_pipeline_topology_unwatch:
+ * @object: The topology
+ *
+ * Stops tracking the elements, typically before the GStreamer pipeline
+ * is torn down.
+ */
+void gstd_pipeline_topology_unwatch (GstdPipelineTopology * object);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_TOPOLOGY_H__
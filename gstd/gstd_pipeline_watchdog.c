@@ -0,0 +1,785 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_pipeline_watchdog.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Pipeline Watchdog debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_pipeline_watchdog_debug);
+#define GST_CAT_DEFAULT gstd_pipeline_watchdog_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+#define GSTD_PIPELINE_WATCHDOG_DEFAULT_TIMEOUT 0
+#define GSTD_PIPELINE_WATCHDOG_DEFAULT_PADS NULL
+#define GSTD_PIPELINE_WATCHDOG_DEFAULT_POLICY GSTD_WATCHDOG_POLICY_RESTART
+#define GSTD_PIPELINE_WATCHDOG_DEFAULT_MAX_BACKOFF 30000
+
+/* Backoff base when only errors are being watched, in milliseconds */
+#define GSTD_PIPELINE_WATCHDOG_ERROR_BACKOFF 1000
+
+/* The activity timestamp is written by the streaming threads and read
+   by the watchdog thread */
+#define GSTD_PIPELINE_WATCHDOG_LOAD(counter) \
+  __atomic_load_n (&(counter), __ATOMIC_RELAXED)
+#define GSTD_PIPELINE_WATCHDOG_STORE(counter, value) \
+  __atomic_store_n (&(counter), (value), __ATOMIC_RELAXED)
+
+enum
+{
+  PROP_TIMEOUT = 1,
+  PROP_PADS,
+  PROP_POLICY,
+  PROP_MAX_BACKOFF,
+  PROP_STALLS,
+  PROP_ERRORS,
+  PROP_RECOVERIES,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+typedef struct _GstdWatchdogProbe GstdWatchdogProbe;
+
+struct _GstdWatchdogProbe
+{
+  GstPad *pad;
+  gulong id;
+};
+
+/**
+ * GstdPipelineWatchdog:
+ * Detects stalled or failed pipelines and recovers them
+ */
+struct _GstdPipelineWatchdog
+{
+  GstdObject parent;
+
+  /**
+   * The pipeline to recover, not referenced
+   */
+  GstdPipeline *owner;
+
+  /**
+   * The GStreamer pipeline being monitored
+   */
+  GstBin *bin;
+
+  /**
+   * Time without buffers before the pipeline is considered stalled, in
+   * milliseconds. 0 disables stall detection
+   */
+  guint timeout;
+
+  /**
+   * Comma separated list of element.pad to monitor
+   */
+  gchar *pads;
+
+  /**
+   * How the pipeline is recovered
+   */
+  GstdWatchdogPolicy policy;
+
+  /**
+   * Upper bound of the wait between consecutive recoveries, in
+   * milliseconds
+   */
+  guint max_backoff;
+
+  /**
+   * The probes installed in the monitored pads
+   */
+  GList *probes;
+
+  /**
+   * Monotonic time of the last buffer or position change
+   */
+  gint64 activity;
+
+  /**
+   * Monotonic time the stall timer was last armed at
+   */
+  gint64 armed;
+
+  /**
+   * The last position seen, when monitoring the clock position
+   */
+  gint64 position;
+
+  gboolean stalled;
+  gboolean errored;
+  guint stalls;
+  guint errors;
+  guint recoveries;
+
+  /**
+   * Consecutive recoveries that didn't bring the buffers back
+   */
+  guint failures;
+  gint64 recovered_at;
+  gint64 next_recovery;
+
+  GThread *thread;
+  GCond cond;
+  gboolean stopping;
+};
+
+struct _GstdPipelineWatchdogClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPipelineWatchdog, gstd_pipeline_watchdog,
+    GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_pipeline_watchdog_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void
+gstd_pipeline_watchdog_get_property (GObject *, guint, GValue *,
+    GParamSpec *);
+static void gstd_pipeline_watchdog_dispose (GObject *);
+static void gstd_pipeline_watchdog_finalize (GObject *);
+static void gstd_pipeline_watchdog_attach (GstdPipelineWatchdog *);
+static void gstd_pipeline_watchdog_detach (GstdPipelineWatchdog *);
+static void gstd_pipeline_watchdog_start (GstdPipelineWatchdog *);
+static gpointer gstd_pipeline_watchdog_func (gpointer);
+static gboolean gstd_pipeline_watchdog_still_playing (GstdPipelineWatchdog *,
+    GstElement *);
+static gboolean gstd_pipeline_watchdog_rebuild (gpointer);
+static GstPadProbeReturn gstd_pipeline_watchdog_probe (GstPad *,
+    GstPadProbeInfo *, gpointer);
+
+GType
+gstd_watchdog_policy_get_type (void)
+{
+  static GType policy_type = 0;
+  static const GEnumValue policy_types[] = {
+    {GSTD_WATCHDOG_POLICY_NONE, "GSTD_WATCHDOG_POLICY_NONE", "none"},
+    {GSTD_WATCHDOG_POLICY_FLUSH, "GSTD_WATCHDOG_POLICY_FLUSH", "flush"},
+    {GSTD_WATCHDOG_POLICY_RESTART, "GSTD_WATCHDOG_POLICY_RESTART", "restart"},
+    {GSTD_WATCHDOG_POLICY_REBUILD, "GSTD_WATCHDOG_POLICY_REBUILD", "rebuild"},
+    {0, NULL, NULL}
+  };
+
+  if (!policy_type) {
+    policy_type = g_enum_register_static ("GstdWatchdogPolicy", policy_types);
+  }
+  return policy_type;
+}
+
+static void
+gstd_pipeline_watchdog_class_init (GstdPipelineWatchdogClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_pipeline_watchdog_set_property;
+  object_class->get_property = gstd_pipeline_watchdog_get_property;
+  object_class->dispose = gstd_pipeline_watchdog_dispose;
+  object_class->finalize = gstd_pipeline_watchdog_finalize;
+
+  properties[PROP_TIMEOUT] =
+      g_param_spec_uint ("timeout",
+      "Timeout",
+      "Time in milliseconds without buffers in PLAYING before the pipeline "
+      "is considered stalled, 0 to only watch for errors",
+      0, G_MAXUINT, GSTD_PIPELINE_WATCHDOG_DEFAULT_TIMEOUT,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_PADS] =
+      g_param_spec_string ("pads",
+      "Pads",
+      "Comma separated list of element.pad whose buffer flow is monitored. "
+      "The pipeline position is monitored if none is found",
+      GSTD_PIPELINE_WATCHDOG_DEFAULT_PADS,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_POLICY] =
+      g_param_spec_enum ("policy",
+      "Policy",
+      "How the pipeline is recovered from stalls and errors",
+      GSTD_TYPE_WATCHDOG_POLICY, GSTD_PIPELINE_WATCHDOG_DEFAULT_POLICY,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_MAX_BACKOFF] =
+      g_param_spec_uint ("max-backoff",
+      "Max Backoff",
+      "Upper bound in milliseconds of the wait between consecutive "
+      "recoveries, which doubles while they don't succeed",
+      0, G_MAXUINT, GSTD_PIPELINE_WATCHDOG_DEFAULT_MAX_BACKOFF,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_STALLS] =
+      g_param_spec_uint ("stalls",
+      "Stalls",
+      "The amount of stalls detected",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_ERRORS] =
+      g_param_spec_uint ("errors",
+      "Errors",
+      "The amount of errors posted by the pipeline",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_RECOVERIES] =
+      g_param_spec_uint ("recoveries",
+      "Recoveries",
+      "The amount of recoveries performed",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_pipeline_watchdog_debug,
+      "gstdpipelinewatchdog", debug_color, "Gstd Pipeline Watchdog category");
+}
+
+static void
+gstd_pipeline_watchdog_init (GstdPipelineWatchdog * self)
+{
+  GST_INFO_OBJECT (self, "Initializing pipeline watchdog");
+
+  self->owner = NULL;
+  self->bin = NULL;
+  self->timeout = GSTD_PIPELINE_WATCHDOG_DEFAULT_TIMEOUT;
+  self->pads = g_strdup (GSTD_PIPELINE_WATCHDOG_DEFAULT_PADS);
+  self->policy = GSTD_PIPELINE_WATCHDOG_DEFAULT_POLICY;
+  self->max_backoff = GSTD_PIPELINE_WATCHDOG_DEFAULT_MAX_BACKOFF;
+  self->probes = NULL;
+  self->activity = 0;
+  self->armed = 0;
+  self->position = -1;
+  self->stalled = FALSE;
+  self->errored = FALSE;
+  self->stalls = 0;
+  self->errors = 0;
+  self->recoveries = 0;
+  self->failures = 0;
+  self->recovered_at = 0;
+  self->next_recovery = 0;
+  self->thread = NULL;
+  self->stopping = FALSE;
+  g_cond_init (&self->cond);
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_pipeline_watchdog_dispose (GObject * object)
+{
+  GstdPipelineWatchdog *self = GSTD_PIPELINE_WATCHDOG (object);
+
+  gstd_pipeline_watchdog_stop (self);
+  gstd_pipeline_watchdog_unwatch (self);
+
+  G_OBJECT_CLASS (gstd_pipeline_watchdog_parent_class)->dispose (object);
+}
+
+static void
+gstd_pipeline_watchdog_finalize (GObject * object)
+{
+  GstdPipelineWatchdog *self = GSTD_PIPELINE_WATCHDOG (object);
+
+  g_free (self->pads);
+  g_cond_clear (&self->cond);
+
+  G_OBJECT_CLASS (gstd_pipeline_watchdog_parent_class)->finalize (object);
+}
+
+static void
+gstd_pipeline_watchdog_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineWatchdog *self = GSTD_PIPELINE_WATCHDOG (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (property_id) {
+    case PROP_TIMEOUT:
+      g_value_set_uint (value, self->timeout);
+      break;
+    case PROP_PADS:
+      g_value_set_string (value, self->pads);
+      break;
+    case PROP_POLICY:
+      g_value_set_enum (value, self->policy);
+      break;
+    case PROP_MAX_BACKOFF:
+      g_value_set_uint (value, self->max_backoff);
+      break;
+    case PROP_STALLS:
+      g_value_set_uint (value, self->stalls);
+      break;
+    case PROP_ERRORS:
+      g_value_set_uint (value, self->errors);
+      break;
+    case PROP_RECOVERIES:
+      g_value_set_uint (value, self->recoveries);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gstd_pipeline_watchdog_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdPipelineWatchdog *self = GSTD_PIPELINE_WATCHDOG (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (property_id) {
+    case PROP_TIMEOUT:
+      self->timeout = g_value_get_uint (value);
+      self->armed = g_get_monotonic_time ();
+      GST_INFO_OBJECT (self, "Changed timeout to %u ms", self->timeout);
+      if (self->timeout) {
+        gstd_pipeline_watchdog_start (self);
+      }
+      break;
+    case PROP_PADS:
+      g_free (self->pads);
+      self->pads = g_value_dup_string (value);
+      gstd_pipeline_watchdog_detach (self);
+      gstd_pipeline_watchdog_attach (self);
+      self->armed = g_get_monotonic_time ();
+      GST_INFO_OBJECT (self, "Changed pads to \"%s\"", self->pads);
+      break;
+    case PROP_POLICY:
+      self->policy = g_value_get_enum (value);
+      GST_INFO_OBJECT (self, "Changed policy to %d", self->policy);
+      break;
+    case PROP_MAX_BACKOFF:
+      self->max_backoff = g_value_get_uint (value);
+      GST_INFO_OBJECT (self, "Changed max backoff to %u ms",
+          self->max_backoff);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  /* Let the watchdog thread pick the new settings up */
+  g_cond_signal (&self->cond);
+  GST_OBJECT_UNLOCK (self);
+}
+
+GstdPipelineWatchdog *
+gstd_pipeline_watchdog_new (GstdPipeline * owner)
+{
+  GstdPipelineWatchdog *self;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE (owner), NULL);
+
+  self = GSTD_PIPELINE_WATCHDOG (g_object_new (GSTD_TYPE_PIPELINE_WATCHDOG,
+          "name", "watchdog", NULL));
+  self->owner = owner;
+
+  return self;
+}
+
+void
+gstd_pipeline_watchdog_watch (GstdPipelineWatchdog * self, GstBin * bin)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_WATCHDOG (self));
+  g_return_if_fail (GST_IS_BIN (bin));
+
+  GST_OBJECT_LOCK (self);
+  if (self->bin) {
+    GST_OBJECT_UNLOCK (self);
+    GST_ERROR_OBJECT (self, "Already watching a pipeline");
+    return;
+  }
+
+  self->bin = gst_object_ref (bin);
+  self->position = -1;
+  self->armed = g_get_monotonic_time ();
+  gstd_pipeline_watchdog_attach (self);
+
+  /* Errors start the thread on demand, stalls need it polling */
+  if (self->timeout) {
+    gstd_pipeline_watchdog_start (self);
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+void
+gstd_pipeline_watchdog_unwatch (GstdPipelineWatchdog * self)
+{
+  g_return_if_fail (GSTD_IS_PIPELINE_WATCHDOG (self));
+
+  GST_OBJECT_LOCK (self);
+  gstd_pipeline_watchdog_detach (self);
+  if (self->bin) {
+    gst_object_unref (self->bin);
+    self->bin = NULL;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+void
+gstd_pipeline_watchdog_stop (GstdPipelineWatchdog * self)
+{
+  GThread *thread;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_WATCHDOG (self));
+
+  GST_OBJECT_LOCK (self);
+  self->stopping = TRUE;
+  thread = self->thread;
+  self->thread = NULL;
+  g_cond_signal (&self->cond);
+  GST_OBJECT_UNLOCK (self);
+
+  if (thread) {
+    g_thread_join (thread);
+  }
+}
+
+void
+gstd_pipeline_watchdog_error (GstdPipelineWatchdog * self,
+    GstMessage * message)
+{
+  GError *error = NULL;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_WATCHDOG (self));
+  g_return_if_fail (GST_MESSAGE_ERROR == GST_MESSAGE_TYPE (message));
+
+  gst_message_parse_error (message, &error, NULL);
+  GST_WARNING_OBJECT (self, "Error from %s: %s", GST_MESSAGE_SRC_NAME (message),
+      error ? error->message : "unknown");
+  g_clear_error (&error);
+
+  GST_OBJECT_LOCK (self);
+  self->errors++;
+  if (GSTD_WATCHDOG_POLICY_NONE != self->policy) {
+    self->errored = TRUE;
+    gstd_pipeline_watchdog_start (self);
+    g_cond_signal (&self->cond);
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+/* Must be called with the object lock held */
+static void
+gstd_pipeline_watchdog_start (GstdPipelineWatchdog * self)
+{
+  if (!self->thread && !self->stopping) {
+    self->thread = g_thread_new ("gstd-watchdog", gstd_pipeline_watchdog_func,
+        self);
+  }
+}
+
+/* Must be called with the object lock held */
+static void
+gstd_pipeline_watchdog_attach (GstdPipelineWatchdog * self)
+{
+  GstdWatchdogProbe *probe;
+  GstElement *element;
+  GstPad *pad;
+  gchar **names;
+  gchar **name;
+  gchar *dot;
+
+  if (!self->bin || !self->pads) {
+    return;
+  }
+
+  names = g_strsplit (self->pads, ",", -1);
+  for (name = names; *name; name++) {
+    g_strstrip (*name);
+
+    dot = strrchr (*name, '.');
+    if (!dot) {
+      if ('\0' != **name) {
+        GST_WARNING_OBJECT (self, "Malformed pad \"%s\", expected element.pad",
+            *name);
+      }
+      continue;
+    }
+    *dot = '\0';
+
+    element = gst_bin_get_by_name (self->bin, *name);
+    pad = element ? gst_element_get_static_pad (element, dot + 1) : NULL;
+
+    if (pad) {
+      probe = g_slice_new (GstdWatchdogProbe);
+      probe->pad = pad;
+      probe->id = gst_pad_add_probe (pad,
+          GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+          gstd_pipeline_watchdog_probe, g_object_ref (self), g_object_unref);
+      self->probes = g_list_prepend (self->probes, probe);
+      GST_INFO_OBJECT (self, "Monitoring %s:%s", GST_DEBUG_PAD_NAME (pad));
+    } else {
+      GST_WARNING_OBJECT (self, "Unable to find pad %s.%s", *name, dot + 1);
+    }
+
+    if (element) {
+      gst_object_unref (element);
+    }
+  }
+  g_strfreev (names);
+}
+
+/* Must be called with the object lock held */
+static void
+gstd_pipeline_watchdog_detach (GstdPipelineWatchdog * self)
+{
+  GstdWatchdogProbe *probe;
+  GList *node;
+
+  for (node = self->probes; node; node = node->next) {
+    probe = node->data;
+    gst_pad_remove_probe (probe->pad, probe->id);
+    gst_object_unref (probe->pad);
+    g_slice_free (GstdWatchdogProbe, probe);
+  }
+  g_list_free (self->probes);
+  self->probes = NULL;
+}
+
+static GstPadProbeReturn
+gstd_pipeline_watchdog_probe (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstdPipelineWatchdog *self = GSTD_PIPELINE_WATCHDOG (user_data);
+
+  GSTD_PIPELINE_WATCHDOG_STORE (self->activity, g_get_monotonic_time ());
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+gstd_pipeline_watchdog_recover (GstdPipelineWatchdog * self,
+    GstElement * pipeline, GstdWatchdogPolicy policy, gboolean errored)
+{
+  gint64 position;
+
+  /* Flushing doesn't clear an error, those need a restart */
+  if (GSTD_WATCHDOG_POLICY_FLUSH == policy && !errored) {
+    GST_WARNING_OBJECT (self, "Flushing stalled pipeline");
+
+    if (gst_element_query_position (pipeline, GST_FORMAT_TIME, &position) &&
+        gst_element_seek_simple (pipeline, GST_FORMAT_TIME,
+            GST_SEEK_FLAG_FLUSH, position)) {
+      return;
+    }
+    GST_WARNING_OBJECT (self, "Unable to flush the pipeline");
+  }
+
+  switch (policy) {
+    case GSTD_WATCHDOG_POLICY_FLUSH:
+    case GSTD_WATCHDOG_POLICY_RESTART:
+      /* Client state changes wait for the restart, or are the ones
+         kept if they got there first */
+      GST_STATE_LOCK (pipeline);
+      if (!gstd_pipeline_watchdog_still_playing (self, pipeline)) {
+        GST_INFO_OBJECT (self, "Pipeline stopped meanwhile, not restarting");
+        GST_STATE_UNLOCK (pipeline);
+        break;
+      }
+      GST_WARNING_OBJECT (self, "Restarting pipeline");
+      gst_element_set_state (pipeline, GST_STATE_NULL);
+      if (GST_STATE_CHANGE_FAILURE == gst_element_set_state (pipeline,
+              GST_STATE_PLAYING)) {
+        GST_ERROR_OBJECT (self, "Unable to restart the pipeline");
+      }
+      GST_STATE_UNLOCK (pipeline);
+      break;
+    case GSTD_WATCHDOG_POLICY_REBUILD:
+      GST_WARNING_OBJECT (self, "Rebuilding pipeline");
+      /* Rebuilds are serialized among themselves in the main context,
+         the pipeline swaps the rebuilt parts under its object lock */
+      g_main_context_invoke_full (NULL, G_PRIORITY_HIGH,
+          gstd_pipeline_watchdog_rebuild, g_object_ref (self->owner),
+          g_object_unref);
+      break;
+    default:
+      break;
+  }
+}
+
+/* Must be called with the state lock of the pipeline held */
+static gboolean
+gstd_pipeline_watchdog_still_playing (GstdPipelineWatchdog * self,
+    GstElement * pipeline)
+{
+  gboolean watched;
+  gboolean target_playing;
+
+  GST_OBJECT_LOCK (self);
+  watched = GST_ELEMENT (self->bin) == pipeline;
+  GST_OBJECT_UNLOCK (self);
+
+  GST_OBJECT_LOCK (pipeline);
+  target_playing = GST_STATE_PLAYING == GST_STATE_TARGET (pipeline);
+  GST_OBJECT_UNLOCK (pipeline);
+
+  return watched && target_playing;
+}
+
+static gboolean
+gstd_pipeline_watchdog_rebuild (gpointer user_data)
+{
+  GstdPipeline *owner = GSTD_PIPELINE (user_data);
+
+  if (GSTD_EOK != gstd_pipeline_rebuild (owner)) {
+    GST_ERROR_OBJECT (owner, "Unable to rebuild the pipeline");
+  }
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Must be called with the object lock held */
+static gint64
+gstd_pipeline_watchdog_backoff (GstdPipelineWatchdog * self)
+{
+  guint64 backoff;
+
+  backoff = self->timeout ? self->timeout :
+      GSTD_PIPELINE_WATCHDOG_ERROR_BACKOFF;
+  backoff <<= MIN (self->failures, 16);
+
+  return MIN (backoff, self->max_backoff) * 1000;
+}
+
+static gpointer
+gstd_pipeline_watchdog_func (gpointer user_data)
+{
+  GstdPipelineWatchdog *self = GSTD_PIPELINE_WATCHDOG (user_data);
+  GstdWatchdogPolicy policy;
+  GstElement *pipeline;
+  gboolean monitor_position;
+  gboolean target_playing;
+  gboolean playing;
+  gboolean errored;
+  gboolean positioned;
+  gint64 position;
+  gint64 activity;
+  gint64 tick;
+  gint64 now;
+
+  GST_OBJECT_LOCK (self);
+  while (!self->stopping) {
+    tick = self->timeout ? CLAMP ((gint64) self->timeout * 1000 / 4,
+        10 * G_TIME_SPAN_MILLISECOND, G_TIME_SPAN_SECOND) : G_TIME_SPAN_SECOND;
+    g_cond_wait_until (&self->cond, GST_OBJECT_GET_LOCK (self),
+        g_get_monotonic_time () + tick);
+
+    if (self->stopping || !self->bin) {
+      continue;
+    }
+
+    pipeline = gst_object_ref (self->bin);
+    monitor_position = NULL == self->probes;
+    GST_OBJECT_UNLOCK (self);
+
+    GST_OBJECT_LOCK (pipeline);
+    target_playing = GST_STATE_PLAYING == GST_STATE_TARGET (pipeline);
+    playing = target_playing && GST_STATE_PLAYING == GST_STATE (pipeline);
+    GST_OBJECT_UNLOCK (pipeline);
+
+    positioned = playing && monitor_position &&
+        gst_element_query_position (pipeline, GST_FORMAT_TIME, &position);
+
+    now = g_get_monotonic_time ();
+
+    GST_OBJECT_LOCK (self);
+
+    if (positioned && position != self->position) {
+      self->position = position;
+      GSTD_PIPELINE_WATCHDOG_STORE (self->activity, now);
+    }
+    activity = GSTD_PIPELINE_WATCHDOG_LOAD (self->activity);
+
+    /* Stalls are only accounted while the pipeline is meant to play */
+    if (!playing) {
+      self->armed = now;
+    }
+
+    /* Errors of pipelines that were stopped afterwards are forgotten */
+    if (!target_playing) {
+      self->errored = FALSE;
+    }
+
+    if (self->failures && activity > self->recovered_at) {
+      GST_INFO_OBJECT (self, "Pipeline recovered after %u attempts",
+          self->failures);
+      self->failures = 0;
+    }
+
+    if (self->timeout &&
+        now - MAX (activity, self->armed) > (gint64) self->timeout * 1000) {
+      if (!self->stalled) {
+        GST_WARNING_OBJECT (self, "No buffers in the last %u ms",
+            self->timeout);
+        self->stalls++;
+      }
+      self->stalled = TRUE;
+    } else {
+      self->stalled = FALSE;
+    }
+
+    policy = self->policy;
+    errored = self->errored;
+
+    if (GSTD_WATCHDOG_POLICY_NONE == policy || self->stopping ||
+        !(self->stalled || errored) || now < self->next_recovery) {
+      gst_object_unref (pipeline);
+      continue;
+    }
+
+    self->next_recovery = now + gstd_pipeline_watchdog_backoff (self);
+    self->failures++;
+    self->recoveries++;
+    self->stalled = FALSE;
+    self->errored = FALSE;
+    GST_OBJECT_UNLOCK (self);
+
+    gstd_pipeline_watchdog_recover (self, pipeline, policy, errored);
+    gst_object_unref (pipeline);
+
+    GST_OBJECT_LOCK (self);
+    self->recovered_at = g_get_monotonic_time ();
+    self->armed = self->recovered_at;
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  return NULL;
+}
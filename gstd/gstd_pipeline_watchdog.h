@@ -0,0 +1,126 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PIPELINE_WATCHDOG_H__
+#define __GSTD_PIPELINE_WATCHDOG_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+#include "gstd_pipeline.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_PIPELINE_WATCHDOG \
+  (gstd_pipeline_watchdog_get_type())
+#define GSTD_PIPELINE_WATCHDOG(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PIPELINE_WATCHDOG,GstdPipelineWatchdog))
+#define GSTD_PIPELINE_WATCHDOG_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PIPELINE_WATCHDOG,GstdPipelineWatchdogClass))
+#define GSTD_IS_PIPELINE_WATCHDOG(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PIPELINE_WATCHDOG))
+#define GSTD_IS_PIPELINE_WATCHDOG_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PIPELINE_WATCHDOG))
+#define GSTD_PIPELINE_WATCHDOG_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PIPELINE_WATCHDOG, GstdPipelineWatchdogClass))
+typedef struct _GstdPipelineWatchdog GstdPipelineWatchdog;
+typedef struct _GstdPipelineWatchdogClass GstdPipelineWatchdogClass;
+GType gstd_pipeline_watchdog_get_type (void);
+
+/**
+ * GstdWatchdogPolicy:
+ * @GSTD_WATCHDOG_POLICY_NONE: Stalls and errors are only accounted
+ * @GSTD_WATCHDOG_POLICY_FLUSH: The pipeline is flushed at its current
+ * position. Errors are recovered with a restart instead
+ * @GSTD_WATCHDOG_POLICY_RESTART: The pipeline is set to NULL and back
+ * to PLAYING
+ * @GSTD_WATCHDOG_POLICY_REBUILD: The pipeline is built again from its
+ * description
+ *
+ * How a stalled or failed pipeline is recovered.
+ */
+typedef enum
+{
+  GSTD_WATCHDOG_POLICY_NONE,
+  GSTD_WATCHDOG_POLICY_FLUSH,
+  GSTD_WATCHDOG_POLICY_RESTART,
+  GSTD_WATCHDOG_POLICY_REBUILD,
+} GstdWatchdogPolicy;
+
+#define GSTD_TYPE_WATCHDOG_POLICY (gstd_watchdog_policy_get_type ())
+GType gstd_watchdog_policy_get_type (void);
+
+/**
+ * gstd_pipeline_watchdog_new: (constructor)
+ * @owner: The pipeline to recover. It is not referenced, the watchdog
+ * must be stopped before @owner is disposed
+ *
+ * Creates a new watchdog that detects stalls and errors and recovers
+ * the pipeline from them.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPipelineWatchdog.
+ * Free after usage using g_object_unref()
+ */
+GstdPipelineWatchdog *gstd_pipeline_watchdog_new (GstdPipeline * owner);
+
+/**
+ * gstd_pipeline_watchdog_watch:
+ * @object: The watchdog
+ * @bin: The GStreamer pipeline of the owner
+ *
+ * Starts monitoring the buffer flow of @bin. The monitoring thread is
+ * started on the first call.
+ */
+void gstd_pipeline_watchdog_watch (GstdPipelineWatchdog * object,
+    GstBin * bin);
+
+/**
+ * gstd_pipeline_watchdog_unwatch:
+ * @object: The watchdog
+ *
+ * Stops monitoring the current GStreamer pipeline, typically before it
+ * is torn down. The monitoring thread keeps running.
+ */
+void gstd_pipeline_watchdog_unwatch (GstdPipelineWatchdog * object);
+
+/**
+ * gstd_pipeline_watchdog_stop:
+ * @object: The watchdog
+ *
+ * Stops the monitoring thread, waiting for any recovery in progress to
+ * finish. Must be called before disposing the owner.
+ */
+void gstd_pipeline_watchdog_stop (GstdPipelineWatchdog * object);
+
+/**
+ * gstd_pipeline_watchdog_error:
+ * @object: The watchdog
+ * @message: The ERROR message posted in the pipeline
+ *
+ * Schedules a recovery of the pipeline. Safe to be called from the bus
+ * sync handler.
+ */
+void gstd_pipeline_watchdog_error (GstdPipelineWatchdog * object,
+    GstMessage * message);
+
+G_END_DECLS
+#endif // __GSTD_PIPELINE_WATCHDOG_H__
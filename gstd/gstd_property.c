@@ -22,6 +22,7 @@
 #endif
 
 #include "gstd_property.h"
+#include "gstd_property_controller.h"
 
 enum
 {
@@ -104,9 +105,18 @@ gstd_property_class_init (GstdPropertyClass * klass)
 static void
 gstd_property_init (GstdProperty * self)
 {
+  GstdPropertyController *controller;
+
   GST_INFO_OBJECT (self, "Initializing property");
   self->target = DEFAULT_PROP_TARGET;
   self->pspec = DEFAULT_PROP_PSPEC;
+
+  /* Creating attaches an interpolated control source, deleting
+     detaches it */
+  controller = gstd_property_controller_new (GSTD_OBJECT (self));
+  gstd_object_set_creator (GSTD_OBJECT (self),
+      GSTD_ICREATOR (g_object_ref (controller)));
+  gstd_object_set_deleter (GSTD_OBJECT (self), GSTD_IDELETER (controller));
 }
 
 static void
@@ -0,0 +1,378 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/controller/gstinterpolationcontrolsource.h>
+#include <gst/controller/gstdirectcontrolbinding.h>
+
+#include "gstd_property_controller.h"
+#include "gstd_property.h"
+
+/* Gstd Property Controller debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_property_controller_debug);
+#define GST_CAT_DEFAULT gstd_property_controller_debug
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/**
+ * GstdPropertyController:
+ * Attaches an interpolation control source to a controllable property
+ * so that GStreamer animates it in sync with the stream, instead of
+ * the client updating the value over and over. The creator takes an
+ * interpolation mode and a list of keyframes:
+ *
+ *   create <property> <mode> [+]<time>:<value> [[+]<time>:<value> ...]
+ *
+ * Times are in nanoseconds of stream time. A leading '+' makes the
+ * time relative to the current position and anchors the ramp at the
+ * current value, so "linear +1000000000:0" fades to 0 in one second.
+ * Deleting the property removes the control binding.
+ */
+struct _GstdPropertyController
+{
+  GObject parent;
+
+  GstdProperty *property;
+};
+
+struct _GstdPropertyControllerClass
+{
+  GObjectClass parent_class;
+};
+
+/* VTable */
+static GstdReturnCode gstd_property_controller_create (GstdICreator * iface,
+    const gchar * name, const gchar * description, GstdObject ** out);
+static GstdReturnCode gstd_property_controller_delete (GstdIDeleter * iface,
+    GstdObject * object);
+static GParamSpec *gstd_property_controller_get_pspec (GstdPropertyController *
+    self);
+static gboolean gstd_property_controller_get_value (GstdPropertyController *
+    self, GParamSpec * pspec, gdouble * value);
+static GstClockTime gstd_property_controller_get_position
+    (GstdPropertyController * self);
+static GstdReturnCode
+gstd_property_controller_fill (GstdPropertyController * self,
+    GParamSpec * pspec, GstTimedValueControlSource * source,
+    const gchar * description);
+
+static void
+gstd_icreator_interface_init (GstdICreatorInterface * iface)
+{
+  iface->create = gstd_property_controller_create;
+}
+
+static void
+gstd_ideleter_interface_init (GstdIDeleterInterface * iface)
+{
+  iface->delete = gstd_property_controller_delete;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GstdPropertyController, gstd_property_controller,
+    G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE (GSTD_TYPE_ICREATOR,
+        gstd_icreator_interface_init);
+    G_IMPLEMENT_INTERFACE (GSTD_TYPE_IDELETER, gstd_ideleter_interface_init));
+
+static void
+gstd_property_controller_class_init (GstdPropertyControllerClass * klass)
+{
+  guint debug_color;
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_property_controller_debug,
+      "gstdpropertycontroller", debug_color,
+      "Gstd Property Controller category");
+}
+
+static void
+gstd_property_controller_init (GstdPropertyController * self)
+{
+  GST_INFO_OBJECT (self, "Initializing property controller");
+  self->property = NULL;
+}
+
+GstdPropertyController *
+gstd_property_controller_new (GstdObject * property)
+{
+  GstdPropertyController *self;
+
+  g_return_val_if_fail (GSTD_IS_PROPERTY (property), NULL);
+
+  self = g_object_new (GSTD_TYPE_PROPERTY_CONTROLLER, NULL);
+  self->property = GSTD_PROPERTY (property);
+
+  return self;
+}
+
+static GParamSpec *
+gstd_property_controller_get_pspec (GstdPropertyController * self)
+{
+  GstdProperty *prop = self->property;
+
+  if (prop->pspec) {
+    return prop->pspec;
+  }
+
+  return g_object_class_find_property (G_OBJECT_GET_CLASS (prop->target),
+      GSTD_OBJECT_NAME (prop));
+}
+
+static gboolean
+gstd_property_controller_get_value (GstdPropertyController * self,
+    GParamSpec * pspec, gdouble * value)
+{
+  GValue current = G_VALUE_INIT;
+  GValue converted = G_VALUE_INIT;
+  gboolean ret;
+
+  g_value_init (&current, pspec->value_type);
+  g_value_init (&converted, G_TYPE_DOUBLE);
+
+  g_object_get_property (self->property->target, pspec->name, &current);
+
+  ret = g_value_transform (&current, &converted);
+  if (ret) {
+    *value = g_value_get_double (&converted);
+  }
+
+  g_value_unset (&current);
+  g_value_unset (&converted);
+
+  return ret;
+}
+
+static GstClockTime
+gstd_property_controller_get_position (GstdPropertyController * self)
+{
+  GObject *target = self->property->target;
+  gint64 position;
+
+  /* Control sources are sampled with the stream time of the buffers
+     being processed, which is what a position query reports */
+  if (GST_IS_ELEMENT (target)
+      && gst_element_query_position (GST_ELEMENT (target), GST_FORMAT_TIME,
+          &position) && position >= 0) {
+    return position;
+  }
+
+  return 0;
+}
+
+static GstdReturnCode
+gstd_property_controller_fill (GstdPropertyController * self,
+    GParamSpec * pspec, GstTimedValueControlSource * source,
+    const gchar * description)
+{
+  GstdReturnCode ret = GSTD_EOK;
+  gchar **keyframes;
+  gchar **keyframe;
+  gchar *time;
+  gchar *end;
+  GstClockTime now = GST_CLOCK_TIME_NONE;
+  GstClockTime timestamp;
+  gdouble value;
+  gint i;
+
+  keyframes = g_strsplit (description, " ", -1);
+
+  for (i = 0; keyframes[i]; ++i) {
+    if ('\0' == keyframes[i][0]) {
+      continue;
+    }
+
+    keyframe = g_strsplit (keyframes[i], ":", 2);
+    if (!keyframe[0] || !keyframe[1]) {
+      GST_ERROR_OBJECT (self, "Malformed keyframe \"%s\", expected "
+          "[+]<time>:<value>", keyframes[i]);
+      ret = GSTD_BAD_VALUE;
+      g_strfreev (keyframe);
+      break;
+    }
+
+    time = keyframe[0];
+    if ('+' == time[0]) {
+      if (!GST_CLOCK_TIME_IS_VALID (now)) {
+        now = gstd_property_controller_get_position (self);
+
+        /* Anchor the ramp at the current value */
+        if (gstd_property_controller_get_value (self, pspec, &value)) {
+          gst_timed_value_control_source_set (source, now, value);
+        }
+      }
+      time++;
+    }
+
+    timestamp = g_ascii_strtoull (time, &end, 10);
+    if (end == time || '\0' != *end) {
+      GST_ERROR_OBJECT (self, "Invalid keyframe time \"%s\"", keyframe[0]);
+      ret = GSTD_BAD_VALUE;
+      g_strfreev (keyframe);
+      break;
+    }
+
+    value = g_ascii_strtod (keyframe[1], &end);
+    if (end == keyframe[1] || '\0' != *end) {
+      GST_ERROR_OBJECT (self, "Invalid keyframe value \"%s\"", keyframe[1]);
+      ret = GSTD_BAD_VALUE;
+      g_strfreev (keyframe);
+      break;
+    }
+
+    if ('+' == keyframe[0][0]) {
+      timestamp += now;
+    }
+
+    GST_DEBUG_OBJECT (self, "Adding keyframe %" GST_TIME_FORMAT " -> %f",
+        GST_TIME_ARGS (timestamp), value);
+    gst_timed_value_control_source_set (source, timestamp, value);
+
+    g_strfreev (keyframe);
+  }
+
+  g_strfreev (keyframes);
+
+  if (GSTD_EOK == ret
+      && 0 == gst_timed_value_control_source_get_count (source)) {
+    GST_ERROR_OBJECT (self, "No keyframes were provided");
+    ret = GSTD_BAD_VALUE;
+  }
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_property_controller_create (GstdICreator * iface, const gchar * name,
+    const gchar * description, GstdObject ** out)
+{
+  GstdPropertyController *self;
+  GParamSpec *pspec;
+  GstObject *target;
+  GEnumClass *modes;
+  GEnumValue *mode;
+  GstControlSource *source;
+  GstControlBinding *binding;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (out, GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PROPERTY_CONTROLLER (iface);
+
+  /* We don't return the control source */
+  *out = NULL;
+
+  if (NULL == name || NULL == description) {
+    GST_ERROR_OBJECT (self, "An interpolation mode and keyframes are needed");
+    return GSTD_NULL_ARGUMENT;
+  }
+
+  if (!GST_IS_OBJECT (self->property->target)) {
+    GST_ERROR_OBJECT (self, "Only properties of GStreamer objects can be "
+        "controlled");
+    return GSTD_BAD_VALUE;
+  }
+  target = GST_OBJECT (self->property->target);
+
+  pspec = gstd_property_controller_get_pspec (self);
+  if (!(pspec->flags & GST_PARAM_CONTROLLABLE)) {
+    GST_ERROR_OBJECT (self, "Property \"%s\" is not controllable",
+        pspec->name);
+    return GSTD_BAD_VALUE;
+  }
+
+  modes = g_type_class_ref (GST_TYPE_INTERPOLATION_MODE);
+  mode = g_enum_get_value_by_nick (modes, name);
+  if (!mode) {
+    mode = g_enum_get_value_by_name (modes, name);
+  }
+
+  if (!mode) {
+    GST_ERROR_OBJECT (self, "Unknown interpolation mode \"%s\"", name);
+    g_type_class_unref (modes);
+    return GSTD_BAD_VALUE;
+  }
+
+  source = gst_interpolation_control_source_new ();
+  g_object_set (source, "mode", mode->value, NULL);
+  g_type_class_unref (modes);
+
+  ret = gstd_property_controller_fill (self, pspec,
+      GST_TIMED_VALUE_CONTROL_SOURCE (source), description);
+  if (GSTD_EOK != ret) {
+    gst_object_unref (source);
+    return ret;
+  }
+
+  /* Absolute bindings take the keyframes in the property units, older
+     versions only offer the [0,1] normalized flavor */
+#if GST_CHECK_VERSION(1,6,0)
+  binding = gst_direct_control_binding_new_absolute (target, pspec->name,
+      source);
+#else
+  binding = gst_direct_control_binding_new (target, pspec->name, source);
+#endif
+  gst_object_unref (source);
+
+  /* Replaces any previous binding for this property */
+  if (!gst_object_add_control_binding (target, binding)) {
+    GST_ERROR_OBJECT (self, "Unable to bind control source to \"%s\"",
+        pspec->name);
+    /* The binding is only sunk when added, drop the floating one */
+    gst_object_ref_sink (binding);
+    gst_object_unref (binding);
+    return GSTD_BAD_VALUE;
+  }
+
+  GST_INFO_OBJECT (self, "Controlling \"%s\" of %s with %s interpolation",
+      pspec->name, GST_OBJECT_NAME (target), name);
+
+  return GSTD_EOK;
+}
+
+static GstdReturnCode
+gstd_property_controller_delete (GstdIDeleter * iface, GstdObject * object)
+{
+  GstdPropertyController *self;
+  GParamSpec *pspec;
+  GstObject *target;
+  GstControlBinding *binding;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+
+  self = GSTD_PROPERTY_CONTROLLER (iface);
+
+  if (!GST_IS_OBJECT (self->property->target)) {
+    return GSTD_EOK;
+  }
+  target = GST_OBJECT (self->property->target);
+
+  pspec = gstd_property_controller_get_pspec (self);
+  binding = gst_object_get_control_binding (target, pspec->name);
+
+  if (binding) {
+    GST_INFO_OBJECT (self, "Releasing control of \"%s\"", pspec->name);
+    gst_object_remove_control_binding (target, binding);
+    gst_object_unref (binding);
+  }
+
+  return GSTD_EOK;
+}
@@ -0,0 +1,59 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_PROPERTY_CONTROLLER_H__
+#define __GSTD_PROPERTY_CONTROLLER_H__
+
+#include <gst/gst.h>
+#include <gstd_object.h>
+
+G_BEGIN_DECLS
+#define GSTD_TYPE_PROPERTY_CONTROLLER \
+  (gstd_property_controller_get_type())
+#define GSTD_PROPERTY_CONTROLLER(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_PROPERTY_CONTROLLER,GstdPropertyController))
+#define GSTD_PROPERTY_CONTROLLER_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_PROPERTY_CONTROLLER,GstdPropertyControllerClass))
+#define GSTD_IS_PROPERTY_CONTROLLER(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_PROPERTY_CONTROLLER))
+#define GSTD_IS_PROPERTY_CONTROLLER_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_PROPERTY_CONTROLLER))
+#define GSTD_PROPERTY_CONTROLLER_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_PROPERTY_CONTROLLER, GstdPropertyControllerClass))
+
+typedef struct _GstdPropertyController GstdPropertyController;
+typedef struct _GstdPropertyControllerClass GstdPropertyControllerClass;
+
+GType gstd_property_controller_get_type (void);
+
+/**
+ * gstd_property_controller_new: (constructor)
+ * @property: The GstdProperty to be controlled. It is not reffed, the
+ * controller is expected to be owned by the property itself.
+ *
+ * Creates a creator/deleter pair that attaches interpolated control
+ * sources to the property target and removes them.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdPropertyController.
+ * Free after usage using g_object_unref()
+ */
+GstdPropertyController *gstd_property_controller_new (GstdObject * property);
+
+G_END_DECLS
+#endif // __GSTD_PROPERTY_CONTROLLER_H__
@@ -73,6 +73,9 @@ static GstdReturnCode
 gstd_property_string_update (GstdObject * object, const gchar * value)
 {
   GstdProperty *prop;
+  GParamSpec *pspec;
+  gchar *current = NULL;
+  GstdReturnCode ret = GSTD_EOK;
 
   g_return_val_if_fail (object, GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (value, GSTD_NULL_ARGUMENT);
@@ -81,5 +84,19 @@ gstd_property_string_update (GstdObject * object, const gchar * value)
 
   g_object_set (prop->target, GSTD_OBJECT_NAME (prop), value, NULL);
 
-  return GSTD_EOK;
+  /* Daemon objects keep their previous value when given one they can't take */
+  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (prop->target),
+      GSTD_OBJECT_NAME (prop));
+  if (GSTD_IS_OBJECT (prop->target) && pspec
+      && (pspec->flags & G_PARAM_READABLE)) {
+    g_object_get (prop->target, GSTD_OBJECT_NAME (prop), &current, NULL);
+    if (g_strcmp0 (current, value)) {
+      GST_ERROR_OBJECT (prop, "\"%s\" refused \"%s\"",
+          GSTD_OBJECT_NAME (prop), value);
+      ret = GSTD_BAD_VALUE;
+    }
+    g_free (current);
+  }
+
+  return ret;
 }
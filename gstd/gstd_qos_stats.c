@@ -0,0 +1,368 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+
+#include "gstd_qos_stats.h"
+#include "gstd_property_reader.h"
+
+/* Gstd QoS Stats debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_qos_stats_debug);
+#define GST_CAT_DEFAULT gstd_qos_stats_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/* Bounds the memory of elements flooding the bus */
+#define GSTD_QOS_STATS_MAX_SAMPLES 4096
+
+enum
+{
+  PROP_WINDOW = 1,
+  PROP_MESSAGES,
+  PROP_PROCESSED,
+  PROP_DROPPED,
+  PROP_DROP_RATE,
+  PROP_MEAN_JITTER,
+  PROP_MAX_JITTER,
+  PROP_MIN_PROPORTION,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+typedef struct _GstdQosSample GstdQosSample;
+
+struct _GstdQosSample
+{
+  GstClockTime time;
+  guint64 processed;
+  guint64 dropped;
+  gint64 jitter;
+  gdouble proportion;
+};
+
+/**
+ * GstdQosStats:
+ * Sliding window aggregates of the QoS messages of an element
+ */
+struct _GstdQosStats
+{
+  GstdObject parent;
+
+  /**
+   * The time span the aggregates are computed over
+   */
+  GstClockTime window;
+
+  /**
+   * The samples in the window, oldest first
+   */
+  GQueue samples;
+
+  /**
+   * The latest cumulative counters reported by the element
+   */
+  guint64 processed;
+  guint64 dropped;
+};
+
+struct _GstdQosStatsClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdQosStats, gstd_qos_stats, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_qos_stats_set_property (GObject *, guint, const GValue *, GParamSpec *);
+static void
+gstd_qos_stats_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_qos_stats_finalize (GObject *);
+static void gstd_qos_stats_expire (GstdQosStats *, GstClockTime);
+
+static void
+gstd_qos_stats_class_init (GstdQosStatsClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_qos_stats_set_property;
+  object_class->get_property = gstd_qos_stats_get_property;
+  object_class->finalize = gstd_qos_stats_finalize;
+
+  properties[PROP_WINDOW] =
+      g_param_spec_uint64 ("window",
+      "Window",
+      "The time span the aggregates are computed over, in nanoseconds",
+      1, G_MAXUINT64, GSTD_QOS_STATS_DEFAULT_WINDOW,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_MESSAGES] =
+      g_param_spec_uint ("messages",
+      "Messages",
+      "The amount of QoS messages in the window",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_PROCESSED] =
+      g_param_spec_uint64 ("processed",
+      "Processed",
+      "The total amount of processed units, as last reported",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_DROPPED] =
+      g_param_spec_uint64 ("dropped",
+      "Dropped",
+      "The total amount of dropped units, as last reported",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_DROP_RATE] =
+      g_param_spec_double ("drop-rate",
+      "Drop Rate",
+      "The fraction of units dropped in the window",
+      0, 1, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_MEAN_JITTER] =
+      g_param_spec_int64 ("mean-jitter",
+      "Mean Jitter",
+      "The mean jitter in the window, in nanoseconds",
+      G_MININT64, G_MAXINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_MAX_JITTER] =
+      g_param_spec_int64 ("max-jitter",
+      "Max Jitter",
+      "The maximum jitter in the window, in nanoseconds",
+      G_MININT64, G_MAXINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_MIN_PROPORTION] =
+      g_param_spec_double ("min-proportion",
+      "Min Proportion",
+      "The minimum proportion in the window, lower than 1 means the "
+      "element can't keep up",
+      0, G_MAXDOUBLE, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_qos_stats_debug, "gstdqosstats", debug_color,
+      "Gstd QoS Stats category");
+}
+
+static void
+gstd_qos_stats_init (GstdQosStats * self)
+{
+  self->window = GSTD_QOS_STATS_DEFAULT_WINDOW;
+  self->processed = 0;
+  self->dropped = 0;
+  g_queue_init (&self->samples);
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_qos_stats_free_sample (gpointer sample)
+{
+  g_slice_free (GstdQosSample, sample);
+}
+
+static void
+gstd_qos_stats_finalize (GObject * object)
+{
+  GstdQosStats *self = GSTD_QOS_STATS (object);
+
+  g_queue_clear_full (&self->samples, gstd_qos_stats_free_sample);
+
+  G_OBJECT_CLASS (gstd_qos_stats_parent_class)->finalize (object);
+}
+
+static void
+gstd_qos_stats_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdQosStats *self = GSTD_QOS_STATS (object);
+  GstdQosSample *first;
+  GstdQosSample *last;
+  GstdQosSample *sample;
+  GList *link;
+  guint64 total;
+  gint64 jitter;
+  gdouble proportion;
+
+  GST_OBJECT_LOCK (self);
+  gstd_qos_stats_expire (self, gst_util_get_timestamp ());
+
+  first = g_queue_peek_head (&self->samples);
+  last = g_queue_peek_tail (&self->samples);
+
+  switch (property_id) {
+    case PROP_WINDOW:
+      g_value_set_uint64 (value, self->window);
+      break;
+    case PROP_MESSAGES:
+      g_value_set_uint (value, g_queue_get_length (&self->samples));
+      break;
+    case PROP_PROCESSED:
+      g_value_set_uint64 (value, self->processed);
+      break;
+    case PROP_DROPPED:
+      g_value_set_uint64 (value, self->dropped);
+      break;
+    case PROP_DROP_RATE:
+      /* Counters are cumulative, the window is the difference between
+         its ends */
+      total = 0;
+      if (first && last != first) {
+        total = (last->processed + last->dropped) -
+            (first->processed + first->dropped);
+      }
+      g_value_set_double (value, total ?
+          (gdouble) (last->dropped - first->dropped) / total : 0);
+      break;
+    case PROP_MEAN_JITTER:
+      jitter = 0;
+      for (link = self->samples.head; link; link = link->next) {
+        sample = link->data;
+        jitter += sample->jitter;
+      }
+      g_value_set_int64 (value, first ?
+          jitter / (gint64) g_queue_get_length (&self->samples) : 0);
+      break;
+    case PROP_MAX_JITTER:
+      jitter = first ? first->jitter : 0;
+      for (link = self->samples.head; link; link = link->next) {
+        sample = link->data;
+        jitter = MAX (jitter, sample->jitter);
+      }
+      g_value_set_int64 (value, jitter);
+      break;
+    case PROP_MIN_PROPORTION:
+      proportion = first ? first->proportion : 0;
+      for (link = self->samples.head; link; link = link->next) {
+        sample = link->data;
+        proportion = MIN (proportion, sample->proportion);
+      }
+      g_value_set_double (value, proportion);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gstd_qos_stats_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdQosStats *self = GSTD_QOS_STATS (object);
+
+  switch (property_id) {
+    case PROP_WINDOW:
+      gstd_qos_stats_set_window (self, g_value_get_uint64 (value));
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+GstdQosStats *
+gstd_qos_stats_new (const gchar * name, GstClockTime window)
+{
+  g_return_val_if_fail (name, NULL);
+
+  return GSTD_QOS_STATS (g_object_new (GSTD_TYPE_QOS_STATS, "name", name,
+          "window", window, NULL));
+}
+
+void
+gstd_qos_stats_set_window (GstdQosStats * self, GstClockTime window)
+{
+  g_return_if_fail (GSTD_IS_QOS_STATS (self));
+
+  GST_OBJECT_LOCK (self);
+  self->window = window;
+  GST_OBJECT_UNLOCK (self);
+}
+
+void
+gstd_qos_stats_add (GstdQosStats * self, GstMessage * message)
+{
+  GstdQosSample *sample;
+  GstFormat format;
+  gint quality;
+
+  g_return_if_fail (GSTD_IS_QOS_STATS (self));
+  g_return_if_fail (GST_MESSAGE_QOS == GST_MESSAGE_TYPE (message));
+
+  sample = g_slice_new0 (GstdQosSample);
+  sample->time = gst_util_get_timestamp ();
+
+  gst_message_parse_qos_values (message, &sample->jitter, &sample->proportion,
+      &quality);
+  gst_message_parse_qos_stats (message, &format, &sample->processed,
+      &sample->dropped);
+
+  GST_OBJECT_LOCK (self);
+
+  /* Unknown counters are reported as -1, carry the last known ones */
+  if (G_MAXUINT64 == sample->processed) {
+    sample->processed = self->processed;
+  }
+  if (G_MAXUINT64 == sample->dropped) {
+    sample->dropped = self->dropped;
+  }
+  self->processed = sample->processed;
+  self->dropped = sample->dropped;
+
+  g_queue_push_tail (&self->samples, sample);
+  if (g_queue_get_length (&self->samples) > GSTD_QOS_STATS_MAX_SAMPLES) {
+    gstd_qos_stats_free_sample (g_queue_pop_head (&self->samples));
+  }
+  gstd_qos_stats_expire (self, sample->time);
+
+  GST_OBJECT_UNLOCK (self);
+}
+
+/* Must be called with the object lock held */
+static void
+gstd_qos_stats_expire (GstdQosStats * self, GstClockTime now)
+{
+  GstdQosSample *sample;
+
+  while ((sample = g_queue_peek_head (&self->samples))) {
+    if (now - sample->time <= self->window) {
+      break;
+    }
+    gstd_qos_stats_free_sample (g_queue_pop_head (&self->samples));
+  }
+}
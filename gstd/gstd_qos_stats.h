@@ -0,0 +1,80 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_QOS_STATS_H__
+#define __GSTD_QOS_STATS_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_QOS_STATS \
+  (gstd_qos_stats_get_type())
+#define GSTD_QOS_STATS(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_QOS_STATS,GstdQosStats))
+#define GSTD_QOS_STATS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_QOS_STATS,GstdQosStatsClass))
+#define GSTD_IS_QOS_STATS(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_QOS_STATS))
+#define GSTD_IS_QOS_STATS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_QOS_STATS))
+#define GSTD_QOS_STATS_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_QOS_STATS, GstdQosStatsClass))
+typedef struct _GstdQosStats GstdQosStats;
+typedef struct _GstdQosStatsClass GstdQosStatsClass;
+GType gstd_qos_stats_get_type (void);
+
+#define GSTD_QOS_STATS_DEFAULT_WINDOW (10 * GST_SECOND)
+
+/**
+ * gstd_qos_stats_new: (constructor)
+ * @name: The name of the element posting the QoS messages
+ * @window: The time span the aggregates are computed over
+ *
+ * Creates a new object to aggregate the QoS messages of an element.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdQosStats. Free after
+ * usage using g_object_unref()
+ */
+GstdQosStats *gstd_qos_stats_new (const gchar * name, GstClockTime window);
+
+/**
+ * gstd_qos_stats_add:
+ * @object: The stats to update
+ * @message: A QoS message posted by the element
+ *
+ * Accounts @message, discarding the samples that fell out of the
+ * window.
+ */
+void gstd_qos_stats_add (GstdQosStats * object, GstMessage * message);
+
+/**
+ * gstd_qos_stats_set_window:
+ * @object: The stats to update
+ * @window: The time span the aggregates are computed over
+ */
+void gstd_qos_stats_set_window (GstdQosStats * object, GstClockTime window);
+
+G_END_DECLS
+#endif // __GSTD_QOS_STATS_H__
@@ -49,7 +49,8 @@ gstd_return_code_to_string (GstdReturnCode code)
     [GSTD_IPC_ERROR] = "IPC error",
     [GSTD_EVENT_ERROR] = "Event error",
     [GSTD_MISSING_ARGUMENT] = "One or more arguments are missing",
-    [GSTD_MISSING_NAME] = "Name is missing"
+    [GSTD_MISSING_NAME] = "Name is missing",
+    [GSTD_NO_THREADS] = "No streaming threads available"
   };
 
   const gint size = sizeof (code_description) / sizeof (gchar *);
@@ -129,6 +129,11 @@ enum _GstdReturnCode
    */
   GSTD_MISSING_NAME,
 
+  /**
+   * No streaming threads left in the shared task pool
+   */
+  GSTD_NO_THREADS,
+
 };
 
 
@@ -0,0 +1,403 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+
+#include "gstd_scheduled_command.h"
+#include "gstd_parser.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Scheduled Command debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_scheduled_command_debug);
+#define GST_CAT_DEFAULT gstd_scheduled_command_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+enum
+{
+  PROP_COMMAND = 1,
+  PROP_DEADLINE,
+  PROP_PIPELINE_TIME,
+  PROP_STATUS,
+  PROP_CODE,
+  PROP_RESPONSE,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/**
+ * GstdScheduledCommand:
+ * A parser command executed by the daemon once a clock deadline is
+ * reached
+ */
+struct _GstdScheduledCommand
+{
+  GstdObject parent;
+
+  /**
+   * The command, as sent by a client
+   */
+  gchar *command;
+
+  /**
+   * The clock being waited on and the wait itself
+   */
+  GstClock *clock;
+  GstClockID id;
+
+  /**
+   * The deadline, in clock time
+   */
+  GstClockTime deadline;
+
+  /**
+   * Whether the clock is the pipeline clock or the wall clock
+   */
+  gboolean pipeline_time;
+
+  GstdScheduleStatus status;
+
+  /**
+   * The outcome of the command, once executed
+   */
+  GstdReturnCode code;
+  gchar *response;
+};
+
+struct _GstdScheduledCommandClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdScheduledCommand, gstd_scheduled_command,
+    GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_scheduled_command_get_property (GObject *, guint, GValue *,
+    GParamSpec *);
+static void gstd_scheduled_command_dispose (GObject *);
+static void gstd_scheduled_command_finalize (GObject *);
+static gboolean gstd_scheduled_command_fired (GstClock *, GstClockTime,
+    GstClockID, gpointer);
+static gboolean gstd_scheduled_command_execute (gpointer);
+
+GType
+gstd_schedule_status_get_type (void)
+{
+  static GType status_type = 0;
+  static const GEnumValue status_types[] = {
+    {GSTD_SCHEDULE_STATUS_PENDING, "GSTD_SCHEDULE_STATUS_PENDING", "pending"},
+    {GSTD_SCHEDULE_STATUS_DONE, "GSTD_SCHEDULE_STATUS_DONE", "done"},
+    {GSTD_SCHEDULE_STATUS_FAILED, "GSTD_SCHEDULE_STATUS_FAILED", "failed"},
+    {GSTD_SCHEDULE_STATUS_CANCELLED, "GSTD_SCHEDULE_STATUS_CANCELLED",
+        "cancelled"},
+    {0, NULL, NULL}
+  };
+
+  if (!status_type) {
+    status_type = g_enum_register_static ("GstdScheduleStatus", status_types);
+  }
+  return status_type;
+}
+
+static void
+gstd_scheduled_command_class_init (GstdScheduledCommandClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->get_property = gstd_scheduled_command_get_property;
+  object_class->dispose = gstd_scheduled_command_dispose;
+  object_class->finalize = gstd_scheduled_command_finalize;
+
+  properties[PROP_COMMAND] =
+      g_param_spec_string ("command", "Command",
+      "The command executed once the deadline is reached",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_DEADLINE] =
+      g_param_spec_uint64 ("deadline", "Deadline",
+      "The deadline in nanoseconds of running time, or since the epoch "
+      "for wall clock deadlines",
+      0, G_MAXUINT64, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_PIPELINE_TIME] =
+      g_param_spec_boolean ("pipeline-time", "Pipeline Time",
+      "Whether the deadline is in pipeline running time or wall clock time",
+      TRUE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_STATUS] =
+      g_param_spec_enum ("status", "Status",
+      "The progress of the scheduled command",
+      GSTD_TYPE_SCHEDULE_STATUS, GSTD_SCHEDULE_STATUS_PENDING,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_CODE] =
+      g_param_spec_int ("code", "Code",
+      "The return code of the command, once executed",
+      G_MININT, G_MAXINT, GSTD_EOK,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_RESPONSE] =
+      g_param_spec_string ("response", "Response",
+      "The response of the command, once executed",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_scheduled_command_debug,
+      "gstdscheduledcommand", debug_color, "Gstd Scheduled Command category");
+}
+
+static void
+gstd_scheduled_command_init (GstdScheduledCommand * self)
+{
+  GST_INFO_OBJECT (self, "Initializing scheduled command");
+
+  self->command = NULL;
+  self->clock = NULL;
+  self->id = NULL;
+  self->deadline = 0;
+  self->pipeline_time = TRUE;
+  self->status = GSTD_SCHEDULE_STATUS_PENDING;
+  self->code = GSTD_EOK;
+  self->response = NULL;
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+GstdScheduledCommand *
+gstd_scheduled_command_new (const gchar * name, const gchar * command)
+{
+  GstdScheduledCommand *self;
+
+  g_return_val_if_fail (name, NULL);
+  g_return_val_if_fail (command, NULL);
+
+  self = GSTD_SCHEDULED_COMMAND (g_object_new (GSTD_TYPE_SCHEDULED_COMMAND,
+          "name", name, NULL));
+  self->command = g_strdup (command);
+
+  return self;
+}
+
+static void
+gstd_scheduled_command_dispose (GObject * object)
+{
+  GstdScheduledCommand *self = GSTD_SCHEDULED_COMMAND (object);
+
+  GST_INFO_OBJECT (self, "Disposing scheduled command");
+
+  gstd_scheduled_command_cancel (self);
+
+  GST_OBJECT_LOCK (self);
+  if (self->id) {
+    gst_clock_id_unref (self->id);
+    self->id = NULL;
+  }
+
+  if (self->clock) {
+    gst_object_unref (self->clock);
+    self->clock = NULL;
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  G_OBJECT_CLASS (gstd_scheduled_command_parent_class)->dispose (object);
+}
+
+static void
+gstd_scheduled_command_finalize (GObject * object)
+{
+  GstdScheduledCommand *self = GSTD_SCHEDULED_COMMAND (object);
+
+  g_free (self->command);
+  g_free (self->response);
+
+  G_OBJECT_CLASS (gstd_scheduled_command_parent_class)->finalize (object);
+}
+
+static void
+gstd_scheduled_command_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdScheduledCommand *self = GSTD_SCHEDULED_COMMAND (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (property_id) {
+    case PROP_COMMAND:
+      g_value_set_string (value, self->command);
+      break;
+    case PROP_DEADLINE:
+      g_value_set_uint64 (value, self->deadline);
+      break;
+    case PROP_PIPELINE_TIME:
+      g_value_set_boolean (value, self->pipeline_time);
+      break;
+    case PROP_STATUS:
+      g_value_set_enum (value, self->status);
+      break;
+    case PROP_CODE:
+      g_value_set_int (value, self->code);
+      break;
+    case PROP_RESPONSE:
+      g_value_set_string (value, self->response);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+gboolean
+gstd_scheduled_command_arm (GstdScheduledCommand * self, GstClock * clock,
+    GstClockTime base_time, GstClockTime deadline, gboolean pipeline_time)
+{
+  GstClockReturn ret;
+
+  g_return_val_if_fail (GSTD_IS_SCHEDULED_COMMAND (self), FALSE);
+  g_return_val_if_fail (GST_IS_CLOCK (clock), FALSE);
+  g_return_val_if_fail (GST_CLOCK_TIME_IS_VALID (base_time), FALSE);
+  g_return_val_if_fail (GST_CLOCK_TIME_IS_VALID (deadline), FALSE);
+
+  GST_OBJECT_LOCK (self);
+  if (self->id) {
+    GST_OBJECT_UNLOCK (self);
+    GST_ERROR_OBJECT (self, "Command is already scheduled");
+    return FALSE;
+  }
+
+  self->clock = gst_object_ref (clock);
+  self->id = gst_clock_new_single_shot_id (clock, base_time + deadline);
+  self->deadline = deadline;
+  self->pipeline_time = pipeline_time;
+  GST_OBJECT_UNLOCK (self);
+
+  GST_INFO_OBJECT (self, "Scheduling \"%s\" at %" GST_TIME_FORMAT,
+      self->command, GST_TIME_ARGS (deadline));
+
+  ret = gst_clock_id_wait_async (self->id, gstd_scheduled_command_fired,
+      g_object_ref (self), g_object_unref);
+
+  return GST_CLOCK_OK == ret;
+}
+
+void
+gstd_scheduled_command_cancel (GstdScheduledCommand * self)
+{
+  g_return_if_fail (GSTD_IS_SCHEDULED_COMMAND (self));
+
+  GST_OBJECT_LOCK (self);
+  if (GSTD_SCHEDULE_STATUS_PENDING == self->status) {
+    self->status = GSTD_SCHEDULE_STATUS_CANCELLED;
+    if (self->id) {
+      GST_INFO_OBJECT (self, "Unscheduling \"%s\"", self->command);
+      gst_clock_id_unschedule (self->id);
+    }
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+gboolean
+gstd_scheduled_command_is_pipeline_time (GstdScheduledCommand * self)
+{
+  gboolean pipeline_time;
+
+  g_return_val_if_fail (GSTD_IS_SCHEDULED_COMMAND (self), FALSE);
+
+  GST_OBJECT_LOCK (self);
+  pipeline_time = self->pipeline_time;
+  GST_OBJECT_UNLOCK (self);
+
+  return pipeline_time;
+}
+
+static gboolean
+gstd_scheduled_command_fired (GstClock * clock, GstClockTime time,
+    GstClockID id, gpointer user_data)
+{
+  GstdScheduledCommand *self = GSTD_SCHEDULED_COMMAND (user_data);
+
+  GST_DEBUG_OBJECT (self, "Deadline reached at %" GST_TIME_FORMAT,
+      GST_TIME_ARGS (time));
+
+  /* Commands may change the pipeline state or block, which must not
+     happen in the clock thread */
+  g_main_context_invoke_full (NULL, G_PRIORITY_HIGH,
+      gstd_scheduled_command_execute, g_object_ref (self), g_object_unref);
+
+  return TRUE;
+}
+
+static gboolean
+gstd_scheduled_command_execute (gpointer user_data)
+{
+  GstdScheduledCommand *self = GSTD_SCHEDULED_COMMAND (user_data);
+  GstdReturnCode code;
+  gchar *response = NULL;
+
+  GST_OBJECT_LOCK (self);
+  if (GSTD_SCHEDULE_STATUS_PENDING != self->status) {
+    GST_OBJECT_UNLOCK (self);
+    return G_SOURCE_REMOVE;
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  code = gstd_scheduled_command_run (self->command, &response);
+
+  GST_INFO_OBJECT (self, "Executed \"%s\": %s", self->command,
+      gstd_return_code_to_string (code));
+
+  GST_OBJECT_LOCK (self);
+  self->status = GSTD_EOK == code ?
+      GSTD_SCHEDULE_STATUS_DONE : GSTD_SCHEDULE_STATUS_FAILED;
+  self->code = code;
+  g_free (self->response);
+  self->response = response;
+  GST_OBJECT_UNLOCK (self);
+
+  return G_SOURCE_REMOVE;
+}
+
+GstdReturnCode
+gstd_scheduled_command_run (const gchar * command, gchar ** response)
+{
+  GstdSession *session;
+  GstdReturnCode code;
+
+  g_return_val_if_fail (command, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  /* The session is a singleton, this returns the running one */
+  session = GSTD_SESSION (g_object_new (GSTD_TYPE_SESSION, NULL));
+  code = gstd_parser_parse_cmd (session, command, response);
+  g_object_unref (session);
+
+  return code;
+}
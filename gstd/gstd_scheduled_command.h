@@ -0,0 +1,133 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_SCHEDULED_COMMAND_H__
+#define __GSTD_SCHEDULED_COMMAND_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_SCHEDULED_COMMAND \
+  (gstd_scheduled_command_get_type())
+#define GSTD_SCHEDULED_COMMAND(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_SCHEDULED_COMMAND,GstdScheduledCommand))
+#define GSTD_SCHEDULED_COMMAND_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_SCHEDULED_COMMAND,GstdScheduledCommandClass))
+#define GSTD_IS_SCHEDULED_COMMAND(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_SCHEDULED_COMMAND))
+#define GSTD_IS_SCHEDULED_COMMAND_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_SCHEDULED_COMMAND))
+#define GSTD_SCHEDULED_COMMAND_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_SCHEDULED_COMMAND, GstdScheduledCommandClass))
+typedef struct _GstdScheduledCommand GstdScheduledCommand;
+typedef struct _GstdScheduledCommandClass GstdScheduledCommandClass;
+GType gstd_scheduled_command_get_type (void);
+
+/**
+ * GstdScheduleStatus:
+ * @GSTD_SCHEDULE_STATUS_PENDING: Waiting for the deadline
+ * @GSTD_SCHEDULE_STATUS_DONE: The command was executed successfully
+ * @GSTD_SCHEDULE_STATUS_FAILED: The command was executed but failed
+ * @GSTD_SCHEDULE_STATUS_CANCELLED: The deadline was unscheduled before
+ * it was reached
+ *
+ * The progress of a scheduled command.
+ */
+typedef enum
+{
+  GSTD_SCHEDULE_STATUS_PENDING,
+  GSTD_SCHEDULE_STATUS_DONE,
+  GSTD_SCHEDULE_STATUS_FAILED,
+  GSTD_SCHEDULE_STATUS_CANCELLED,
+} GstdScheduleStatus;
+
+#define GSTD_TYPE_SCHEDULE_STATUS (gstd_schedule_status_get_type ())
+GType gstd_schedule_status_get_type (void);
+
+/**
+ * gstd_scheduled_command_new: (constructor)
+ * @name: The name of the scheduled command
+ * @command: The parser command to execute, as sent by a client
+ *
+ * Creates a new command waiting to be scheduled.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdScheduledCommand.
+ * Free after usage using g_object_unref()
+ */
+GstdScheduledCommand *gstd_scheduled_command_new (const gchar * name,
+    const gchar * command);
+
+/**
+ * gstd_scheduled_command_arm:
+ * @object: The scheduled command
+ * @clock: The clock to wait on
+ * @base_time: The @clock time the deadline is relative to
+ * @deadline: The deadline, relative to @base_time
+ * @pipeline_time: Whether @clock is the pipeline clock, as opposed to
+ * the wall clock
+ *
+ * Waits asynchronously on @clock and executes the command from the
+ * main context once @base_time + @deadline is reached.
+ *
+ * Returns: TRUE if the wait was scheduled, FALSE otherwise.
+ */
+gboolean gstd_scheduled_command_arm (GstdScheduledCommand * object,
+    GstClock * clock, GstClockTime base_time, GstClockTime deadline,
+    gboolean pipeline_time);
+
+/**
+ * gstd_scheduled_command_cancel:
+ * @object: The scheduled command
+ *
+ * Unschedules the command if it is still pending.
+ */
+void gstd_scheduled_command_cancel (GstdScheduledCommand * object);
+
+/**
+ * gstd_scheduled_command_run:
+ * @command: The parser command to execute, as sent by a client
+ * @response: (out) (transfer full) (nullable): The response of the
+ * command
+ *
+ * Executes a command on the running session, the way scheduled
+ * commands are once due. Must be called from the main context.
+ *
+ * Returns: A GstdReturnCode with the status of the command.
+ */
+GstdReturnCode gstd_scheduled_command_run (const gchar * command,
+    gchar ** response);
+
+/**
+ * gstd_scheduled_command_is_pipeline_time:
+ * @object: The scheduled command
+ *
+ * Returns: TRUE if the command waits on the pipeline clock, so it
+ * becomes meaningless once the pipeline is torn down.
+ */
+gboolean gstd_scheduled_command_is_pipeline_time (GstdScheduledCommand *
+    object);
+
+G_END_DECLS
+#endif // __GSTD_SCHEDULED_COMMAND_H__
@@ -28,6 +28,16 @@
 #include "gstd_property_reader.h"
 #include "gstd_list_reader.h"
 #include "gstd_pipeline_deleter.h"
+#include "gstd_pipeline_pool.h"
+#include "gstd_pipeline_pool_creator.h"
+#include "gstd_pipeline_pool_deleter.h"
+#include "gstd_sync_group.h"
+#include "gstd_sync_group_creator.h"
+#include "gstd_sync_group_deleter.h"
+#include "gstd_pipeline_link.h"
+#include "gstd_pipeline_link_creator.h"
+#include "gstd_pipeline_link_deleter.h"
+#include "gstd_task_pool.h"
 
 /* Gstd Session debugging category */
 GST_DEBUG_CATEGORY_STATIC (gstd_session_debug);
@@ -40,8 +50,12 @@ GMutex singleton_mutex;
 enum
 {
   PROP_PIPELINES = 1,
+  PROP_POOLS,
+  PROP_GROUPS,
+  PROP_LINKS,
   PROP_PID,
   PROP_DEBUG,
+  PROP_TASK_POOL_SIZE,
   N_PROPERTIES                  // NOT A PROPERTY
 };
 
@@ -106,6 +120,33 @@ gstd_session_class_init (GstdSessionClass * klass)
       G_PARAM_STATIC_STRINGS |
       GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_DELETE);
 
+  properties[PROP_POOLS] =
+      g_param_spec_object ("pools",
+      "Pools",
+      "The pools of warm pipelines created by the user",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE |
+      G_PARAM_STATIC_STRINGS |
+      GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_DELETE);
+
+  properties[PROP_GROUPS] =
+      g_param_spec_object ("groups",
+      "Groups",
+      "The groups of pipelines sharing a clock created by the user",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE |
+      G_PARAM_STATIC_STRINGS |
+      GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_DELETE);
+
+  properties[PROP_LINKS] =
+      g_param_spec_object ("links",
+      "Links",
+      "The buffer links between pipelines created by the user",
+      GSTD_TYPE_LIST,
+      G_PARAM_READABLE |
+      G_PARAM_STATIC_STRINGS |
+      GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_DELETE);
+
   properties[PROP_PID] =
       g_param_spec_int ("pid",
       "PID",
@@ -119,6 +160,17 @@ gstd_session_class_init (GstdSessionClass * klass)
       "The debug object containing debug information",
       GSTD_TYPE_DEBUG, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+  properties[PROP_TASK_POOL_SIZE] =
+      g_param_spec_int ("task-pool-size",
+      "Task Pool Size",
+      "The maximum amount of streaming threads shared among the pipelines "
+      "using the shared task pool, -1 for no limit. Threads are created on "
+      "demand up to it, and state changes needing more fail",
+      -1,
+      G_MAXINT, GSTD_TASK_POOL_DEFAULT_MAX_THREADS,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
   g_object_class_install_properties (object_class, N_PROPERTIES, properties);
 
   /* Initialize debug category with nice colors */
@@ -150,6 +202,51 @@ gstd_session_init (GstdSession * self)
   gstd_object_set_deleter (GSTD_OBJECT (self->pipelines),
       g_object_new (GSTD_TYPE_PIPELINE_DELETER, NULL));
 
+  self->pools =
+      GSTD_LIST (g_object_new (GSTD_TYPE_LIST, "name", "pools", "node-type",
+          GSTD_TYPE_PIPELINE_POOL, "flags",
+          GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_UPDATE |
+          GSTD_PARAM_DELETE, NULL));
+
+  gstd_object_set_creator (GSTD_OBJECT (self->pools),
+      g_object_new (GSTD_TYPE_PIPELINE_POOL_CREATOR, NULL));
+
+  gstd_object_set_reader (GSTD_OBJECT (self->pools),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+
+  gstd_object_set_deleter (GSTD_OBJECT (self->pools),
+      g_object_new (GSTD_TYPE_PIPELINE_POOL_DELETER, NULL));
+
+  self->groups =
+      GSTD_LIST (g_object_new (GSTD_TYPE_LIST, "name", "groups", "node-type",
+          GSTD_TYPE_SYNC_GROUP, "flags",
+          GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_UPDATE |
+          GSTD_PARAM_DELETE, NULL));
+
+  gstd_object_set_creator (GSTD_OBJECT (self->groups),
+      g_object_new (GSTD_TYPE_SYNC_GROUP_CREATOR, NULL));
+
+  gstd_object_set_reader (GSTD_OBJECT (self->groups),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+
+  gstd_object_set_deleter (GSTD_OBJECT (self->groups),
+      g_object_new (GSTD_TYPE_SYNC_GROUP_DELETER, NULL));
+
+  self->links =
+      GSTD_LIST (g_object_new (GSTD_TYPE_LIST, "name", "links", "node-type",
+          GSTD_TYPE_PIPELINE_LINK, "flags",
+          GSTD_PARAM_CREATE | GSTD_PARAM_READ | GSTD_PARAM_UPDATE |
+          GSTD_PARAM_DELETE, NULL));
+
+  gstd_object_set_creator (GSTD_OBJECT (self->links),
+      g_object_new (GSTD_TYPE_PIPELINE_LINK_CREATOR, NULL));
+
+  gstd_object_set_reader (GSTD_OBJECT (self->links),
+      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+
+  gstd_object_set_deleter (GSTD_OBJECT (self->links),
+      g_object_new (GSTD_TYPE_PIPELINE_LINK_DELETER, NULL));
+
   self->debug =
       GSTD_DEBUG (g_object_new (GSTD_TYPE_DEBUG, "name", "Debug", NULL));
 
@@ -161,12 +258,25 @@ gstd_session_get_property (GObject * object,
     guint property_id, GValue * value, GParamSpec * pspec)
 {
   GstdSession *self = GSTD_SESSION (object);
+  GstTaskPool *pool;
 
   switch (property_id) {
     case PROP_PIPELINES:
       GST_DEBUG_OBJECT (self, "Returning pipeline list %p", self->pipelines);
       g_value_set_object (value, self->pipelines);
       break;
+    case PROP_POOLS:
+      GST_DEBUG_OBJECT (self, "Returning pool list %p", self->pools);
+      g_value_set_object (value, self->pools);
+      break;
+    case PROP_GROUPS:
+      GST_DEBUG_OBJECT (self, "Returning group list %p", self->groups);
+      g_value_set_object (value, self->groups);
+      break;
+    case PROP_LINKS:
+      GST_DEBUG_OBJECT (self, "Returning link list %p", self->links);
+      g_value_set_object (value, self->links);
+      break;
     case PROP_PID:
       GST_DEBUG_OBJECT (self, "Returning pid %d", self->pid);
       g_value_set_int (value, self->pid);
@@ -175,6 +285,12 @@ gstd_session_get_property (GObject * object,
       GST_DEBUG_OBJECT (self, "Returning debug object %p", self->debug);
       g_value_set_object (value, self->debug);
       break;
+    case PROP_TASK_POOL_SIZE:
+      pool = gstd_task_pool_get_default ();
+      g_value_set_int (value,
+          gstd_task_pool_get_max_threads (GSTD_TASK_POOL (pool)));
+      gst_object_unref (pool);
+      break;
 
     default:
       /* We don't have any other property... */
@@ -188,6 +304,8 @@ gstd_session_set_property (GObject * object,
     guint property_id, const GValue * value, GParamSpec * pspec)
 {
   GstdSession *self = GSTD_SESSION (object);
+  GstTaskPool *pool;
+  gint max_threads;
 
   switch (property_id) {
     case PROP_PIPELINES:
@@ -198,6 +316,17 @@ gstd_session_set_property (GObject * object,
       self->debug = g_value_dup_object (value);
       GST_DEBUG_OBJECT (self, "Changing debug object to %p", self->debug);
       break;
+    case PROP_TASK_POOL_SIZE:
+      max_threads = g_value_get_int (value);
+      if (0 == max_threads) {
+        GST_WARNING_OBJECT (self, "The task pool needs at least one thread");
+        break;
+      }
+      pool = gstd_task_pool_get_default ();
+      gstd_task_pool_set_max_threads (GSTD_TASK_POOL (pool), max_threads);
+      gst_object_unref (pool);
+      GST_INFO_OBJECT (self, "Changed task pool size to %d", max_threads);
+      break;
 
     default:
       /* We don't have any other property... */
@@ -218,6 +347,21 @@ gstd_session_dispose (GObject * object)
     self->pipelines = NULL;
   }
 
+  if (self->pools) {
+    g_object_unref (self->pools);
+    self->pools = NULL;
+  }
+
+  if (self->groups) {
+    g_object_unref (self->groups);
+    self->groups = NULL;
+  }
+
+  if (self->links) {
+    g_object_unref (self->links);
+    self->links = NULL;
+  }
+
   if (self->debug) {
     g_object_unref (self->debug);
     self->debug = NULL;
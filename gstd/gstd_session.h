@@ -201,6 +201,21 @@ struct _GstdSession
    */
   GstdList *pipelines;
 
+  /**
+   * The pools of warm pipelines created by the user
+   */
+  GstdList *pools;
+
+  /**
+   * The groups of pipelines sharing a clock and base time
+   */
+  GstdList *groups;
+
+  /**
+   * The buffer links between pipelines
+   */
+  GstdList *links;
+
   /*
    * The current process identifier
    */
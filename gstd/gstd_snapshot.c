@@ -0,0 +1,588 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_snapshot.h"
+#include "gstd_snapshot_image.h"
+#include "gstd_snapshot_reader.h"
+
+/* Gstd Snapshot debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_snapshot_debug);
+#define GST_CAT_DEFAULT gstd_snapshot_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+#define GSTD_SNAPSHOT_DEFAULT_TTL 1000
+
+/* Encodings running at once, shared by every snapshot node */
+#define GSTD_SNAPSHOT_WORKERS 2
+
+/* How long an encoding may take before giving up */
+#define GSTD_SNAPSHOT_TIMEOUT (2 * GST_SECOND)
+
+/* Largest width or height an image is scaled to */
+#define GSTD_SNAPSHOT_MAX_SIZE 4096
+
+enum
+{
+  PROP_TTL = 1,
+  PROP_CACHED,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/**
+ * GstdSnapshot:
+ * Encodes the last sample of an element into a still image on
+ * request. Nothing is added to the pipeline, so snapshots cost
+ * nothing while nobody asks for them.
+ */
+struct _GstdSnapshot
+{
+  GstdObject parent;
+
+  GstElement *target;
+
+  guint ttl;
+
+  GMutex lock;
+  GCond cond;
+
+  /**
+   * Images handed out recently, and encodings in progress, by request
+   */
+  GHashTable *cache;
+  GHashTable *pending;
+};
+
+struct _GstdSnapshotClass
+{
+  GstdObjectClass parent_class;
+};
+
+/**
+ * GstdSnapshotJob:
+ * An encoding in progress, shared by every request waiting for it.
+ * The last waiter frees it.
+ */
+typedef struct
+{
+  GstdSnapshot *snapshot;
+  gchar *key;
+  GstSample *sample;
+  GstCaps *caps;
+  const gchar *encoder;
+
+  gboolean done;
+  guint waiters;
+  GstdReturnCode ret;
+  GstdSnapshotImage *image;
+} GstdSnapshotJob;
+
+/* The workers all snapshot nodes encode in */
+static GThreadPool *gstd_snapshot_pool = NULL;
+
+G_DEFINE_TYPE (GstdSnapshot, gstd_snapshot, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_snapshot_set_property (GObject *, guint, const GValue *, GParamSpec *);
+static void
+gstd_snapshot_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_snapshot_dispose (GObject *);
+static void gstd_snapshot_finalize (GObject *);
+static GstdReturnCode gstd_snapshot_parse (GstdSnapshot *, const gchar *,
+    GstdSnapshotJob *);
+static GstdReturnCode gstd_snapshot_last_sample (GstdSnapshot *,
+    GstSample **);
+static void gstd_snapshot_job_free (GstdSnapshotJob *);
+static void gstd_snapshot_encode (gpointer, gpointer);
+static GstdReturnCode gstd_snapshot_run (GstdSnapshotJob *, GstSample **);
+static gboolean gstd_snapshot_is_stale (gpointer, gpointer, gpointer);
+
+static void
+gstd_snapshot_class_init (GstdSnapshotClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_snapshot_set_property;
+  object_class->get_property = gstd_snapshot_get_property;
+  object_class->dispose = gstd_snapshot_dispose;
+  object_class->finalize = gstd_snapshot_finalize;
+
+  properties[PROP_TTL] =
+      g_param_spec_uint ("ttl", "TTL",
+      "Milliseconds an image is handed out again to identical requests",
+      0, G_MAXUINT, GSTD_SNAPSHOT_DEFAULT_TTL,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_CACHED] =
+      g_param_spec_uint ("cached", "Cached",
+      "The amount of images currently cached",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_snapshot_debug, "gstdsnapshot", debug_color,
+      "Gstd Snapshot category");
+
+  gstd_snapshot_pool = g_thread_pool_new (gstd_snapshot_encode, NULL,
+      GSTD_SNAPSHOT_WORKERS, FALSE, NULL);
+}
+
+static void
+gstd_snapshot_init (GstdSnapshot * self)
+{
+  GST_INFO_OBJECT (self, "Initializing snapshot");
+
+  self->target = NULL;
+  self->ttl = GSTD_SNAPSHOT_DEFAULT_TTL;
+
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond);
+
+  self->cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+      g_object_unref);
+  self->pending = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+      NULL);
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_SNAPSHOT_READER, NULL));
+}
+
+GstdSnapshot *
+gstd_snapshot_new (GstElement * target)
+{
+  GstdSnapshot *self;
+
+  g_return_val_if_fail (GST_IS_ELEMENT (target), NULL);
+
+  self = GSTD_SNAPSHOT (g_object_new (GSTD_TYPE_SNAPSHOT, "name", "snapshot",
+          NULL));
+  self->target = gst_object_ref (target);
+
+  return self;
+}
+
+static void
+gstd_snapshot_dispose (GObject * object)
+{
+  GstdSnapshot *self = GSTD_SNAPSHOT (object);
+
+  GST_INFO_OBJECT (self, "Disposing snapshot");
+
+  g_mutex_lock (&self->lock);
+  g_hash_table_remove_all (self->cache);
+  g_mutex_unlock (&self->lock);
+
+  if (self->target) {
+    gst_object_unref (self->target);
+    self->target = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_snapshot_parent_class)->dispose (object);
+}
+
+static void
+gstd_snapshot_finalize (GObject * object)
+{
+  GstdSnapshot *self = GSTD_SNAPSHOT (object);
+
+  g_hash_table_unref (self->cache);
+  g_hash_table_unref (self->pending);
+
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond);
+
+  G_OBJECT_CLASS (gstd_snapshot_parent_class)->finalize (object);
+}
+
+static void
+gstd_snapshot_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdSnapshot *self = GSTD_SNAPSHOT (object);
+
+  switch (property_id) {
+    case PROP_TTL:
+      g_mutex_lock (&self->lock);
+      self->ttl = g_value_get_uint (value);
+      GST_INFO_OBJECT (self, "Images live for %u ms", self->ttl);
+      /* Don't keep handing out images under the old setting */
+      g_hash_table_remove_all (self->cache);
+      g_mutex_unlock (&self->lock);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_snapshot_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdSnapshot *self = GSTD_SNAPSHOT (object);
+
+  g_mutex_lock (&self->lock);
+  switch (property_id) {
+    case PROP_TTL:
+      g_value_set_uint (value, self->ttl);
+      break;
+    case PROP_CACHED:
+      g_value_set_uint (value, g_hash_table_size (self->cache));
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  g_mutex_unlock (&self->lock);
+}
+
+static GstdReturnCode
+gstd_snapshot_parse (GstdSnapshot * self, const gchar * request,
+    GstdSnapshotJob * job)
+{
+  GstStructure *structure;
+  const gchar *format;
+  gchar *description;
+  gint width = 0;
+  gint height = 0;
+
+  /* The request reads as the fields of a structure */
+  description = g_strdup_printf ("snapshot,%s", request);
+  structure = gst_structure_from_string (description, NULL);
+  g_free (description);
+
+  if (!structure) {
+    GST_ERROR_OBJECT (self, "Malformed snapshot request \"%s\", expected "
+        "format=<jpeg|png>[,width=<w>][,height=<h>]", request);
+    return GSTD_BAD_VALUE;
+  }
+
+  format = gst_structure_get_string (structure, "format");
+  if (!format || !g_strcmp0 (format, "jpeg")) {
+    format = "jpeg";
+    job->encoder = "jpegenc";
+  } else if (!g_strcmp0 (format, "png")) {
+    job->encoder = "pngenc";
+  } else {
+    GST_ERROR_OBJECT (self, "Unsupported snapshot format \"%s\"", format);
+    gst_structure_free (structure);
+    return GSTD_BAD_VALUE;
+  }
+
+  gst_structure_get_int (structure, "width", &width);
+  gst_structure_get_int (structure, "height", &height);
+
+  if (width < 0 || height < 0) {
+    GST_ERROR_OBJECT (self, "Invalid snapshot size %dx%d", width, height);
+    gst_structure_free (structure);
+    return GSTD_BAD_VALUE;
+  }
+
+  /* Scaling buffers are allocated from the requested size */
+  if (width > GSTD_SNAPSHOT_MAX_SIZE || height > GSTD_SNAPSHOT_MAX_SIZE) {
+    GST_WARNING_OBJECT (self, "Snapshot size %dx%d clamped to %d", width,
+        height, GSTD_SNAPSHOT_MAX_SIZE);
+    width = MIN (width, GSTD_SNAPSHOT_MAX_SIZE);
+    height = MIN (height, GSTD_SNAPSHOT_MAX_SIZE);
+  }
+
+  job->caps = gst_caps_new_empty_simple ("video/x-raw");
+  if (width) {
+    gst_caps_set_simple (job->caps, "width", G_TYPE_INT, width, NULL);
+  }
+  if (height) {
+    gst_caps_set_simple (job->caps, "height", G_TYPE_INT, height, NULL);
+  }
+
+  /* Equivalent requests share their cache entry */
+  job->key = g_strdup_printf ("format=%s,width=%d,height=%d", format, width,
+      height);
+
+  gst_structure_free (structure);
+
+  return GSTD_EOK;
+}
+
+static GstdReturnCode
+gstd_snapshot_last_sample (GstdSnapshot * self, GstSample ** sample)
+{
+  GstStructure *structure;
+  GstCaps *caps;
+
+  *sample = NULL;
+
+  if (!g_object_class_find_property (G_OBJECT_GET_CLASS (self->target),
+          "last-sample")) {
+    GST_ERROR_OBJECT (self, "\"%s\" doesn't keep its last sample",
+        GST_OBJECT_NAME (self->target));
+    return GSTD_NO_RESOURCE;
+  }
+
+  g_object_get (self->target, "last-sample", sample, NULL);
+  if (!*sample) {
+    GST_ERROR_OBJECT (self, "\"%s\" hasn't rendered anything yet, or has "
+        "enable-last-sample disabled", GST_OBJECT_NAME (self->target));
+    return GSTD_NO_RESOURCE;
+  }
+
+  caps = gst_sample_get_caps (*sample);
+  structure = caps ? gst_caps_get_structure (caps, 0) : NULL;
+  if (!structure || !gst_structure_has_name (structure, "video/x-raw")) {
+    GST_ERROR_OBJECT (self, "Only raw video can be snapshotted, \"%s\" "
+        "renders %" GST_PTR_FORMAT, GST_OBJECT_NAME (self->target), caps);
+    gst_sample_unref (*sample);
+    *sample = NULL;
+    return GSTD_BAD_VALUE;
+  }
+
+  return GSTD_EOK;
+}
+
+static gboolean
+gstd_snapshot_is_stale (gpointer key, gpointer value, gpointer user_data)
+{
+  gint64 *now = user_data;
+
+  return gstd_snapshot_image_is_stale (GSTD_SNAPSHOT_IMAGE (value), *now);
+}
+
+GstdReturnCode
+gstd_snapshot_take (GstdSnapshot * self, const gchar * request,
+    GstdObject ** image)
+{
+  GstdSnapshotJob *job;
+  GstdSnapshotJob *pending;
+  GstdSnapshotImage *cached;
+  GstdReturnCode ret;
+  gint64 now;
+
+  g_return_val_if_fail (GSTD_IS_SNAPSHOT (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (request, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (image, GSTD_NULL_ARGUMENT);
+
+  *image = NULL;
+
+  job = g_new0 (GstdSnapshotJob, 1);
+  ret = gstd_snapshot_parse (self, request, job);
+  if (GSTD_EOK != ret) {
+    gstd_snapshot_job_free (job);
+    return ret;
+  }
+
+  now = g_get_monotonic_time ();
+
+  g_mutex_lock (&self->lock);
+  g_hash_table_foreach_remove (self->cache, gstd_snapshot_is_stale, &now);
+
+  cached = g_hash_table_lookup (self->cache, job->key);
+  if (cached) {
+    GST_DEBUG_OBJECT (self, "Handing out cached %s", job->key);
+    *image = GSTD_OBJECT (g_object_ref (cached));
+    g_mutex_unlock (&self->lock);
+    gstd_snapshot_job_free (job);
+    return GSTD_EOK;
+  }
+
+  pending = g_hash_table_lookup (self->pending, job->key);
+  if (pending) {
+    GST_DEBUG_OBJECT (self, "Waiting for the %s in progress", job->key);
+    gstd_snapshot_job_free (job);
+    job = pending;
+  } else {
+    ret = gstd_snapshot_last_sample (self, &job->sample);
+    if (GSTD_EOK != ret) {
+      g_mutex_unlock (&self->lock);
+      gstd_snapshot_job_free (job);
+      return ret;
+    }
+
+    job->snapshot = g_object_ref (self);
+    g_hash_table_insert (self->pending, g_strdup (job->key), job);
+    g_thread_pool_push (gstd_snapshot_pool, job, NULL);
+  }
+
+  job->waiters++;
+  while (!job->done) {
+    g_cond_wait (&self->cond, &self->lock);
+  }
+
+  ret = job->ret;
+  if (job->image) {
+    *image = GSTD_OBJECT (g_object_ref (job->image));
+  }
+
+  job->waiters--;
+  if (0 == job->waiters) {
+    gstd_snapshot_job_free (job);
+  }
+  g_mutex_unlock (&self->lock);
+
+  return ret;
+}
+
+static void
+gstd_snapshot_job_free (GstdSnapshotJob * job)
+{
+  if (job->snapshot) {
+    g_object_unref (job->snapshot);
+  }
+  if (job->sample) {
+    gst_sample_unref (job->sample);
+  }
+  if (job->caps) {
+    gst_caps_unref (job->caps);
+  }
+  if (job->image) {
+    g_object_unref (job->image);
+  }
+  g_free (job->key);
+  g_free (job);
+}
+
+static void
+gstd_snapshot_encode (gpointer data, gpointer user_data)
+{
+  GstdSnapshotJob *job = data;
+  GstdSnapshot *self = job->snapshot;
+  GstdSnapshotImage *image = NULL;
+  GstSample *encoded = NULL;
+  GstBuffer *buffer;
+  GstdReturnCode ret;
+  gint64 expiration;
+
+  ret = gstd_snapshot_run (job, &encoded);
+
+  if (GSTD_EOK == ret) {
+    buffer = gst_sample_get_buffer (job->sample);
+
+    g_mutex_lock (&self->lock);
+    expiration = g_get_monotonic_time () + self->ttl * G_TIME_SPAN_MILLISECOND;
+    g_mutex_unlock (&self->lock);
+
+    image = gstd_snapshot_image_new (job->key, encoded,
+        buffer ? GST_BUFFER_PTS (buffer) : GST_CLOCK_TIME_NONE, expiration);
+    gst_sample_unref (encoded);
+
+    if (!image) {
+      ret = GSTD_BAD_VALUE;
+    }
+  }
+
+  g_mutex_lock (&self->lock);
+  job->ret = ret;
+  job->image = image;
+  job->done = TRUE;
+  if (image) {
+    g_hash_table_replace (self->cache, g_strdup (job->key),
+        g_object_ref (image));
+  }
+  g_hash_table_remove (self->pending, job->key);
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->lock);
+}
+
+static GstdReturnCode
+gstd_snapshot_run (GstdSnapshotJob * job, GstSample ** encoded)
+{
+  GstdSnapshot *self = job->snapshot;
+  GstElement *pipeline;
+  GstElement *src;
+  GstElement *filter;
+  GstElement *sink;
+  GstFlowReturn flow;
+  GstMessage *message;
+  GstBus *bus;
+  GError *error = NULL;
+  gchar *description;
+  GstdReturnCode ret;
+
+  *encoded = NULL;
+
+  description = g_strdup_printf ("appsrc name=src format=time ! videoconvert "
+      "! videoscale ! capsfilter name=filter ! %s ! appsink name=sink "
+      "sync=false", job->encoder);
+  pipeline = gst_parse_launch (description, &error);
+  g_free (description);
+
+  if (!pipeline || error) {
+    GST_ERROR_OBJECT (self, "Unable to build the %s encoder: %s",
+        job->encoder, error ? error->message : "unknown error");
+    g_clear_error (&error);
+    if (pipeline) {
+      gst_object_unref (pipeline);
+    }
+    return GSTD_BAD_DESCRIPTION;
+  }
+
+  src = gst_bin_get_by_name (GST_BIN (pipeline), "src");
+  filter = gst_bin_get_by_name (GST_BIN (pipeline), "filter");
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+
+  g_object_set (src, "caps", gst_sample_get_caps (job->sample), NULL);
+  g_object_set (filter, "caps", job->caps, NULL);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  g_signal_emit_by_name (src, "push-sample", job->sample, &flow);
+  g_signal_emit_by_name (src, "end-of-stream", &flow);
+
+  bus = gst_element_get_bus (pipeline);
+  message = gst_bus_timed_pop_filtered (bus, GSTD_SNAPSHOT_TIMEOUT,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  gst_object_unref (bus);
+
+  if (!message) {
+    GST_ERROR_OBJECT (self, "Timed out encoding %s", job->key);
+    ret = GSTD_STATE_ERROR;
+  } else if (GST_MESSAGE_ERROR == GST_MESSAGE_TYPE (message)) {
+    gst_message_parse_error (message, &error, NULL);
+    GST_ERROR_OBJECT (self, "Unable to encode %s: %s", job->key,
+        error->message);
+    g_clear_error (&error);
+    ret = GSTD_BAD_VALUE;
+  } else {
+    /* The encoded image waits in the sink past the EOS */
+    g_signal_emit_by_name (sink, "pull-sample", encoded);
+    ret = *encoded ? GSTD_EOK : GSTD_BAD_VALUE;
+  }
+
+  if (message) {
+    gst_message_unref (message);
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (src);
+  gst_object_unref (filter);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  return ret;
+}
@@ -0,0 +1,80 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_SNAPSHOT_H__
+#define __GSTD_SNAPSHOT_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_SNAPSHOT \
+  (gstd_snapshot_get_type())
+#define GSTD_SNAPSHOT(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_SNAPSHOT,GstdSnapshot))
+#define GSTD_SNAPSHOT_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_SNAPSHOT,GstdSnapshotClass))
+#define GSTD_IS_SNAPSHOT(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_SNAPSHOT))
+#define GSTD_IS_SNAPSHOT_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_SNAPSHOT))
+#define GSTD_SNAPSHOT_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_SNAPSHOT, GstdSnapshotClass))
+typedef struct _GstdSnapshot GstdSnapshot;
+typedef struct _GstdSnapshotClass GstdSnapshotClass;
+GType gstd_snapshot_get_type (void);
+
+/**
+ * gstd_snapshot_new: (constructor)
+ * @target: The element whose last sample is snapshotted
+ *
+ * Creates the snapshot node of an element. Nothing is done until a
+ * snapshot is requested.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdSnapshot.
+ * Free after usage using g_object_unref()
+ */
+GstdSnapshot *gstd_snapshot_new (GstElement * target);
+
+/**
+ * gstd_snapshot_take:
+ * @object: The snapshot node
+ * @request: The image to produce, as in "format=jpeg,width=320". The
+ * format may be jpeg or png, the width and height default to the ones
+ * of the frame, preserving the aspect ratio if only one is given.
+ * Sizes over 4096 are clamped.
+ * @image: (out) (transfer full): The encoded image
+ *
+ * Encodes the last sample of the element on the shared snapshot
+ * workers, unless the same request was answered within the time to
+ * live of the node. Concurrent identical requests share the same
+ * encoding.
+ *
+ * Returns: A GstdReturnCode with the status of the operation.
+ */
+GstdReturnCode gstd_snapshot_take (GstdSnapshot * object,
+    const gchar * request, GstdObject ** image);
+
+G_END_DECLS
+#endif // __GSTD_SNAPSHOT_H__
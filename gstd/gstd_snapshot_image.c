@@ -0,0 +1,236 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_snapshot_image.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Snapshot Image debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_snapshot_image_debug);
+#define GST_CAT_DEFAULT gstd_snapshot_image_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+enum
+{
+  PROP_MIME = 1,
+  PROP_WIDTH,
+  PROP_HEIGHT,
+  PROP_PTS,
+  PROP_SIZE,
+  PROP_DATA,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/**
+ * GstdSnapshotImage:
+ * An encoded snapshot of a frame, as handed out to clients
+ */
+struct _GstdSnapshotImage
+{
+  GstdObject parent;
+
+  gchar *mime;
+  gint width;
+  gint height;
+  GstClockTime pts;
+  guint size;
+
+  /**
+   * The encoded image, in base64 so that it fits in the response
+   */
+  gchar *data;
+
+  gint64 expiration;
+};
+
+struct _GstdSnapshotImageClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdSnapshotImage, gstd_snapshot_image, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_snapshot_image_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_snapshot_image_finalize (GObject *);
+
+static void
+gstd_snapshot_image_class_init (GstdSnapshotImageClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->get_property = gstd_snapshot_image_get_property;
+  object_class->finalize = gstd_snapshot_image_finalize;
+
+  properties[PROP_MIME] =
+      g_param_spec_string ("mime", "Mime",
+      "The media type of the encoded image",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_WIDTH] =
+      g_param_spec_int ("width", "Width",
+      "The width of the image in pixels",
+      0, G_MAXINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_HEIGHT] =
+      g_param_spec_int ("height", "Height",
+      "The height of the image in pixels",
+      0, G_MAXINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_PTS] =
+      g_param_spec_uint64 ("pts", "PTS",
+      "The timestamp of the frame the image was taken from",
+      0, G_MAXUINT64, GST_CLOCK_TIME_NONE,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_SIZE] =
+      g_param_spec_uint ("size", "Size",
+      "The size of the encoded image in bytes",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_DATA] =
+      g_param_spec_string ("data", "Data",
+      "The encoded image in base64",
+      NULL, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_snapshot_image_debug, "gstdsnapshotimage",
+      debug_color, "Gstd Snapshot Image category");
+}
+
+static void
+gstd_snapshot_image_init (GstdSnapshotImage * self)
+{
+  GST_INFO_OBJECT (self, "Initializing snapshot image");
+
+  self->mime = NULL;
+  self->width = 0;
+  self->height = 0;
+  self->pts = GST_CLOCK_TIME_NONE;
+  self->size = 0;
+  self->data = NULL;
+  self->expiration = 0;
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+GstdSnapshotImage *
+gstd_snapshot_image_new (const gchar * name, GstSample * sample,
+    GstClockTime pts, gint64 expiration)
+{
+  GstdSnapshotImage *self;
+  GstStructure *structure;
+  GstBuffer *buffer;
+  GstCaps *caps;
+  GstMapInfo map;
+
+  g_return_val_if_fail (name, NULL);
+  g_return_val_if_fail (GST_IS_SAMPLE (sample), NULL);
+
+  buffer = gst_sample_get_buffer (sample);
+  caps = gst_sample_get_caps (sample);
+  g_return_val_if_fail (buffer, NULL);
+  g_return_val_if_fail (caps, NULL);
+
+  if (!gst_buffer_map (buffer, &map, GST_MAP_READ)) {
+    GST_ERROR ("Unable to map the encoded image");
+    return NULL;
+  }
+
+  self = GSTD_SNAPSHOT_IMAGE (g_object_new (GSTD_TYPE_SNAPSHOT_IMAGE, "name",
+          name, NULL));
+
+  structure = gst_caps_get_structure (caps, 0);
+  self->mime = g_strdup (gst_structure_get_name (structure));
+  gst_structure_get_int (structure, "width", &self->width);
+  gst_structure_get_int (structure, "height", &self->height);
+  self->pts = pts;
+  self->size = map.size;
+  self->data = g_base64_encode (map.data, map.size);
+  self->expiration = expiration;
+
+  gst_buffer_unmap (buffer, &map);
+
+  return self;
+}
+
+static void
+gstd_snapshot_image_finalize (GObject * object)
+{
+  GstdSnapshotImage *self = GSTD_SNAPSHOT_IMAGE (object);
+
+  g_free (self->mime);
+  g_free (self->data);
+
+  G_OBJECT_CLASS (gstd_snapshot_image_parent_class)->finalize (object);
+}
+
+static void
+gstd_snapshot_image_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdSnapshotImage *self = GSTD_SNAPSHOT_IMAGE (object);
+
+  switch (property_id) {
+    case PROP_MIME:
+      g_value_set_string (value, self->mime);
+      break;
+    case PROP_WIDTH:
+      g_value_set_int (value, self->width);
+      break;
+    case PROP_HEIGHT:
+      g_value_set_int (value, self->height);
+      break;
+    case PROP_PTS:
+      g_value_set_uint64 (value, self->pts);
+      break;
+    case PROP_SIZE:
+      g_value_set_uint (value, self->size);
+      break;
+    case PROP_DATA:
+      g_value_set_string (value, self->data);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+gboolean
+gstd_snapshot_image_is_stale (GstdSnapshotImage * self, gint64 now)
+{
+  g_return_val_if_fail (GSTD_IS_SNAPSHOT_IMAGE (self), TRUE);
+
+  return now >= self->expiration;
+}
@@ -0,0 +1,74 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_SNAPSHOT_IMAGE_H__
+#define __GSTD_SNAPSHOT_IMAGE_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_SNAPSHOT_IMAGE \
+  (gstd_snapshot_image_get_type())
+#define GSTD_SNAPSHOT_IMAGE(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_SNAPSHOT_IMAGE,GstdSnapshotImage))
+#define GSTD_SNAPSHOT_IMAGE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_SNAPSHOT_IMAGE,GstdSnapshotImageClass))
+#define GSTD_IS_SNAPSHOT_IMAGE(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_SNAPSHOT_IMAGE))
+#define GSTD_IS_SNAPSHOT_IMAGE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_SNAPSHOT_IMAGE))
+#define GSTD_SNAPSHOT_IMAGE_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_SNAPSHOT_IMAGE, GstdSnapshotImageClass))
+typedef struct _GstdSnapshotImage GstdSnapshotImage;
+typedef struct _GstdSnapshotImageClass GstdSnapshotImageClass;
+GType gstd_snapshot_image_get_type (void);
+
+/**
+ * gstd_snapshot_image_new: (constructor)
+ * @name: The request the image answers, as in "format=jpeg,width=320"
+ * @sample: The encoded image
+ * @pts: The timestamp of the frame the image was taken from
+ * @expiration: Monotonic time after which the image is stale
+ *
+ * Creates a new image holding an encoded snapshot of a frame.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdSnapshotImage.
+ * Free after usage using g_object_unref()
+ */
+GstdSnapshotImage *gstd_snapshot_image_new (const gchar * name,
+    GstSample * sample, GstClockTime pts, gint64 expiration);
+
+/**
+ * gstd_snapshot_image_is_stale:
+ * @object: The image
+ * @now: The current monotonic time
+ *
+ * Returns: Whether the image outlived its time to live.
+ */
+gboolean gstd_snapshot_image_is_stale (GstdSnapshotImage * object,
+    gint64 now);
+
+G_END_DECLS
+#endif // __GSTD_SNAPSHOT_IMAGE_H__
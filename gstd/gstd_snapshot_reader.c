@@ -0,0 +1,109 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+
+#include "gstd_ireader.h"
+#include "gstd_snapshot_reader.h"
+#include "gstd_snapshot.h"
+#include "gstd_property_reader.h"
+
+/* Gstd Core debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_snapshot_reader_debug);
+#define GST_CAT_DEFAULT gstd_snapshot_reader_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+static GstdReturnCode
+gstd_snapshot_reader_read (GstdIReader * iface, GstdObject * object,
+    const gchar * name, GstdObject ** out);
+
+typedef struct _GstdSnapshotReaderClass GstdSnapshotReaderClass;
+
+/**
+ * GstdSnapshotReader:
+ * Reads the properties of a snapshot node, and treats any other name
+ * as a snapshot request
+ */
+struct _GstdSnapshotReader
+{
+  GObject parent;
+};
+
+struct _GstdSnapshotReaderClass
+{
+  GObjectClass parent_class;
+};
+
+
+static void
+gstd_ireader_interface_init (GstdIReaderInterface * iface)
+{
+  iface->read = gstd_snapshot_reader_read;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GstdSnapshotReader, gstd_snapshot_reader,
+    G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE (GSTD_TYPE_IREADER,
+        gstd_ireader_interface_init));
+
+static void
+gstd_snapshot_reader_class_init (GstdSnapshotReaderClass * klass)
+{
+  guint debug_color;
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_snapshot_reader_debug, "gstdsnapshotreader",
+      debug_color, "Gstd Snapshot Reader category");
+}
+
+static void
+gstd_snapshot_reader_init (GstdSnapshotReader * self)
+{
+  GST_INFO_OBJECT (self, "Initializing snapshot reader");
+}
+
+static GstdReturnCode
+gstd_snapshot_reader_read (GstdIReader * iface, GstdObject * object,
+    const gchar * name, GstdObject ** out)
+{
+  GstdIReader *reader;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_SNAPSHOT (object), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (name, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (out, GSTD_NULL_ARGUMENT);
+
+  *out = NULL;
+
+  if (!g_object_class_find_property (G_OBJECT_GET_CLASS (object), name)) {
+    return gstd_snapshot_take (GSTD_SNAPSHOT (object), name, out);
+  }
+
+  reader = GSTD_IREADER (g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+  ret = gstd_ireader_read (reader, object, name, out);
+  g_object_unref (reader);
+
+  return ret;
+}
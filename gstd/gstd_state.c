@@ -24,6 +24,7 @@
 
 #include <gst/gst.h>
 #include "gstd_state.h"
+#include "gstd_task_pool.h"
 
 enum
 {
@@ -185,6 +186,7 @@ gstd_state_update (GstdObject * object, const gchar * sstate)
   GstStateChangeReturn gstret;
   GValue value = G_VALUE_INIT;
   GstState state;
+  GError *refusal;
 
   g_return_val_if_fail (object, GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (sstate, GSTD_NULL_ARGUMENT);
@@ -200,7 +202,21 @@ gstd_state_update (GstdObject * object, const gchar * sstate)
   state = g_value_get_enum (&value);
   g_value_unset (&value);
 
+  /* Forget refusals of previous state changes from this thread */
+  refusal = gstd_task_pool_take_refusal ();
+  g_clear_error (&refusal);
+
   gstret = gst_element_set_state (self->target, state);
+
+  /* The shared pool ran out of threads for the streaming tasks */
+  refusal = gstd_task_pool_take_refusal ();
+  if (refusal) {
+    GST_ERROR_OBJECT (self, "Failed to change the state of the pipeline: %s",
+        refusal->message);
+    g_error_free (refusal);
+    return GSTD_NO_THREADS;
+  }
+
   if (GST_STATE_CHANGE_FAILURE == gstret) {
     GST_ERROR_OBJECT (self, "Failed to change the state of the pipeline");
     return GSTD_STATE_ERROR;
@@ -0,0 +1,460 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "gstd_sync_group.h"
+#include "gstd_pipeline.h"
+#include "gstd_property_reader.h"
+#include "gstd_session.h"
+
+/* Gstd Sync Group debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_sync_group_debug);
+#define GST_CAT_DEFAULT gstd_sync_group_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+enum
+{
+  PROP_PIPELINES = 1,
+  PROP_DELAY,
+  PROP_BASE_TIME,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+#define GSTD_SYNC_GROUP_DEFAULT_PIPELINES NULL
+#define GSTD_SYNC_GROUP_DEFAULT_DELAY 200
+
+/**
+ * GstdSyncGroup:
+ * A set of pipelines that share a single clock and base time, so that
+ * their running times match and they start rendering at the same
+ * instant. The group is driven as a whole with:
+ *
+ *   update /groups/<name> play
+ *   update /groups/<name> stop
+ *
+ * On play the system clock is distributed to every pipeline along with
+ * a base time a delay ahead of now, giving all of them room to reach
+ * PLAYING before the first buffer is due. Playing again restarts the
+ * running time of the whole group from a fresh base time, pipelines
+ * already playing go through PAUSED to pick it up. A pipeline stopped
+ * on its own goes back to its own clock until the group plays again.
+ */
+struct _GstdSyncGroup
+{
+  GstdObject parent;
+
+  /**
+   * Comma separated names of the grouped pipelines
+   */
+  gchar *pipelines;
+
+  /**
+   * The names split for convenience
+   */
+  gchar **names;
+
+  /**
+   * Milliseconds between the play command and the common base time
+   */
+  guint delay;
+
+  /**
+   * The base time distributed on the last play, or
+   * GST_CLOCK_TIME_NONE if stopped
+   */
+  GstClockTime base_time;
+};
+
+struct _GstdSyncGroupClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdSyncGroup, gstd_sync_group, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_sync_group_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void
+gstd_sync_group_set_property (GObject *, guint, const GValue *, GParamSpec *);
+static void gstd_sync_group_finalize (GObject *);
+static GstdReturnCode gstd_sync_group_update (GstdObject *, const gchar *);
+static GstdReturnCode gstd_sync_group_lookup (GstdSyncGroup *, GList **);
+static GstdReturnCode gstd_sync_group_play (GstdSyncGroup *);
+static GstdReturnCode gstd_sync_group_stop (GstdSyncGroup *);
+static GstdReturnCode gstd_sync_group_set_state (GstdSyncGroup *,
+    GstdPipeline *, GstState);
+
+static void
+gstd_sync_group_class_init (GstdSyncGroupClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GstdObjectClass *gstdc = GSTD_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_sync_group_set_property;
+  object_class->get_property = gstd_sync_group_get_property;
+  object_class->finalize = gstd_sync_group_finalize;
+
+  properties[PROP_PIPELINES] =
+      g_param_spec_string ("pipelines",
+      "Pipelines",
+      "Comma separated names of the pipelines in the group",
+      GSTD_SYNC_GROUP_DEFAULT_PIPELINES,
+      G_PARAM_CONSTRUCT_ONLY |
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_DELAY] =
+      g_param_spec_uint ("delay",
+      "Delay",
+      "Milliseconds from the play command to the common base time",
+      0, G_MAXUINT, GSTD_SYNC_GROUP_DEFAULT_DELAY,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_BASE_TIME] =
+      g_param_spec_uint64 ("base-time",
+      "Base Time",
+      "The base time shared by the pipelines, -1 if the group is stopped",
+      0, G_MAXUINT64, GST_CLOCK_TIME_NONE,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  gstdc->update = GST_DEBUG_FUNCPTR (gstd_sync_group_update);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_sync_group_debug, "gstdsyncgroup",
+      debug_color, "Gstd Sync Group category");
+}
+
+static void
+gstd_sync_group_init (GstdSyncGroup * self)
+{
+  GST_INFO_OBJECT (self, "Initializing sync group");
+
+  self->pipelines = GSTD_SYNC_GROUP_DEFAULT_PIPELINES;
+  self->names = NULL;
+  self->delay = GSTD_SYNC_GROUP_DEFAULT_DELAY;
+  self->base_time = GST_CLOCK_TIME_NONE;
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+}
+
+static void
+gstd_sync_group_finalize (GObject * object)
+{
+  GstdSyncGroup *self = GSTD_SYNC_GROUP (object);
+
+  GST_DEBUG_OBJECT (self, "Finalizing sync group");
+
+  g_free (self->pipelines);
+  g_strfreev (self->names);
+
+  G_OBJECT_CLASS (gstd_sync_group_parent_class)->finalize (object);
+}
+
+static void
+gstd_sync_group_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdSyncGroup *self = GSTD_SYNC_GROUP (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (property_id) {
+    case PROP_PIPELINES:
+      g_value_set_string (value, self->pipelines);
+      break;
+    case PROP_DELAY:
+      g_value_set_uint (value, self->delay);
+      break;
+    case PROP_BASE_TIME:
+      g_value_set_uint64 (value, self->base_time);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gstd_sync_group_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdSyncGroup *self = GSTD_SYNC_GROUP (object);
+
+  switch (property_id) {
+    case PROP_PIPELINES:
+      g_free (self->pipelines);
+      g_strfreev (self->names);
+      self->pipelines = g_value_dup_string (value);
+      self->names = NULL;
+      if (self->pipelines) {
+        self->names = g_strsplit (self->pipelines, ",", -1);
+      }
+      GST_INFO_OBJECT (self, "Changed pipelines to \"%s\"", self->pipelines);
+      break;
+    case PROP_DELAY:
+      GST_OBJECT_LOCK (self);
+      self->delay = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (self);
+      GST_INFO_OBJECT (self, "Changed delay to %u ms", self->delay);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+GstdReturnCode
+gstd_sync_group_build (GstdSyncGroup * object)
+{
+  GstdSyncGroup *self = object;
+  GstdReturnCode ret;
+  GList *pipelines;
+
+  g_return_val_if_fail (GSTD_IS_SYNC_GROUP (self), GSTD_NULL_ARGUMENT);
+
+  if (!self->names || !self->names[0]) {
+    GST_ERROR_OBJECT (self, "No pipelines to group");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  ret = gstd_sync_group_lookup (self, &pipelines);
+  g_list_free_full (pipelines, g_object_unref);
+
+  return ret;
+}
+
+void
+gstd_sync_group_release (GstdSyncGroup * object)
+{
+  GstdSyncGroup *self = object;
+  GstdSession *session;
+  GstdObject *pipeline;
+  gchar **name;
+  gchar *uri;
+
+  g_return_if_fail (GSTD_IS_SYNC_GROUP (self));
+
+  session = GSTD_SESSION (g_object_new (GSTD_TYPE_SESSION, NULL));
+
+  /* Pipelines deleted in the meantime are simply skipped */
+  for (name = self->names; name && *name; name++) {
+    uri = g_strdup_printf ("/pipelines/%s", *name);
+    if (GSTD_EOK == gstd_get_by_uri (session, uri, &pipeline)) {
+      gstd_pipeline_set_sync (GSTD_PIPELINE (pipeline), NULL, 0);
+      g_object_unref (pipeline);
+    }
+    g_free (uri);
+  }
+
+  g_object_unref (session);
+
+  GST_OBJECT_LOCK (self);
+  self->base_time = GST_CLOCK_TIME_NONE;
+  GST_OBJECT_UNLOCK (self);
+}
+
+static GstdReturnCode
+gstd_sync_group_update (GstdObject * object, const gchar * value)
+{
+  GstdSyncGroup *self = GSTD_SYNC_GROUP (object);
+
+  g_return_val_if_fail (value, GSTD_NULL_ARGUMENT);
+
+  if (!g_ascii_strcasecmp (value, "play")) {
+    return gstd_sync_group_play (self);
+  } else if (!g_ascii_strcasecmp (value, "stop")) {
+    return gstd_sync_group_stop (self);
+  }
+
+  GST_ERROR_OBJECT (self, "Unknown group action \"%s\", expected play or "
+      "stop", value);
+  return GSTD_BAD_VALUE;
+}
+
+static GstdReturnCode
+gstd_sync_group_lookup (GstdSyncGroup * self, GList ** pipelines)
+{
+  GstdSession *session;
+  GstdObject *pipeline;
+  GstdReturnCode ret;
+  gchar **name;
+  gchar *uri;
+
+  *pipelines = NULL;
+  ret = GSTD_EOK;
+
+  session = GSTD_SESSION (g_object_new (GSTD_TYPE_SESSION, NULL));
+
+  for (name = self->names; name && *name; name++) {
+    uri = g_strdup_printf ("/pipelines/%s", *name);
+    ret = gstd_get_by_uri (session, uri, &pipeline);
+    g_free (uri);
+
+    if (GSTD_EOK != ret || !GSTD_IS_PIPELINE (pipeline)) {
+      GST_ERROR_OBJECT (self, "Pipeline \"%s\" doesn't exist", *name);
+      if (GSTD_EOK == ret) {
+        g_object_unref (pipeline);
+      }
+      ret = GSTD_NO_RESOURCE;
+      break;
+    }
+
+    *pipelines = g_list_append (*pipelines, pipeline);
+  }
+
+  g_object_unref (session);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_sync_group_set_state (GstdSyncGroup * self, GstdPipeline * pipeline,
+    GstState target)
+{
+  GstdObject *state;
+  GstdReturnCode ret;
+
+  ret = gstd_object_read (GSTD_OBJECT (pipeline), "state", &state);
+  if (ret) {
+    return ret;
+  }
+
+  ret = gstd_object_update (state, gst_element_state_get_name (target));
+  g_object_unref (state);
+
+  if (ret) {
+    GST_ERROR_OBJECT (self, "Unable to set \"%s\" to %s",
+        GSTD_OBJECT_NAME (pipeline), gst_element_state_get_name (target));
+  }
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_sync_group_play (GstdSyncGroup * self)
+{
+  GstdReturnCode ret;
+  GstClock *clock;
+  GstClockTime base_time;
+  GList *pipelines;
+  GList *iter;
+
+  ret = gstd_sync_group_lookup (self, &pipelines);
+  if (ret) {
+    goto out;
+  }
+
+  /* Bins only hand the base time to their elements on PAUSED to
+     PLAYING, so pipelines already playing are paused first. For the
+     others PAUSED is on the way to PLAYING anyway. */
+  for (iter = pipelines; iter; iter = iter->next) {
+    ret = gstd_sync_group_set_state (self, GSTD_PIPELINE (iter->data),
+        GST_STATE_PAUSED);
+    if (ret) {
+      goto out;
+    }
+  }
+
+  /* The system clock is shared by all the pipelines in the process,
+     which is what keeps their running times aligned */
+  clock = gst_system_clock_obtain ();
+
+  GST_OBJECT_LOCK (self);
+  base_time = gst_clock_get_time (clock) + self->delay * GST_MSECOND;
+  GST_OBJECT_UNLOCK (self);
+
+  /* Distribute the clock to everyone before any pipeline starts */
+  for (iter = pipelines; iter; iter = iter->next) {
+    ret = gstd_pipeline_set_sync (GSTD_PIPELINE (iter->data), clock,
+        base_time);
+    if (ret) {
+      goto release;
+    }
+  }
+
+  for (iter = pipelines; iter; iter = iter->next) {
+    ret = gstd_sync_group_set_state (self, GSTD_PIPELINE (iter->data),
+        GST_STATE_PLAYING);
+    if (ret) {
+      goto release;
+    }
+  }
+
+  if (gst_clock_get_time (clock) > base_time) {
+    GST_WARNING_OBJECT (self, "The group reached PLAYING after its base "
+        "time, consider increasing the delay");
+  }
+
+  GST_INFO_OBJECT (self, "Playing group with base time %" GST_TIME_FORMAT,
+      GST_TIME_ARGS (base_time));
+
+  GST_OBJECT_LOCK (self);
+  self->base_time = base_time;
+  GST_OBJECT_UNLOCK (self);
+
+release:
+  gst_object_unref (clock);
+out:
+  g_list_free_full (pipelines, g_object_unref);
+  return ret;
+}
+
+static GstdReturnCode
+gstd_sync_group_stop (GstdSyncGroup * self)
+{
+  GstdReturnCode ret;
+  GstdReturnCode last;
+  GList *pipelines;
+  GList *iter;
+
+  ret = gstd_sync_group_lookup (self, &pipelines);
+  if (ret) {
+    goto out;
+  }
+
+  /* Stop everyone even if one of them fails, and report the failure */
+  for (iter = pipelines; iter; iter = iter->next) {
+    last = gstd_sync_group_set_state (self, GSTD_PIPELINE (iter->data),
+        GST_STATE_NULL);
+    if (last) {
+      ret = last;
+    }
+  }
+
+  gstd_sync_group_release (self);
+
+out:
+  g_list_free_full (pipelines, g_object_unref);
+  return ret;
+}
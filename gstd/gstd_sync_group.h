@@ -0,0 +1,68 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_SYNC_GROUP_H__
+#define __GSTD_SYNC_GROUP_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_SYNC_GROUP \
+  (gstd_sync_group_get_type())
+#define GSTD_SYNC_GROUP(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_SYNC_GROUP,GstdSyncGroup))
+#define GSTD_SYNC_GROUP_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_SYNC_GROUP,GstdSyncGroupClass))
+#define GSTD_IS_SYNC_GROUP(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_SYNC_GROUP))
+#define GSTD_IS_SYNC_GROUP_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_SYNC_GROUP))
+#define GSTD_SYNC_GROUP_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_SYNC_GROUP, GstdSyncGroupClass))
+typedef struct _GstdSyncGroup GstdSyncGroup;
+typedef struct _GstdSyncGroupClass GstdSyncGroupClass;
+GType gstd_sync_group_get_type (void);
+
+/**
+ * gstd_sync_group_build:
+ * @object: The group to validate
+ *
+ * Checks that every pipeline in the group exists in the session.
+ *
+ * Returns: A GstdReturnCode with the build status.
+ */
+GstdReturnCode gstd_sync_group_build (GstdSyncGroup * object);
+
+/**
+ * gstd_sync_group_release:
+ * @object: The group to release
+ *
+ * Hands the pipelines that still exist back to their own clock and
+ * base time selection, typically before the group is deleted.
+ */
+void gstd_sync_group_release (GstdSyncGroup * object);
+
+G_END_DECLS
+#endif // __GSTD_SYNC_GROUP_H__
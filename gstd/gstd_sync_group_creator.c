@@ -0,0 +1,105 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_sync_group_creator.h"
+#include "gstd_sync_group.h"
+
+/* Gstd Core debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_sync_group_creator_debug);
+#define GST_CAT_DEFAULT gstd_sync_group_creator_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+static GstdReturnCode gstd_sync_group_creator_create (GstdICreator * iface,
+    const gchar * name, const gchar * description, GstdObject ** out);
+
+typedef struct _GstdSyncGroupCreatorClass GstdSyncGroupCreatorClass;
+
+/**
+ * GstdSyncGroupCreator:
+ * A creator for groups of synchronized pipelines
+ */
+struct _GstdSyncGroupCreator
+{
+  GObject parent;
+};
+
+struct _GstdSyncGroupCreatorClass
+{
+  GObjectClass parent_class;
+};
+
+
+static void
+gstd_icreator_interface_init (GstdICreatorInterface * iface)
+{
+  iface->create = gstd_sync_group_creator_create;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GstdSyncGroupCreator, gstd_sync_group_creator,
+    G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE (GSTD_TYPE_ICREATOR,
+        gstd_icreator_interface_init));
+
+static void
+gstd_sync_group_creator_class_init (GstdSyncGroupCreatorClass * klass)
+{
+  guint debug_color;
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_sync_group_creator_debug,
+      "gstdsyncgroupcreator", debug_color,
+      "Gstd Sync Group Creator category");
+}
+
+static void
+gstd_sync_group_creator_init (GstdSyncGroupCreator * self)
+{
+  GST_INFO_OBJECT (self, "Initializing sync group creator");
+}
+
+static GstdReturnCode
+gstd_sync_group_creator_create (GstdICreator * iface, const gchar * name,
+    const gchar * description, GstdObject ** out)
+{
+  GstdSyncGroup *group;
+  *out = NULL;
+
+  g_return_val_if_fail (iface, GSTD_NULL_ARGUMENT);
+
+  if (NULL == name) {
+    GST_ERROR_OBJECT (iface, "Group name not provided");
+    return GSTD_MISSING_NAME;
+  }
+
+  if (NULL == description) {
+    GST_ERROR_OBJECT (iface, "Group pipelines not provided");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  group = g_object_new (GSTD_TYPE_SYNC_GROUP, "name", name, "pipelines",
+      description, NULL);
+  *out = GSTD_OBJECT (group);
+
+  return gstd_sync_group_build (group);
+}
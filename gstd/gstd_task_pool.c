@@ -0,0 +1,275 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_task_pool.h"
+
+/* Gstd Task Pool debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_task_pool_debug);
+#define GST_CAT_DEFAULT gstd_task_pool_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+typedef struct _GstdTaskPoolJob GstdTaskPoolJob;
+
+/**
+ * GstdTaskPool:
+ * A bounded GstTaskPool that reuses its threads among every pipeline
+ * that opts in
+ */
+struct _GstdTaskPool
+{
+  GstTaskPool parent;
+
+  /**
+   * The maximum amount of threads, -1 for no limit
+   */
+  gint max_threads;
+
+  /**
+   * The amount of tasks pushed and not yet finished
+   */
+  gint busy;
+};
+
+struct _GstdTaskPoolClass
+{
+  GstTaskPoolClass parent_class;
+};
+
+struct _GstdTaskPoolJob
+{
+  GstTaskPoolFunction func;
+  gpointer user_data;
+};
+
+G_DEFINE_TYPE (GstdTaskPool, gstd_task_pool, GST_TYPE_TASK_POOL);
+
+/* GstTask only logs why a push failed, the last refusal is kept for
+   the thread that started the task */
+static GPrivate gstd_task_pool_refusal =
+G_PRIVATE_INIT ((GDestroyNotify) g_error_free);
+
+/* VTable */
+static void gstd_task_pool_prepare (GstTaskPool *, GError **);
+static void gstd_task_pool_cleanup (GstTaskPool *);
+static gpointer gstd_task_pool_push (GstTaskPool *, GstTaskPoolFunction,
+    gpointer, GError **);
+static void gstd_task_pool_join (GstTaskPool *, gpointer);
+static void gstd_task_pool_func (gpointer, gpointer);
+
+GType
+gstd_task_pool_policy_get_type (void)
+{
+  static GType policy_type = 0;
+  static const GEnumValue policy_types[] = {
+    {GSTD_TASK_POOL_POLICY_DEFAULT, "GSTD_TASK_POOL_POLICY_DEFAULT",
+        "default"},
+    {GSTD_TASK_POOL_POLICY_SHARED, "GSTD_TASK_POOL_POLICY_SHARED", "shared"},
+    {0, NULL, NULL}
+  };
+
+  if (!policy_type) {
+    policy_type = g_enum_register_static ("GstdTaskPoolPolicy", policy_types);
+  }
+  return policy_type;
+}
+
+static void
+gstd_task_pool_class_init (GstdTaskPoolClass * klass)
+{
+  GstTaskPoolClass *pool_class = GST_TASK_POOL_CLASS (klass);
+  guint debug_color;
+
+  pool_class->prepare = GST_DEBUG_FUNCPTR (gstd_task_pool_prepare);
+  pool_class->cleanup = GST_DEBUG_FUNCPTR (gstd_task_pool_cleanup);
+  pool_class->push = GST_DEBUG_FUNCPTR (gstd_task_pool_push);
+  pool_class->join = GST_DEBUG_FUNCPTR (gstd_task_pool_join);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_task_pool_debug, "gstdtaskpool", debug_color,
+      "Gstd Task Pool category");
+}
+
+static void
+gstd_task_pool_init (GstdTaskPool * self)
+{
+  GST_INFO_OBJECT (self, "Initializing task pool");
+  self->max_threads = GSTD_TASK_POOL_DEFAULT_MAX_THREADS;
+  self->busy = 0;
+}
+
+static void
+gstd_task_pool_prepare (GstTaskPool * pool, GError ** error)
+{
+  GstdTaskPool *self = GSTD_TASK_POOL (pool);
+
+  GST_OBJECT_LOCK (self);
+  if (NULL == pool->pool) {
+    /* Non exclusive, so idle threads are shared with the rest of the
+       process instead of being kept alive */
+    pool->pool = g_thread_pool_new (gstd_task_pool_func, self,
+        self->max_threads, FALSE, error);
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  GST_INFO_OBJECT (self, "Prepared task pool with up to %d threads",
+      self->max_threads);
+}
+
+static void
+gstd_task_pool_cleanup (GstTaskPool * pool)
+{
+  GThreadPool *threads;
+
+  GST_OBJECT_LOCK (pool);
+  threads = pool->pool;
+  pool->pool = NULL;
+  GST_OBJECT_UNLOCK (pool);
+
+  if (threads) {
+    g_thread_pool_free (threads, FALSE, TRUE);
+  }
+}
+
+static gpointer
+gstd_task_pool_push (GstTaskPool * pool, GstTaskPoolFunction func,
+    gpointer user_data, GError ** error)
+{
+  GstdTaskPool *self = GSTD_TASK_POOL (pool);
+  GstdTaskPoolJob *job;
+  gint max_threads;
+  gint busy;
+
+  g_return_val_if_fail (pool->pool, NULL);
+
+  /* Streaming tasks never give their thread back, a queued task would
+     wait forever */
+  max_threads = gstd_task_pool_get_max_threads (self);
+  busy = g_atomic_int_add (&self->busy, 1);
+  if (-1 != max_threads && busy >= max_threads) {
+    g_atomic_int_add (&self->busy, -1);
+    GST_ERROR_OBJECT (self, "All %d threads are busy", max_threads);
+    g_set_error (error, GST_CORE_ERROR, GST_CORE_ERROR_THREAD,
+        "All %d streaming threads of the shared pool are busy", max_threads);
+    g_private_replace (&gstd_task_pool_refusal,
+        g_error_new (GST_CORE_ERROR, GST_CORE_ERROR_THREAD,
+            "All %d streaming threads of the shared pool are busy",
+            max_threads));
+    return NULL;
+  }
+
+  job = g_slice_new (GstdTaskPoolJob);
+  job->func = func;
+  job->user_data = user_data;
+
+  if (!g_thread_pool_push (pool->pool, job, error)) {
+    g_atomic_int_add (&self->busy, -1);
+    g_slice_free (GstdTaskPoolJob, job);
+  }
+
+  /* Tasks signal their own termination, there is nothing to join */
+  return NULL;
+}
+
+static void
+gstd_task_pool_join (GstTaskPool * pool, gpointer id)
+{
+  /* Threads return to the pool once the task function returns */
+}
+
+static void
+gstd_task_pool_func (gpointer data, gpointer user_data)
+{
+  GstdTaskPool *self = GSTD_TASK_POOL (user_data);
+  GstdTaskPoolJob *job = data;
+
+  job->func (job->user_data);
+  g_slice_free (GstdTaskPoolJob, job);
+
+  g_atomic_int_add (&self->busy, -1);
+}
+
+GstTaskPool *
+gstd_task_pool_get_default (void)
+{
+  static GstTaskPool *pool = NULL;
+
+  if (g_once_init_enter (&pool)) {
+    GstTaskPool *shared;
+
+    shared = g_object_new (GSTD_TYPE_TASK_POOL, "name", "gstdtaskpool", NULL);
+    gst_object_ref_sink (shared);
+    gst_task_pool_prepare (shared, NULL);
+
+    g_once_init_leave (&pool, shared);
+  }
+
+  return gst_object_ref (pool);
+}
+
+void
+gstd_task_pool_set_max_threads (GstdTaskPool * self, gint max_threads)
+{
+  GstTaskPool *pool;
+
+  g_return_if_fail (GSTD_IS_TASK_POOL (self));
+  g_return_if_fail (max_threads >= -1 && max_threads != 0);
+
+  pool = GST_TASK_POOL (self);
+
+  GST_OBJECT_LOCK (self);
+  self->max_threads = max_threads;
+  if (pool->pool) {
+    g_thread_pool_set_max_threads (pool->pool, max_threads, NULL);
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  GST_INFO_OBJECT (self, "Changed maximum threads to %d", max_threads);
+}
+
+GError *
+gstd_task_pool_take_refusal (void)
+{
+  GError *refusal;
+
+  /* Unlike replacing it, setting it doesn't free the previous one */
+  refusal = g_private_get (&gstd_task_pool_refusal);
+  g_private_set (&gstd_task_pool_refusal, NULL);
+
+  return refusal;
+}
+
+gint
+gstd_task_pool_get_max_threads (GstdTaskPool * self)
+{
+  gint max_threads;
+
+  g_return_val_if_fail (GSTD_IS_TASK_POOL (self), -1);
+
+  GST_OBJECT_LOCK (self);
+  max_threads = self->max_threads;
+  GST_OBJECT_UNLOCK (self);
+
+  return max_threads;
+}
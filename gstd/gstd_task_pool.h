@@ -0,0 +1,107 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_TASK_POOL_H__
+#define __GSTD_TASK_POOL_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_TASK_POOL \
+  (gstd_task_pool_get_type())
+#define GSTD_TASK_POOL(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_TASK_POOL,GstdTaskPool))
+#define GSTD_TASK_POOL_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_TASK_POOL,GstdTaskPoolClass))
+#define GSTD_IS_TASK_POOL(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_TASK_POOL))
+#define GSTD_IS_TASK_POOL_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_TASK_POOL))
+#define GSTD_TASK_POOL_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_TASK_POOL, GstdTaskPoolClass))
+typedef struct _GstdTaskPool GstdTaskPool;
+typedef struct _GstdTaskPoolClass GstdTaskPoolClass;
+GType gstd_task_pool_get_type (void);
+
+/**
+ * GstdTaskPoolPolicy:
+ * @GSTD_TASK_POOL_POLICY_DEFAULT: Streaming threads are handled by
+ * GStreamer as usual
+ * @GSTD_TASK_POOL_POLICY_SHARED: Streaming threads are taken from the
+ * bounded pool shared by every pipeline in the daemon
+ *
+ * How the streaming threads of a pipeline are provided.
+ */
+typedef enum
+{
+  GSTD_TASK_POOL_POLICY_DEFAULT,
+  GSTD_TASK_POOL_POLICY_SHARED,
+} GstdTaskPoolPolicy;
+
+#define GSTD_TYPE_TASK_POOL_POLICY (gstd_task_pool_policy_get_type ())
+GType gstd_task_pool_policy_get_type (void);
+
+#define GSTD_TASK_POOL_DEFAULT_MAX_THREADS 64
+
+/**
+ * gstd_task_pool_get_default:
+ *
+ * Retrieves the task pool shared by all the pipelines using the
+ * shared policy.
+ *
+ * Returns: (transfer full): The shared #GstTaskPool, unref after usage.
+ */
+GstTaskPool *gstd_task_pool_get_default (void);
+
+/**
+ * gstd_task_pool_set_max_threads:
+ * @pool: The task pool to configure
+ * @max_threads: The maximum amount of threads, -1 for no limit
+ *
+ * Bounds the amount of streaming threads the pool may run at once.
+ * Threads are created on demand up to the bound. Streaming tasks hold
+ * their thread until they stop, so tasks pushed while the pool is
+ * saturated are refused, failing the state change that started them.
+ */
+void gstd_task_pool_set_max_threads (GstdTaskPool * pool, gint max_threads);
+
+/**
+ * gstd_task_pool_take_refusal:
+ *
+ * Retrieves why the last task started from the calling thread was
+ * refused by the shared pool, and forgets it.
+ *
+ * Returns: (transfer full) (nullable): The reason of the refusal, or
+ * NULL if none. Free after usage using g_error_free()
+ */
+GError *gstd_task_pool_take_refusal (void);
+
+/**
+ * gstd_task_pool_get_max_threads:
+ * @pool: The task pool to query
+ *
+ * Returns: The maximum amount of threads the pool may run at once.
+ */
+gint gstd_task_pool_get_max_threads (GstdTaskPool * pool);
+
+G_END_DECLS
+#endif // __GSTD_TASK_POOL_H__
@@ -0,0 +1,175 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstd_telemetry_range.h"
+#include "gstd_iformatter.h"
+
+/* Gstd Telemetry Range debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_telemetry_range_debug);
+#define GST_CAT_DEFAULT gstd_telemetry_range_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/**
+ * GstdTelemetryRange:
+ * The points of a telemetry series within a time range
+ */
+struct _GstdTelemetryRange
+{
+  GstdObject parent;
+
+  GArray *points;
+};
+
+struct _GstdTelemetryRangeClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdTelemetryRange, gstd_telemetry_range, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void gstd_telemetry_range_finalize (GObject *);
+static GstdReturnCode gstd_telemetry_range_to_string (GstdObject *,
+    gchar **);
+
+static void
+gstd_telemetry_range_class_init (GstdTelemetryRangeClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GstdObjectClass *gstd_object_class = GSTD_OBJECT_CLASS (klass);
+  guint debug_color;
+
+  object_class->finalize = gstd_telemetry_range_finalize;
+
+  gstd_object_class->to_string = gstd_telemetry_range_to_string;
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_telemetry_range_debug, "gstdtelemetryrange",
+      debug_color, "Gstd Telemetry Range category");
+}
+
+static void
+gstd_telemetry_range_init (GstdTelemetryRange * self)
+{
+  GST_INFO_OBJECT (self, "Initializing telemetry range");
+
+  self->points = NULL;
+}
+
+GstdTelemetryRange *
+gstd_telemetry_range_new (const gchar * name, GArray * points)
+{
+  GstdTelemetryRange *self;
+
+  g_return_val_if_fail (name, NULL);
+  g_return_val_if_fail (points, NULL);
+
+  self = GSTD_TELEMETRY_RANGE (g_object_new (GSTD_TYPE_TELEMETRY_RANGE,
+          "name", name, NULL));
+  self->points = points;
+
+  return self;
+}
+
+static void
+gstd_telemetry_range_finalize (GObject * object)
+{
+  GstdTelemetryRange *self = GSTD_TELEMETRY_RANGE (object);
+
+  if (self->points) {
+    g_array_unref (self->points);
+    self->points = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_telemetry_range_parent_class)->finalize (object);
+}
+
+static GstdReturnCode
+gstd_telemetry_range_to_string (GstdObject * object, gchar ** outstring)
+{
+  GstdTelemetryRange *self;
+  GstdTelemetryPoint *point;
+  GstdIFormatter *formatter;
+  GValue value = G_VALUE_INIT;
+  guint i;
+
+  g_return_val_if_fail (GSTD_IS_TELEMETRY_RANGE (object), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (outstring, GSTD_NULL_ARGUMENT);
+
+  self = GSTD_TELEMETRY_RANGE (object);
+  formatter = g_object_new (object->formatter_factory, NULL);
+
+  gstd_iformatter_begin_object (formatter);
+  gstd_iformatter_set_member_name (formatter, "name");
+  gstd_iformatter_set_string_value (formatter, GSTD_OBJECT_NAME (self));
+
+  gstd_iformatter_set_member_name (formatter, "points");
+  gstd_iformatter_begin_array (formatter);
+
+  for (i = 0; i < self->points->len; i++) {
+    point = &g_array_index (self->points, GstdTelemetryPoint, i);
+
+    gstd_iformatter_begin_object (formatter);
+
+    gstd_iformatter_set_member_name (formatter, "time");
+    g_value_init (&value, G_TYPE_INT64);
+    g_value_set_int64 (&value, point->time);
+    gstd_iformatter_set_value (formatter, &value);
+    g_value_unset (&value);
+
+    gstd_iformatter_set_member_name (formatter, "span");
+    g_value_init (&value, G_TYPE_UINT);
+    g_value_set_uint (&value, point->span);
+    gstd_iformatter_set_value (formatter, &value);
+    g_value_unset (&value);
+
+    g_value_init (&value, G_TYPE_DOUBLE);
+
+    gstd_iformatter_set_member_name (formatter, "value");
+    g_value_set_double (&value, point->value);
+    gstd_iformatter_set_value (formatter, &value);
+
+    gstd_iformatter_set_member_name (formatter, "min");
+    g_value_set_double (&value, point->min);
+    gstd_iformatter_set_value (formatter, &value);
+
+    gstd_iformatter_set_member_name (formatter, "max");
+    g_value_set_double (&value, point->max);
+    gstd_iformatter_set_value (formatter, &value);
+
+    g_value_unset (&value);
+
+    gstd_iformatter_end_object (formatter);
+  }
+
+  gstd_iformatter_end_array (formatter);
+  gstd_iformatter_end_object (formatter);
+
+  gstd_iformatter_generate (formatter, outstring);
+
+  g_object_unref (formatter);
+
+  return GSTD_EOK;
+}
@@ -0,0 +1,83 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_TELEMETRY_RANGE_H__
+#define __GSTD_TELEMETRY_RANGE_H__
+
+#include <glib-object.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_TELEMETRY_RANGE \
+  (gstd_telemetry_range_get_type())
+#define GSTD_TELEMETRY_RANGE(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_TELEMETRY_RANGE,GstdTelemetryRange))
+#define GSTD_TELEMETRY_RANGE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_TELEMETRY_RANGE,GstdTelemetryRangeClass))
+#define GSTD_IS_TELEMETRY_RANGE(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_TELEMETRY_RANGE))
+#define GSTD_IS_TELEMETRY_RANGE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_TELEMETRY_RANGE))
+#define GSTD_TELEMETRY_RANGE_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_TELEMETRY_RANGE, GstdTelemetryRangeClass))
+typedef struct _GstdTelemetryRange GstdTelemetryRange;
+typedef struct _GstdTelemetryRangeClass GstdTelemetryRangeClass;
+GType gstd_telemetry_range_get_type (void);
+
+/**
+ * GstdTelemetryPoint:
+ * @time: When the point was sampled, in microseconds since the Epoch
+ * @span: The amount of milliseconds the point summarizes
+ * @value: The sampled value, or the mean of the summarized samples
+ * @min: The smallest of the summarized samples
+ * @max: The largest of the summarized samples
+ *
+ * A point of a telemetry series. Raw samples have @min and @max equal
+ * to @value.
+ */
+typedef struct
+{
+  gint64 time;
+  guint span;
+  gdouble value;
+  gdouble min;
+  gdouble max;
+} GstdTelemetryPoint;
+
+/**
+ * gstd_telemetry_range_new: (constructor)
+ * @name: The name of the series the points belong to
+ * @points: (transfer full): A #GArray of #GstdTelemetryPoint, oldest
+ * first
+ *
+ * Wraps a stretch of a telemetry series so it can be sent to a client
+ * in a single response.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdTelemetryRange.
+ * Free after usage using g_object_unref()
+ */
+GstdTelemetryRange *gstd_telemetry_range_new (const gchar * name,
+    GArray * points);
+
+G_END_DECLS
+#endif // __GSTD_TELEMETRY_RANGE_H__
@@ -0,0 +1,692 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "gstd_telemetry_series.h"
+#include "gstd_telemetry_range.h"
+#include "gstd_telemetry_reader.h"
+
+/* Gstd Telemetry Series debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_telemetry_series_debug);
+#define GST_CAT_DEFAULT gstd_telemetry_series_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+#define GSTD_TELEMETRY_SERIES_DEFAULT_INTERVAL 1000
+#define GSTD_TELEMETRY_SERIES_DEFAULT_CAPACITY 600
+
+/* Raw samples summarized by every downsampled point */
+#define GSTD_TELEMETRY_SERIES_DOWNSAMPLE 10
+
+enum
+{
+  PROP_ELEMENT = 1,
+  PROP_PROPERTY,
+  PROP_INTERVAL,
+  PROP_CAPACITY,
+  PROP_SAMPLES,
+  PROP_DOWNSAMPLED,
+  PROP_VALUE,
+  PROP_ERRORS,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/**
+ * GstdTelemetryRing:
+ * A fixed amount of points, overwriting the oldest once full
+ */
+typedef struct
+{
+  GstdTelemetryPoint *points;
+  guint capacity;
+  guint head;
+  guint count;
+} GstdTelemetryRing;
+
+/**
+ * GstdTelemetrySeries:
+ * Samples a numeric property of an element at a fixed interval. The
+ * latest samples are kept as they are, and every few of them are
+ * summarized into a second ring that reaches further back in time.
+ */
+struct _GstdTelemetrySeries
+{
+  GstdObject parent;
+
+  GMutex lock;
+
+  gchar *element_name;
+  gchar *property_name;
+  guint interval;
+  guint capacity;
+
+  /**
+   * The sampled element and property, while attached. Fields of
+   * structure properties are looked up by field name.
+   */
+  GstElement *element;
+  GParamSpec *pspec;
+  gchar *field;
+
+  /**
+   * When the next sample is due, in monotonic time
+   */
+  gint64 next;
+
+  GstdTelemetryRing raw;
+  GstdTelemetryRing downsampled;
+
+  /**
+   * The raw samples not yet summarized
+   */
+  GstdTelemetryPoint pending;
+  guint pending_count;
+
+  gdouble value;
+  guint errors;
+};
+
+struct _GstdTelemetrySeriesClass
+{
+  GstdObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdTelemetrySeries, gstd_telemetry_series, GSTD_TYPE_OBJECT);
+
+/* VTable */
+static void
+gstd_telemetry_series_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void
+gstd_telemetry_series_get_property (GObject *, guint, GValue *,
+    GParamSpec *);
+static void gstd_telemetry_series_dispose (GObject *);
+static void gstd_telemetry_series_finalize (GObject *);
+static gboolean gstd_telemetry_series_read (GstdTelemetrySeries *,
+    gdouble *);
+static void gstd_telemetry_series_store (GstdTelemetrySeries *, gint64,
+    gdouble);
+static void gstd_telemetry_ring_push (GstdTelemetryRing *,
+    const GstdTelemetryPoint *);
+static const GstdTelemetryPoint *gstd_telemetry_ring_get (GstdTelemetryRing *,
+    guint);
+static gboolean gstd_telemetry_series_parse_range (const gchar *, gint64 *,
+    gint64 *);
+
+static void
+gstd_telemetry_series_class_init (GstdTelemetrySeriesClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_telemetry_series_set_property;
+  object_class->get_property = gstd_telemetry_series_get_property;
+  object_class->dispose = gstd_telemetry_series_dispose;
+  object_class->finalize = gstd_telemetry_series_finalize;
+
+  properties[PROP_ELEMENT] =
+      g_param_spec_string ("element", "Element",
+      "The element being sampled", NULL,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_PROPERTY] =
+      g_param_spec_string ("property", "Property",
+      "The property being sampled, as property or property.field", NULL,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_INTERVAL] =
+      g_param_spec_uint ("interval", "Interval",
+      "Milliseconds between samples",
+      GSTD_TELEMETRY_SERIES_MIN_INTERVAL, G_MAXUINT,
+      GSTD_TELEMETRY_SERIES_DEFAULT_INTERVAL,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ |
+      GSTD_PARAM_UPDATE);
+
+  properties[PROP_CAPACITY] =
+      g_param_spec_uint ("capacity", "Capacity",
+      "The amount of raw and of downsampled points kept",
+      1, GSTD_TELEMETRY_SERIES_MAX_CAPACITY,
+      GSTD_TELEMETRY_SERIES_DEFAULT_CAPACITY,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_SAMPLES] =
+      g_param_spec_uint ("samples", "Samples",
+      "The amount of raw samples currently kept",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_DOWNSAMPLED] =
+      g_param_spec_uint ("downsampled", "Downsampled",
+      "The amount of downsampled points currently kept",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_VALUE] =
+      g_param_spec_double ("value", "Value",
+      "The last sampled value",
+      -G_MAXDOUBLE, G_MAXDOUBLE, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_ERRORS] =
+      g_param_spec_uint ("errors", "Errors",
+      "The amount of samples that couldn't be read as a number",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_telemetry_series_debug, "gstdtelemetryseries",
+      debug_color, "Gstd Telemetry Series category");
+}
+
+static void
+gstd_telemetry_series_init (GstdTelemetrySeries * self)
+{
+  GST_INFO_OBJECT (self, "Initializing telemetry series");
+
+  g_mutex_init (&self->lock);
+
+  self->element_name = NULL;
+  self->property_name = NULL;
+  self->interval = GSTD_TELEMETRY_SERIES_DEFAULT_INTERVAL;
+  self->capacity = GSTD_TELEMETRY_SERIES_DEFAULT_CAPACITY;
+  self->element = NULL;
+  self->pspec = NULL;
+  self->field = NULL;
+  self->next = 0;
+  memset (&self->raw, 0, sizeof (self->raw));
+  memset (&self->downsampled, 0, sizeof (self->downsampled));
+  memset (&self->pending, 0, sizeof (self->pending));
+  self->pending_count = 0;
+  self->value = 0;
+  self->errors = 0;
+
+  gstd_object_set_reader (GSTD_OBJECT (self),
+      g_object_new (GSTD_TYPE_TELEMETRY_READER, NULL));
+}
+
+GstdTelemetrySeries *
+gstd_telemetry_series_new (const gchar * name, const gchar * description)
+{
+  GstdTelemetrySeries *self;
+  gchar **tokens;
+
+  g_return_val_if_fail (name, NULL);
+  g_return_val_if_fail (description, NULL);
+
+  self = GSTD_TELEMETRY_SERIES (g_object_new (GSTD_TYPE_TELEMETRY_SERIES,
+          "name", name, NULL));
+
+  tokens = g_strsplit (description, " ", 4);
+  self->element_name = g_strdup (tokens[0]);
+  if (tokens[0] && tokens[1]) {
+    self->property_name = g_strdup (tokens[1]);
+    if (tokens[2]) {
+      /* Out of range values saturate and are refused on attach */
+      self->interval = MIN (g_ascii_strtoull (tokens[2], NULL, 10),
+          G_MAXUINT);
+      if (tokens[3]) {
+        self->capacity = MIN (g_ascii_strtoull (tokens[3], NULL, 10),
+            G_MAXUINT);
+      }
+    }
+  }
+  g_strfreev (tokens);
+
+  return self;
+}
+
+static void
+gstd_telemetry_series_dispose (GObject * object)
+{
+  GstdTelemetrySeries *self = GSTD_TELEMETRY_SERIES (object);
+
+  GST_INFO_OBJECT (self, "Disposing telemetry series");
+
+  gstd_telemetry_series_detach (self);
+
+  G_OBJECT_CLASS (gstd_telemetry_series_parent_class)->dispose (object);
+}
+
+static void
+gstd_telemetry_series_finalize (GObject * object)
+{
+  GstdTelemetrySeries *self = GSTD_TELEMETRY_SERIES (object);
+
+  g_free (self->element_name);
+  g_free (self->property_name);
+  g_free (self->raw.points);
+  g_free (self->downsampled.points);
+
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (gstd_telemetry_series_parent_class)->finalize (object);
+}
+
+static void
+gstd_telemetry_series_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdTelemetrySeries *self = GSTD_TELEMETRY_SERIES (object);
+
+  switch (property_id) {
+    case PROP_INTERVAL:
+      g_mutex_lock (&self->lock);
+      self->interval = g_value_get_uint (value);
+      GST_INFO_OBJECT (self, "Sampling every %u ms", self->interval);
+      /* Take the next sample on the new cadence */
+      self->next = 0;
+      g_mutex_unlock (&self->lock);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_telemetry_series_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdTelemetrySeries *self = GSTD_TELEMETRY_SERIES (object);
+
+  g_mutex_lock (&self->lock);
+  switch (property_id) {
+    case PROP_ELEMENT:
+      g_value_set_string (value, self->element_name);
+      break;
+    case PROP_PROPERTY:
+      g_value_set_string (value, self->property_name);
+      break;
+    case PROP_INTERVAL:
+      g_value_set_uint (value, self->interval);
+      break;
+    case PROP_CAPACITY:
+      g_value_set_uint (value, self->capacity);
+      break;
+    case PROP_SAMPLES:
+      g_value_set_uint (value, self->raw.count);
+      break;
+    case PROP_DOWNSAMPLED:
+      g_value_set_uint (value, self->downsampled.count);
+      break;
+    case PROP_VALUE:
+      g_value_set_double (value, self->value);
+      break;
+    case PROP_ERRORS:
+      g_value_set_uint (value, self->errors);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  g_mutex_unlock (&self->lock);
+}
+
+GstdReturnCode
+gstd_telemetry_series_attach (GstdTelemetrySeries * self, GstBin * bin)
+{
+  GstElement *element;
+  GParamSpec *pspec;
+  gchar **tokens;
+  GstdReturnCode ret = GSTD_EOK;
+
+  g_return_val_if_fail (GSTD_IS_TELEMETRY_SERIES (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GST_IS_BIN (bin), GSTD_NULL_ARGUMENT);
+
+  if (!self->element_name || !self->property_name) {
+    GST_ERROR_OBJECT (self, "Expected an element and a property to sample");
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  if (self->interval < GSTD_TELEMETRY_SERIES_MIN_INTERVAL) {
+    GST_ERROR_OBJECT (self, "The interval must be at least %u ms",
+        GSTD_TELEMETRY_SERIES_MIN_INTERVAL);
+    return GSTD_BAD_VALUE;
+  }
+
+  if (0 == self->capacity
+      || self->capacity > GSTD_TELEMETRY_SERIES_MAX_CAPACITY) {
+    GST_ERROR_OBJECT (self, "The capacity must be between 1 and %u",
+        GSTD_TELEMETRY_SERIES_MAX_CAPACITY);
+    return GSTD_BAD_VALUE;
+  }
+
+  element = gst_bin_get_by_name (bin, self->element_name);
+  if (!element) {
+    GST_ERROR_OBJECT (self, "No element named \"%s\"", self->element_name);
+    return GSTD_NO_RESOURCE;
+  }
+
+  tokens = g_strsplit (self->property_name, ".", 2);
+  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (element),
+      tokens[0]);
+
+  if (!pspec || !(pspec->flags & G_PARAM_READABLE)) {
+    GST_ERROR_OBJECT (self, "\"%s\" has no readable property \"%s\"",
+        self->element_name, tokens[0]);
+    ret = GSTD_NO_RESOURCE;
+  } else if (tokens[1] && GST_TYPE_STRUCTURE != pspec->value_type) {
+    GST_ERROR_OBJECT (self, "\"%s\" is not a structure, it has no field "
+        "\"%s\"", tokens[0], tokens[1]);
+    ret = GSTD_BAD_VALUE;
+  } else if (!tokens[1]
+      && !g_value_type_transformable (pspec->value_type, G_TYPE_DOUBLE)) {
+    GST_ERROR_OBJECT (self, "\"%s\" of type %s can't be sampled as a number",
+        tokens[0], g_type_name (pspec->value_type));
+    ret = GSTD_BAD_VALUE;
+  }
+
+  if (GSTD_EOK != ret) {
+    g_strfreev (tokens);
+    gst_object_unref (element);
+    return ret;
+  }
+
+  g_mutex_lock (&self->lock);
+  if (self->element) {
+    g_mutex_unlock (&self->lock);
+    g_strfreev (tokens);
+    gst_object_unref (element);
+    GST_ERROR_OBJECT (self, "Already attached");
+    return GSTD_EXISTING_RESOURCE;
+  }
+
+  self->element = element;
+  self->pspec = g_param_spec_ref (pspec);
+  self->field = g_strdup (tokens[1]);
+  self->next = 0;
+
+  if (!self->raw.points) {
+    self->raw.capacity = self->capacity;
+    self->raw.points = g_new0 (GstdTelemetryPoint, self->capacity);
+    self->downsampled.capacity = self->capacity;
+    self->downsampled.points = g_new0 (GstdTelemetryPoint, self->capacity);
+  }
+  g_mutex_unlock (&self->lock);
+
+  GST_INFO_OBJECT (self, "Sampling %s:%s every %u ms", self->element_name,
+      self->property_name, self->interval);
+
+  g_strfreev (tokens);
+
+  return GSTD_EOK;
+}
+
+void
+gstd_telemetry_series_detach (GstdTelemetrySeries * self)
+{
+  g_return_if_fail (GSTD_IS_TELEMETRY_SERIES (self));
+
+  g_mutex_lock (&self->lock);
+  if (self->element) {
+    gst_object_unref (self->element);
+    self->element = NULL;
+  }
+  if (self->pspec) {
+    g_param_spec_unref (self->pspec);
+    self->pspec = NULL;
+  }
+  g_free (self->field);
+  self->field = NULL;
+  g_mutex_unlock (&self->lock);
+}
+
+gint64
+gstd_telemetry_series_poll (GstdTelemetrySeries * self, gint64 now)
+{
+  gint64 period;
+  gint64 next;
+  gdouble value;
+
+  g_return_val_if_fail (GSTD_IS_TELEMETRY_SERIES (self), G_MAXINT64);
+
+  g_mutex_lock (&self->lock);
+  period = self->interval * G_TIME_SPAN_MILLISECOND;
+
+  if (!self->element) {
+    g_mutex_unlock (&self->lock);
+    return now + period;
+  }
+
+  if (now < self->next) {
+    next = self->next;
+    g_mutex_unlock (&self->lock);
+    return next;
+  }
+
+  if (gstd_telemetry_series_read (self, &value)) {
+    gstd_telemetry_series_store (self, g_get_real_time (), value);
+  } else {
+    self->errors++;
+    GST_LOG_OBJECT (self, "Unable to sample %s:%s", self->element_name,
+        self->property_name);
+  }
+
+  /* Keep the cadence, unless we fell behind a whole period */
+  self->next = self->next + period;
+  if (self->next <= now) {
+    self->next = now + period;
+  }
+  next = self->next;
+  g_mutex_unlock (&self->lock);
+
+  return next;
+}
+
+/* Must be called with the lock held */
+static gboolean
+gstd_telemetry_series_read (GstdTelemetrySeries * self, gdouble * out)
+{
+  GValue value = G_VALUE_INIT;
+  GValue number = G_VALUE_INIT;
+  const GstStructure *structure;
+  const GValue *sampled;
+  gboolean ret = FALSE;
+
+  g_value_init (&value, self->pspec->value_type);
+  g_object_get_property (G_OBJECT (self->element), self->pspec->name, &value);
+
+  sampled = &value;
+  if (self->field) {
+    structure = gst_value_get_structure (&value);
+    sampled = structure ? gst_structure_get_value (structure, self->field) :
+        NULL;
+  }
+
+  if (sampled
+      && g_value_type_transformable (G_VALUE_TYPE (sampled), G_TYPE_DOUBLE)) {
+    g_value_init (&number, G_TYPE_DOUBLE);
+    ret = g_value_transform (sampled, &number);
+    *out = g_value_get_double (&number);
+    g_value_unset (&number);
+  }
+
+  g_value_unset (&value);
+
+  return ret;
+}
+
+/* Must be called with the lock held */
+static void
+gstd_telemetry_series_store (GstdTelemetrySeries * self, gint64 time,
+    gdouble value)
+{
+  GstdTelemetryPoint point;
+
+  self->value = value;
+
+  point.time = time;
+  point.span = self->interval;
+  point.value = value;
+  point.min = value;
+  point.max = value;
+  gstd_telemetry_ring_push (&self->raw, &point);
+
+  /* The pending point accumulates the sum until it is summarized */
+  if (0 == self->pending_count) {
+    self->pending = point;
+  } else {
+    self->pending.span += point.span;
+    self->pending.value += value;
+    self->pending.min = MIN (self->pending.min, value);
+    self->pending.max = MAX (self->pending.max, value);
+  }
+  self->pending_count++;
+
+  if (GSTD_TELEMETRY_SERIES_DOWNSAMPLE == self->pending_count) {
+    self->pending.value /= self->pending_count;
+    gstd_telemetry_ring_push (&self->downsampled, &self->pending);
+    self->pending_count = 0;
+  }
+}
+
+static void
+gstd_telemetry_ring_push (GstdTelemetryRing * ring,
+    const GstdTelemetryPoint * point)
+{
+  ring->points[ring->head] = *point;
+  ring->head = (ring->head + 1) % ring->capacity;
+  if (ring->count < ring->capacity) {
+    ring->count++;
+  }
+}
+
+/* The index counts from the oldest point */
+static const GstdTelemetryPoint *
+gstd_telemetry_ring_get (GstdTelemetryRing * ring, guint index)
+{
+  return &ring->points[(ring->head + ring->capacity - ring->count + index) %
+      ring->capacity];
+}
+
+static gboolean
+gstd_telemetry_series_parse_range (const gchar * range, gint64 * from,
+    gint64 * to)
+{
+  gchar **fields;
+  gchar **field;
+  gchar *value;
+  gchar *end;
+  gint64 number;
+  gboolean ret = TRUE;
+
+  *from = G_MININT64;
+  *to = G_MAXINT64;
+
+  if (!g_strcmp0 (range, "all")) {
+    return TRUE;
+  }
+
+  /* Parsed by hand, Epoch microseconds don't fit the integers of a
+     GstStructure */
+  fields = g_strsplit (range, ",", -1);
+  for (field = fields; *field && ret; field++) {
+    value = strchr (*field, '=');
+    if (!value) {
+      ret = FALSE;
+      break;
+    }
+    *value++ = '\0';
+
+    number = g_ascii_strtoll (value, &end, 10);
+    if (end == value || '\0' != *end) {
+      ret = FALSE;
+    } else if (!g_strcmp0 (*field, "from")) {
+      *from = number;
+    } else if (!g_strcmp0 (*field, "to")) {
+      *to = number;
+    } else if (!g_strcmp0 (*field, "last")) {
+      *from = g_get_real_time () - number * G_TIME_SPAN_SECOND;
+    } else {
+      ret = FALSE;
+    }
+  }
+  g_strfreev (fields);
+
+  return ret;
+}
+
+GstdReturnCode
+gstd_telemetry_series_query (GstdTelemetrySeries * self,
+    const gchar * range, GstdObject ** points)
+{
+  const GstdTelemetryPoint *point;
+  GArray *found;
+  gint64 oldest;
+  gint64 from;
+  gint64 to;
+  guint i;
+
+  g_return_val_if_fail (GSTD_IS_TELEMETRY_SERIES (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (range, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (points, GSTD_NULL_ARGUMENT);
+
+  *points = NULL;
+
+  if (!gstd_telemetry_series_parse_range (range, &from, &to)) {
+    GST_ERROR_OBJECT (self, "Malformed range \"%s\", expected all, "
+        "last=<seconds> or from=<us>,to=<us>", range);
+    return GSTD_BAD_VALUE;
+  }
+
+  found = g_array_new (FALSE, FALSE, sizeof (GstdTelemetryPoint));
+
+  g_mutex_lock (&self->lock);
+
+  /* Downsampled points only where the raw samples are gone */
+  oldest = G_MAXINT64;
+  if (self->raw.count > 0) {
+    oldest = gstd_telemetry_ring_get (&self->raw, 0)->time;
+  }
+
+  for (i = 0; i < self->downsampled.count; i++) {
+    point = gstd_telemetry_ring_get (&self->downsampled, i);
+    if (point->time + point->span * G_TIME_SPAN_MILLISECOND > oldest) {
+      break;
+    }
+    if (point->time >= from && point->time <= to) {
+      g_array_append_vals (found, point, 1);
+    }
+  }
+
+  for (i = 0; i < self->raw.count; i++) {
+    point = gstd_telemetry_ring_get (&self->raw, i);
+    if (point->time >= from && point->time <= to) {
+      g_array_append_vals (found, point, 1);
+    }
+  }
+
+  g_mutex_unlock (&self->lock);
+
+  *points = GSTD_OBJECT (gstd_telemetry_range_new (GSTD_OBJECT_NAME (self),
+          found));
+
+  return GSTD_EOK;
+}
@@ -0,0 +1,123 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2020 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_TELEMETRY_SERIES_H__
+#define __GSTD_TELEMETRY_SERIES_H__
+
+#include <glib-object.h>
+#include <gst/gst.h>
+
+#include "gstd_object.h"
+
+G_BEGIN_DECLS
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_TELEMETRY_SERIES \
+  (gstd_telemetry_series_get_type())
+#define GSTD_TELEMETRY_SERIES(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_TELEMETRY_SERIES,GstdTelemetrySeries))
+#define GSTD_TELEMETRY_SERIES_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_TELEMETRY_SERIES,GstdTelemetrySeriesClass))
+#define GSTD_IS_TELEMETRY_SERIES(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_TELEMETRY_SERIES))
+#define GSTD_IS_TELEMETRY_SERIES_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_TELEMETRY_SERIES))
+#define GSTD_TELEMETRY_SERIES_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_TELEMETRY_SERIES, GstdTelemetrySeriesClass))
+typedef struct _GstdTelemetrySeries GstdTelemetrySeries;
+typedef struct _GstdTelemetrySeriesClass GstdTelemetrySeriesClass;
+GType gstd_telemetry_series_get_type (void);
+
+/*
+ * The shortest sampling interval in milliseconds, and the most points
+ * kept in each ring. Series outside these bounds are refused.
+ */
+#define GSTD_TELEMETRY_SERIES_MIN_INTERVAL 100
+#define GSTD_TELEMETRY_SERIES_MAX_CAPACITY 86400
+
+/**
+ * gstd_telemetry_series_new: (constructor)
+ * @name: The name of the series
+ * @description: The element and property to sample, optionally
+ * followed by the sampling interval in milliseconds and the amount of
+ * points kept, as in "<element> <property> [<interval> [<capacity>]]".
+ * Fields of structure properties are addressed as "property.field".
+ *
+ * Creates a new series, not yet attached.
+ *
+ * Returns: (transfer full) (nullable): A new #GstdTelemetrySeries.
+ * Free after usage using g_object_unref()
+ */
+GstdTelemetrySeries *gstd_telemetry_series_new (const gchar * name,
+    const gchar * description);
+
+/**
+ * gstd_telemetry_series_attach:
+ * @object: The series
+ * @bin: The GStreamer pipeline holding the element
+ *
+ * Looks the element up and validates the property can be sampled as
+ * a number. Intervals under %GSTD_TELEMETRY_SERIES_MIN_INTERVAL and
+ * capacities over %GSTD_TELEMETRY_SERIES_MAX_CAPACITY are bad values.
+ *
+ * Returns: A GstdReturnCode with the status of the operation.
+ */
+GstdReturnCode gstd_telemetry_series_attach (GstdTelemetrySeries *
+    object, GstBin * bin);
+
+/**
+ * gstd_telemetry_series_detach:
+ * @object: The series
+ *
+ * Stops sampling and releases the element. The points sampled so far
+ * are kept.
+ */
+void gstd_telemetry_series_detach (GstdTelemetrySeries * object);
+
+/**
+ * gstd_telemetry_series_poll:
+ * @object: The series
+ * @now: The current monotonic time
+ *
+ * Samples the property if the interval elapsed since the last sample.
+ *
+ * Returns: The monotonic time the series is due again.
+ */
+gint64 gstd_telemetry_series_poll (GstdTelemetrySeries * object, gint64 now);
+
+/**
+ * gstd_telemetry_series_query:
+ * @object: The series
+ * @range: The points to return: "all", "last=<seconds>" or
+ * "from=<us>,to=<us>" in microseconds since the Epoch, either end
+ * being optional
+ * @points: (out) (transfer full): A #GstdTelemetryRange
+ *
+ * Collects the points of the series within @range, oldest first.
+ * Downsampled points are used where the raw samples were already
+ * overwritten.
+ *
+ * Returns: A GstdReturnCode with the status of the operation.
+ */
+GstdReturnCode gstd_telemetry_series_query (GstdTelemetrySeries * object,
+    const gchar * range, GstdObject ** points);
+
+G_END_DECLS
+#endif // __GSTD_TELEMETRY_SERIES_H__
@@ -0,0 +1,73 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_http.h"
+
+
+GST_START_TEST (test_http_query_node)
+{
+  fail_unless (gstd_http_query_is_node ("/pipelines/p0/elements/s0/snapshot"));
+  fail_unless (gstd_http_query_is_node ("/pipelines/p0/telemetry/s0"));
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_http_query_ignored)
+{
+  /* Resources merely named alike keep ignoring the query */
+  fail_if (gstd_http_query_is_node ("/pipelines/p0/elements/snapshot"));
+  fail_if (gstd_http_query_is_node ("/pipelines/snapshot"));
+  fail_if (gstd_http_query_is_node ("/pipelines/p0/telemetry"));
+  fail_if (gstd_http_query_is_node ("/pipelines/telemetry/s0"));
+  fail_if (gstd_http_query_is_node ("/pipelines/p0/elements/s0/properties/"
+          "snapshot"));
+  fail_if (gstd_http_query_is_node ("/pipelines/p0/telemetry/s0/points"));
+  fail_if (gstd_http_query_is_node ("/groups/p0/telemetry/s0"));
+  fail_if (gstd_http_query_is_node ("pipelines/p0/telemetry/s0"));
+  fail_if (gstd_http_query_is_node ("/pipelines//telemetry/s0"));
+  fail_if (gstd_http_query_is_node ("/pipelines/p0/telemetry/"));
+  fail_if (gstd_http_query_is_node ("/pipelines/p0/elements/s0/snapshot/"));
+  fail_if (gstd_http_query_is_node ("/"));
+  fail_if (gstd_http_query_is_node (""));
+}
+
+GST_END_TEST;
+
+static Suite *
+gstd_http_suite (void)
+{
+  Suite *suite = suite_create ("gstd_http");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_http_query_node);
+  tcase_add_test (tc, test_http_query_ignored);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_http);
@@ -0,0 +1,303 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_ideleter.h"
+#include "gstd_list.h"
+
+/* Fails every deletion, trying to take the name meanwhile */
+typedef struct _TestDeleter TestDeleter;
+typedef struct _TestDeleterClass TestDeleterClass;
+
+struct _TestDeleter
+{
+  GObject parent;
+
+  GstdList *list;
+  gboolean taken;
+};
+
+struct _TestDeleterClass
+{
+  GObjectClass parent_class;
+};
+
+static GstdReturnCode
+test_deleter_delete (GstdIDeleter * iface, GstdObject * object)
+{
+  TestDeleter *self = (TestDeleter *) iface;
+  GstdObject *duplicate;
+
+  duplicate = GSTD_OBJECT (g_object_new (GSTD_TYPE_OBJECT, "name",
+          GSTD_OBJECT_NAME (object), NULL));
+  self->taken = gstd_list_append_child (self->list, duplicate);
+  if (!self->taken) {
+    g_object_unref (duplicate);
+  }
+
+  return GSTD_STATE_ERROR;
+}
+
+static void
+test_deleter_interface_init (GstdIDeleterInterface * iface)
+{
+  iface->delete = test_deleter_delete;
+}
+
+G_DEFINE_TYPE_WITH_CODE (TestDeleter, test_deleter, G_TYPE_OBJECT,
+    G_IMPLEMENT_INTERFACE (GSTD_TYPE_IDELETER, test_deleter_interface_init));
+
+static void
+test_deleter_class_init (TestDeleterClass * klass)
+{
+}
+
+static void
+test_deleter_init (TestDeleter * self)
+{
+}
+
+
+static GstdList *
+test_list_new (void)
+{
+  return GSTD_LIST (g_object_new (GSTD_TYPE_LIST, "name", "test_list",
+          "node-type", GSTD_TYPE_OBJECT, "flags", GSTD_PARAM_READ, NULL));
+}
+
+static GstdObject *
+test_node_new (const gchar * name)
+{
+  return GSTD_OBJECT (g_object_new (GSTD_TYPE_OBJECT, "name", name, NULL));
+}
+
+static guint
+test_list_count (GstdList * list)
+{
+  guint count;
+
+  g_object_get (list, "count", &count, NULL);
+
+  return count;
+}
+
+
+GST_START_TEST (test_list_find_appended)
+{
+  GstdList *list = test_list_new ();
+  GstdObject *n0 = test_node_new ("n0");
+  GstdObject *n1 = test_node_new ("n1");
+  GstdObject *found;
+
+  fail_unless (gstd_list_append_child (list, n0));
+  fail_unless (gstd_list_append_child (list, n1));
+  fail_unless_equals_int (2, test_list_count (list));
+
+  found = gstd_list_find_child (list, "n1");
+  fail_unless (n1 == found);
+  g_object_unref (found);
+
+  found = gstd_list_find_child (list, "n0");
+  fail_unless (n0 == found);
+  g_object_unref (found);
+
+  fail_unless (NULL == gstd_list_find_child (list, "n2"));
+
+  g_object_unref (list);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_list_append_existing)
+{
+  GstdList *list = test_list_new ();
+  GstdObject *n0 = test_node_new ("n0");
+  GstdObject *duplicate = test_node_new ("n0");
+  GstdObject *found;
+
+  fail_unless (gstd_list_append_child (list, n0));
+  fail_if (gstd_list_append_child (list, duplicate));
+  fail_unless_equals_int (1, test_list_count (list));
+
+  /* The node already listed is kept */
+  found = gstd_list_find_child (list, "n0");
+  fail_unless (n0 == found);
+  g_object_unref (found);
+
+  g_object_unref (duplicate);
+  g_object_unref (list);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_list_remove)
+{
+  GstdList *list = test_list_new ();
+  GstdObject *n0 = test_node_new ("n0");
+  GstdObject *n1 = test_node_new ("n1");
+  GstdObject *found;
+
+  fail_unless (gstd_list_append_child (list, n0));
+  fail_unless (gstd_list_append_child (list, n1));
+
+  fail_unless (gstd_list_remove_child (list, "n0"));
+  fail_unless_equals_int (1, test_list_count (list));
+  fail_unless (NULL == gstd_list_find_child (list, "n0"));
+  fail_if (gstd_list_remove_child (list, "n0"));
+
+  found = gstd_list_find_child (list, "n1");
+  fail_unless (n1 == found);
+  g_object_unref (found);
+
+  /* The name is free again */
+  fail_unless (gstd_list_append_child (list, test_node_new ("n0")));
+  fail_unless_equals_int (2, test_list_count (list));
+
+  g_object_unref (list);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_list_keeps_order)
+{
+  GstdList *list = test_list_new ();
+  GList *node;
+  gchar *name;
+  gint i;
+
+  for (i = 0; i < 8; i++) {
+    name = g_strdup_printf ("n%d", i);
+    fail_unless (gstd_list_append_child (list, test_node_new (name)));
+    g_free (name);
+  }
+
+  fail_unless (gstd_list_remove_child (list, "n0"));
+  fail_unless (gstd_list_remove_child (list, "n4"));
+  fail_unless (gstd_list_remove_child (list, "n7"));
+  fail_unless (gstd_list_append_child (list, test_node_new ("n4")));
+
+  /* Nodes stay in the order they were appended */
+  node = list->list;
+  fail_unless_equals_string ("n1", GSTD_OBJECT_NAME (node->data));
+  node = node->next;
+  fail_unless_equals_string ("n2", GSTD_OBJECT_NAME (node->data));
+  node = node->next;
+  fail_unless_equals_string ("n3", GSTD_OBJECT_NAME (node->data));
+  node = node->next;
+  fail_unless_equals_string ("n5", GSTD_OBJECT_NAME (node->data));
+  node = node->next;
+  fail_unless_equals_string ("n6", GSTD_OBJECT_NAME (node->data));
+  node = node->next;
+  fail_unless_equals_string ("n4", GSTD_OBJECT_NAME (node->data));
+  fail_unless (NULL == node->next);
+
+  fail_unless_equals_int (6, test_list_count (list));
+  fail_unless_equals_int (6, g_hash_table_size (list->index));
+
+  g_object_unref (list);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_list_delete_unexisting)
+{
+  GstdList *list = test_list_new ();
+
+  fail_unless (gstd_list_append_child (list, test_node_new ("n0")));
+  fail_unless_equals_int (GSTD_NO_RESOURCE,
+      gstd_object_delete (GSTD_OBJECT (list), "n1"));
+  fail_unless_equals_int (1, test_list_count (list));
+
+  g_object_unref (list);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_list_delete_failed)
+{
+  GstdList *list = test_list_new ();
+  TestDeleter *deleter;
+  GstdObject *n1 = test_node_new ("n1");
+  GstdObject *found;
+  GList *node;
+
+  deleter = g_object_new (test_deleter_get_type (), NULL);
+  deleter->list = list;
+  gstd_object_set_deleter (GSTD_OBJECT (list), GSTD_IDELETER (deleter));
+
+  fail_unless (gstd_list_append_child (list, test_node_new ("n0")));
+  fail_unless (gstd_list_append_child (list, n1));
+  fail_unless (gstd_list_append_child (list, test_node_new ("n2")));
+
+  fail_unless_equals_int (GSTD_STATE_ERROR,
+      gstd_object_delete (GSTD_OBJECT (list), "n1"));
+
+  /* The name can't be taken while the deleter runs */
+  fail_if (deleter->taken);
+
+  /* Listed back where it was */
+  node = list->list;
+  fail_unless_equals_string ("n0", GSTD_OBJECT_NAME (node->data));
+  node = node->next;
+  fail_unless (n1 == node->data);
+  node = node->next;
+  fail_unless_equals_string ("n2", GSTD_OBJECT_NAME (node->data));
+  fail_unless (NULL == node->next);
+
+  found = gstd_list_find_child (list, "n1");
+  fail_unless (n1 == found);
+  g_object_unref (found);
+  fail_unless_equals_int (3, test_list_count (list));
+  fail_unless_equals_int (0, g_hash_table_size (list->deleting));
+
+  g_object_unref (list);
+}
+
+GST_END_TEST;
+
+
+static Suite *
+gstd_list_suite (void)
+{
+  Suite *suite = suite_create ("gstd_list");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_list_find_appended);
+  tcase_add_test (tc, test_list_append_existing);
+  tcase_add_test (tc, test_list_remove);
+  tcase_add_test (tc, test_list_keeps_order);
+  tcase_add_test (tc, test_list_delete_unexisting);
+  tcase_add_test (tc, test_list_delete_failed);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_list);
@@ -0,0 +1,283 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_session.h"
+
+#define TEST_PIPELINE "fakesrc name=src ! testconstruct name=tc ! fakesink"
+
+/* An element with a property that can only be set on construction */
+typedef struct _TestConstruct TestConstruct;
+typedef struct _TestConstructClass TestConstructClass;
+
+struct _TestConstruct
+{
+  GstElement parent;
+
+  gint fixed;
+  gint mutable;
+  GstPad *sinkpad;
+  GstPad *srcpad;
+};
+
+struct _TestConstructClass
+{
+  GstElementClass parent_class;
+};
+
+enum
+{
+  PROP_FIXED = 1,
+  PROP_MUTABLE,
+};
+
+static GstStaticPadTemplate test_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS_ANY);
+static GstStaticPadTemplate test_src_template =
+GST_STATIC_PAD_TEMPLATE ("src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS_ANY);
+
+G_DEFINE_TYPE (TestConstruct, test_construct, GST_TYPE_ELEMENT);
+
+static void
+test_construct_set_property (GObject * object, guint property_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  TestConstruct *self = (TestConstruct *) object;
+
+  switch (property_id) {
+    case PROP_FIXED:
+      self->fixed = g_value_get_int (value);
+      break;
+    case PROP_MUTABLE:
+      self->mutable = g_value_get_int (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+test_construct_get_property (GObject * object, guint property_id,
+    GValue * value, GParamSpec * pspec)
+{
+  TestConstruct *self = (TestConstruct *) object;
+
+  switch (property_id) {
+    case PROP_FIXED:
+      g_value_set_int (value, self->fixed);
+      break;
+    case PROP_MUTABLE:
+      g_value_set_int (value, self->mutable);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+test_construct_class_init (TestConstructClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+
+  object_class->set_property = test_construct_set_property;
+  object_class->get_property = test_construct_get_property;
+
+  g_object_class_install_property (object_class, PROP_FIXED,
+      g_param_spec_int ("fixed", "Fixed", "Set on construction only",
+          0, G_MAXINT, 0, G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+  g_object_class_install_property (object_class, PROP_MUTABLE,
+      g_param_spec_int ("mutable", "Mutable", "Set at any time",
+          0, G_MAXINT, 0, G_PARAM_READWRITE));
+
+  gst_element_class_add_static_pad_template (element_class,
+      &test_sink_template);
+  gst_element_class_add_static_pad_template (element_class,
+      &test_src_template);
+  gst_element_class_set_static_metadata (element_class, "Test construct",
+      "Generic", "Has a construct only property", "Gstd");
+}
+
+static void
+test_construct_init (TestConstruct * self)
+{
+  self->sinkpad = gst_pad_new_from_static_template (&test_sink_template,
+      "sink");
+  self->srcpad = gst_pad_new_from_static_template (&test_src_template, "src");
+  gst_element_add_pad (GST_ELEMENT (self), self->sinkpad);
+  gst_element_add_pad (GST_ELEMENT (self), self->srcpad);
+}
+
+static GstElement *
+test_batch_element (GstdSession * session, const gchar * name)
+{
+  GstdObject *node;
+  GstElement *pipeline;
+  GstElement *element;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, "/pipelines", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, "p0", TEST_PIPELINE);
+  fail_if (ret);
+  gst_object_unref (node);
+
+  ret = gstd_get_by_uri (session, "/pipelines/p0", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  g_object_get (node, "pipeline", &pipeline, NULL);
+  fail_if (NULL == pipeline);
+  gst_object_unref (node);
+
+  element = gst_bin_get_by_name (GST_BIN (pipeline), name);
+  fail_if (NULL == element);
+  gst_object_unref (pipeline);
+
+  return element;
+}
+
+static GstdReturnCode
+test_batch_update (GstdSession * session, const gchar * value)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, "/pipelines/p0/batch", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_update (node, value);
+  gst_object_unref (node);
+
+  return ret;
+}
+
+static guint
+test_batch_applied (GstdSession * session)
+{
+  GstdObject *node;
+  guint applied;
+
+  fail_if (gstd_get_by_uri (session, "/pipelines/p0/batch", &node));
+  g_object_get (node, "applied", &applied, NULL);
+  gst_object_unref (node);
+
+  return applied;
+}
+
+
+GST_START_TEST (test_batch_stopped)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstElement *element;
+  gint mutable;
+
+  element = test_batch_element (test_session, "tc");
+
+  /* Nothing is flowing, applied right away */
+  fail_if (test_batch_update (test_session, "tc.mutable=3"));
+  g_object_get (element, "mutable", &mutable, NULL);
+  fail_unless_equals_int (3, mutable);
+  fail_unless_equals_int (1, test_batch_applied (test_session));
+
+  gst_object_unref (element);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_batch_construct_only)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstElement *element;
+  gint mutable;
+
+  element = test_batch_element (test_session, "tc");
+
+  /* Refused as a whole, the other sets aren't applied either */
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      test_batch_update (test_session, "tc.mutable=3 tc.fixed=1"));
+  g_object_get (element, "mutable", &mutable, NULL);
+  fail_unless_equals_int (0, mutable);
+  fail_unless_equals_int (0, test_batch_applied (test_session));
+
+  gst_object_unref (element);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_batch_malformed)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstElement *element;
+
+  element = test_batch_element (test_session, "tc");
+
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      test_batch_update (test_session, "tc.mutable"));
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      test_batch_update (test_session, "tc.mutable=three"));
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      test_batch_update (test_session, "at=soon tc.mutable=3"));
+  fail_unless_equals_int (GSTD_NO_RESOURCE,
+      test_batch_update (test_session, "nosuchelement.mutable=3"));
+  fail_unless_equals_int (GSTD_NO_RESOURCE,
+      test_batch_update (test_session, "tc.nosuchproperty=3"));
+  fail_unless_equals_int (0, test_batch_applied (test_session));
+
+  gst_object_unref (element);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+static Suite *
+gstd_pipeline_batch_suite (void)
+{
+  Suite *suite = suite_create ("gstd_pipeline_batch");
+  TCase *tc = tcase_create ("general");
+
+  gst_element_register (NULL, "testconstruct", GST_RANK_NONE,
+      test_construct_get_type ());
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_batch_stopped);
+  tcase_add_test (tc, test_batch_construct_only);
+  tcase_add_test (tc, test_batch_malformed);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_pipeline_batch);
@@ -0,0 +1,113 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_session.h"
+#include "gstd_pipeline_bulk.h"
+
+
+GST_START_TEST (test_pipeline_bulk_is_bulk)
+{
+  fail_if (gstd_pipeline_bulk_is_bulk ("cam_0"));
+  fail_unless (gstd_pipeline_bulk_is_bulk ("cam_*"));
+  fail_unless (gstd_pipeline_bulk_is_bulk ("*"));
+  fail_unless (gstd_pipeline_bulk_is_bulk ("cam_0,cam_1"));
+  fail_unless (gstd_pipeline_bulk_is_bulk ("cam_0 cam_1"));
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_pipeline_bulk_glob)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+  gchar *response = NULL;
+  GstdSession *test_session = gstd_session_new ("Test_session");
+
+  ret = gstd_get_by_uri (test_session, "/pipelines", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, "cam_0", "fakesrc ! fakesink");
+  fail_if (GSTD_EOK != ret);
+  ret = gstd_object_create (node, "cam_1", "fakesrc ! fakesink");
+  fail_if (GSTD_EOK != ret);
+  ret = gstd_object_create (node, "other", "fakesrc ! fakesink");
+  fail_if (GSTD_EOK != ret);
+
+  ret = gstd_pipeline_bulk_set_state (test_session->pipelines, "cam_*",
+      "playing", &response);
+  fail_if (GSTD_EOK != ret);
+  fail_if (NULL == response);
+  fail_if (NULL == strstr (response, "cam_0"));
+  fail_if (NULL == strstr (response, "cam_1"));
+  fail_if (NULL != strstr (response, "other"));
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_pipeline_bulk_set_state (test_session->pipelines, "*",
+      "null", &response);
+  fail_if (GSTD_EOK != ret);
+  g_free (response);
+
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_pipeline_bulk_no_match)
+{
+  GstdReturnCode ret;
+  gchar *response = NULL;
+  GstdSession *test_session = gstd_session_new ("Test_session");
+
+  ret = gstd_pipeline_bulk_set_state (test_session->pipelines, "none_*",
+      "playing", &response);
+  fail_if (GSTD_NO_PIPELINE != ret);
+  fail_if (NULL != response);
+
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+static Suite *
+gstd_pipeline_bulk_suite (void)
+{
+  Suite *suite = suite_create ("gstd_pipeline_bulk");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_pipeline_bulk_is_bulk);
+  tcase_add_test (tc, test_pipeline_bulk_glob);
+  tcase_add_test (tc, test_pipeline_bulk_no_match);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_pipeline_bulk);
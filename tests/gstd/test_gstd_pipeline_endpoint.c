@@ -0,0 +1,467 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <gst/check/gstcheck.h>
+
+#include "gstd_pipeline_endpoint.h"
+
+#define TEST_CAPS "application/x-gstd-test"
+
+typedef struct
+{
+  GstdEndpointHeader *header;
+  gsize size;
+} TestRing;
+
+/* Maps the ring the way a client would */
+static void
+test_ring_map (GstdPipelineEndpoint * endpoint, TestRing * ring)
+{
+  struct stat st;
+  gchar *path;
+  gint fd;
+
+  g_object_get (endpoint, "path", &path, NULL);
+  fail_if (NULL == path);
+
+  fd = open (path, O_RDWR);
+  fail_if (fd < 0);
+  fail_if (fstat (fd, &st));
+
+  ring->size = st.st_size;
+  ring->header = mmap (NULL, ring->size, PROT_READ | PROT_WRITE, MAP_SHARED,
+      fd, 0);
+  fail_if (MAP_FAILED == ring->header);
+
+  close (fd);
+  g_free (path);
+}
+
+static void
+test_ring_unmap (TestRing * ring)
+{
+  munmap (ring->header, ring->size);
+}
+
+static GstdEndpointSlot *
+test_ring_slot (TestRing * ring, guint index)
+{
+  guint8 *base = (guint8 *) ring->header;
+
+  return (GstdEndpointSlot *) (base + ring->header->slot_offset +
+      index * ring->header->slot_stride);
+}
+
+/* Writes a buffer of 16 bytes to the slot and hands it to the daemon */
+static void
+test_slot_write (GstdEndpointSlot * slot, guint seq, guint caps_seq)
+{
+  memset (slot + 1, seq, 16);
+  slot->size = 16;
+  slot->flags = 0;
+  slot->caps_seq = caps_seq;
+  slot->pts = GST_CLOCK_TIME_NONE;
+  slot->dts = GST_CLOCK_TIME_NONE;
+  slot->duration = GST_CLOCK_TIME_NONE;
+  slot->seq = seq;
+  g_atomic_int_set (&slot->state, GSTD_ENDPOINT_SLOT_READY);
+}
+
+static void
+test_pipeline_wait_eos (GstElement * pipeline)
+{
+  GstBus *bus;
+  GstMessage *message;
+
+  bus = gst_element_get_bus (pipeline);
+  message = gst_bus_timed_pop_filtered (bus, 5 * GST_SECOND,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_if (NULL == message);
+  fail_unless_equals_int (GST_MESSAGE_EOS, GST_MESSAGE_TYPE (message));
+
+  gst_message_unref (message);
+  gst_object_unref (bus);
+}
+
+static GstElement *
+test_pipeline_new (const gchar * description)
+{
+  GstElement *pipeline;
+  GError *error = NULL;
+
+  pipeline = gst_parse_launch (description, &error);
+  fail_if (NULL == pipeline);
+  fail_if (NULL != error);
+
+  return pipeline;
+}
+
+static guint64
+test_endpoint_counter (GstdPipelineEndpoint * endpoint, const gchar * name)
+{
+  guint64 counter;
+
+  g_object_get (endpoint, name, &counter, NULL);
+
+  return counter;
+}
+
+
+GST_START_TEST (test_endpoint_ring_layout)
+{
+  GstElement *pipeline;
+  GstdPipelineEndpoint *endpoint;
+  TestRing ring;
+
+  pipeline = test_pipeline_new ("fakesrc ! appsink name=sink");
+  endpoint = gstd_pipeline_endpoint_new ("e0", "sink 4 64");
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_pipeline_endpoint_attach (endpoint, GST_BIN (pipeline)));
+
+  test_ring_map (endpoint, &ring);
+  fail_unless_equals_int (GSTD_ENDPOINT_MAGIC, ring.header->magic);
+  fail_unless_equals_int (GSTD_ENDPOINT_VERSION, ring.header->version);
+  fail_unless_equals_int (4, ring.header->slots);
+  fail_unless_equals_int (64, ring.header->slot_size);
+  fail_unless (ring.header->slot_offset >= sizeof (GstdEndpointHeader));
+  fail_unless (ring.header->slot_stride >= sizeof (GstdEndpointSlot) + 64);
+  fail_unless (ring.header->slot_offset + 4 * ring.header->slot_stride <=
+      ring.size);
+  fail_unless_equals_int (0, ring.header->caps_seq);
+  fail_unless_equals_int (GSTD_ENDPOINT_SLOT_FREE,
+      test_ring_slot (&ring, 3)->state);
+
+  gstd_pipeline_endpoint_detach (endpoint);
+  test_ring_unmap (&ring);
+  g_object_unref (endpoint);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_endpoint_attach_invalid)
+{
+  GstElement *pipeline;
+  GstdPipelineEndpoint *endpoint;
+
+  pipeline = test_pipeline_new ("fakesrc name=src ! appsink name=sink");
+
+  endpoint = gstd_pipeline_endpoint_new ("e0", "other");
+  fail_unless_equals_int (GSTD_NO_RESOURCE,
+      gstd_pipeline_endpoint_attach (endpoint, GST_BIN (pipeline)));
+  g_object_unref (endpoint);
+
+  endpoint = gstd_pipeline_endpoint_new ("e0", "sink 0");
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      gstd_pipeline_endpoint_attach (endpoint, GST_BIN (pipeline)));
+  g_object_unref (endpoint);
+
+  endpoint = gstd_pipeline_endpoint_new ("e0", "src");
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      gstd_pipeline_endpoint_attach (endpoint, GST_BIN (pipeline)));
+  g_object_unref (endpoint);
+
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_endpoint_pull)
+{
+  GstElement *pipeline;
+  GstdPipelineEndpoint *endpoint;
+  GstdEndpointSlot *slot;
+  TestRing ring;
+  gchar *path;
+  guint i;
+
+  pipeline = test_pipeline_new ("fakesrc num-buffers=3 sizetype=fixed "
+      "sizemax=16 ! capsfilter caps=" TEST_CAPS " ! appsink name=sink "
+      "sync=false");
+  endpoint = gstd_pipeline_endpoint_new ("e0", "sink 4 64");
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_pipeline_endpoint_attach (endpoint, GST_BIN (pipeline)));
+  test_ring_map (endpoint, &ring);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  test_pipeline_wait_eos (pipeline);
+
+  /* The caps were written once, and left even */
+  fail_unless_equals_int (2, g_atomic_int_get (&ring.header->caps_seq));
+  fail_unless_equals_string (TEST_CAPS, ring.header->caps);
+  fail_unless (g_atomic_int_get (&ring.header->eos));
+
+  for (i = 0; i < 3; i++) {
+    slot = test_ring_slot (&ring, i);
+    fail_unless_equals_int (GSTD_ENDPOINT_SLOT_READY,
+        g_atomic_int_get (&slot->state));
+    fail_unless_equals_int (i, slot->seq);
+    fail_unless_equals_int (16, slot->size);
+    fail_unless_equals_int (2, slot->caps_seq);
+  }
+  fail_unless_equals_int (GSTD_ENDPOINT_SLOT_FREE,
+      g_atomic_int_get (&test_ring_slot (&ring, 3)->state));
+
+  fail_unless_equals_int (3, test_endpoint_counter (endpoint, "samples"));
+  fail_unless_equals_int (0, test_endpoint_counter (endpoint, "dropped"));
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+
+  /* The file goes away, the mapping stays valid */
+  g_object_get (endpoint, "path", &path, NULL);
+  gstd_pipeline_endpoint_detach (endpoint);
+  fail_if (g_file_test (path, G_FILE_TEST_EXISTS));
+  fail_unless_equals_int (GSTD_ENDPOINT_MAGIC, ring.header->magic);
+  g_free (path);
+
+  test_ring_unmap (&ring);
+  g_object_unref (endpoint);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_endpoint_pull_drops)
+{
+  GstElement *pipeline;
+  GstdPipelineEndpoint *endpoint;
+  TestRing ring;
+
+  /* The client never frees a slot, so the ring fills up */
+  pipeline = test_pipeline_new ("fakesrc num-buffers=5 sizetype=fixed "
+      "sizemax=16 ! appsink name=sink sync=false");
+  endpoint = gstd_pipeline_endpoint_new ("e0", "sink 2 64");
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_pipeline_endpoint_attach (endpoint, GST_BIN (pipeline)));
+  test_ring_map (endpoint, &ring);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  test_pipeline_wait_eos (pipeline);
+
+  fail_unless_equals_int (2, test_endpoint_counter (endpoint, "samples"));
+  fail_unless_equals_int (3, test_endpoint_counter (endpoint, "dropped"));
+  fail_unless_equals_int (0, test_ring_slot (&ring, 0)->seq);
+  fail_unless_equals_int (1, test_ring_slot (&ring, 1)->seq);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gstd_pipeline_endpoint_detach (endpoint);
+  test_ring_unmap (&ring);
+  g_object_unref (endpoint);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_endpoint_pull_oversized)
+{
+  GstElement *pipeline;
+  GstdPipelineEndpoint *endpoint;
+
+  pipeline = test_pipeline_new ("fakesrc num-buffers=2 sizetype=fixed "
+      "sizemax=16 ! appsink name=sink sync=false");
+  endpoint = gstd_pipeline_endpoint_new ("e0", "sink 4 8");
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_pipeline_endpoint_attach (endpoint, GST_BIN (pipeline)));
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  test_pipeline_wait_eos (pipeline);
+
+  fail_unless_equals_int (0, test_endpoint_counter (endpoint, "samples"));
+  fail_unless_equals_int (2, test_endpoint_counter (endpoint, "dropped"));
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gstd_pipeline_endpoint_detach (endpoint);
+  g_object_unref (endpoint);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_endpoint_push)
+{
+  GstElement *pipeline;
+  GstdPipelineEndpoint *endpoint;
+  GstdEndpointSlot *slot;
+  TestRing ring;
+  gchar *caps;
+  guint i;
+
+  pipeline = test_pipeline_new ("appsrc name=src ! fakesink "
+      "enable-last-sample=false");
+  endpoint = gstd_pipeline_endpoint_new ("e0", "src 4 64");
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_pipeline_endpoint_attach (endpoint, GST_BIN (pipeline)));
+  test_ring_map (endpoint, &ring);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  /* Write the caps under their sequence lock, then the slots */
+  g_atomic_int_inc (&ring.header->caps_seq);
+  g_strlcpy (ring.header->caps, TEST_CAPS, GSTD_ENDPOINT_CAPS_SIZE);
+  g_atomic_int_inc (&ring.header->caps_seq);
+
+  for (i = 0; i < 2; i++) {
+    test_slot_write (test_ring_slot (&ring, i), i, 2);
+  }
+  g_atomic_int_set (&ring.header->eos, TRUE);
+
+  test_pipeline_wait_eos (pipeline);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+
+  fail_unless_equals_int (2, test_endpoint_counter (endpoint, "samples"));
+  fail_unless_equals_int (0, test_endpoint_counter (endpoint, "dropped"));
+
+  g_object_get (endpoint, "caps", &caps, NULL);
+  fail_unless_equals_string (TEST_CAPS, caps);
+  g_free (caps);
+
+  /* Handed back to the client once the pipeline let go of them */
+  for (i = 0; i < 2; i++) {
+    slot = test_ring_slot (&ring, i);
+    fail_unless_equals_int (GSTD_ENDPOINT_SLOT_FREE,
+        g_atomic_int_get (&slot->state));
+  }
+
+  gstd_pipeline_endpoint_detach (endpoint);
+  test_ring_unmap (&ring);
+  g_object_unref (endpoint);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_endpoint_push_tampered_layout)
+{
+  GstElement *pipeline;
+  GstdPipelineEndpoint *endpoint;
+  GstdEndpointSlot *slots[2];
+  TestRing ring;
+  guint i;
+
+  pipeline = test_pipeline_new ("appsrc name=src ! fakesink "
+      "enable-last-sample=false");
+  endpoint = gstd_pipeline_endpoint_new ("e0", "src 4 64");
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_pipeline_endpoint_attach (endpoint, GST_BIN (pipeline)));
+  test_ring_map (endpoint, &ring);
+
+  for (i = 0; i < 2; i++) {
+    slots[i] = test_ring_slot (&ring, i);
+  }
+
+  /* The layout in the header is only informative for the client, the
+     daemon keeps its own */
+  ring.header->slot_offset = G_MAXUINT64 / 2;
+  ring.header->slot_stride = G_MAXUINT32;
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  for (i = 0; i < 2; i++) {
+    test_slot_write (slots[i], i, 0);
+  }
+  g_atomic_int_set (&ring.header->eos, TRUE);
+
+  test_pipeline_wait_eos (pipeline);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+
+  fail_unless_equals_int (2, test_endpoint_counter (endpoint, "samples"));
+
+  gstd_pipeline_endpoint_detach (endpoint);
+  test_ring_unmap (&ring);
+  g_object_unref (endpoint);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_endpoint_push_locked_caps)
+{
+  GstElement *pipeline;
+  GstdPipelineEndpoint *endpoint;
+  TestRing ring;
+
+  pipeline = test_pipeline_new ("appsrc name=src ! fakesink "
+      "enable-last-sample=false");
+  endpoint = gstd_pipeline_endpoint_new ("e0", "src 4 64");
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_pipeline_endpoint_attach (endpoint, GST_BIN (pipeline)));
+  test_ring_map (endpoint, &ring);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  /* A client that starts writing the caps and never finishes */
+  g_atomic_int_inc (&ring.header->caps_seq);
+  test_slot_write (test_ring_slot (&ring, 0), 0, 2);
+  g_atomic_int_set (&ring.header->eos, TRUE);
+
+  /* The slot is pushed with the current caps */
+  test_pipeline_wait_eos (pipeline);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+
+  fail_unless_equals_int (1, test_endpoint_counter (endpoint, "samples"));
+
+  /* Neither blocks detaching */
+  test_slot_write (test_ring_slot (&ring, 1), 1, 2);
+  gstd_pipeline_endpoint_detach (endpoint);
+
+  test_ring_unmap (&ring);
+  g_object_unref (endpoint);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+static Suite *
+gstd_pipeline_endpoint_suite (void)
+{
+  Suite *suite = suite_create ("gstd_pipeline_endpoint");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_endpoint_ring_layout);
+  tcase_add_test (tc, test_endpoint_attach_invalid);
+  tcase_add_test (tc, test_endpoint_pull);
+  tcase_add_test (tc, test_endpoint_pull_drops);
+  tcase_add_test (tc, test_endpoint_pull_oversized);
+  tcase_add_test (tc, test_endpoint_push);
+  tcase_add_test (tc, test_endpoint_push_tampered_layout);
+  tcase_add_test (tc, test_endpoint_push_locked_caps);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_pipeline_endpoint);
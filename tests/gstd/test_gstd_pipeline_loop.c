@@ -0,0 +1,272 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_session.h"
+
+/* A short stream that can be seeked in time */
+#define TEST_LOOPED \
+  "fakesrc format=time can-activate-pull=true num-buffers=10 ! fakesink"
+#define TEST_WAIT (500 * G_TIME_SPAN_MILLISECOND)
+
+typedef struct _TestCounts TestCounts;
+struct _TestCounts
+{
+  guint segments;
+  guint eos;
+};
+
+static GstdObject *
+test_pipeline_new (GstdSession * session)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, "/pipelines", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, "p0", TEST_LOOPED);
+  fail_if (ret);
+  gst_object_unref (node);
+
+  ret = gstd_get_by_uri (session, "/pipelines/p0", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  return node;
+}
+
+static void
+test_pipeline_update (GstdSession * session, const gchar * uri,
+    const gchar * value)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, uri, &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_update (node, value);
+  gst_object_unref (node);
+  fail_if (ret);
+}
+
+static void
+test_pipeline_seek (GstdSession * session)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  /* A flushing seek to the start, by default */
+  ret = gstd_get_by_uri (session, "/pipelines/p0/event", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, "seek", NULL);
+  gst_object_unref (node);
+  fail_if (ret);
+}
+
+/* Loops are driven from the default main context, which is iterated
+   while the bus is drained */
+static void
+test_pipeline_run (GstdObject * node, TestCounts * counts)
+{
+  GstElement *pipeline;
+  GstMessage *message;
+  GstBus *bus;
+  gint64 deadline = g_get_monotonic_time () + TEST_WAIT;
+
+  g_object_get (node, "pipeline", &pipeline, NULL);
+  fail_if (NULL == pipeline);
+  bus = gst_pipeline_get_bus (GST_PIPELINE (pipeline));
+
+  counts->segments = 0;
+  counts->eos = 0;
+
+  while (g_get_monotonic_time () < deadline) {
+    while (g_main_context_iteration (NULL, FALSE));
+
+    message = gst_bus_timed_pop_filtered (bus, 10 * GST_MSECOND,
+        GST_MESSAGE_SEGMENT_DONE | GST_MESSAGE_EOS);
+    if (!message) {
+      continue;
+    }
+
+    if (GST_MESSAGE_EOS == GST_MESSAGE_TYPE (message)) {
+      counts->eos++;
+    } else {
+      counts->segments++;
+    }
+    gst_message_unref (message);
+  }
+
+  gst_object_unref (bus);
+  gst_object_unref (pipeline);
+}
+
+
+GST_START_TEST (test_loop_disabled)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdObject *node;
+  TestCounts counts;
+
+  node = test_pipeline_new (test_session);
+  test_pipeline_update (test_session, "/pipelines/p0/state", "playing");
+
+  test_pipeline_run (node, &counts);
+  fail_unless_equals_int (0, counts.segments);
+  fail_unless_equals_int (1, counts.eos);
+
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_loop_enabled)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdObject *node;
+  TestCounts counts;
+
+  node = test_pipeline_new (test_session);
+  g_object_set (node, "loop", TRUE, NULL);
+  test_pipeline_update (test_session, "/pipelines/p0/state", "playing");
+
+  test_pipeline_run (node, &counts);
+  fail_unless (counts.segments > 0);
+  fail_unless_equals_int (0, counts.eos);
+
+  /* Finishes as a regular stream once disabled */
+  g_object_set (node, "loop", FALSE, NULL);
+  test_pipeline_run (node, &counts);
+  fail_unless_equals_int (1, counts.eos);
+
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_loop_enabled_prerolled)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdObject *node;
+  TestCounts counts;
+
+  node = test_pipeline_new (test_session);
+  test_pipeline_update (test_session, "/pipelines/p0/state", "paused");
+
+  /* Armed from the main context, without a new preroll */
+  g_object_set (node, "loop", TRUE, NULL);
+  while (g_main_context_iteration (NULL, FALSE));
+  test_pipeline_update (test_session, "/pipelines/p0/state", "playing");
+
+  test_pipeline_run (node, &counts);
+  fail_unless (counts.segments > 0);
+  fail_unless_equals_int (0, counts.eos);
+
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_loop_client_seek)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdObject *node;
+  TestCounts counts;
+
+  node = test_pipeline_new (test_session);
+  g_object_set (node, "loop", TRUE, NULL);
+  test_pipeline_update (test_session, "/pipelines/p0/state", "playing");
+
+  test_pipeline_run (node, &counts);
+  fail_unless (counts.segments > 0);
+
+  /* The client seek replaces the looping segment, which is armed again
+     once it completes */
+  test_pipeline_seek (test_session);
+  test_pipeline_run (node, &counts);
+  fail_unless (counts.segments > 0);
+  fail_unless_equals_int (0, counts.eos);
+
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_loop_restarted)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdObject *node;
+  TestCounts counts;
+
+  node = test_pipeline_new (test_session);
+  g_object_set (node, "loop", TRUE, NULL);
+  test_pipeline_update (test_session, "/pipelines/p0/state", "playing");
+  test_pipeline_run (node, &counts);
+
+  /* Stopping disarms it, playing again prerolls and arms it again */
+  test_pipeline_update (test_session, "/pipelines/p0/state", "null");
+  test_pipeline_update (test_session, "/pipelines/p0/state", "playing");
+
+  test_pipeline_run (node, &counts);
+  fail_unless (counts.segments > 0);
+  fail_unless_equals_int (0, counts.eos);
+
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+static Suite *
+gstd_pipeline_loop_suite (void)
+{
+  Suite *suite = suite_create ("gstd_pipeline_loop");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_loop_disabled);
+  tcase_add_test (tc, test_loop_enabled);
+  tcase_add_test (tc, test_loop_enabled_prerolled);
+  tcase_add_test (tc, test_loop_client_seek);
+  tcase_add_test (tc, test_loop_restarted);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_pipeline_loop);
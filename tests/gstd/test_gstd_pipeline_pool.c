@@ -0,0 +1,124 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_session.h"
+#include "gstd_pipeline_pool.h"
+
+
+GST_START_TEST (test_pipeline_pool_create_successful)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_session_new ("Test_session");
+
+  ret = gstd_get_by_uri (test_session, "/pools", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, "pool0", "fakesrc ! fakesink");
+  fail_if (GSTD_EOK != ret);
+
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_pipeline_pool_create_erroneous_description)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_session_new ("Test_session");
+
+  ret = gstd_get_by_uri (test_session, "/pools", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, "pool1", "fakesrc !");
+  fail_if (GSTD_BAD_DESCRIPTION != ret);
+
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_pipeline_pool_take)
+{
+  GstdObject *node;
+  GstdObject *pool;
+  GstdPipeline *pipeline;
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_session_new ("Test_session");
+
+  ret = gstd_get_by_uri (test_session, "/pools", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, "pool2", "fakesrc ! fakesink");
+  fail_if (GSTD_EOK != ret);
+
+  ret = gstd_get_by_uri (test_session, "/pools/pool2", &pool);
+  fail_if (ret);
+  fail_if (!GSTD_IS_PIPELINE_POOL (pool));
+
+  /* Take more instances than the pool holds to exercise the cold path */
+  ret = gstd_pipeline_pool_take (GSTD_PIPELINE_POOL (pool), "p0", &pipeline);
+  fail_if (GSTD_EOK != ret);
+  fail_if (NULL == pipeline);
+  fail_if (g_strcmp0 ("p0", GSTD_OBJECT_NAME (pipeline)));
+  g_object_unref (pipeline);
+
+  ret = gstd_pipeline_pool_take (GSTD_PIPELINE_POOL (pool), "p1", &pipeline);
+  fail_if (GSTD_EOK != ret);
+  fail_if (NULL == pipeline);
+  fail_if (g_strcmp0 ("p1", GSTD_OBJECT_NAME (pipeline)));
+  g_object_unref (pipeline);
+
+  gst_object_unref (pool);
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+static Suite *
+gstd_pipeline_pool_suite (void)
+{
+  Suite *suite = suite_create ("gstd_pipeline_pool");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_pipeline_pool_create_successful);
+  tcase_add_test (tc, test_pipeline_pool_create_erroneous_description);
+  tcase_add_test (tc, test_pipeline_pool_take);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_pipeline_pool);
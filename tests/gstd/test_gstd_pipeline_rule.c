@@ -0,0 +1,194 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_pipeline_rule.h"
+
+#define TEST_PIPELINE \
+  "fakesrc ! identity name=id ! fakesink ( name=inner fakesrc ! fakesink )"
+
+static GstElement *
+test_pipeline_new (void)
+{
+  GstElement *pipeline;
+  GError *error = NULL;
+
+  pipeline = gst_parse_launch (TEST_PIPELINE, &error);
+  fail_if (NULL == pipeline);
+  fail_if (NULL != error);
+
+  return pipeline;
+}
+
+static GstdPipelineRule *
+test_rule_bind (GstElement * pipeline, const gchar * description)
+{
+  GstdPipelineRule *rule;
+
+  rule = gstd_pipeline_rule_new ("r0", description);
+  fail_unless_equals_int (GSTD_EOK, gstd_pipeline_rule_build (rule));
+  gstd_pipeline_rule_bind (rule, GST_BIN (pipeline));
+
+  return rule;
+}
+
+static guint
+test_rule_hits (GstdPipelineRule * rule)
+{
+  guint hits;
+
+  g_object_get (rule, "hits", &hits, NULL);
+
+  return hits;
+}
+
+static GstElement *
+test_pipeline_element (GstElement * pipeline, const gchar * name)
+{
+  GstElement *element;
+
+  element = gst_bin_get_by_name (GST_BIN (pipeline), name);
+  fail_if (NULL == element);
+
+  return element;
+}
+
+
+GST_START_TEST (test_rule_build_invalid)
+{
+  GstdPipelineRule *rule;
+
+  rule = gstd_pipeline_rule_new ("r0", "signal=id.handoff");
+  fail_unless_equals_int (GSTD_MISSING_ARGUMENT,
+      gstd_pipeline_rule_build (rule));
+  g_object_unref (rule);
+
+  rule = gstd_pipeline_rule_new ("r0", "other=id.handoff list_pipelines");
+  fail_unless_equals_int (GSTD_BAD_VALUE, gstd_pipeline_rule_build (rule));
+  g_object_unref (rule);
+
+  rule = gstd_pipeline_rule_new ("r0", "signal=id.handoff ; ;");
+  fail_unless_equals_int (GSTD_MISSING_ARGUMENT,
+      gstd_pipeline_rule_build (rule));
+  g_object_unref (rule);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_rule_signal)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdPipelineRule *rule;
+  GstElement *identity;
+  GstBuffer *buffer;
+
+  rule = test_rule_bind (pipeline, "signal=id.handoff list_pipelines");
+  identity = test_pipeline_element (pipeline, "id");
+
+  buffer = gst_buffer_new ();
+  g_signal_emit_by_name (identity, "handoff", buffer);
+  g_signal_emit_by_name (identity, "handoff", buffer);
+  fail_unless_equals_int (2, test_rule_hits (rule));
+
+  /* Unbound rules are no longer triggered */
+  gstd_pipeline_rule_unbind (rule);
+  g_signal_emit_by_name (identity, "handoff", buffer);
+  fail_unless_equals_int (2, test_rule_hits (rule));
+
+  gst_buffer_unref (buffer);
+  gst_object_unref (identity);
+  g_object_unref (rule);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_rule_signal_missing)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdPipelineRule *rule;
+  GstElement *identity;
+  GstBuffer *buffer;
+
+  /* Neither binds, and neither fails */
+  rule = test_rule_bind (pipeline, "signal=other.handoff list_pipelines");
+  gstd_pipeline_rule_unbind (rule);
+  g_object_unref (rule);
+
+  rule = test_rule_bind (pipeline, "signal=id.other list_pipelines");
+  identity = test_pipeline_element (pipeline, "id");
+
+  buffer = gst_buffer_new ();
+  g_signal_emit_by_name (identity, "handoff", buffer);
+  fail_unless_equals_int (0, test_rule_hits (rule));
+
+  gst_buffer_unref (buffer);
+  gst_object_unref (identity);
+  g_object_unref (rule);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_rule_signal_return_value)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdPipelineRule *rule;
+  GstElement *inner;
+  gboolean handled = FALSE;
+
+  /* Left to the class handler, which is the one providing the value */
+  rule = test_rule_bind (pipeline, "signal=inner.do-latency list_pipelines");
+  inner = test_pipeline_element (pipeline, "inner");
+
+  g_signal_emit_by_name (inner, "do-latency", &handled);
+  fail_unless_equals_int (0, test_rule_hits (rule));
+
+  gst_object_unref (inner);
+  g_object_unref (rule);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+static Suite *
+gstd_pipeline_rule_suite (void)
+{
+  Suite *suite = suite_create ("gstd_pipeline_rule");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_rule_build_invalid);
+  tcase_add_test (tc, test_rule_signal);
+  tcase_add_test (tc, test_rule_signal_missing);
+  tcase_add_test (tc, test_rule_signal_return_value);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_pipeline_rule);
@@ -0,0 +1,212 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_pipeline_scheduling.h"
+#include "gstd_session.h"
+
+#define TEST_PIPELINE "fakesrc ! queue ! fakesink"
+
+static GstdPipelineScheduling *
+test_scheduling_new (GstdSession * session)
+{
+  GstdPipelineScheduling *scheduling;
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, "/pipelines", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, "p0", TEST_PIPELINE);
+  fail_if (ret);
+  gst_object_unref (node);
+
+  ret = gstd_get_by_uri (session, "/pipelines/p0", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  g_object_get (node, "scheduling", &scheduling, NULL);
+  fail_if (NULL == scheduling);
+  gst_object_unref (node);
+
+  return scheduling;
+}
+
+static GstdReturnCode
+test_scheduling_update (GstdSession * session, const gchar * uri,
+    const gchar * value)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, uri, &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_update (node, value);
+  gst_object_unref (node);
+
+  return ret;
+}
+
+static guint
+test_scheduling_threads (GstdPipelineScheduling * scheduling)
+{
+  guint threads;
+
+  g_object_get (scheduling, "threads", &threads, NULL);
+
+  return threads;
+}
+
+
+GST_START_TEST (test_scheduling_cpus_malformed)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdPipelineScheduling *scheduling;
+  const gchar *malformed[] = { "3-1", "a", "0-", "0,,1", "99999", NULL };
+  const gchar **cpus;
+  gchar *current;
+  GstdReturnCode ret;
+
+  scheduling = test_scheduling_new (test_session);
+
+  ret = test_scheduling_update (test_session, "/pipelines/p0/scheduling/cpus",
+      "0");
+  fail_if (ret);
+
+  /* Refused, the previous set is kept */
+  for (cpus = malformed; *cpus; cpus++) {
+    ret = test_scheduling_update (test_session,
+        "/pipelines/p0/scheduling/cpus", *cpus);
+    fail_unless_equals_int (GSTD_BAD_VALUE, ret);
+
+    g_object_get (scheduling, "cpus", &current, NULL);
+    fail_unless_equals_string ("0", current);
+    g_free (current);
+  }
+
+  g_object_unref (scheduling);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_scheduling_threads)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdPipelineScheduling *scheduling;
+  GstdReturnCode ret;
+
+  scheduling = test_scheduling_new (test_session);
+  fail_unless_equals_int (0, test_scheduling_threads (scheduling));
+
+  ret = test_scheduling_update (test_session, "/pipelines/p0/state",
+      "playing");
+  fail_if (ret);
+#ifdef __linux__
+  /* The source and the queue run their own streaming threads */
+  fail_unless (test_scheduling_threads (scheduling) > 0);
+#endif
+
+  ret = test_scheduling_update (test_session, "/pipelines/p0/state", "null");
+  fail_if (ret);
+  fail_unless_equals_int (0, test_scheduling_threads (scheduling));
+
+  g_object_unref (scheduling);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+#ifdef __linux__
+GST_START_TEST (test_scheduling_cpus_restored)
+{
+  GstdPipelineScheduling *scheduling;
+  cpu_set_t original;
+  cpu_set_t pinned;
+  cpu_set_t current;
+
+  /* Needs a CPU to pin the thread away from the policy */
+  if (sysconf (_SC_NPROCESSORS_ONLN) < 2) {
+    return;
+  }
+
+  fail_if (sched_getaffinity (0, sizeof (original), &original));
+  CPU_ZERO (&pinned);
+  CPU_SET (1, &pinned);
+  if (sched_setaffinity (0, sizeof (pinned), &pinned)) {
+    return;
+  }
+
+  scheduling = gstd_pipeline_scheduling_new ();
+  g_object_set (scheduling, "cpus", "0", NULL);
+
+  gstd_pipeline_scheduling_enter (scheduling, NULL);
+  fail_if (sched_getaffinity (0, sizeof (current), &current));
+  fail_unless (CPU_ISSET (0, &current));
+  fail_unless_equals_int (1, CPU_COUNT (&current));
+
+  /* Back to the CPU the thread had, not to the ones of the process */
+  gstd_pipeline_scheduling_leave (scheduling, NULL);
+  fail_if (sched_getaffinity (0, sizeof (current), &current));
+  fail_unless (CPU_EQUAL (&pinned, &current));
+  fail_unless_equals_int (0, test_scheduling_threads (scheduling));
+
+  g_object_unref (scheduling);
+  fail_if (sched_setaffinity (0, sizeof (original), &original));
+}
+
+GST_END_TEST;
+#endif
+
+static Suite *
+gstd_pipeline_scheduling_suite (void)
+{
+  Suite *suite = suite_create ("gstd_pipeline_scheduling");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_scheduling_cpus_malformed);
+  tcase_add_test (tc, test_scheduling_threads);
+#ifdef __linux__
+  tcase_add_test (tc, test_scheduling_cpus_restored);
+#endif
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_pipeline_scheduling);
@@ -0,0 +1,130 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_list.h"
+#include "gstd_pipeline_stats.h"
+
+static guint
+test_stats_threads (GstdPipelineStats * stats)
+{
+  GstdList *threads;
+  guint count;
+
+  g_object_get (stats, "threads", &threads, NULL);
+  fail_if (NULL == threads);
+  g_object_get (threads, "count", &count, NULL);
+  g_object_unref (threads);
+
+  return count;
+}
+
+
+GST_START_TEST (test_stats_thread_listed)
+{
+  GstdPipelineStats *stats = gstd_pipeline_stats_new ();
+  GstElement *owner = gst_element_factory_make ("fakesrc", "src");
+
+  gstd_pipeline_stats_thread_enter (stats, "p0", owner);
+#ifdef __linux__
+  {
+    GstdList *threads;
+    GstdObject *thread;
+
+    fail_unless_equals_int (1, test_stats_threads (stats));
+
+    g_object_get (stats, "threads", &threads, NULL);
+    thread = GSTD_OBJECT (threads->list->data);
+
+    /* Only the usage is exposed, listed threads are running */
+    fail_if (g_object_class_find_property (G_OBJECT_GET_CLASS (thread),
+            "running"));
+    g_object_unref (threads);
+  }
+#endif
+
+  /* Entering again keeps a single entry */
+  gstd_pipeline_stats_thread_enter (stats, "p0", owner);
+#ifdef __linux__
+  fail_unless_equals_int (1, test_stats_threads (stats));
+#endif
+
+  gstd_pipeline_stats_thread_leave (stats, owner);
+  fail_unless_equals_int (0, test_stats_threads (stats));
+
+  gst_object_unref (owner);
+  g_object_unref (stats);
+}
+
+GST_END_TEST;
+
+
+#ifdef __linux__
+GST_START_TEST (test_stats_thread_name)
+{
+  GstdPipelineStats *stats = gstd_pipeline_stats_new ();
+  GstElement *owner = gst_element_factory_make ("fakesrc", "src");
+  gchar name[16] = { 0, };
+
+  fail_if (prctl (PR_SET_NAME, "pooled", 0, 0, 0));
+
+  gstd_pipeline_stats_thread_enter (stats, "p0", owner);
+  fail_if (prctl (PR_GET_NAME, name, 0, 0, 0));
+  fail_unless_equals_string ("p0:src", name);
+
+  /* The name from the first entry is the one given back */
+  gstd_pipeline_stats_thread_enter (stats, "p0", owner);
+
+  gstd_pipeline_stats_thread_leave (stats, owner);
+  fail_if (prctl (PR_GET_NAME, name, 0, 0, 0));
+  fail_unless_equals_string ("pooled", name);
+
+  gst_object_unref (owner);
+  g_object_unref (stats);
+}
+
+GST_END_TEST;
+#endif
+
+static Suite *
+gstd_pipeline_stats_suite (void)
+{
+  Suite *suite = suite_create ("gstd_pipeline_stats");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_stats_thread_listed);
+#ifdef __linux__
+  tcase_add_test (tc, test_stats_thread_name);
+#endif
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_pipeline_stats);
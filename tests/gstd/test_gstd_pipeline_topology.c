@@ -0,0 +1,291 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_session.h"
+
+/* A tee to branch from while the pipeline runs */
+#define TEST_PIPELINE \
+  "fakesrc is-live=true ! tee name=t ! queue ! fakesink name=s0"
+
+static GstdObject *
+test_topology_new (GstdSession * session)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, "/pipelines", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, "p0", TEST_PIPELINE);
+  fail_if (ret);
+  gst_object_unref (node);
+
+  ret = gstd_get_by_uri (session, "/pipelines/p0/topology", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  return node;
+}
+
+static GstdReturnCode
+test_topology_update (GstdSession * session, const gchar * uri,
+    const gchar * value)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, uri, &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_update (node, value);
+  gst_object_unref (node);
+
+  return ret;
+}
+
+static GstdReturnCode
+test_topology_create (GstdSession * session, const gchar * name,
+    const gchar * description)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, "/pipelines/p0/elements", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, name, description);
+  gst_object_unref (node);
+
+  return ret;
+}
+
+static GstdReturnCode
+test_topology_delete (GstdSession * session, const gchar * name)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, "/pipelines/p0/elements", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_delete (node, name);
+  gst_object_unref (node);
+
+  return ret;
+}
+
+static gboolean
+test_topology_listed (GstdSession * session, const gchar * name)
+{
+  GstdObject *node;
+  GstdObject *child;
+
+  fail_if (gstd_get_by_uri (session, "/pipelines/p0/elements", &node));
+  child = gstd_list_find_child (GSTD_LIST (node), name);
+  gst_object_unref (node);
+
+  if (child) {
+    g_object_unref (child);
+  }
+
+  return NULL != child;
+}
+
+static gboolean
+test_topology_linked (GstdObject * topology, const gchar * link)
+{
+  gchar *links;
+  gboolean linked;
+
+  g_object_get (topology, "links", &links, NULL);
+  fail_if (NULL == links);
+  linked = NULL != strstr (links, link);
+  g_free (links);
+
+  return linked;
+}
+
+
+GST_START_TEST (test_topology_create_delete)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdObject *topology;
+
+  topology = test_topology_new (test_session);
+  fail_if (test_topology_update (test_session, "/pipelines/p0/state",
+          "playing"));
+
+  fail_if (test_topology_create (test_session, "q1", "queue"));
+  fail_unless (test_topology_listed (test_session, "q1"));
+
+  /* Names are unique in the pipeline */
+  fail_unless_equals_int (GSTD_EXISTING_RESOURCE,
+      test_topology_create (test_session, "q1", "queue"));
+  fail_unless_equals_int (GSTD_BAD_DESCRIPTION,
+      test_topology_create (test_session, "q2", "nosuchelement"));
+  fail_if (test_topology_listed (test_session, "q2"));
+
+  fail_if (test_topology_delete (test_session, "q1"));
+  fail_if (test_topology_listed (test_session, "q1"));
+  fail_unless_equals_int (GSTD_NO_RESOURCE,
+      test_topology_delete (test_session, "q1"));
+
+  /* Free to be taken again */
+  fail_if (test_topology_create (test_session, "q1", "queue"));
+  fail_unless (test_topology_listed (test_session, "q1"));
+
+  gst_object_unref (topology);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_topology_link_unlink)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdObject *topology;
+
+  topology = test_topology_new (test_session);
+  fail_if (test_topology_update (test_session, "/pipelines/p0/state",
+          "playing"));
+
+  fail_if (test_topology_create (test_session, "q1", "queue"));
+  fail_if (test_topology_create (test_session, "s1", "fakesink async=false"));
+
+  /* A new branch from the running tee */
+  fail_if (test_topology_update (test_session, "/pipelines/p0/topology",
+          "link q1 s1"));
+  fail_if (test_topology_update (test_session, "/pipelines/p0/topology",
+          "link t q1"));
+  fail_unless (test_topology_linked (topology, "q1.src:s1.sink"));
+  fail_unless (test_topology_linked (topology, ":q1.sink"));
+
+  fail_if (test_topology_update (test_session, "/pipelines/p0/topology",
+          "unlink t q1"));
+  fail_if (test_topology_linked (topology, ":q1.sink"));
+  fail_unless (test_topology_linked (topology, "q1.src:s1.sink"));
+
+  /* Not linked anymore */
+  fail_unless_equals_int (GSTD_NO_RESOURCE,
+      test_topology_update (test_session, "/pipelines/p0/topology",
+          "unlink t q1"));
+  fail_unless_equals_int (GSTD_NO_RESOURCE,
+      test_topology_update (test_session, "/pipelines/p0/topology",
+          "link t nosuchelement"));
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      test_topology_update (test_session, "/pipelines/p0/topology",
+          "relink t q1"));
+  fail_unless_equals_int (GSTD_MISSING_ARGUMENT,
+      test_topology_update (test_session, "/pipelines/p0/topology",
+          "link t"));
+
+  gst_object_unref (topology);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_topology_delete_linked)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdObject *topology;
+
+  topology = test_topology_new (test_session);
+  fail_if (test_topology_update (test_session, "/pipelines/p0/state",
+          "playing"));
+
+  fail_if (test_topology_create (test_session, "q1", "queue"));
+  fail_if (test_topology_create (test_session, "s1", "fakesink async=false"));
+  fail_if (test_topology_update (test_session, "/pipelines/p0/topology",
+          "link q1 s1"));
+  fail_if (test_topology_update (test_session, "/pipelines/p0/topology",
+          "link t q1"));
+
+  /* Unlinked on both sides before it is removed */
+  fail_if (test_topology_delete (test_session, "q1"));
+  fail_if (test_topology_linked (topology, "q1."));
+  fail_if (test_topology_linked (topology, ":q1."));
+  fail_unless (test_topology_listed (test_session, "s1"));
+  fail_unless (test_topology_listed (test_session, "s0"));
+
+  gst_object_unref (topology);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_topology_external)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdObject *topology;
+  GstdObject *node;
+  GstElement *pipeline;
+  GstElement *element;
+
+  topology = test_topology_new (test_session);
+
+  fail_if (gstd_get_by_uri (test_session, "/pipelines/p0", &node));
+  g_object_get (node, "pipeline", &pipeline, NULL);
+  gst_object_unref (node);
+
+  /* Elements added and removed by other means are followed */
+  element = gst_element_factory_make ("identity", "i0");
+  fail_unless (gst_bin_add (GST_BIN (pipeline), element));
+  fail_unless (test_topology_listed (test_session, "i0"));
+
+  fail_unless (gst_bin_remove (GST_BIN (pipeline), element));
+  fail_if (test_topology_listed (test_session, "i0"));
+
+  gst_object_unref (pipeline);
+  gst_object_unref (topology);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+static Suite *
+gstd_pipeline_topology_suite (void)
+{
+  Suite *suite = suite_create ("gstd_pipeline_topology");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_topology_create_delete);
+  tcase_add_test (tc, test_topology_link_unlink);
+  tcase_add_test (tc, test_topology_delete_linked);
+  tcase_add_test (tc, test_topology_external);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_pipeline_topology);
@@ -0,0 +1,360 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_session.h"
+#include "gstd_pipeline_watchdog.h"
+
+/* Reaches EOS right away, so it stalls as soon as it plays */
+#define TEST_STALLED "fakesrc num-buffers=0 ! fakesink name=sink"
+#define TEST_TIMEOUT 50
+#define TEST_WAIT (5 * G_TIME_SPAN_SECOND)
+
+static GstdObject *
+test_pipeline_new (GstdSession * session, const gchar * description,
+    GstdWatchdogPolicy policy, guint timeout, GstdPipelineWatchdog ** watchdog)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, "/pipelines", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, "p0", description);
+  fail_if (ret);
+  gst_object_unref (node);
+
+  ret = gstd_get_by_uri (session, "/pipelines/p0", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  g_object_get (node, "watchdog", watchdog, NULL);
+  fail_if (NULL == *watchdog);
+  g_object_set (*watchdog, "policy", policy, "max-backoff", TEST_TIMEOUT,
+      "timeout", timeout, NULL);
+
+  return node;
+}
+
+static void
+test_pipeline_update_state (GstdSession * session, const gchar * state)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, "/pipelines/p0/state", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_update (node, state);
+  gst_object_unref (node);
+  fail_if (ret);
+}
+
+static guint
+test_watchdog_count (GstdPipelineWatchdog * watchdog, const gchar * name)
+{
+  guint count;
+
+  g_object_get (watchdog, name, &count, NULL);
+
+  return count;
+}
+
+/* Rebuilds are dispatched in the default main context, which is
+   iterated while waiting */
+static gboolean
+test_watchdog_wait (GstdPipelineWatchdog * watchdog, const gchar * name,
+    guint count)
+{
+  gint64 deadline = g_get_monotonic_time () + TEST_WAIT;
+
+  while (test_watchdog_count (watchdog, name) < count) {
+    if (g_get_monotonic_time () > deadline) {
+      return FALSE;
+    }
+    while (g_main_context_iteration (NULL, FALSE));
+    g_usleep (10 * G_TIME_SPAN_MILLISECOND);
+  }
+
+  return TRUE;
+}
+
+static GstElement *
+test_pipeline_element (GstdObject * node)
+{
+  GstElement *pipeline;
+
+  g_object_get (node, "pipeline", &pipeline, NULL);
+  fail_if (NULL == pipeline);
+
+  return pipeline;
+}
+
+static GstState
+test_pipeline_target (GstElement * pipeline)
+{
+  GstState target;
+
+  GST_OBJECT_LOCK (pipeline);
+  target = GST_STATE_TARGET (pipeline);
+  GST_OBJECT_UNLOCK (pipeline);
+
+  return target;
+}
+
+
+GST_START_TEST (test_watchdog_stall)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdPipelineWatchdog *watchdog;
+  GstdObject *node;
+
+  node = test_pipeline_new (test_session, TEST_STALLED,
+      GSTD_WATCHDOG_POLICY_NONE, TEST_TIMEOUT, &watchdog);
+  test_pipeline_update_state (test_session, "playing");
+
+  fail_unless (test_watchdog_wait (watchdog, "stalls", 1));
+
+  /* Only accounted */
+  fail_unless_equals_int (0, test_watchdog_count (watchdog, "recoveries"));
+
+  g_object_unref (watchdog);
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_watchdog_stall_paused)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdPipelineWatchdog *watchdog;
+  GstdObject *node;
+
+  node = test_pipeline_new (test_session, TEST_STALLED,
+      GSTD_WATCHDOG_POLICY_RESTART, TEST_TIMEOUT, &watchdog);
+  test_pipeline_update_state (test_session, "paused");
+
+  /* Stalls are only accounted while the pipeline is meant to play */
+  g_usleep (4 * TEST_TIMEOUT * G_TIME_SPAN_MILLISECOND);
+  fail_unless_equals_int (0, test_watchdog_count (watchdog, "stalls"));
+  fail_unless_equals_int (0, test_watchdog_count (watchdog, "recoveries"));
+
+  g_object_unref (watchdog);
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_watchdog_flush)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdPipelineWatchdog *watchdog;
+  GstElement *current;
+  GstElement *pipeline;
+  GstdObject *node;
+
+  node = test_pipeline_new (test_session, TEST_STALLED,
+      GSTD_WATCHDOG_POLICY_FLUSH, TEST_TIMEOUT, &watchdog);
+  pipeline = test_pipeline_element (node);
+  test_pipeline_update_state (test_session, "playing");
+
+  fail_unless (test_watchdog_wait (watchdog, "recoveries", 1));
+  fail_unless (test_watchdog_count (watchdog, "stalls") >= 1);
+
+  /* Same pipeline, still meant to play */
+  current = test_pipeline_element (node);
+  fail_unless (current == pipeline);
+  fail_unless_equals_int (GST_STATE_PLAYING, test_pipeline_target (current));
+
+  gst_object_unref (current);
+  gst_object_unref (pipeline);
+  g_object_unref (watchdog);
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_watchdog_restart)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdPipelineWatchdog *watchdog;
+  GstElement *current;
+  GstElement *pipeline;
+  GstdObject *node;
+
+  node = test_pipeline_new (test_session, TEST_STALLED,
+      GSTD_WATCHDOG_POLICY_RESTART, TEST_TIMEOUT, &watchdog);
+  pipeline = test_pipeline_element (node);
+  test_pipeline_update_state (test_session, "playing");
+
+  fail_unless (test_watchdog_wait (watchdog, "recoveries", 2));
+
+  current = test_pipeline_element (node);
+  fail_unless (current == pipeline);
+  fail_unless_equals_int (GST_STATE_PLAYING, test_pipeline_target (current));
+
+  gst_object_unref (current);
+  gst_object_unref (pipeline);
+  g_object_unref (watchdog);
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_watchdog_restart_stopped)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdPipelineWatchdog *watchdog;
+  GstElement *pipeline;
+  GstdObject *node;
+  guint recoveries;
+
+  node = test_pipeline_new (test_session, TEST_STALLED,
+      GSTD_WATCHDOG_POLICY_RESTART, TEST_TIMEOUT, &watchdog);
+  pipeline = test_pipeline_element (node);
+  test_pipeline_update_state (test_session, "playing");
+
+  fail_unless (test_watchdog_wait (watchdog, "recoveries", 1));
+
+  /* A client stop is never undone by a restart */
+  test_pipeline_update_state (test_session, "null");
+  recoveries = test_watchdog_count (watchdog, "recoveries");
+  g_usleep (4 * TEST_TIMEOUT * G_TIME_SPAN_MILLISECOND);
+
+  fail_unless (test_watchdog_count (watchdog, "recoveries") <= recoveries + 1);
+  fail_unless_equals_int (GST_STATE_NULL, test_pipeline_target (pipeline));
+  fail_unless_equals_int (GST_STATE_NULL, GST_STATE (pipeline));
+
+  gst_object_unref (pipeline);
+  g_object_unref (watchdog);
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_watchdog_rebuild)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdPipelineWatchdog *watchdog;
+  GstElement *pipeline;
+  GstElement *rebuilt;
+  GstdObject *element;
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  node = test_pipeline_new (test_session, TEST_STALLED,
+      GSTD_WATCHDOG_POLICY_REBUILD, TEST_TIMEOUT, &watchdog);
+  pipeline = test_pipeline_element (node);
+  test_pipeline_update_state (test_session, "playing");
+
+  fail_unless (test_watchdog_wait (watchdog, "recoveries", 1));
+  while (g_main_context_iteration (NULL, FALSE));
+
+  /* A new pipeline, restored to the state of the old one */
+  rebuilt = test_pipeline_element (node);
+  fail_if (rebuilt == pipeline);
+  fail_unless_equals_int (GST_STATE_NULL, GST_STATE (pipeline));
+  fail_unless_equals_int (GST_STATE_PLAYING, test_pipeline_target (rebuilt));
+
+  /* Its elements are found under the same names */
+  ret = gstd_get_by_uri (test_session, "/pipelines/p0/elements/sink", &element);
+  fail_if (ret);
+  fail_if (NULL == element);
+
+  gst_object_unref (element);
+  gst_object_unref (rebuilt);
+  gst_object_unref (pipeline);
+  g_object_unref (watchdog);
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_watchdog_error)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdPipelineWatchdog *watchdog;
+  GstElement *pipeline;
+  GstdObject *node;
+  GError *error;
+
+  /* Errors are watched without a timeout */
+  node = test_pipeline_new (test_session, "fakesrc ! fakesink",
+      GSTD_WATCHDOG_POLICY_RESTART, 0, &watchdog);
+  pipeline = test_pipeline_element (node);
+  test_pipeline_update_state (test_session, "playing");
+
+  error = g_error_new_literal (GST_STREAM_ERROR, GST_STREAM_ERROR_FAILED,
+      "Test error");
+  gst_element_post_message (pipeline,
+      gst_message_new_error (GST_OBJECT (pipeline), error, NULL));
+  g_error_free (error);
+
+  fail_unless (test_watchdog_wait (watchdog, "recoveries", 1));
+  fail_unless_equals_int (1, test_watchdog_count (watchdog, "errors"));
+  fail_unless_equals_int (0, test_watchdog_count (watchdog, "stalls"));
+  fail_unless_equals_int (GST_STATE_PLAYING, test_pipeline_target (pipeline));
+
+  gst_object_unref (pipeline);
+  g_object_unref (watchdog);
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+static Suite *
+gstd_pipeline_watchdog_suite (void)
+{
+  Suite *suite = suite_create ("gstd_pipeline_watchdog");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_watchdog_stall);
+  tcase_add_test (tc, test_watchdog_stall_paused);
+  tcase_add_test (tc, test_watchdog_flush);
+  tcase_add_test (tc, test_watchdog_restart);
+  tcase_add_test (tc, test_watchdog_restart_stopped);
+  tcase_add_test (tc, test_watchdog_rebuild);
+  tcase_add_test (tc, test_watchdog_error);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_pipeline_watchdog);
@@ -0,0 +1,290 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_snapshot.h"
+
+#define TEST_PIPELINE \
+  "videotestsrc name=src ! video/x-raw,width=1280,height=720 ! " \
+  "fakesink name=sink"
+#define TEST_WAITERS 8
+
+typedef struct _TestWaiter TestWaiter;
+struct _TestWaiter
+{
+  GstdSnapshot *snapshot;
+  GstdObject *image;
+  GstdReturnCode ret;
+};
+
+/* Prerolled, so the sink holds a last sample */
+static GstElement *
+test_pipeline_new (void)
+{
+  GstElement *pipeline;
+  GError *error = NULL;
+
+  pipeline = gst_parse_launch (TEST_PIPELINE, &error);
+  fail_if (NULL == pipeline);
+  fail_if (NULL != error);
+
+  gst_element_set_state (pipeline, GST_STATE_PAUSED);
+  fail_unless_equals_int (GST_STATE_CHANGE_SUCCESS,
+      gst_element_get_state (pipeline, NULL, NULL, GST_CLOCK_TIME_NONE));
+
+  return pipeline;
+}
+
+static GstdSnapshot *
+test_snapshot_new (GstElement * pipeline, const gchar * name)
+{
+  GstdSnapshot *snapshot;
+  GstElement *element;
+
+  element = gst_bin_get_by_name (GST_BIN (pipeline), name);
+  fail_if (NULL == element);
+  snapshot = gstd_snapshot_new (element);
+  gst_object_unref (element);
+
+  return snapshot;
+}
+
+static gint
+test_image_width (GstdObject * image)
+{
+  gint width;
+
+  g_object_get (image, "width", &width, NULL);
+
+  return width;
+}
+
+static guint
+test_snapshot_cached (GstdSnapshot * snapshot)
+{
+  guint cached;
+
+  g_object_get (snapshot, "cached", &cached, NULL);
+
+  return cached;
+}
+
+static gpointer
+test_waiter_func (gpointer data)
+{
+  TestWaiter *waiter = data;
+
+  waiter->ret = gstd_snapshot_take (waiter->snapshot, "format=png",
+      &waiter->image);
+
+  return NULL;
+}
+
+
+GST_START_TEST (test_snapshot_parse)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdSnapshot *snapshot = test_snapshot_new (pipeline, "sink");
+  GstdObject *image = NULL;
+
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      gstd_snapshot_take (snapshot, "format=gif", &image));
+  fail_unless (NULL == image);
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      gstd_snapshot_take (snapshot, "format=jpeg,width=-1", &image));
+  fail_unless (NULL == image);
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      gstd_snapshot_take (snapshot, "format=jpeg,=", &image));
+  fail_unless (NULL == image);
+
+  /* Scaled preserving the aspect ratio, and clamped */
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_snapshot_take (snapshot, "format=jpeg,width=320", &image));
+  fail_unless_equals_int (320, test_image_width (image));
+  g_object_unref (image);
+
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_snapshot_take (snapshot, "width=99999", &image));
+  fail_unless_equals_int (4096, test_image_width (image));
+  g_object_unref (image);
+
+  g_object_unref (snapshot);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_snapshot_no_sample)
+{
+  GstElement *pipeline;
+  GstdSnapshot *snapshot;
+  GstdObject *image = NULL;
+
+  pipeline = gst_parse_launch (TEST_PIPELINE, NULL);
+  fail_if (NULL == pipeline);
+
+  /* Nothing rendered yet */
+  snapshot = test_snapshot_new (pipeline, "sink");
+  fail_unless_equals_int (GSTD_NO_RESOURCE,
+      gstd_snapshot_take (snapshot, "format=jpeg", &image));
+  fail_unless (NULL == image);
+  g_object_unref (snapshot);
+
+  /* Doesn't keep a last sample at all */
+  snapshot = test_snapshot_new (pipeline, "src");
+  fail_unless_equals_int (GSTD_NO_RESOURCE,
+      gstd_snapshot_take (snapshot, "format=jpeg", &image));
+  fail_unless (NULL == image);
+  g_object_unref (snapshot);
+
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_snapshot_cached)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdSnapshot *snapshot = test_snapshot_new (pipeline, "sink");
+  GstdObject *first = NULL;
+  GstdObject *second = NULL;
+  GstdObject *other = NULL;
+
+  g_object_set (snapshot, "ttl", 60000, NULL);
+
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_snapshot_take (snapshot, "format=jpeg,width=320", &first));
+
+  /* Equivalent requests share the entry */
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_snapshot_take (snapshot, "width=320", &second));
+  fail_unless (first == second);
+  fail_unless_equals_int (1, test_snapshot_cached (snapshot));
+
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_snapshot_take (snapshot, "format=png,width=320", &other));
+  fail_if (first == other);
+  fail_unless_equals_int (2, test_snapshot_cached (snapshot));
+
+  g_object_unref (first);
+  g_object_unref (second);
+  g_object_unref (other);
+  g_object_unref (snapshot);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_snapshot_ttl)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdSnapshot *snapshot = test_snapshot_new (pipeline, "sink");
+  GstdObject *first = NULL;
+  GstdObject *second = NULL;
+
+  g_object_set (snapshot, "ttl", 100, NULL);
+
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_snapshot_take (snapshot, "format=jpeg", &first));
+  g_usleep (200 * G_TIME_SPAN_MILLISECOND);
+
+  /* Expired, encoded again */
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_snapshot_take (snapshot, "format=jpeg", &second));
+  fail_if (first == second);
+  fail_unless_equals_int (1, test_snapshot_cached (snapshot));
+
+  g_object_unref (first);
+  g_object_unref (second);
+  g_object_unref (snapshot);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_snapshot_coalesced)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdSnapshot *snapshot = test_snapshot_new (pipeline, "sink");
+  TestWaiter waiters[TEST_WAITERS];
+  GThread *threads[TEST_WAITERS];
+  GHashTable *images;
+  gint i;
+
+  /* Nothing is cached, only the encoding in progress is shared */
+  g_object_set (snapshot, "ttl", 0, NULL);
+
+  for (i = 0; i < TEST_WAITERS; i++) {
+    waiters[i].snapshot = snapshot;
+    waiters[i].image = NULL;
+    threads[i] = g_thread_new ("waiter", test_waiter_func, &waiters[i]);
+  }
+
+  images = g_hash_table_new (g_direct_hash, g_direct_equal);
+  for (i = 0; i < TEST_WAITERS; i++) {
+    g_thread_join (threads[i]);
+    fail_unless_equals_int (GSTD_EOK, waiters[i].ret);
+    fail_if (NULL == waiters[i].image);
+    g_hash_table_add (images, waiters[i].image);
+  }
+
+  /* A full size png takes long enough for the requests to meet */
+  fail_unless (g_hash_table_size (images) < TEST_WAITERS);
+
+  g_hash_table_unref (images);
+  for (i = 0; i < TEST_WAITERS; i++) {
+    g_object_unref (waiters[i].image);
+  }
+  g_object_unref (snapshot);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+static Suite *
+gstd_snapshot_suite (void)
+{
+  Suite *suite = suite_create ("gstd_snapshot");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_snapshot_parse);
+  tcase_add_test (tc, test_snapshot_no_sample);
+  tcase_add_test (tc, test_snapshot_cached);
+  tcase_add_test (tc, test_snapshot_ttl);
+  tcase_add_test (tc, test_snapshot_coalesced);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_snapshot);
@@ -0,0 +1,204 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_session.h"
+
+#define TEST_PIPELINE "fakesrc is-live=true ! fakesink"
+
+static void
+test_group_new (GstdSession * session)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, "/pipelines", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+  fail_if (gstd_object_create (node, "p0", TEST_PIPELINE));
+  fail_if (gstd_object_create (node, "p1", TEST_PIPELINE));
+  gst_object_unref (node);
+
+  ret = gstd_get_by_uri (session, "/groups", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+  fail_if (gstd_object_create (node, "g0", "p0,p1"));
+  gst_object_unref (node);
+}
+
+static void
+test_group_update (GstdSession * session, const gchar * uri,
+    const gchar * value)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_get_by_uri (session, uri, &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_update (node, value);
+  gst_object_unref (node);
+  fail_if (ret);
+}
+
+static GstElement *
+test_group_pipeline (GstdSession * session, const gchar * name)
+{
+  GstdObject *node;
+  GstElement *pipeline;
+  gchar *uri;
+
+  uri = g_strdup_printf ("/pipelines/%s", name);
+  fail_if (gstd_get_by_uri (session, uri, &node));
+  g_free (uri);
+
+  g_object_get (node, "pipeline", &pipeline, NULL);
+  fail_if (NULL == pipeline);
+  gst_object_unref (node);
+
+  return pipeline;
+}
+
+static gboolean
+test_group_synced (GstElement * pipeline)
+{
+  return GST_OBJECT_FLAG_IS_SET (pipeline, GST_PIPELINE_FLAG_FIXED_CLOCK) &&
+      !GST_CLOCK_TIME_IS_VALID (gst_element_get_start_time (pipeline));
+}
+
+
+GST_START_TEST (test_group_play_stop)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstElement *p0;
+  GstElement *p1;
+
+  test_group_new (test_session);
+  p0 = test_group_pipeline (test_session, "p0");
+  p1 = test_group_pipeline (test_session, "p1");
+
+  test_group_update (test_session, "/groups/g0", "play");
+  fail_unless (test_group_synced (p0));
+  fail_unless (test_group_synced (p1));
+  fail_unless_equals_uint64 (gst_element_get_base_time (p0),
+      gst_element_get_base_time (p1));
+
+  test_group_update (test_session, "/groups/g0", "stop");
+  fail_if (test_group_synced (p0));
+  fail_if (test_group_synced (p1));
+
+  gst_object_unref (p0);
+  gst_object_unref (p1);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_group_member_stopped)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstElement *p0;
+  GstElement *p1;
+  GstClockTime base_time;
+
+  test_group_new (test_session);
+  p0 = test_group_pipeline (test_session, "p0");
+  p1 = test_group_pipeline (test_session, "p1");
+
+  test_group_update (test_session, "/groups/g0", "play");
+  base_time = gst_element_get_base_time (p1);
+
+  /* Stopped on its own, the member leaves the group timing */
+  test_group_update (test_session, "/pipelines/p0/state", "null");
+  fail_if (test_group_synced (p0));
+  fail_unless (test_group_synced (p1));
+
+  /* Playing on its own picks a fresh base time */
+  test_group_update (test_session, "/pipelines/p0/state", "playing");
+  fail_if (test_group_synced (p0));
+  fail_if (base_time == gst_element_get_base_time (p0));
+
+  /* Until the group plays again */
+  test_group_update (test_session, "/groups/g0", "play");
+  fail_unless (test_group_synced (p0));
+  fail_unless_equals_uint64 (gst_element_get_base_time (p0),
+      gst_element_get_base_time (p1));
+
+  test_group_update (test_session, "/groups/g0", "stop");
+
+  gst_object_unref (p0);
+  gst_object_unref (p1);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_group_member_paused)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstElement *p0;
+  GstElement *p1;
+
+  test_group_new (test_session);
+  p0 = test_group_pipeline (test_session, "p0");
+  p1 = test_group_pipeline (test_session, "p1");
+
+  test_group_update (test_session, "/groups/g0", "play");
+
+  /* Pausing keeps the member in the group timing */
+  test_group_update (test_session, "/pipelines/p0/state", "paused");
+  fail_unless (test_group_synced (p0));
+  test_group_update (test_session, "/pipelines/p0/state", "playing");
+  fail_unless (test_group_synced (p0));
+  fail_unless_equals_uint64 (gst_element_get_base_time (p0),
+      gst_element_get_base_time (p1));
+
+  test_group_update (test_session, "/groups/g0", "stop");
+
+  gst_object_unref (p0);
+  gst_object_unref (p1);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+static Suite *
+gstd_sync_group_suite (void)
+{
+  Suite *suite = suite_create ("gstd_sync_group");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_group_play_stop);
+  tcase_add_test (tc, test_group_member_stopped);
+  tcase_add_test (tc, test_group_member_paused);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_sync_group);
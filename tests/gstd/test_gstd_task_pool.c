@@ -0,0 +1,157 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_session.h"
+#include "gstd_task_pool.h"
+
+/* A single streaming thread, the one of the source */
+#define TEST_PIPELINE "fakesrc ! fakesink"
+
+static void
+test_pipeline_new (GstdSession * session, const gchar * name)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+  gchar *uri;
+
+  ret = gstd_get_by_uri (session, "/pipelines", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_create (node, name, TEST_PIPELINE);
+  fail_if (ret);
+  gst_object_unref (node);
+
+  uri = g_strdup_printf ("/pipelines/%s", name);
+  ret = gstd_get_by_uri (session, uri, &node);
+  g_free (uri);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  g_object_set (node, "task-pool", GSTD_TASK_POOL_POLICY_SHARED, NULL);
+  gst_object_unref (node);
+}
+
+static GstdReturnCode
+test_pipeline_update_state (GstdSession * session, const gchar * name,
+    const gchar * state)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+  gchar *uri;
+
+  uri = g_strdup_printf ("/pipelines/%s/state", name);
+  ret = gstd_get_by_uri (session, uri, &node);
+  g_free (uri);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  ret = gstd_object_update (node, state);
+  gst_object_unref (node);
+
+  return ret;
+}
+
+
+GST_START_TEST (test_task_pool_saturated)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  GstdReturnCode ret;
+
+  g_object_set (test_session, "task-pool-size", 1, NULL);
+  test_pipeline_new (test_session, "p0");
+  test_pipeline_new (test_session, "p1");
+
+  fail_unless_equals_int (GSTD_EOK,
+      test_pipeline_update_state (test_session, "p0", "playing"));
+
+  /* The client that ran out of threads is told so. GstTask warns about
+     the refused push */
+  ASSERT_WARNING (ret =
+      test_pipeline_update_state (test_session, "p1", "playing"));
+  fail_unless_equals_int (GSTD_NO_THREADS, ret);
+  fail_unless_equals_int (GSTD_EOK,
+      test_pipeline_update_state (test_session, "p1", "null"));
+
+  /* Threads are given back once their task stops */
+  fail_unless_equals_int (GSTD_EOK,
+      test_pipeline_update_state (test_session, "p0", "null"));
+  g_usleep (100 * G_TIME_SPAN_MILLISECOND);
+  fail_unless_equals_int (GSTD_EOK,
+      test_pipeline_update_state (test_session, "p1", "playing"));
+
+  fail_unless_equals_int (GSTD_EOK,
+      test_pipeline_update_state (test_session, "p1", "null"));
+  g_object_set (test_session, "task-pool-size",
+      GSTD_TASK_POOL_DEFAULT_MAX_THREADS, NULL);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_task_pool_unlimited)
+{
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  gint size;
+
+  g_object_set (test_session, "task-pool-size", -1, NULL);
+  g_object_get (test_session, "task-pool-size", &size, NULL);
+  fail_unless_equals_int (-1, size);
+
+  test_pipeline_new (test_session, "p0");
+  test_pipeline_new (test_session, "p1");
+
+  fail_unless_equals_int (GSTD_EOK,
+      test_pipeline_update_state (test_session, "p0", "playing"));
+  fail_unless_equals_int (GSTD_EOK,
+      test_pipeline_update_state (test_session, "p1", "playing"));
+
+  fail_unless_equals_int (GSTD_EOK,
+      test_pipeline_update_state (test_session, "p0", "null"));
+  fail_unless_equals_int (GSTD_EOK,
+      test_pipeline_update_state (test_session, "p1", "null"));
+  g_object_set (test_session, "task-pool-size",
+      GSTD_TASK_POOL_DEFAULT_MAX_THREADS, NULL);
+  gst_object_unref (test_session);
+}
+
+GST_END_TEST;
+
+static Suite *
+gstd_task_pool_suite (void)
+{
+  Suite *suite = suite_create ("gstd_task_pool");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_task_pool_saturated);
+  tcase_add_test (tc, test_task_pool_unlimited);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_task_pool);
@@ -0,0 +1,366 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/check/gstcheck.h>
+
+#include "gstd_icreator.h"
+#include "gstd_ideleter.h"
+#include "gstd_pipeline_telemetry.h"
+#include "gstd_telemetry_series.h"
+
+#define TEST_PERIOD (100 * G_TIME_SPAN_MILLISECOND)
+
+static GstElement *
+test_pipeline_new (void)
+{
+  GstElement *pipeline;
+  GError *error = NULL;
+
+  pipeline = gst_parse_launch ("fakesrc name=src ! fakesink", &error);
+  fail_if (NULL == pipeline);
+  fail_if (NULL != error);
+
+  return pipeline;
+}
+
+static GstdTelemetrySeries *
+test_series_attach (GstElement * pipeline, const gchar * description)
+{
+  GstdTelemetrySeries *series;
+
+  series = gstd_telemetry_series_new ("s0", description);
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_telemetry_series_attach (series, GST_BIN (pipeline)));
+
+  return series;
+}
+
+static GstdReturnCode
+test_series_attach_result (GstElement * pipeline, const gchar * description)
+{
+  GstdTelemetrySeries *series;
+  GstdReturnCode ret;
+
+  series = gstd_telemetry_series_new ("s0", description);
+  ret = gstd_telemetry_series_attach (series, GST_BIN (pipeline));
+  g_object_unref (series);
+
+  return ret;
+}
+
+static guint
+test_series_count (GstdTelemetrySeries * series, const gchar * name)
+{
+  guint count;
+
+  g_object_get (series, name, &count, NULL);
+
+  return count;
+}
+
+/* Samples the source size, set to each sample's position */
+static void
+test_series_sample (GstdTelemetrySeries * series, GstElement * pipeline,
+    guint samples, gboolean wait)
+{
+  GstElement *src;
+  gint64 due = 0;
+  gint64 now;
+  guint i;
+
+  src = gst_bin_get_by_name (GST_BIN (pipeline), "src");
+
+  for (i = 0; i < samples; i++) {
+    g_object_set (src, "sizemax", i, NULL);
+
+    if (wait) {
+      now = g_get_monotonic_time ();
+      if (now < due) {
+        g_usleep (due - now);
+      }
+      due = gstd_telemetry_series_poll (series, g_get_monotonic_time ());
+    } else {
+      gstd_telemetry_series_poll (series, i * TEST_PERIOD);
+    }
+  }
+
+  gst_object_unref (src);
+}
+
+/* Queries the series and returns the amount of points and the
+   response */
+static guint
+test_series_query (GstdTelemetrySeries * series, const gchar * range,
+    gchar ** response)
+{
+  GstdObject *points = NULL;
+  gchar *string = NULL;
+  const gchar *time;
+  guint count = 0;
+
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_telemetry_series_query (series, range, &points));
+  fail_if (NULL == points);
+  fail_unless_equals_int (GSTD_EOK, gstd_object_to_string (points, &string));
+
+  for (time = strstr (string, "\"time\""); time;
+      time = strstr (time + 1, "\"time\"")) {
+    count++;
+  }
+
+  if (response) {
+    *response = string;
+  } else {
+    g_free (string);
+  }
+  g_object_unref (points);
+
+  return count;
+}
+
+
+GST_START_TEST (test_telemetry_attach_invalid)
+{
+  GstElement *pipeline = test_pipeline_new ();
+
+  fail_unless_equals_int (GSTD_MISSING_ARGUMENT,
+      test_series_attach_result (pipeline, "src"));
+  fail_unless_equals_int (GSTD_NO_RESOURCE,
+      test_series_attach_result (pipeline, "other sizemax"));
+  fail_unless_equals_int (GSTD_NO_RESOURCE,
+      test_series_attach_result (pipeline, "src other"));
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      test_series_attach_result (pipeline, "src name"));
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      test_series_attach_result (pipeline, "src sizemax.field"));
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      test_series_attach_result (pipeline, "src sizemax 99"));
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      test_series_attach_result (pipeline, "src sizemax 100 0"));
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      test_series_attach_result (pipeline, "src sizemax 100 86401"));
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      test_series_attach_result (pipeline, "src sizemax 100 99999999999"));
+
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_telemetry_cadence)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdTelemetrySeries *series;
+
+  series = test_series_attach (pipeline, "src sizemax 100 10");
+
+  fail_unless_equals_int64 (TEST_PERIOD,
+      gstd_telemetry_series_poll (series, 0));
+  fail_unless_equals_int (1, test_series_count (series, "samples"));
+
+  /* Not due yet */
+  fail_unless_equals_int64 (TEST_PERIOD,
+      gstd_telemetry_series_poll (series, TEST_PERIOD / 2));
+  fail_unless_equals_int (1, test_series_count (series, "samples"));
+
+  fail_unless_equals_int64 (2 * TEST_PERIOD,
+      gstd_telemetry_series_poll (series, TEST_PERIOD));
+  fail_unless_equals_int (2, test_series_count (series, "samples"));
+
+  /* Fell behind, the cadence starts over from now */
+  fail_unless_equals_int64 (11 * TEST_PERIOD,
+      gstd_telemetry_series_poll (series, 10 * TEST_PERIOD));
+  fail_unless_equals_int (3, test_series_count (series, "samples"));
+
+  /* Detached series are not sampled */
+  gstd_telemetry_series_detach (series);
+  gstd_telemetry_series_poll (series, 11 * TEST_PERIOD);
+  fail_unless_equals_int (3, test_series_count (series, "samples"));
+
+  g_object_unref (series);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_telemetry_downsample)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdTelemetrySeries *series;
+  gdouble value;
+
+  series = test_series_attach (pipeline, "src sizemax 100 5");
+  test_series_sample (series, pipeline, 25, FALSE);
+
+  /* The raw ring keeps the latest samples, every ten of them are
+     summarized into a downsampled point */
+  fail_unless_equals_int (5, test_series_count (series, "samples"));
+  fail_unless_equals_int (2, test_series_count (series, "downsampled"));
+  fail_unless_equals_int (0, test_series_count (series, "errors"));
+
+  g_object_get (series, "value", &value, NULL);
+  fail_unless_equals_float (24, value);
+
+  /* Sampled within a second, the raw samples still cover the span of
+     both downsampled points */
+  fail_unless_equals_int (5, test_series_query (series, "all", NULL));
+
+  g_object_unref (series);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_telemetry_range_downsampled)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdTelemetrySeries *series;
+  gchar *response;
+  guint count;
+
+  series = test_series_attach (pipeline, "src sizemax 100 5");
+  test_series_sample (series, pipeline, 20, TRUE);
+
+  fail_unless_equals_int (5, test_series_count (series, "samples"));
+  fail_unless_equals_int (2, test_series_count (series, "downsampled"));
+
+  /* The first second is gone from the raw ring, so its downsampled
+     point leads the range. The second one may still overlap it */
+  count = test_series_query (series, "all", &response);
+  fail_unless (count >= 6 && count <= 7, "Got %u points", count);
+
+  /* The mean of the first ten samples, 0 to 9 */
+  fail_unless (NULL != strstr (response, "4.5"), "%s", response);
+  g_free (response);
+
+  g_object_unref (series);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_telemetry_range_bounds)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdTelemetrySeries *series;
+  GstdObject *points = NULL;
+  gchar *range;
+
+  series = test_series_attach (pipeline, "src sizemax 100 5");
+  test_series_sample (series, pipeline, 5, FALSE);
+
+  fail_unless_equals_int (5, test_series_query (series, "last=3600", NULL));
+  fail_unless_equals_int (0, test_series_query (series, "to=0", NULL));
+
+  range = g_strdup_printf ("from=%" G_GINT64_FORMAT,
+      g_get_real_time () + 3600 * G_TIME_SPAN_SECOND);
+  fail_unless_equals_int (0, test_series_query (series, range, NULL));
+  g_free (range);
+
+  range = g_strdup_printf ("from=0,to=%" G_GINT64_FORMAT,
+      g_get_real_time () + 3600 * G_TIME_SPAN_SECOND);
+  fail_unless_equals_int (5, test_series_query (series, range, NULL));
+  g_free (range);
+
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      gstd_telemetry_series_query (series, "bogus", &points));
+  fail_unless (NULL == points);
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      gstd_telemetry_series_query (series, "from=now", &points));
+  fail_unless (NULL == points);
+  fail_unless_equals_int (GSTD_BAD_VALUE,
+      gstd_telemetry_series_query (series, "since=0", &points));
+  fail_unless (NULL == points);
+
+  g_object_unref (series);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+GST_START_TEST (test_telemetry_interval_update)
+{
+  GstElement *pipeline = test_pipeline_new ();
+  GstdPipelineTelemetry *telemetry = gstd_pipeline_telemetry_new ();
+  GstdObject *series = NULL;
+  gint64 deadline;
+
+  gstd_pipeline_telemetry_watch (telemetry, GST_BIN (pipeline));
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_icreator_create (GSTD_ICREATOR (telemetry), "s0",
+          "src sizemax 60000 10", &series));
+
+  /* The first sample is taken right away */
+  deadline = g_get_monotonic_time () + 5 * TEST_PERIOD;
+  while (0 == test_series_count (GSTD_TELEMETRY_SERIES (series), "samples")
+      && g_get_monotonic_time () < deadline) {
+    g_usleep (TEST_PERIOD / 10);
+  }
+  fail_unless_equals_int (1,
+      test_series_count (GSTD_TELEMETRY_SERIES (series), "samples"));
+
+  /* The sampler doesn't sleep through the old interval */
+  g_object_set (series, "interval", 100, NULL);
+  deadline = g_get_monotonic_time () + 5 * TEST_PERIOD;
+  while (test_series_count (GSTD_TELEMETRY_SERIES (series), "samples") < 2
+      && g_get_monotonic_time () < deadline) {
+    g_usleep (TEST_PERIOD / 10);
+  }
+  fail_unless (test_series_count (GSTD_TELEMETRY_SERIES (series),
+          "samples") >= 2);
+
+  fail_unless_equals_int (GSTD_EOK,
+      gstd_ideleter_delete (GSTD_IDELETER (telemetry), series));
+
+  g_object_unref (telemetry);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+
+static Suite *
+gstd_telemetry_suite (void)
+{
+  Suite *suite = suite_create ("gstd_telemetry");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_telemetry_attach_invalid);
+  tcase_add_test (tc, test_telemetry_cadence);
+  tcase_add_test (tc, test_telemetry_downsample);
+  tcase_add_test (tc, test_telemetry_range_downsampled);
+  tcase_add_test (tc, test_telemetry_range_bounds);
+  tcase_add_test (tc, test_telemetry_interval_update);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_telemetry);